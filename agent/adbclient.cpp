@@ -0,0 +1,511 @@
+#include "adbclient.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+namespace SysMon {
+
+constexpr size_t AdbClient::SYNC_DATA_MAX;
+constexpr size_t AdbClient::FRAMES_PER_WRITE;
+constexpr std::chrono::seconds AdbClient::IO_TIMEOUT;
+
+namespace {
+
+// Sync frames carry a four-letter id and a little-endian 32-bit length
+struct SyncHeader {
+    char id[4];
+    uint8_t length[4];
+};
+
+void encodeLength(uint8_t out[4], uint32_t value) {
+    out[0] = static_cast<uint8_t>(value);
+    out[1] = static_cast<uint8_t>(value >> 8);
+    out[2] = static_cast<uint8_t>(value >> 16);
+    out[3] = static_cast<uint8_t>(value >> 24);
+}
+
+uint32_t decodeLength(const uint8_t in[4]) {
+    return static_cast<uint32_t>(in[0]) | (static_cast<uint32_t>(in[1]) << 8) |
+           (static_cast<uint32_t>(in[2]) << 16) | (static_cast<uint32_t>(in[3]) << 24);
+}
+
+SyncHeader makeHeader(const char id[4], uint32_t length) {
+    SyncHeader header;
+    std::memcpy(header.id, id, 4);
+    encodeLength(header.length, length);
+    return header;
+}
+
+bool hasId(const SyncHeader& header, const char* id) {
+    return std::memcmp(header.id, id, 4) == 0;
+}
+
+} // anonymous namespace
+
+AdbClient::AdbClient(int port)
+    : port_(port) {
+}
+
+int AdbClient::serverPort() {
+    const char* value = std::getenv("ANDROID_ADB_SERVER_PORT");
+    int port = value ? std::atoi(value) : 0;
+    return port > 0 && port < 65536 ? port : 5037;
+}
+
+#ifndef _WIN32
+
+bool AdbClient::push(const std::string& serial, const void* data, size_t size, const std::string& remotePath,
+                     uint32_t mode, const ProgressCallback& progress, std::string& error) {
+    int socket = openService(serial, "sync:", error);
+    if (socket < 0) {
+        return false;
+    }
+
+    // "SEND" <path>,<mode>, then DATA frames, then DONE with the mtime
+    bool ok = sendSyncRequest(socket, "SEND", remotePath + "," + std::to_string(mode), error);
+
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    size_t offset = 0;
+    SyncHeader headers[FRAMES_PER_WRITE];
+    struct iovec vectors[FRAMES_PER_WRITE * 2];
+    while (ok && offset < size) {
+        size_t frames = 0;
+        size_t batchBytes = 0;
+        while (frames < FRAMES_PER_WRITE && offset + batchBytes < size) {
+            size_t chunk = std::min(SYNC_DATA_MAX, size - offset - batchBytes);
+            headers[frames] = makeHeader("DATA", static_cast<uint32_t>(chunk));
+            vectors[frames * 2].iov_base = &headers[frames];
+            vectors[frames * 2].iov_len = sizeof(SyncHeader);
+            vectors[frames * 2 + 1].iov_base = const_cast<uint8_t*>(bytes + offset + batchBytes);
+            vectors[frames * 2 + 1].iov_len = chunk;
+            batchBytes += chunk;
+            frames++;
+        }
+
+        // writev() may stop part way; advance through the vectors
+        struct iovec* vector = vectors;
+        int count = static_cast<int>(frames * 2);
+        while (count > 0) {
+            ssize_t written = writev(socket, vector, count);
+            if (written < 0 && errno == EINTR) {
+                continue;
+            }
+            if (written <= 0) {
+                error = "Connection to device lost";
+                ok = false;
+                break;
+            }
+            size_t remaining = static_cast<size_t>(written);
+            while (count > 0 && remaining >= vector->iov_len) {
+                remaining -= vector->iov_len;
+                ++vector;
+                --count;
+            }
+            if (count > 0) {
+                vector->iov_base = static_cast<uint8_t*>(vector->iov_base) + remaining;
+                vector->iov_len -= remaining;
+            }
+        }
+
+        offset += batchBytes;
+        if (ok && progress && !progress(offset, size)) {
+            error = "Cancelled";
+            ok = false;
+        }
+    }
+
+    if (ok) {
+        SyncHeader done = makeHeader("DONE", static_cast<uint32_t>(std::time(nullptr)));
+        ok = writeAll(socket, &done, sizeof(done));
+        if (!ok) {
+            error = "Connection to device lost";
+        }
+    }
+    ok = ok && readSyncStatus(socket, error);
+
+    closeSocket(socket);
+    return ok;
+}
+
+bool AdbClient::pull(const std::string& serial, const std::string& remotePath, const std::string& localPath,
+                     const ProgressCallback& progress, std::string& error) {
+    int socket = openService(serial, "sync:", error);
+    if (socket < 0) {
+        return false;
+    }
+
+    // STAT first for the size; it is 32-bit, so larger files report no total
+    uint64_t total = 0;
+    if (!sendSyncRequest(socket, "STAT", remotePath, error)) {
+        closeSocket(socket);
+        return false;
+    }
+    uint8_t stat[16];
+    if (!readExactly(socket, stat, sizeof(stat)) || std::memcmp(stat, "STAT", 4) != 0) {
+        error = "Unexpected reply to STAT";
+        closeSocket(socket);
+        return false;
+    }
+    if (decodeLength(stat + 4) == 0) {
+        error = "Remote file not found: " + remotePath;
+        closeSocket(socket);
+        return false;
+    }
+    total = decodeLength(stat + 8);
+
+    // Written under a temporary name and renamed, so a failed pull never
+    // leaves a truncated file at the destination
+    std::string partialPath = localPath + ".part";
+    int fileFd = open(partialPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC | O_NOFOLLOW, 0644);
+    if (fileFd < 0) {
+        error = "Cannot create " + partialPath + ": " + std::strerror(errno);
+        closeSocket(socket);
+        return false;
+    }
+
+    bool ok = sendSyncRequest(socket, "RECV", remotePath, error);
+    uint64_t received = 0;
+    std::vector<uint8_t> buffer(SYNC_DATA_MAX);
+    while (ok) {
+        SyncHeader header;
+        if (!readExactly(socket, &header, sizeof(header))) {
+            error = "Connection to device lost";
+            ok = false;
+            break;
+        }
+        uint32_t length = decodeLength(header.length);
+
+        if (hasId(header, "DONE")) {
+            break;
+        }
+        if (hasId(header, "FAIL")) {
+            std::string message(std::min<size_t>(length, 1024), '\0');
+            readExactly(socket, &message[0], message.size());
+            error = "Device refused pull: " + message;
+            ok = false;
+            break;
+        }
+        if (!hasId(header, "DATA") || length > SYNC_DATA_MAX) {
+            error = "Malformed sync frame";
+            ok = false;
+            break;
+        }
+
+        if (!readExactly(socket, buffer.data(), length)) {
+            error = "Connection to device lost";
+            ok = false;
+            break;
+        }
+        if (!writeAll(fileFd, buffer.data(), length)) {
+            error = "Write to " + partialPath + " failed: " + std::strerror(errno);
+            ok = false;
+            break;
+        }
+
+        received += length;
+        if (progress && !progress(received, std::max(total, received))) {
+            error = "Cancelled";
+            ok = false;
+        }
+    }
+
+    if (close(fileFd) != 0 && ok) {
+        error = "Write to " + partialPath + " failed: " + std::strerror(errno);
+        ok = false;
+    }
+    if (ok && std::rename(partialPath.c_str(), localPath.c_str()) != 0) {
+        error = "Cannot rename " + partialPath + ": " + std::strerror(errno);
+        ok = false;
+    }
+    if (!ok) {
+        unlink(partialPath.c_str());
+    }
+
+    closeSocket(socket);
+    return ok;
+}
+
+bool AdbClient::install(const std::string& serial, const void* data, size_t size,
+                        const ProgressCallback& progress, std::string& error) {
+    std::string output;
+    if (streamInstall(serial, data, size, progress, output, error)) {
+        if (output.find("Success") != std::string::npos) {
+            return true;
+        }
+
+        // "cmd" is missing before Android 7; anything else is a real failure
+        bool unsupported = output.find("not found") != std::string::npos ||
+                           output.find("Unknown command") != std::string::npos ||
+                           output.find("Can't find service") != std::string::npos;
+        if (!unsupported) {
+            error = output.empty() ? "Install failed" : output;
+            while (!error.empty() && (error.back() == '\n' || error.back() == '\r')) {
+                error.pop_back();
+            }
+            return false;
+        }
+    } else if (error == "Cancelled") {
+        return false;
+    }
+
+    // Fallback: sync push, then pm install and clean up on the device
+    static std::atomic<uint32_t> sequence{0};
+    const std::string remotePath = "/data/local/tmp/sysmon_install_" + std::to_string(getpid()) + "_" +
+                                   std::to_string(++sequence) + ".apk";
+    error.clear();
+    if (!push(serial, data, size, remotePath, 0644, progress, error)) {
+        return false;
+    }
+    if (!runShell(serial, "pm install -r " + remotePath + "; rm -f " + remotePath, output, error)) {
+        return false;
+    }
+    if (output.find("Success") == std::string::npos) {
+        error = output.empty() ? "Install failed" : output;
+        return false;
+    }
+    return true;
+}
+
+bool AdbClient::streamInstall(const std::string& serial, const void* data, size_t size,
+                              const ProgressCallback& progress, std::string& output, std::string& error) {
+    int socket = openService(serial, "exec:cmd package install -r -S " + std::to_string(size), error);
+    if (socket < 0) {
+        return false;
+    }
+
+    // The package manager reads exactly size bytes, then prints the result
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    const size_t batch = SYNC_DATA_MAX * FRAMES_PER_WRITE;
+    size_t offset = 0;
+    bool ok = true;
+    while (ok && offset < size) {
+        size_t chunk = std::min(batch, size - offset);
+        if (!writeAll(socket, bytes + offset, chunk)) {
+            // The device may have rejected the APK early; its message follows
+            break;
+        }
+        offset += chunk;
+        if (progress && !progress(offset, size)) {
+            error = "Cancelled";
+            ok = false;
+        }
+    }
+
+    if (ok) {
+        readToEnd(socket, output);
+    }
+    closeSocket(socket);
+    return ok;
+}
+
+bool AdbClient::runShell(const std::string& serial, const std::string& command, std::string& output,
+                         std::string& error) const {
+    int socket = openService(serial, "shell:" + command, error);
+    if (socket < 0) {
+        return false;
+    }
+    readToEnd(socket, output);
+    closeSocket(socket);
+    return true;
+}
+
+int AdbClient::connectServer(std::string& error) const {
+    int socket = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (socket < 0) {
+        error = "Cannot create socket";
+        return -1;
+    }
+
+    // A wedged device must not hold a worker forever
+    struct timeval timeout;
+    timeout.tv_sec = static_cast<time_t>(IO_TIMEOUT.count());
+    timeout.tv_usec = 0;
+    setsockopt(socket, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    setsockopt(socket, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+    struct sockaddr_in address;
+    std::memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_port = htons(static_cast<uint16_t>(port_));
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (connect(socket, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) != 0) {
+        error = "Cannot connect to adb server on port " + std::to_string(port_);
+        closeSocket(socket);
+        return -1;
+    }
+    return socket;
+}
+
+int AdbClient::openService(const std::string& serial, const std::string& service, std::string& error) const {
+    int socket = connectServer(error);
+    if (socket < 0) {
+        return -1;
+    }
+
+    if (!sendRequest(socket, "host:transport:" + serial, error) || !readStatus(socket, error) ||
+        !sendRequest(socket, service, error) || !readStatus(socket, error)) {
+        closeSocket(socket);
+        return -1;
+    }
+    return socket;
+}
+
+bool AdbClient::sendRequest(int socket, const std::string& request, std::string& error) {
+    // Four hex digits of length, then the request
+    char length[5];
+    std::snprintf(length, sizeof(length), "%04x", static_cast<unsigned>(request.size() & 0xffff));
+    if (request.size() > 0xffff || !writeAll(socket, length, 4) ||
+        !writeAll(socket, request.data(), request.size())) {
+        error = "Cannot send request to adb server";
+        return false;
+    }
+    return true;
+}
+
+bool AdbClient::readStatus(int socket, std::string& error) {
+    char status[4];
+    if (!readExactly(socket, status, sizeof(status))) {
+        error = "No reply from adb server";
+        return false;
+    }
+    if (std::memcmp(status, "OKAY", 4) == 0) {
+        return true;
+    }
+
+    // FAIL, then a hex length and the reason ("device 'X' not found")
+    char length[5] = {0};
+    error = "adb server refused request";
+    if (std::memcmp(status, "FAIL", 4) == 0 && readExactly(socket, length, 4)) {
+        size_t size = std::min<size_t>(std::strtoul(length, nullptr, 16), 1024);
+        std::string message(size, '\0');
+        if (readExactly(socket, &message[0], size)) {
+            error = message;
+        }
+    }
+    return false;
+}
+
+bool AdbClient::sendSyncRequest(int socket, const char id[4], const std::string& path, std::string& error) {
+    if (path.size() > 1024) {
+        error = "Remote path too long";
+        return false;
+    }
+    SyncHeader header = makeHeader(id, static_cast<uint32_t>(path.size()));
+    if (!writeAll(socket, &header, sizeof(header)) || !writeAll(socket, path.data(), path.size())) {
+        error = "Connection to device lost";
+        return false;
+    }
+    return true;
+}
+
+bool AdbClient::readSyncStatus(int socket, std::string& error) {
+    SyncHeader header;
+    if (!readExactly(socket, &header, sizeof(header))) {
+        error = "Connection to device lost";
+        return false;
+    }
+    if (hasId(header, "OKAY")) {
+        return true;
+    }
+
+    uint32_t length = decodeLength(header.length);
+    std::string message(std::min<size_t>(length, 1024), '\0');
+    if (hasId(header, "FAIL") && readExactly(socket, &message[0], message.size())) {
+        error = "Device refused push: " + message;
+    } else {
+        error = "Malformed sync frame";
+    }
+    return false;
+}
+
+bool AdbClient::writeAll(int socket, const void* data, size_t size) {
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    while (size > 0) {
+        ssize_t written = write(socket, bytes, size);
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+        if (written <= 0) {
+            return false;
+        }
+        bytes += written;
+        size -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+bool AdbClient::readExactly(int socket, void* data, size_t size) {
+    auto* bytes = static_cast<uint8_t*>(data);
+    while (size > 0) {
+        ssize_t received = read(socket, bytes, size);
+        if (received < 0 && errno == EINTR) {
+            continue;
+        }
+        if (received <= 0) {
+            return false;
+        }
+        bytes += received;
+        size -= static_cast<size_t>(received);
+    }
+    return true;
+}
+
+bool AdbClient::readToEnd(int socket, std::string& output) {
+    char chunk[4096];
+    while (output.size() < 64 * 1024) {
+        ssize_t received = read(socket, chunk, sizeof(chunk));
+        if (received < 0 && errno == EINTR) {
+            continue;
+        }
+        if (received <= 0) {
+            return received == 0;
+        }
+        output.append(chunk, static_cast<size_t>(received));
+    }
+    return true;
+}
+
+void AdbClient::closeSocket(int socket) {
+    if (socket >= 0) {
+        close(socket);
+    }
+}
+
+#else
+
+// Windows keeps using adb.exe through AndroidManager
+bool AdbClient::push(const std::string&, const void*, size_t, const std::string&, uint32_t,
+                     const ProgressCallback&, std::string& error) {
+    error = "ADB sync is not supported on Windows";
+    return false;
+}
+
+bool AdbClient::pull(const std::string&, const std::string&, const std::string&,
+                     const ProgressCallback&, std::string& error) {
+    error = "ADB sync is not supported on Windows";
+    return false;
+}
+
+bool AdbClient::install(const std::string&, const void*, size_t, const ProgressCallback&, std::string& error) {
+    error = "ADB sync is not supported on Windows";
+    return false;
+}
+
+#endif
+
+} // namespace SysMon
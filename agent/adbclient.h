@@ -0,0 +1,68 @@
+#pragma once
+
+#include <string>
+#include <functional>
+#include <chrono>
+#include <cstdint>
+
+namespace SysMon {
+
+// ADB Client - talks to the local adb server directly instead of spawning adb
+//
+// Speaks the adb server's smart-socket protocol ("host:transport:<serial>"
+// followed by a service) and the sync protocol on top of it. Pushes stream
+// from the caller's buffer (typically an mmap) in batches of 64 KiB DATA
+// frames with one writev() per batch, so nothing is copied in user space.
+// Pulls go straight from the socket to the destination file. Every call
+// opens its own connection, so one client may be used from many threads.
+// Linux/macOS only; on Windows every call fails.
+class AdbClient {
+public:
+    // Called after every batch; returning false aborts the transfer
+    using ProgressCallback = std::function<bool(uint64_t transferred, uint64_t total)>;
+
+    explicit AdbClient(int port = serverPort());
+
+    bool push(const std::string& serial, const void* data, size_t size, const std::string& remotePath,
+              uint32_t mode, const ProgressCallback& progress, std::string& error);
+    bool pull(const std::string& serial, const std::string& remotePath, const std::string& localPath,
+              const ProgressCallback& progress, std::string& error);
+
+    // Streams the APK into "cmd package install -S" (Android 7+); older
+    // devices get a sync push to /data/local/tmp and "pm install"
+    bool install(const std::string& serial, const void* data, size_t size,
+                 const ProgressCallback& progress, std::string& error);
+
+    // ANDROID_ADB_SERVER_PORT, else 5037
+    static int serverPort();
+
+    // Constants
+    static constexpr size_t SYNC_DATA_MAX = 64 * 1024;          // protocol limit per DATA frame
+    static constexpr size_t FRAMES_PER_WRITE = 16;              // 1 MiB per writev()
+    static constexpr std::chrono::seconds IO_TIMEOUT{30};
+
+private:
+    // Smart-socket helpers; return a connected socket or -1 with error set
+    int connectServer(std::string& error) const;
+    int openService(const std::string& serial, const std::string& service, std::string& error) const;
+    static bool sendRequest(int socket, const std::string& request, std::string& error);
+    static bool readStatus(int socket, std::string& error);
+
+    // Sync protocol
+    static bool sendSyncRequest(int socket, const char id[4], const std::string& path, std::string& error);
+    static bool readSyncStatus(int socket, std::string& error);
+    bool streamInstall(const std::string& serial, const void* data, size_t size,
+                       const ProgressCallback& progress, std::string& output, std::string& error);
+    bool runShell(const std::string& serial, const std::string& command, std::string& output,
+                  std::string& error) const;
+
+    // Socket I/O
+    static bool writeAll(int socket, const void* data, size_t size);
+    static bool readExactly(int socket, void* data, size_t size);
+    static bool readToEnd(int socket, std::string& output);
+    static void closeSocket(int socket);
+
+    int port_;
+};
+
+} // namespace SysMon
@@ -0,0 +1,519 @@
+#include "adbtransfermanager.h"
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace SysMon {
+
+constexpr size_t AdbTransferManager::DEFAULT_PARALLELISM;
+constexpr size_t AdbTransferManager::MAX_PARALLELISM;
+constexpr size_t AdbTransferManager::MAX_TRANSFERS;
+constexpr size_t AdbTransferManager::MAX_QUEUED;
+constexpr std::chrono::milliseconds AdbTransferManager::PROGRESS_INTERVAL;
+
+AdbTransferManager::MappedFile::~MappedFile() {
+#ifndef _WIN32
+    if (data_) {
+        munmap(data_, size_);
+    }
+#endif
+}
+
+std::shared_ptr<AdbTransferManager::MappedFile> AdbTransferManager::MappedFile::open(const std::string& path,
+                                                                                      std::string& error) {
+#ifdef _WIN32
+    (void)path;
+    error = "File transfers are not supported on Windows";
+    return nullptr;
+#else
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        error = "Cannot open " + path + ": " + std::strerror(errno);
+        return nullptr;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)) {
+        error = "Not a regular file: " + path;
+        close(fd);
+        return nullptr;
+    }
+
+    std::shared_ptr<MappedFile> file(new MappedFile());
+    file->size_ = static_cast<size_t>(info.st_size);
+    if (file->size_ > 0) {
+        void* data = mmap(nullptr, file->size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED) {
+            error = "Cannot map " + path + ": " + std::strerror(errno);
+            close(fd);
+            return nullptr;
+        }
+        // Read front to back once per device
+        madvise(data, file->size_, MADV_SEQUENTIAL);
+        file->data_ = data;
+    }
+    close(fd);
+    return file;
+#endif
+}
+
+AdbTransferManager::AdbTransferManager()
+    : running_(false)
+    , initialized_(false)
+    , fallbackMode_(false)
+    , nextId_(1)
+    , parallelism_(DEFAULT_PARALLELISM) {
+}
+
+AdbTransferManager::~AdbTransferManager() {
+    shutdown();
+}
+
+bool AdbTransferManager::initialize() {
+    if (initialized_) {
+        return true;
+    }
+
+#ifdef _WIN32
+    return false;
+#else
+    if (transferDirectory_.empty()) {
+        return false;
+    }
+
+    // The directory must exist; everything is resolved against its real path
+    char resolved[PATH_MAX];
+    if (!realpath(transferDirectory_.c_str(), resolved)) {
+        return false;
+    }
+    transferDirectory_ = resolved;
+
+    initialized_ = true;
+    return true;
+#endif
+}
+
+void AdbTransferManager::shutdown() {
+    if (!initialized_) {
+        return;
+    }
+
+    stop();
+
+    initialized_ = false;
+}
+
+bool AdbTransferManager::start() {
+    if (!initialized_) {
+        return false;
+    }
+
+    if (running_ || fallbackMode_) {
+        return true;
+    }
+
+    running_ = true;
+    for (size_t i = 0; i < parallelism_; ++i) {
+        workers_.emplace_back(&AdbTransferManager::workerThread, this);
+    }
+
+    return true;
+}
+
+void AdbTransferManager::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_ = false;
+    }
+    queueCondition_.notify_all();
+
+    // Running transfers see running_ in their progress callback and abort
+    for (auto& worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    workers_.clear();
+
+    std::vector<uint64_t> cancelled;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& task : queue_) {
+            cancelled.push_back(task.id);
+        }
+        queue_.clear();
+    }
+    for (uint64_t id : cancelled) {
+        finishTransfer(id, false, "Agent stopped");
+    }
+}
+
+void AdbTransferManager::enableFallbackMode() {
+    fallbackMode_ = true;
+}
+
+bool AdbTransferManager::isFallbackMode() const {
+    return fallbackMode_;
+}
+
+void AdbTransferManager::setParallelism(size_t workers) {
+    parallelism_ = std::max<size_t>(1, std::min(workers, MAX_PARALLELISM));
+}
+
+void AdbTransferManager::setTransferDirectory(const std::string& directory) {
+    transferDirectory_ = directory;
+}
+
+void AdbTransferManager::setProgressCallback(ProgressCallback callback) {
+    progressCallback_ = std::move(callback);
+}
+
+uint64_t AdbTransferManager::pushFile(const std::string& serial, const std::string& localPath,
+                                      const std::string& remotePath, std::string& error) {
+    if (!isValidSerial(serial)) {
+        error = "Invalid device serial";
+        return 0;
+    }
+    if (!isValidRemotePath(remotePath)) {
+        error = "Remote path must be absolute";
+        return 0;
+    }
+
+    std::string resolved;
+    if (!resolveLocalPath(localPath, true, resolved, error)) {
+        return 0;
+    }
+    auto file = MappedFile::open(resolved, error);
+    if (!file) {
+        return 0;
+    }
+
+    AndroidTransferInfo transfer;
+    transfer.serial = serial;
+    transfer.operation = "push";
+    transfer.localPath = localPath;
+    transfer.remotePath = remotePath;
+    transfer.totalBytes = file->size();
+    return enqueue({std::move(transfer)}, std::move(file), false, error);
+}
+
+uint64_t AdbTransferManager::pullFile(const std::string& serial, const std::string& remotePath,
+                                      const std::string& localPath, std::string& error) {
+    if (!isValidSerial(serial)) {
+        error = "Invalid device serial";
+        return 0;
+    }
+    if (!isValidRemotePath(remotePath)) {
+        error = "Remote path must be absolute";
+        return 0;
+    }
+
+    std::string resolved;
+    if (!resolveLocalPath(localPath, false, resolved, error)) {
+        return 0;
+    }
+
+    AndroidTransferInfo transfer;
+    transfer.serial = serial;
+    transfer.operation = "pull";
+    transfer.localPath = localPath;
+    transfer.remotePath = remotePath;
+    return enqueue({std::move(transfer)}, nullptr, false, error);
+}
+
+uint64_t AdbTransferManager::installApk(const std::vector<std::string>& serials, const std::string& apkPath,
+                                        std::string& error) {
+    if (serials.empty()) {
+        error = "No devices to install to";
+        return 0;
+    }
+    for (const auto& serial : serials) {
+        if (!isValidSerial(serial)) {
+            error = "Invalid device serial: " + serial;
+            return 0;
+        }
+    }
+
+    std::string resolved;
+    if (!resolveLocalPath(apkPath, true, resolved, error)) {
+        return 0;
+    }
+
+    // Mapped once; every device streams from the same pages
+    auto file = MappedFile::open(resolved, error);
+    if (!file) {
+        return 0;
+    }
+    if (file->size() == 0) {
+        error = "APK is empty";
+        return 0;
+    }
+
+    std::vector<AndroidTransferInfo> transfers;
+    for (const auto& serial : serials) {
+        AndroidTransferInfo transfer;
+        transfer.serial = serial;
+        transfer.operation = "install";
+        transfer.localPath = apkPath;
+        transfer.totalBytes = file->size();
+        transfers.push_back(std::move(transfer));
+    }
+    return enqueue(std::move(transfers), file, true, error);
+}
+
+std::vector<AndroidTransferInfo> AdbTransferManager::getTransfers(uint64_t batchId) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<AndroidTransferInfo> result;
+    result.reserve(transfers_.size());
+    for (const auto& transfer : transfers_) {
+        if (batchId == 0 || transfer.batchId == batchId) {
+            result.push_back(transfer);
+        }
+    }
+    return result;
+}
+
+bool AdbTransferManager::isRunning() const {
+    return running_;
+}
+
+void AdbTransferManager::workerThread() {
+    while (true) {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            queueCondition_.wait(lock, [this] { return !running_ || !queue_.empty(); });
+            if (!running_) {
+                return;
+            }
+            task = std::move(queue_.front());
+            queue_.pop_front();
+
+            if (auto* transfer = findTransfer(task.id)) {
+                transfer->state = "running";
+                transfer->startedAt = currentTimeMs();
+            }
+        }
+        notify(task.id);
+
+        runTask(task);
+    }
+}
+
+void AdbTransferManager::runTask(const Task& task) {
+    AndroidTransferInfo transfer;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto* found = findTransfer(task.id);
+        if (!found) {
+            return;
+        }
+        transfer = *found;
+    }
+
+    auto lastReport = std::chrono::steady_clock::now();
+    AdbClient::ProgressCallback progress = [this, &task, &lastReport](uint64_t transferred, uint64_t total) {
+        return reportProgress(task.id, transferred, total, lastReport);
+    };
+
+    std::string error;
+    bool success = false;
+    if (transfer.operation == "push") {
+        success = client_.push(transfer.serial, task.file->data(), task.file->size(), transfer.remotePath,
+                               0644, progress, error);
+    } else if (transfer.operation == "pull") {
+        std::string resolved;
+        success = resolveLocalPath(transfer.localPath, false, resolved, error) &&
+                  client_.pull(transfer.serial, transfer.remotePath, resolved, progress, error);
+    } else {
+        success = client_.install(transfer.serial, task.file->data(), task.file->size(), progress, error);
+    }
+
+    finishTransfer(task.id, success, error);
+}
+
+bool AdbTransferManager::reportProgress(uint64_t id, uint64_t transferred, uint64_t total,
+                                        std::chrono::steady_clock::time_point& lastReport) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (auto* transfer = findTransfer(id)) {
+            transfer->bytesTransferred = transferred;
+            transfer->totalBytes = total;
+        }
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    if (now - lastReport >= PROGRESS_INTERVAL) {
+        lastReport = now;
+        notify(id);
+    }
+    return running_;
+}
+
+uint64_t AdbTransferManager::enqueue(std::vector<AndroidTransferInfo> transfers, std::shared_ptr<MappedFile> file,
+                                     bool batch, std::string& error) {
+    uint64_t firstId = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_) {
+            error = "Transfer manager not running";
+            return 0;
+        }
+        if (queue_.size() + transfers.size() > MAX_QUEUED) {
+            error = "Too many queued transfers";
+            return 0;
+        }
+
+        // A batch is named after its first transfer
+        firstId = nextId_;
+        for (auto& transfer : transfers) {
+            transfer.id = nextId_++;
+            transfer.batchId = batch ? firstId : 0;
+            transfer.sanitize();
+            queue_.push_back({transfer.id, file});
+            transfers_.push_back(transfer);
+        }
+
+        // Drop the oldest finished transfers; queued and running ones stay
+        while (transfers_.size() > MAX_TRANSFERS) {
+            auto it = std::find_if(transfers_.begin(), transfers_.end(), [](const AndroidTransferInfo& entry) {
+                return entry.state == "done" || entry.state == "failed";
+            });
+            if (it == transfers_.end()) {
+                break;
+            }
+            transfers_.erase(it);
+        }
+    }
+
+    for (const auto& transfer : transfers) {
+        notify(transfer.id);
+    }
+    queueCondition_.notify_all();
+    return firstId;
+}
+
+void AdbTransferManager::finishTransfer(uint64_t id, bool success, const std::string& error) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto* transfer = findTransfer(id);
+        if (!transfer) {
+            return;
+        }
+        transfer->state = success ? "done" : "failed";
+        transfer->error = success ? std::string() : error;
+        if (transfer->startedAt > 0) {
+            uint64_t now = currentTimeMs();
+            transfer->durationMs = now > transfer->startedAt ? now - transfer->startedAt : 0;
+        }
+        transfer->sanitize();
+    }
+    notify(id);
+}
+
+void AdbTransferManager::notify(uint64_t id) {
+    if (!progressCallback_) {
+        return;
+    }
+
+    AndroidTransferInfo snapshot;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto* transfer = findTransfer(id);
+        if (!transfer) {
+            return;
+        }
+        snapshot = *transfer;
+    }
+    progressCallback_(snapshot);
+}
+
+AndroidTransferInfo* AdbTransferManager::findTransfer(uint64_t id) {
+    // Ids are increasing, so the history is sorted by id
+    auto it = std::lower_bound(transfers_.begin(), transfers_.end(), id,
+                               [](const AndroidTransferInfo& entry, uint64_t value) { return entry.id < value; });
+    return it != transfers_.end() && it->id == id ? &*it : nullptr;
+}
+
+bool AdbTransferManager::resolveLocalPath(const std::string& path, bool mustExist, std::string& resolved,
+                                          std::string& error) const {
+#ifdef _WIN32
+    (void)path;
+    (void)mustExist;
+    (void)resolved;
+    error = "File transfers are not supported on Windows";
+    return false;
+#else
+    if (path.empty() || path.size() > 1024 || path[0] == '/') {
+        error = "Local path must be relative to the transfer directory";
+        return false;
+    }
+    size_t start = 0;
+    while (start <= path.size()) {
+        size_t end = path.find('/', start);
+        if (end == std::string::npos) {
+            end = path.size();
+        }
+        if (path.compare(start, end - start, "..") == 0 && end - start == 2) {
+            error = "Local path may not contain '..'";
+            return false;
+        }
+        start = end + 1;
+    }
+
+    // Symlinks could still point outside; check the real path of the file
+    // (or, for a pull, of its directory)
+    std::string candidate = transferDirectory_ + "/" + path;
+    std::string checked = candidate;
+    std::string fileName;
+    if (!mustExist) {
+        size_t slash = candidate.rfind('/');
+        checked = candidate.substr(0, slash);
+        fileName = candidate.substr(slash);
+    }
+
+    char buffer[PATH_MAX];
+    if (!realpath(checked.c_str(), buffer)) {
+        error = "No such file or directory: " + path;
+        return false;
+    }
+    std::string real = buffer;
+    if (real != transferDirectory_ && real.compare(0, transferDirectory_.size() + 1, transferDirectory_ + "/") != 0) {
+        error = "Local path leaves the transfer directory";
+        return false;
+    }
+
+    resolved = real + fileName;
+    return true;
+#endif
+}
+
+bool AdbTransferManager::isValidSerial(const std::string& serial) {
+    if (serial.empty() || serial.size() > 64) {
+        return false;
+    }
+    return std::all_of(serial.begin(), serial.end(), [](char c) {
+        return c > ' ' && c < 127 && c != ',';
+    });
+}
+
+bool AdbTransferManager::isValidRemotePath(const std::string& path) {
+    return !path.empty() && path[0] == '/' && path.size() <= 1024 &&
+           path.find_first_of("\n\r,") == std::string::npos;
+}
+
+uint64_t AdbTransferManager::currentTimeMs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+} // namespace SysMon
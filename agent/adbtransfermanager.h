@@ -0,0 +1,126 @@
+#pragma once
+
+#include "../shared/systemtypes.h"
+#include "adbclient.h"
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <deque>
+
+namespace SysMon {
+
+// ADB Transfer Manager - queued file push/pull and multi-device APK installs
+//
+// Transfers run on a bounded pool of worker threads over AdbClient's sync
+// protocol, so callers get an id back at once and follow progress through
+// the callback or getTransfers(). An install reads the APK once (mmap) and
+// every device streams from the same mapping. Local paths are relative to
+// the transfer directory and may not leave it.
+class AdbTransferManager {
+public:
+    // Called from worker threads, at most every PROGRESS_INTERVAL per
+    // transfer and always on state changes
+    using ProgressCallback = std::function<void(const AndroidTransferInfo&)>;
+
+    AdbTransferManager();
+    ~AdbTransferManager();
+
+    // Lifecycle
+    bool initialize();
+    bool start();
+    void stop();
+    void shutdown();
+
+    // Fallback mode support
+    void enableFallbackMode();
+    bool isFallbackMode() const;
+
+    // Configuration (before start)
+    void setParallelism(size_t workers);
+    void setTransferDirectory(const std::string& directory);
+    void setProgressCallback(ProgressCallback callback);
+
+    // Transfers; return the transfer id, or 0 with error set
+    uint64_t pushFile(const std::string& serial, const std::string& localPath, const std::string& remotePath,
+                      std::string& error);
+    uint64_t pullFile(const std::string& serial, const std::string& remotePath, const std::string& localPath,
+                      std::string& error);
+
+    // One transfer per device sharing a batch id; returns the batch id
+    uint64_t installApk(const std::vector<std::string>& serials, const std::string& apkPath, std::string& error);
+
+    // Data access; batchId 0 returns every transfer still in the history
+    std::vector<AndroidTransferInfo> getTransfers(uint64_t batchId = 0) const;
+
+    // Status
+    bool isRunning() const;
+
+private:
+    // Read-only mapping of a local file, shared by the transfers using it
+    class MappedFile {
+    public:
+        ~MappedFile();
+        static std::shared_ptr<MappedFile> open(const std::string& path, std::string& error);
+
+        const void* data() const { return data_; }
+        size_t size() const { return size_; }
+
+    private:
+        MappedFile() = default;
+        void* data_ = nullptr;
+        size_t size_ = 0;
+    };
+
+    struct Task {
+        uint64_t id;
+        std::shared_ptr<MappedFile> file;
+    };
+
+    // Worker threads
+    void workerThread();
+    void runTask(const Task& task);
+    bool reportProgress(uint64_t id, uint64_t transferred, uint64_t total,
+                        std::chrono::steady_clock::time_point& lastReport);
+
+    // Helpers
+    uint64_t enqueue(std::vector<AndroidTransferInfo> transfers, std::shared_ptr<MappedFile> file, bool batch,
+                     std::string& error);
+    void finishTransfer(uint64_t id, bool success, const std::string& error);
+    void notify(uint64_t id);
+    AndroidTransferInfo* findTransfer(uint64_t id);
+    bool resolveLocalPath(const std::string& path, bool mustExist, std::string& resolved, std::string& error) const;
+    static bool isValidSerial(const std::string& serial);
+    static bool isValidRemotePath(const std::string& path);
+    static uint64_t currentTimeMs();
+
+    // Thread management
+    std::vector<std::thread> workers_;
+    std::atomic<bool> running_;
+    std::atomic<bool> initialized_;
+    std::atomic<bool> fallbackMode_;
+
+    // Queue and history
+    std::deque<Task> queue_;
+    std::deque<AndroidTransferInfo> transfers_;
+    mutable std::mutex mutex_;
+    std::condition_variable queueCondition_;
+    uint64_t nextId_;
+
+    // Configuration
+    AdbClient client_;
+    size_t parallelism_;
+    std::string transferDirectory_;
+    ProgressCallback progressCallback_;
+
+    // Constants
+    static constexpr size_t DEFAULT_PARALLELISM = 4;
+    static constexpr size_t MAX_PARALLELISM = 32;
+    static constexpr size_t MAX_TRANSFERS = 256;
+    static constexpr size_t MAX_QUEUED = 1024;
+    static constexpr std::chrono::milliseconds PROGRESS_INTERVAL{250};
+};
+
+} // namespace SysMon
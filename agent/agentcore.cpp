@@ -1,11 +1,25 @@
 #include "agentcore.h"
 #include "ipcserver.h"
+#include "httpserver.h"
 #include "systemmonitor.h"
 #include "devicemanager.h"
 #include "networkmanager.h"
 #include "processmanager.h"
 #include "androidmanager.h"
+#include "filesystemmonitor.h"
+#include "netstatmonitor.h"
+#include "taskstatsmonitor.h"
+#include "powermonitor.h"
+#include "ebpfmonitor.h"
+#include "collectorregistry.h"
+#include "builtincollectors.h"
+#include "historyarchive.h"
+#include "historyexport.h"
+#include "androidtelemetry.h"
+#include "adbtransfermanager.h"
+#include "logstreamer.h"
 #include "automationengine.h"
+#include "watchdog.h"
 #include "logger.h"
 #include "configmanager.h"
 #include "../shared/ipcprotocol.h"
@@ -17,6 +31,8 @@
 #include <mutex>
 #include <sstream>
 #include <iomanip>
+#include <algorithm>
+#include <numeric>
 
 namespace SysMon {
 
@@ -87,6 +103,57 @@ bool AgentCore::start() {
             return false;
         }
         
+        if (httpServer_ && !httpServer_->start()) {
+            LOG_WARNING_CAT("AgentCore", "Failed to start HTTP server");
+        }
+        
+        if (logStreamer_ && !logStreamer_->start()) {
+            LOG_WARNING_CAT("AgentCore", "Failed to start log streamer");
+        }
+        
+        // Monitors register their jobs with the watchdog as they start
+        if (!Watchdog::getInstance().start()) {
+            LOG_WARNING_CAT("AgentCore", "Failed to start watchdog");
+        }
+        
+        // The device manager enforces the USB policy on plug-in
+        if (deviceManager_ && !deviceManager_->start()) {
+            LOG_WARNING_CAT("AgentCore", "Failed to start device manager");
+        }
+        
+        // The process snapshot feeds the process list, aggregates and taskstats candidates
+        if (processManager_ && !processManager_->start()) {
+            LOG_WARNING_CAT("AgentCore", "Failed to start process manager");
+        }
+        
+        if (filesystemMonitor_ && !filesystemMonitor_->start()) {
+            LOG_WARNING_CAT("AgentCore", "Failed to start filesystem monitor");
+        }
+        
+        if (netStatMonitor_ && !netStatMonitor_->start()) {
+            LOG_WARNING_CAT("AgentCore", "Failed to start network statistics monitor");
+        }
+        
+        if (taskStatsMonitor_ && !taskStatsMonitor_->start()) {
+            LOG_WARNING_CAT("AgentCore", "Failed to start taskstats monitor");
+        }
+        
+        if (powerMonitor_ && !powerMonitor_->start()) {
+            LOG_WARNING_CAT("AgentCore", "Failed to start power monitor");
+        }
+        
+        if (ebpfMonitor_ && !ebpfMonitor_->start()) {
+            LOG_WARNING_CAT("AgentCore", "Failed to start eBPF monitor");
+        }
+        
+        if (collectorRegistry_ && !collectorRegistry_->start()) {
+            LOG_WARNING_CAT("AgentCore", "Failed to start collector registry");
+        }
+        
+        if (adbTransferManager_ && !adbTransferManager_->start()) {
+            LOG_WARNING_CAT("AgentCore", "Failed to start ADB transfer manager");
+        }
+        
         LOG_INFO_CAT("AgentCore", "Starting worker thread");
         running_ = true;
         workerThread_ = std::thread(&AgentCore::workerThread, this);
@@ -114,11 +181,21 @@ void AgentCore::stop() {
     
     // Stop components
     if (automationEngine_) automationEngine_->stop();
+    if (adbTransferManager_) adbTransferManager_->stop();
     if (androidManager_) androidManager_->stop();
+    if (filesystemMonitor_) filesystemMonitor_->stop();
+    if (netStatMonitor_) netStatMonitor_->stop();
+    if (taskStatsMonitor_) taskStatsMonitor_->stop();
+    if (powerMonitor_) powerMonitor_->stop();
+    if (ebpfMonitor_) ebpfMonitor_->stop();
+    if (collectorRegistry_) collectorRegistry_->stop();
     if (processManager_) processManager_->stop();
     if (networkManager_) networkManager_->stop();
     if (deviceManager_) deviceManager_->stop();
     if (systemMonitor_) systemMonitor_->stop();
+    Watchdog::getInstance().stop();
+    if (logStreamer_) logStreamer_->stop();
+    if (httpServer_) httpServer_->stop();
     if (ipcServer_) ipcServer_->stop();
     
     // Wait for worker thread
@@ -166,12 +243,39 @@ bool AgentCore::initializeComponents() {
     // Initialize IPC server (critical)
     ipcServer_ = std::make_unique<IpcServer>();
     int ipcPort = configManager_->getInt("agent.ipc_port", Constants::DEFAULT_IPC_PORT);
-    if (!ipcServer_->initialize(ipcPort)) {
+    std::string ipcSocket = configManager_->getString("agent.ipc_socket", "");
+    if (!ipcServer_->initialize(ipcPort, ipcSocket)) {
         logger_->error("Failed to initialize IPC server on port " + std::to_string(ipcPort));
         return false;
     }
     logger_->info("IPC server initialized on port " + std::to_string(ipcPort));
     
+    // Live log tail for SUBSCRIBE topic=logs
+    logStreamer_ = std::make_unique<LogStreamer>();
+    logStreamer_->setPollInterval(std::chrono::milliseconds(
+        configManager_->getInt("log.stream_interval", 250)));
+    logStreamer_->setEventSender([this](const std::string& clientId, const Event& event) {
+        if (ipcServer_) {
+            ipcServer_->sendEventToClient(clientId, event);
+        }
+    });
+    logStreamer_->initialize();
+    
+    // Initialize optional HTTP endpoint (non-critical)
+    if (configManager_->getBool("http.enabled", false)) {
+        httpServer_ = std::make_unique<HttpServer>();
+        int httpPort = configManager_->getInt("http.port", 8082);
+        std::string bindAddress = configManager_->getString("http.bind_address", "127.0.0.1");
+        if (httpServer_->initialize(httpPort, bindAddress)) {
+            httpServer_->setAuthToken(configManager_->getString("http.token", ""));
+            httpServer_->setStreamInterval(std::chrono::milliseconds(configManager_->getInt("http.stream_interval", 1000)));
+            logger_->info("HTTP server initialized on " + bindAddress + ":" + std::to_string(httpPort));
+        } else {
+            logger_->warning("Failed to initialize HTTP server on port " + std::to_string(httpPort) + ", HTTP endpoint disabled");
+            httpServer_.reset();
+        }
+    }
+    
     // Initialize system monitor with fallback
     systemMonitor_ = std::make_unique<SystemMonitor>();
     if (!systemMonitor_->initialize()) {
@@ -186,6 +290,24 @@ bool AgentCore::initializeComponents() {
         deviceManager_->enableFallbackMode();
     }
     
+    // USB policy: decisions made on plug-in are forwarded to clients as events
+    deviceManager_->setDefaultPolicy(configManager_->getString("devices.policy_default", "allow") != "deny");
+    deviceManager_->setPolicyEventCallback([this](const UsbPolicyEvent& policyEvent) {
+        std::map<std::string, std::string> data;
+        data["device_path"] = policyEvent.devicePath;
+        data["vid"] = policyEvent.device.vid;
+        data["pid"] = policyEvent.device.pid;
+        data["serial"] = policyEvent.device.serialNumber;
+        data["rule_id"] = policyEvent.decision.ruleId.empty() ? "default" : policyEvent.decision.ruleId;
+        data["applied"] = policyEvent.applied ? "1" : "0";
+        sendEventToClients(createEvent(Module::DEVICE,
+            policyEvent.decision.allow ? "USB_POLICY_AUTHORIZED" : "USB_POLICY_BLOCKED", data));
+    });
+    if (configManager_->getBool("devices.deauthorize_by_default", false) &&
+        !deviceManager_->setDeauthorizeByDefault(true)) {
+        logger_->warning("Failed to set USB authorized_default, devices are checked after plug-in");
+    }
+    
     // Initialize network manager with fallback
     networkManager_ = std::make_unique<NetworkManager>();
     if (!networkManager_->initialize()) {
@@ -195,18 +317,231 @@ bool AgentCore::initializeComponents() {
     
     // Initialize process manager with fallback
     processManager_ = std::make_unique<ProcessManager>();
+    processManager_->setExecutableHashing(configManager_->getBool("processes.hash_executables", true));
+    processManager_->setBatchedReads(configManager_->getBool("processes.io_uring", true));
     if (!processManager_->initialize()) {
         logger_->warning("Failed to initialize process manager, using fallback mode");
         processManager_->enableFallbackMode();
     }
     
+    // Initialize filesystem monitor with fallback
+    filesystemMonitor_ = std::make_unique<FilesystemMonitor>();
+    filesystemMonitor_->setUpdateInterval(std::chrono::milliseconds(
+        configManager_->getInt("filesystem.update_interval", 10000)));
+    if (!filesystemMonitor_->initialize()) {
+        logger_->warning("Failed to initialize filesystem monitor, using fallback mode");
+        filesystemMonitor_->enableFallbackMode();
+    }
+    
+    // Initialize network statistics monitor with fallback
+    netStatMonitor_ = std::make_unique<NetStatMonitor>();
+    netStatMonitor_->setUpdateInterval(std::chrono::milliseconds(
+        configManager_->getInt("network.stats_interval", 1000)));
+    if (!netStatMonitor_->initialize()) {
+        logger_->warning("Failed to initialize network statistics monitor, using fallback mode");
+        netStatMonitor_->enableFallbackMode();
+    }
+    
+    // Initialize taskstats monitor with fallback (needs CAP_NET_ADMIN)
+    taskStatsMonitor_ = std::make_unique<TaskStatsMonitor>();
+    taskStatsMonitor_->setUpdateInterval(std::chrono::milliseconds(
+        configManager_->getInt("processes.taskstats_interval", 2000)));
+    size_t candidateCount = static_cast<size_t>(std::max(1, configManager_->getInt("processes.taskstats_candidates", 32)));
+    taskStatsMonitor_->setCandidateProvider([this, candidateCount]() {
+        // Processes blocked in the kernel (D, mostly I/O) first, then
+        // runnable ones (R, possibly waiting for a CPU), then by CPU
+        std::vector<uint32_t> pids;
+        std::shared_lock<std::shared_mutex> lock(componentsMutex_);
+        if (!processManager_) {
+            return pids;
+        }
+        auto table = processManager_->getProcessTable();
+        if (!table) {
+            return pids;
+        }
+        auto stateRank = [&table](size_t row) {
+            char state = table->states[row];
+            return state == 'D' ? 0 : state == 'R' ? 1 : 2;
+        };
+        std::vector<size_t> rows(table->size());
+        std::iota(rows.begin(), rows.end(), 0);
+        size_t count = std::min(candidateCount, rows.size());
+        std::partial_sort(rows.begin(), rows.begin() + static_cast<std::ptrdiff_t>(count), rows.end(),
+                          [&table, &stateRank](size_t a, size_t b) {
+                              int rankA = stateRank(a);
+                              int rankB = stateRank(b);
+                              if (rankA != rankB) return rankA < rankB;
+                              return table->cpuUsage[a] > table->cpuUsage[b];
+                          });
+        for (size_t i = 0; i < count; ++i) {
+            pids.push_back(table->pids[rows[i]]);
+        }
+        return pids;
+    });
+    if (!taskStatsMonitor_->initialize()) {
+        logger_->warning("Failed to initialize taskstats monitor, using fallback mode");
+        taskStatsMonitor_->enableFallbackMode();
+    }
+    
+    // Initialize power monitor with fallback (no RAPL on VMs and most non-x86)
+    powerMonitor_ = std::make_unique<PowerMonitor>();
+    powerMonitor_->setUpdateInterval(std::chrono::milliseconds(
+        configManager_->getInt("power.update_interval", 5000)));
+    powerMonitor_->setSysfsRoot(configManager_->getString("power.sysfs_root", "/sys/class/powercap"));
+    if (!powerMonitor_->initialize()) {
+        logger_->warning("Failed to initialize power monitor, using fallback mode");
+        powerMonitor_->enableFallbackMode();
+    }
+    
+    // Initialize eBPF monitor with fallback (needs libbpf at build time, root
+    // or CAP_BPF + CAP_PERFMON and a BTF-enabled 5.8+ kernel at run time)
+    ebpfMonitor_ = std::make_unique<EbpfMonitor>();
+    ebpfMonitor_->setUpdateInterval(std::chrono::milliseconds(
+        configManager_->getInt("ebpf.update_interval", 5000)));
+    std::string ebpfObject = configManager_->getString("ebpf.object_path", "");
+    if (!ebpfObject.empty()) {
+        ebpfMonitor_->setObjectPath(ebpfObject);
+    }
+    if (configManager_->getBool("ebpf.publish_task_events", false)) {
+        ebpfMonitor_->setTaskEventCallback([this](const TaskTraceEvent& taskEvent) {
+            std::map<std::string, std::string> data;
+            data["pid"] = std::to_string(taskEvent.pid);
+            data["parent_pid"] = std::to_string(taskEvent.parentPid);
+            data["uid"] = std::to_string(taskEvent.uid);
+            data["name"] = taskEvent.name;
+            if (taskEvent.type == "exec") {
+                data["filename"] = taskEvent.filename;
+            } else {
+                data["exit_code"] = std::to_string(taskEvent.exitCode);
+                data["lifetime_ms"] = std::to_string(taskEvent.lifetimeMs);
+            }
+            sendEventToClients(createEvent(Module::PROCESS,
+                taskEvent.type == "exec" ? "PROCESS_EXEC" : "PROCESS_EXIT", data));
+        });
+    }
+    if (!configManager_->getBool("ebpf.enabled", true) || !ebpfMonitor_->initialize()) {
+        logger_->warning(EbpfMonitor::isSupported()
+            ? "Failed to initialize eBPF monitor, using fallback mode"
+            : "eBPF monitor not built (libbpf not found), using fallback mode");
+        ebpfMonitor_->enableFallbackMode();
+    }
+    
+    // Configure the watchdog: per-job deadlines override twice the interval
+    Watchdog::getInstance().setDeadlineProvider([this](const std::string& job) {
+        return std::chrono::milliseconds(configManager_->getInt("watchdog." + job + ".deadline", 0));
+    });
+    Watchdog::getInstance().setHealthCallback([this](const JobHealthInfo& health) {
+        sendEventToClients(createEvent(Module::SYSTEM, health.isStale ? "DATA_STALE" : "DATA_RECOVERED",
+            {{"job", health.name},
+             {"age_ms", std::to_string(health.ageMs)},
+             {"running_ms", std::to_string(health.runningMs)},
+             {"quarantined", health.isQuarantined ? "1" : "0"}}));
+    });
+    
+    // Initialize collector registry: built-ins first, then site plugins
+    collectorRegistry_ = std::make_unique<CollectorRegistry>();
+    collectorRegistry_->setHistorySize(static_cast<size_t>(configManager_->getInt("collectors.history_size", 120)));
+    collectorRegistry_->setConfigProvider([this](const std::string& name) {
+        return configManager_->getString("collectors." + name + ".config", "");
+    });
+    
+    // Optional on-disk copy of every sample, for exports beyond the in-memory window
+    std::string archiveDir = configManager_->getString("collectors.archive_dir", "");
+    if (!archiveDir.empty()) {
+        historyArchive_ = std::make_unique<HistoryArchive>();
+        historyArchive_->setRetentionDays(configManager_->getInt("collectors.archive_days", 31));
+        std::string archiveError;
+        if (!historyArchive_->initialize(archiveDir, archiveError)) {
+            logger_->warning("Failed to initialize history archive (" + archiveError +
+                             "), exports limited to in-memory history");
+            historyArchive_.reset();
+        }
+    }
+    
+    bool publishSamples = configManager_->getBool("collectors.publish_events", false);
+    if (publishSamples || historyArchive_) {
+        collectorRegistry_->setSampleCallback([this, publishSamples](const std::string& name,
+                                                                     const std::vector<MetricSample>& samples) {
+            if (historyArchive_) {
+                historyArchive_->append(samples);
+            }
+            if (publishSamples) {
+                sendEventToClients(createEvent(Module::SYSTEM, "COLLECTOR_SAMPLES",
+                    {{"collector", name}, {"samples", serializer_->serializeMetricSamples(samples)}}));
+            }
+        });
+    }
+    if (!collectorRegistry_->initialize()) {
+        logger_->warning("Failed to initialize collector registry, using fallback mode");
+        collectorRegistry_->enableFallbackMode();
+    } else {
+        for (const auto* collector : BuiltinCollectors::all()) {
+            collectorRegistry_->registerCollector(collector);
+        }
+        std::string pluginDir = configManager_->getString("collectors.plugin_dir", "");
+        if (!pluginDir.empty()) {
+            size_t loaded = collectorRegistry_->loadPlugins(pluginDir);
+            logger_->info("Loaded " + std::to_string(loaded) + " collector plugins from " + pluginDir);
+        }
+    }
+    
     // Initialize android manager (optional)
     androidManager_ = std::make_unique<AndroidManager>();
+    androidManager_->setParallelism(static_cast<size_t>(
+        std::max(1, configManager_->getInt("android.action_parallelism", 8))));
+    androidManager_->setInventoryCheckInterval(std::chrono::milliseconds(
+        configManager_->getInt("android.app_inventory_interval", 30000)));
     if (!androidManager_->initialize()) {
         logger_->warning("Failed to initialize android manager, Android features disabled");
         androidManager_.reset(); // Optional component, can be disabled
     }
     
+    // Device telemetry runs as the "android" collector, so it shares the
+    // history store, deadlines and GET_COLLECTOR_* commands
+    if (androidManager_ && !collectorRegistry_->isFallbackMode() &&
+        configManager_->getBool("android.telemetry.enabled", true)) {
+        std::string adbPath = androidManager_->getAdbExecutable();
+        collectorRegistry_->setConfigProvider([this, adbPath](const std::string& name) {
+            std::string config = configManager_->getString("collectors." + name + ".config", "");
+            return name == "android" && config.empty() ? adbPath : config;
+        });
+        if (!collectorRegistry_->registerCollector(AndroidTelemetry::collector())) {
+            logger_->warning("Failed to register Android telemetry collector");
+        }
+    }
+    
+    // Pushes, pulls and installs run in the background; handlers only queue them
+    if (androidManager_) {
+        adbTransferManager_ = std::make_unique<AdbTransferManager>();
+        adbTransferManager_->setParallelism(static_cast<size_t>(
+            std::max(1, configManager_->getInt("android.transfer_parallelism", 4))));
+        adbTransferManager_->setTransferDirectory(
+            configManager_->getString("android.transfer_dir", "/var/lib/sysmon/android"));
+        adbTransferManager_->setProgressCallback([this](const AndroidTransferInfo& transfer) {
+            std::map<std::string, std::string> data;
+            data["transfer_id"] = std::to_string(transfer.id);
+            data["batch_id"] = std::to_string(transfer.batchId);
+            data["serial"] = transfer.serial;
+            data["operation"] = transfer.operation;
+            data["state"] = transfer.state;
+            data["bytes_transferred"] = std::to_string(transfer.bytesTransferred);
+            data["total_bytes"] = std::to_string(transfer.totalBytes);
+            if (!transfer.error.empty()) {
+                data["error"] = transfer.error;
+            }
+            // A finished install changes the device's package set
+            if (transfer.operation == "install" && transfer.state == "done" && androidManager_) {
+                androidManager_->invalidateAppInventory(transfer.serial);
+            }
+            sendEventToClients(createEvent(Module::ANDROID, "ANDROID_TRANSFER_PROGRESS", data));
+        });
+        if (!adbTransferManager_->initialize()) {
+            logger_->warning("Failed to initialize ADB transfer manager (missing android.transfer_dir?), "
+                             "file transfers disabled");
+            adbTransferManager_->enableFallbackMode();
+        }
+    }
+    
     // Initialize automation engine (always works)
     automationEngine_ = std::make_unique<AutomationEngine>();
     if (!automationEngine_->initialize(this)) {
@@ -219,9 +554,29 @@ bool AgentCore::initializeComponents() {
         return handleCommand(cmd);
     });
     
+    // Subscriptions are per connection and end with it
+    ipcServer_->setSubscriptionHandler([this](const std::string& clientId, const Command& cmd) {
+        return handleSubscription(clientId, cmd);
+    });
+    ipcServer_->setDisconnectHandler([this](const std::string& clientId) {
+        if (logStreamer_) {
+            logStreamer_->unsubscribe(clientId);
+        }
+    });
+    
     // Set up logger
     ipcServer_->setLogger(logger_.get());
     
+    // HTTP clients go through the same command dispatch as IPC clients
+    if (httpServer_) {
+        httpServer_->setCommandHandler([this](const Command& cmd) {
+            return handleCommand(cmd);
+        });
+        httpServer_->setExportHandler([this](const std::map<std::string, std::string>& query, std::string& error) {
+            return createHistoryExport(query, error);
+        });
+    }
+    
     logger_->info("Components initialized with fallback support");
     return true;
 }
@@ -229,17 +584,60 @@ bool AgentCore::initializeComponents() {
 void AgentCore::cleanupComponents() {
     logger_->info("Cleaning up components...");
     
+    Watchdog::getInstance().setHealthCallback(nullptr);
+    Watchdog::getInstance().setDeadlineProvider(nullptr);
+    
     // Cleanup in reverse order
     if (automationEngine_) {
         automationEngine_->shutdown();
         automationEngine_.reset();
     }
     
+    if (adbTransferManager_) {
+        adbTransferManager_->shutdown();
+        adbTransferManager_.reset();
+    }
+    
     if (androidManager_) {
         androidManager_->shutdown();
         androidManager_.reset();
     }
     
+    if (collectorRegistry_) {
+        collectorRegistry_->shutdown();
+        collectorRegistry_.reset();
+    }
+    
+    if (historyArchive_) {
+        historyArchive_->shutdown();
+        historyArchive_.reset();
+    }
+    
+    if (ebpfMonitor_) {
+        ebpfMonitor_->shutdown();
+        ebpfMonitor_.reset();
+    }
+    
+    if (powerMonitor_) {
+        powerMonitor_->shutdown();
+        powerMonitor_.reset();
+    }
+    
+    if (taskStatsMonitor_) {
+        taskStatsMonitor_->shutdown();
+        taskStatsMonitor_.reset();
+    }
+    
+    if (netStatMonitor_) {
+        netStatMonitor_->shutdown();
+        netStatMonitor_.reset();
+    }
+    
+    if (filesystemMonitor_) {
+        filesystemMonitor_->shutdown();
+        filesystemMonitor_.reset();
+    }
+    
     if (processManager_) {
         processManager_->shutdown();
         processManager_.reset();
@@ -260,6 +658,16 @@ void AgentCore::cleanupComponents() {
         systemMonitor_.reset();
     }
     
+    if (logStreamer_) {
+        logStreamer_->shutdown();
+        logStreamer_.reset();
+    }
+    
+    if (httpServer_) {
+        httpServer_->shutdown();
+        httpServer_.reset();
+    }
+    
     if (ipcServer_) {
         ipcServer_->shutdown();
         ipcServer_.reset();
@@ -311,23 +719,34 @@ Response AgentCore::handleCommand(const Command& command) {
             return createResponse(command.id, CommandStatus::FAILED, "Invalid command format");
         }
         
+        Response response;
         switch (command.module) {
             case Module::SYSTEM:
-                return handleSystemCommand(command);
+                response = handleSystemCommand(command);
+                break;
             case Module::DEVICE:
-                return handleDeviceCommand(command);
+                response = handleDeviceCommand(command);
+                break;
             case Module::NETWORK:
-                return handleNetworkCommand(command);
+                response = handleNetworkCommand(command);
+                break;
             case Module::PROCESS:
-                return handleProcessCommand(command);
+                response = handleProcessCommand(command);
+                break;
             case Module::ANDROID:
-                return handleAndroidCommand(command);
+                response = handleAndroidCommand(command);
+                break;
             case Module::AUTOMATION:
-                return handleAutomationCommand(command);
+                response = handleAutomationCommand(command);
+                break;
             default:
                 logCommand(command, "unknown_module");
-                return handleGenericCommand(command);
+                response = handleGenericCommand(command);
+                break;
         }
+        
+        annotateFreshness(command, response);
+        return response;
     } catch (const std::exception& e) {
         logError("handleCommand", e);
         logCommand(command, "exception");
@@ -351,13 +770,13 @@ Response AgentCore::handleSystemCommand(const Command& command) {
                 // Check if in fallback mode and add special message
                 if (systemMonitor_->isFallbackMode()) {
                     logCommand(command, "system_monitor_fallback");
-                    std::string serializedData = serializer_->serializeSystemInfo(info);
+                    std::string serializedData = serializer_->serializeSystemInfo(info, getFieldMask(command));
                     Response response = createResponse(command.id, CommandStatus::SUCCESS, serializedData);
                     response.message = "System info in fallback mode - limited functionality";
                     return response;
                 }
                 
-                std::string serializedData = serializer_->serializeSystemInfo(info);
+                std::string serializedData = serializer_->serializeSystemInfo(info, getFieldMask(command));
                 logCommand(command, "success");
                 return createResponse(command.id, CommandStatus::SUCCESS, serializedData);
             }
@@ -373,19 +792,291 @@ Response AgentCore::handleSystemCommand(const Command& command) {
                 // Check if in fallback mode and add special message
                 if (processManager_->isFallbackMode()) {
                     logCommand(command, "process_manager_fallback");
-                    std::string serializedData = serializer_->serializeProcessList(processes);
-                    Response response = createResponse(command.id, CommandStatus::SUCCESS, serializedData);
-                    response.message = "Process list in fallback mode - limited functionality";
-                    return response;
+                    std::string serializedData = serializer_->serializeProcessList(processes, getFieldMask(command));
+                    return createResponse(command.id, CommandStatus::SUCCESS,
+                                        "Process list in fallback mode - limited functionality",
+                                        {{"data", serializedData}});
                 }
                 
-                std::string serializedData = serializer_->serializeProcessList(processes);
+                std::string serializedData = serializer_->serializeProcessList(processes, getFieldMask(command));
                 
                 logCommand(command, "success");
                 return createResponse(command.id, CommandStatus::SUCCESS, "Process list retrieved", 
                                     {{"data", serializedData}});
             }
             
+            case CommandType::GET_PROCESS_AGGREGATES: {
+                if (!processManager_) {
+                    logCommand(command, "process_manager_unavailable");
+                    return createResponse(command.id, CommandStatus::FAILED, "Process manager not available");
+                }
+                
+                auto groupIt = command.parameters.find("group_by");
+                std::string groupBy = groupIt != command.parameters.end() ? groupIt->second : "name";
+                ProcessTable::GroupKey groupKey;
+                if (!ProcessTable::parseGroupKey(groupBy, groupKey)) {
+                    return createResponse(command.id, CommandStatus::FAILED,
+                                        "Invalid group_by (expected name, user, cgroup or exe)");
+                }
+                
+                auto sortIt = command.parameters.find("sort");
+                std::string sortBy = sortIt != command.parameters.end() ? sortIt->second : "cpu";
+                if (sortBy != "cpu" && sortBy != "rss" && sortBy != "count") {
+                    return createResponse(command.id, CommandStatus::FAILED, "Invalid sort (expected cpu, rss or count)");
+                }
+                
+                size_t limit = 50; // limit=0 returns every group
+                if (!parseLimit(command, limit)) {
+                    return createResponse(command.id, CommandStatus::FAILED, "Invalid limit");
+                }
+                
+                auto table = processManager_->getProcessTable();
+                std::vector<ProcessAggregate> groups = table ? table->aggregate(groupKey) : std::vector<ProcessAggregate>();
+                size_t groupCount = groups.size();
+                size_t shown = limit > 0 ? std::min(limit, groups.size()) : groups.size();
+                std::partial_sort(groups.begin(), groups.begin() + static_cast<std::ptrdiff_t>(shown), groups.end(),
+                    [&sortBy](const ProcessAggregate& a, const ProcessAggregate& b) {
+                        if (sortBy == "rss") return a.rssTotal > b.rssTotal;
+                        if (sortBy == "count") return a.count > b.count;
+                        return a.cpuTotal > b.cpuTotal;
+                    });
+                groups.resize(shown);
+                
+                std::string serializedData = serializer_->serializeProcessAggregates(
+                    groups, ProcessTable::groupKeyToString(groupKey), table ? table->size() : 0, groupCount);
+                logCommand(command, "success");
+                return createResponse(command.id, CommandStatus::SUCCESS, "Process aggregates retrieved",
+                                    {{"data", serializedData}});
+            }
+            
+            case CommandType::GET_EXECUTABLE_IDENTITIES: {
+                if (!processManager_) {
+                    logCommand(command, "process_manager_unavailable");
+                    return createResponse(command.id, CommandStatus::FAILED, "Process manager not available");
+                }
+                
+                // Optional filters: id, exact sha256 or exact path
+                uint32_t idFilter = 0;
+                auto idIt = command.parameters.find("id");
+                if (idIt != command.parameters.end()) {
+                    try {
+                        idFilter = static_cast<uint32_t>(std::stoul(idIt->second));
+                    } catch (const std::exception& e) {
+                        return createResponse(command.id, CommandStatus::FAILED, "Invalid id");
+                    }
+                }
+                auto shaIt = command.parameters.find("sha256");
+                std::string shaFilter = shaIt != command.parameters.end() ? shaIt->second : "";
+                std::transform(shaFilter.begin(), shaFilter.end(), shaFilter.begin(),
+                               [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+                auto pathIt = command.parameters.find("path");
+                std::string pathFilter = pathIt != command.parameters.end() ? pathIt->second : "";
+                
+                std::vector<ExecutableIdentity> identities;
+                for (auto& identity : processManager_->getExecutableIdentities()) {
+                    if ((idFilter == 0 || identity.id == idFilter) &&
+                        (shaFilter.empty() || identity.sha256 == shaFilter) &&
+                        (pathFilter.empty() || identity.path == pathFilter)) {
+                        identities.push_back(std::move(identity));
+                    }
+                }
+                std::sort(identities.begin(), identities.end(),
+                          [](const ExecutableIdentity& a, const ExecutableIdentity& b) { return a.id < b.id; });
+                
+                // Attach the pids running each identity in the latest snapshot
+                auto table = processManager_->getProcessTable();
+                if (table && !identities.empty()) {
+                    for (size_t row = 0; row < table->size(); ++row) {
+                        uint32_t id = table->executableIds[row];
+                        auto match = std::lower_bound(identities.begin(), identities.end(), id,
+                            [](const ExecutableIdentity& identity, uint32_t value) { return identity.id < value; });
+                        if (id != 0 && match != identities.end() && match->id == id) {
+                            match->pids.push_back(table->pids[row]);
+                        }
+                    }
+                }
+                
+                std::string serializedData = serializer_->serializeExecutableIdentities(identities, getFieldMask(command));
+                logCommand(command, "success");
+                return createResponse(command.id, CommandStatus::SUCCESS, "Executable identities retrieved",
+                                    {{"data", serializedData}});
+            }
+
+            case CommandType::GET_TOP_CONSUMERS: {
+                if (!processManager_) {
+                    logCommand(command, "process_manager_unavailable");
+                    return createResponse(command.id, CommandStatus::FAILED, "Process manager not available");
+                }
+
+                auto windowIt = command.parameters.find("window");
+                uint64_t windowSeconds = 0;
+                if (!TopConsumerTracker::parseWindow(windowIt != command.parameters.end() ? windowIt->second : "24h",
+                                                     windowSeconds)) {
+                    return createResponse(command.id, CommandStatus::FAILED,
+                                        "Invalid window (expected seconds or 90m, 24h, 7d up to 7d)");
+                }
+
+                auto metricIt = command.parameters.find("metric");
+                std::string metricName = metricIt != command.parameters.end() ? metricIt->second : "cpu";
+                TopConsumerTracker::Metric metric;
+                if (!TopConsumerTracker::parseMetric(metricName, metric)) {
+                    return createResponse(command.id, CommandStatus::FAILED, "Invalid metric (expected cpu or memory)");
+                }
+
+                size_t limit = 20; // at most TopConsumerTracker::CAPACITY
+                if (!parseLimit(command, limit)) {
+                    return createResponse(command.id, CommandStatus::FAILED, "Invalid limit");
+                }
+
+                uint64_t coveredSeconds = 0;
+                auto consumers = processManager_->getTopConsumers(metric, windowSeconds, limit, coveredSeconds);
+                std::string serializedData = serializer_->serializeTopConsumers(
+                    consumers, metricName, windowSeconds, coveredSeconds, getFieldMask(command));
+                logCommand(command, "success");
+                return createResponse(command.id, CommandStatus::SUCCESS, "Top consumers retrieved",
+                                    {{"data", serializedData}});
+            }
+
+            case CommandType::GET_FILESYSTEM_INFO: {
+                if (!filesystemMonitor_) {
+                    logCommand(command, "filesystem_monitor_unavailable");
+                    return createResponse(command.id, CommandStatus::FAILED, "Filesystem monitor not available");
+                }
+                
+                auto filesystems = filesystemMonitor_->getFilesystems();
+                std::string serializedData = serializer_->serializeFilesystems(filesystems, getFieldMask(command));
+                
+                if (filesystemMonitor_->isFallbackMode()) {
+                    logCommand(command, "filesystem_monitor_fallback");
+                    Response response = createResponse(command.id, CommandStatus::SUCCESS, "Filesystem info retrieved",
+                                                       {{"data", serializedData}});
+                    response.message = "Filesystem info in fallback mode - limited functionality";
+                    return response;
+                }
+                
+                logCommand(command, "success");
+                return createResponse(command.id, CommandStatus::SUCCESS, "Filesystem info retrieved",
+                                    {{"data", serializedData}});
+            }
+            
+            case CommandType::GET_POWER_INFO: {
+                if (!powerMonitor_) {
+                    logCommand(command, "power_monitor_unavailable");
+                    return createResponse(command.id, CommandStatus::FAILED, "Power monitor not available");
+                }
+                
+                std::string serializedData = serializer_->serializePowerInfo(powerMonitor_->getDomains(),
+                                                                             powerMonitor_->getProcessPower(),
+                                                                             getFieldMask(command));
+                
+                if (powerMonitor_->isFallbackMode()) {
+                    logCommand(command, "power_monitor_fallback");
+                    Response response = createResponse(command.id, CommandStatus::SUCCESS, "Power info retrieved",
+                                                       {{"data", serializedData}});
+                    response.message = "Power info in fallback mode - RAPL counters unavailable";
+                    return response;
+                }
+                
+                logCommand(command, "success");
+                return createResponse(command.id, CommandStatus::SUCCESS, "Power info retrieved",
+                                    {{"data", serializedData}});
+            }
+            
+            case CommandType::GET_COLLECTORS: {
+                if (!collectorRegistry_) {
+                    logCommand(command, "collector_registry_unavailable");
+                    return createResponse(command.id, CommandStatus::FAILED, "Collector registry not available");
+                }
+                
+                std::string serializedData = serializer_->serializeCollectors(collectorRegistry_->getCollectors());
+                logCommand(command, "success");
+                return createResponse(command.id, CommandStatus::SUCCESS, "Collectors retrieved",
+                                    {{"data", serializedData}});
+            }
+            
+            case CommandType::GET_COLLECTOR_METRICS: {
+                if (!collectorRegistry_) {
+                    logCommand(command, "collector_registry_unavailable");
+                    return createResponse(command.id, CommandStatus::FAILED, "Collector registry not available");
+                }
+                
+                // Without a collector name every collector's latest samples are returned
+                auto it = command.parameters.find("collector");
+                std::string collectorName = it != command.parameters.end() ? it->second : "";
+                std::string serializedData = serializer_->serializeMetricSamples(
+                    collectorRegistry_->getSamples(collectorName), getFieldMask(command));
+                logCommand(command, "success");
+                return createResponse(command.id, CommandStatus::SUCCESS, "Collector metrics retrieved",
+                                    {{"data", serializedData}});
+            }
+            
+            case CommandType::GET_COLLECTOR_HISTORY: {
+                if (!collectorRegistry_) {
+                    logCommand(command, "collector_registry_unavailable");
+                    return createResponse(command.id, CommandStatus::FAILED, "Collector registry not available");
+                }
+                if (!validateParameters(command, {"collector", "metric"})) {
+                    return createResponse(command.id, CommandStatus::FAILED, "Missing collector or metric parameter");
+                }
+                
+                auto instanceIt = command.parameters.find("instance");
+                std::string instance = instanceIt != command.parameters.end() ? instanceIt->second : "";
+                std::string serializedData = serializer_->serializeMetricSamples(
+                    collectorRegistry_->getHistory(command.parameters.at("collector"), command.parameters.at("metric"),
+                                                   instance),
+                    getFieldMask(command));
+                logCommand(command, "success");
+                return createResponse(command.id, CommandStatus::SUCCESS, "Collector history retrieved",
+                                    {{"data", serializedData}});
+            }
+            
+            case CommandType::GET_JOB_HEALTH: {
+                std::string serializedData = serializer_->serializeJobHealth(Watchdog::getInstance().getJobHealth());
+                logCommand(command, "success");
+                return createResponse(command.id, CommandStatus::SUCCESS, "Job health retrieved",
+                                    {{"data", serializedData}});
+            }
+            
+            case CommandType::GET_RUNQUEUE_LATENCY: {
+                if (!ebpfMonitor_) {
+                    logCommand(command, "ebpf_monitor_unavailable");
+                    return createResponse(command.id, CommandStatus::FAILED, "eBPF monitor not available");
+                }
+                
+                std::string serializedData = serializer_->serializeRunQueueLatency(
+                    ebpfMonitor_->getTotalRunQueueLatency(), ebpfMonitor_->getRunQueueLatency(),
+                    static_cast<uint64_t>(ebpfMonitor_->getUpdateInterval().count()));
+                
+                if (ebpfMonitor_->isFallbackMode()) {
+                    logCommand(command, "ebpf_monitor_fallback");
+                    Response response = createResponse(command.id, CommandStatus::SUCCESS, "Run-queue latency retrieved",
+                                                       {{"data", serializedData}});
+                    response.message = "Run-queue latency in fallback mode - eBPF unavailable";
+                    return response;
+                }
+                
+                logCommand(command, "success");
+                return createResponse(command.id, CommandStatus::SUCCESS, "Run-queue latency retrieved",
+                                    {{"data", serializedData}});
+            }
+            
+            case CommandType::CANCEL_COMMAND: {
+                // IpcServer cancels queued commands itself; anything that
+                // reaches here (or comes over HTTP) has nothing to cancel
+                if (!validateParameters(command, {"command_id"})) {
+                    return createResponse(command.id, CommandStatus::FAILED, "Missing command_id parameter");
+                }
+                logCommand(command, "not_queued");
+                return createResponse(command.id, CommandStatus::SUCCESS, "Command is not queued",
+                                    {{"cancelled", "0"}});
+            }
+            
+            case CommandType::SUBSCRIBE:
+            case CommandType::UNSUBSCRIBE:
+                // IpcServer routes these to handleSubscription with the client id
+                logCommand(command, "no_connection");
+                return createResponse(command.id, CommandStatus::FAILED, "Subscriptions need an IPC connection");
+            
             default:
                 logCommand(command, "unknown_system_command");
                 return createResponse(command.id, CommandStatus::FAILED, "Unknown system command");
@@ -433,6 +1124,22 @@ Response AgentCore::handleDeviceCommand(const Command& command) {
             
             case CommandType::ENABLE_USB_DEVICE:
             case CommandType::DISABLE_USB_DEVICE: {
+                // Auto-connect toggle from the device tab: vid/pid plus prevent_auto
+                auto preventIt = command.parameters.find("prevent_auto");
+                if (preventIt != command.parameters.end()) {
+                    auto vidIt = command.parameters.find("vid");
+                    auto pidIt = command.parameters.find("pid");
+                    if (vidIt == command.parameters.end() || pidIt == command.parameters.end()) {
+                        return createResponse(command.id, CommandStatus::FAILED, "Missing vid or pid parameter");
+                    }
+                    
+                    bool prevent = preventIt->second == "true";
+                    return deviceManager_->preventAutoConnect(vidIt->second, pidIt->second, prevent) ?
+                        createResponse(command.id, CommandStatus::SUCCESS,
+                            prevent ? "Auto-connect prevented" : "Auto-connect allowed") :
+                        createResponse(command.id, CommandStatus::FAILED, "Invalid vid/pid");
+                }
+                
                 auto it = command.parameters.find("device_id");
                 if (it == command.parameters.end()) {
                     return createResponse(command.id, CommandStatus::FAILED, "Missing device_id parameter");
@@ -464,6 +1171,52 @@ Response AgentCore::handleDeviceCommand(const Command& command) {
                 }
             }
             
+            case CommandType::GET_USB_POLICY: {
+                std::string serializedData = serializer_->serializeUsbPolicyRules(deviceManager_->getPolicyRules());
+                return createResponse(command.id, CommandStatus::SUCCESS, "USB policy retrieved",
+                                    {{"data", serializedData},
+                                     {"default_action", deviceManager_->isDefaultPolicyAllow() ? "allow" : "deny"},
+                                     {"deauthorize_by_default", deviceManager_->isDeauthorizeByDefault() ? "1" : "0"}});
+            }
+            
+            case CommandType::ADD_USB_POLICY_RULE: {
+                auto actionIt = command.parameters.find("action");
+                if (actionIt == command.parameters.end() ||
+                    (actionIt->second != "allow" && actionIt->second != "deny")) {
+                    return createResponse(command.id, CommandStatus::FAILED, "Missing or invalid action parameter");
+                }
+                
+                auto parameter = [&command](const std::string& key) {
+                    auto it = command.parameters.find(key);
+                    return it != command.parameters.end() ? it->second : std::string();
+                };
+                
+                UsbPolicyRule rule;
+                rule.id = parameter("rule_id");
+                rule.allow = actionIt->second == "allow";
+                rule.vid = parameter("vid");
+                rule.pid = parameter("pid");
+                rule.deviceClass = parameter("class");
+                rule.serialNumber = parameter("serial");
+                rule.sanitize();
+                
+                return deviceManager_->addPolicyRule(rule) ?
+                    createResponse(command.id, CommandStatus::SUCCESS,
+                        "USB policy rule added with ID: " + rule.id, {{"rule_id", rule.id}}) :
+                    createResponse(command.id, CommandStatus::FAILED, "Invalid USB policy rule");
+            }
+            
+            case CommandType::REMOVE_USB_POLICY_RULE: {
+                auto it = command.parameters.find("rule_id");
+                if (it == command.parameters.end()) {
+                    return createResponse(command.id, CommandStatus::FAILED, "Missing rule_id parameter");
+                }
+                
+                return deviceManager_->removePolicyRule(it->second) ?
+                    createResponse(command.id, CommandStatus::SUCCESS, "USB policy rule removed") :
+                    createResponse(command.id, CommandStatus::FAILED, "USB policy rule not found");
+            }
+            
             default:
                 return createResponse(command.id, CommandStatus::FAILED, "Unknown device command");
         }
@@ -475,6 +1228,21 @@ Response AgentCore::handleDeviceCommand(const Command& command) {
 
 Response AgentCore::handleNetworkCommand(const Command& command) {
     try {
+        // Stack counters come from their own monitor, independent of interface control
+        if (command.type == CommandType::GET_NETWORK_STATS) {
+            if (!netStatMonitor_) {
+                return createResponse(command.id, CommandStatus::FAILED, "Network statistics monitor not available");
+            }
+            
+            std::string serializedData = serializer_->serializeNetworkStats(netStatMonitor_->getCounters(), getFieldMask(command));
+            Response response = createResponse(command.id, CommandStatus::SUCCESS, "Network statistics retrieved",
+                                               {{"data", serializedData}});
+            if (netStatMonitor_->isFallbackMode()) {
+                response.message = "Network statistics in fallback mode - limited functionality";
+            }
+            return response;
+        }
+        
         if (!networkManager_) {
             return createResponse(command.id, CommandStatus::FAILED, "Network manager not available");
         }
@@ -577,6 +1345,75 @@ Response AgentCore::handleNetworkCommand(const Command& command) {
 
 Response AgentCore::handleProcessCommand(const Command& command) {
     try {
+        // Delay accounting comes from the taskstats monitor, not the process manager
+        if (command.type == CommandType::GET_PROCESS_DELAYS) {
+            if (!taskStatsMonitor_) {
+                return createResponse(command.id, CommandStatus::FAILED, "Taskstats monitor not available");
+            }
+            
+            std::vector<TaskDelayInfo> tasks;
+            auto it = command.parameters.find("pids");
+            if (it != command.parameters.end() && !it->second.empty()) {
+                // Explicit pids are queried on demand (lifetime averages); each
+                // one costs netlink round trips, so the list is bounded like a batch
+                std::vector<uint32_t> pids;
+                std::stringstream stream(it->second);
+                std::string item;
+                while (std::getline(stream, item, ',')) {
+                    if (item.empty()) {
+                        continue;
+                    }
+                    uint64_t pid = 0;
+                    if (!parseNumber(item, UINT32_MAX, pid) || pid == 0) {
+                        return createResponse(command.id, CommandStatus::FAILED, "Invalid PID format");
+                    }
+                    if (std::find(pids.begin(), pids.end(), static_cast<uint32_t>(pid)) != pids.end()) {
+                        continue;
+                    }
+                    if (pids.size() >= TaskStatsMonitor::MAX_CANDIDATES) {
+                        return createResponse(command.id, CommandStatus::FAILED,
+                                            "Too many PIDs (at most " +
+                                            std::to_string(TaskStatsMonitor::MAX_CANDIDATES) + ")");
+                    }
+                    pids.push_back(static_cast<uint32_t>(pid));
+                }
+                tasks = taskStatsMonitor_->queryTasks(pids);
+            } else {
+                tasks = taskStatsMonitor_->getTaskDelays();
+            }
+            
+            std::string serializedData = serializer_->serializeTaskDelays(tasks, taskStatsMonitor_->getExitedTasks(),
+                                                                         getFieldMask(command));
+            Response response = createResponse(command.id, CommandStatus::SUCCESS, "Process delays retrieved",
+                                               {{"data", serializedData}});
+            if (taskStatsMonitor_->isFallbackMode()) {
+                response.message = "Process delays in fallback mode - taskstats unavailable";
+            }
+            return response;
+        }
+        
+        // Exec/exit tracing comes from the eBPF monitor
+        if (command.type == CommandType::GET_TASK_EVENTS) {
+            if (!ebpfMonitor_) {
+                return createResponse(command.id, CommandStatus::FAILED, "eBPF monitor not available");
+            }
+            
+            size_t limit = 100; // limit=0 returns every buffered event
+            if (!parseLimit(command, limit)) {
+                return createResponse(command.id, CommandStatus::FAILED, "Invalid limit");
+            }
+            
+            std::string serializedData = serializer_->serializeTaskEvents(ebpfMonitor_->getTaskEvents(limit),
+                                                                         ebpfMonitor_->getDroppedEvents(),
+                                                                         getFieldMask(command));
+            Response response = createResponse(command.id, CommandStatus::SUCCESS, "Task events retrieved",
+                                               {{"data", serializedData}});
+            if (ebpfMonitor_->isFallbackMode()) {
+                response.message = "Task events in fallback mode - eBPF unavailable";
+            }
+            return response;
+        }
+        
         if (!processManager_) {
             return createResponse(command.id, CommandStatus::FAILED, "Process manager not available");
         }
@@ -631,6 +1468,17 @@ Response AgentCore::handleAndroidCommand(const Command& command) {
             return createResponse(command.id, CommandStatus::FAILED, "Android manager not available - ADB not found");
         }
         
+        // A "devices" selector runs a control command on many devices at once
+        bool fleetAction = command.type == CommandType::ANDROID_SCREEN_ON ||
+                           command.type == CommandType::ANDROID_SCREEN_OFF ||
+                           command.type == CommandType::ANDROID_LOCK_DEVICE ||
+                           command.type == CommandType::ANDROID_LAUNCH_APP ||
+                           command.type == CommandType::ANDROID_STOP_APP;
+        if (fleetAction && command.parameters.count("devices")) {
+            return handleAndroidFleetCommand(command);
+        }
+        
+        std::string message;
         switch (command.type) {
             case CommandType::GET_ANDROID_DEVICES: {
                 auto devices = androidManager_->getConnectedDevices();
@@ -663,8 +1511,8 @@ Response AgentCore::handleAndroidCommand(const Command& command) {
                 bool turnOn = (command.type == CommandType::ANDROID_SCREEN_ON);
                 
                 bool success = turnOn ? 
-                    androidManager_->turnScreenOn(deviceSerial) : 
-                    androidManager_->turnScreenOff(deviceSerial);
+                    androidManager_->turnScreenOn(deviceSerial, message) : 
+                    androidManager_->turnScreenOff(deviceSerial, message);
                 
                 if (success) {
                     std::string action = turnOn ? "turned on" : "turned off";
@@ -672,7 +1520,7 @@ Response AgentCore::handleAndroidCommand(const Command& command) {
                         "Screen " + action + " successfully");
                 } else {
                     return createResponse(command.id, CommandStatus::FAILED, 
-                        "Failed to " + std::string(turnOn ? "turn on" : "turn off") + " screen");
+                        "Failed to " + std::string(turnOn ? "turn on" : "turn off") + " screen: " + message);
                 }
             }
             
@@ -682,11 +1530,11 @@ Response AgentCore::handleAndroidCommand(const Command& command) {
                     return createResponse(command.id, CommandStatus::FAILED, "Missing device_serial parameter");
                 }
                 
-                bool success = androidManager_->lockDevice(it->second);
+                bool success = androidManager_->lockDevice(it->second, message);
                 
                 return success ? 
                     createResponse(command.id, CommandStatus::SUCCESS, "Device locked successfully") :
-                    createResponse(command.id, CommandStatus::FAILED, "Failed to lock device");
+                    createResponse(command.id, CommandStatus::FAILED, "Failed to lock device: " + message);
             }
             
             case CommandType::ANDROID_GET_FOREGROUND_APP: {
@@ -712,11 +1560,14 @@ Response AgentCore::handleAndroidCommand(const Command& command) {
                     return createResponse(command.id, CommandStatus::FAILED, 
                         "Missing device_serial or package_name parameter");
                 }
+                if (!AndroidManager::isValidPackageName(appIt->second)) {
+                    return createResponse(command.id, CommandStatus::FAILED, "Invalid package_name parameter");
+                }
                 
                 bool launch = (command.type == CommandType::ANDROID_LAUNCH_APP);
                 bool success = launch ? 
-                    androidManager_->launchApp(deviceIt->second, appIt->second) :
-                    androidManager_->stopApp(deviceIt->second, appIt->second);
+                    androidManager_->launchApp(deviceIt->second, appIt->second, message) :
+                    androidManager_->stopApp(deviceIt->second, appIt->second, message);
                 
                 if (success) {
                     std::string action = launch ? "launched" : "stopped";
@@ -724,7 +1575,7 @@ Response AgentCore::handleAndroidCommand(const Command& command) {
                         "App " + action + " successfully");
                 } else {
                     return createResponse(command.id, CommandStatus::FAILED, 
-                        "Failed to " + std::string(launch ? "launch" : "stop") + " app");
+                        "Failed to " + std::string(launch ? "launch" : "stop") + " app: " + message);
                 }
             }
             
@@ -774,6 +1625,129 @@ Response AgentCore::handleAndroidCommand(const Command& command) {
                     "Logcat retrieved", data);
             }
             
+            case CommandType::ANDROID_PUSH_FILE:
+            case CommandType::ANDROID_PULL_FILE: {
+                if (!validateParameters(command, {"device_serial", "local_path", "remote_path"})) {
+                    return createResponse(command.id, CommandStatus::FAILED,
+                        "Missing device_serial, local_path or remote_path parameter");
+                }
+                if (!adbTransferManager_ || !adbTransferManager_->isRunning()) {
+                    return createResponse(command.id, CommandStatus::FAILED, "File transfers not available");
+                }
+                
+                const auto& parameters = command.parameters;
+                bool push = (command.type == CommandType::ANDROID_PUSH_FILE);
+                std::string error;
+                uint64_t transferId = push ?
+                    adbTransferManager_->pushFile(parameters.at("device_serial"), parameters.at("local_path"),
+                                                  parameters.at("remote_path"), error) :
+                    adbTransferManager_->pullFile(parameters.at("device_serial"), parameters.at("remote_path"),
+                                                  parameters.at("local_path"), error);
+                if (transferId == 0) {
+                    return createResponse(command.id, CommandStatus::FAILED, error);
+                }
+                
+                // Progress and completion arrive as ANDROID_TRANSFER_PROGRESS events
+                std::map<std::string, std::string> data;
+                data["transfer_id"] = std::to_string(transferId);
+                return createResponse(command.id, CommandStatus::SUCCESS,
+                    push ? "Push queued" : "Pull queued", data);
+            }
+            
+            case CommandType::ANDROID_INSTALL_APK: {
+                auto apkIt = command.parameters.find("apk_path");
+                if (apkIt == command.parameters.end()) {
+                    return createResponse(command.id, CommandStatus::FAILED, "Missing apk_path parameter");
+                }
+                if (!adbTransferManager_ || !adbTransferManager_->isRunning()) {
+                    return createResponse(command.id, CommandStatus::FAILED, "File transfers not available");
+                }
+                
+                // Comma-separated serials; empty or "all" means every connected device
+                std::vector<std::string> serials;
+                auto serialsIt = command.parameters.find("device_serials");
+                std::string list = serialsIt != command.parameters.end() ? serialsIt->second : "";
+                if (list.empty() || list == "all") {
+                    for (const auto& device : androidManager_->getConnectedDevices()) {
+                        serials.push_back(device.serialNumber);
+                    }
+                } else {
+                    std::stringstream stream(list);
+                    std::string serial;
+                    while (std::getline(stream, serial, ',')) {
+                        if (!serial.empty()) {
+                            serials.push_back(serial);
+                        }
+                    }
+                }
+                
+                std::string error;
+                uint64_t batchId = adbTransferManager_->installApk(serials, apkIt->second, error);
+                if (batchId == 0) {
+                    return createResponse(command.id, CommandStatus::FAILED, error);
+                }
+                
+                std::map<std::string, std::string> data;
+                data["batch_id"] = std::to_string(batchId);
+                data["device_count"] = std::to_string(serials.size());
+                return createResponse(command.id, CommandStatus::SUCCESS, "Install queued", data);
+            }
+            
+            case CommandType::ANDROID_GET_INSTALLED_APPS: {
+                auto it = command.parameters.find("device_serial");
+                if (it == command.parameters.end()) {
+                    return createResponse(command.id, CommandStatus::FAILED, "Missing device_serial parameter");
+                }
+                
+                auto parameter = [&command](const std::string& name, const std::string& fallback) {
+                    auto found = command.parameters.find(name);
+                    return found != command.parameters.end() ? found->second : fallback;
+                };
+                std::string scope = parameter("scope", "all");
+                if (scope != "all" && scope != "user" && scope != "system") {
+                    return createResponse(command.id, CommandStatus::FAILED, "scope must be all, user or system");
+                }
+                uint64_t offset = 0;
+                if (!parseNumber(parameter("offset", "0"), UINT32_MAX, offset)) {
+                    return createResponse(command.id, CommandStatus::FAILED, "Invalid offset");
+                }
+                size_t limit = 100; // at most 1000
+                if (!parseLimit(command, limit)) {
+                    return createResponse(command.id, CommandStatus::FAILED, "Invalid limit");
+                }
+                limit = std::min<size_t>(limit, 1000);
+                
+                // Served from the per-device cache; "refresh" forces a re-read
+                AndroidManager::AppPage page;
+                if (!androidManager_->queryInstalledApps(it->second, parameter("filter", ""), scope, offset, limit,
+                                                         parameter("refresh", "0") == "1", page)) {
+                    return createResponse(command.id, CommandStatus::FAILED, "Failed to list packages on " + it->second);
+                }
+                
+                std::string serializedData = serializer_->serializeAndroidApps(page.apps, page.total, page.matched,
+                                                                              offset, page.refreshedAt,
+                                                                              getFieldMask(command));
+                return createResponse(command.id, CommandStatus::SUCCESS, "Installed apps retrieved",
+                                      {{"data", serializedData}});
+            }
+            
+            case CommandType::ANDROID_GET_TRANSFERS: {
+                if (!adbTransferManager_) {
+                    return createResponse(command.id, CommandStatus::FAILED, "File transfers not available");
+                }
+                
+                // 0 lists every batch, so a malformed id must not fall back to it
+                uint64_t batchId = 0;
+                auto batchIt = command.parameters.find("batch_id");
+                if (batchIt != command.parameters.end() && !parseNumber(batchIt->second, UINT64_MAX, batchId)) {
+                    return createResponse(command.id, CommandStatus::FAILED, "Invalid batch_id");
+                }
+                std::string serializedData = serializer_->serializeAndroidTransfers(
+                    adbTransferManager_->getTransfers(batchId), getFieldMask(command));
+                return createResponse(command.id, CommandStatus::SUCCESS, "Transfers retrieved",
+                                      {{"data", serializedData}});
+            }
+            
             default:
                 return createResponse(command.id, CommandStatus::FAILED, "Unknown android command");
         }
@@ -783,6 +1757,75 @@ Response AgentCore::handleAndroidCommand(const Command& command) {
     }
 }
 
+Response AgentCore::handleAndroidFleetCommand(const Command& command) {
+    std::vector<std::string> serials = androidManager_->selectDevices(command.parameters.at("devices"));
+    if (serials.empty()) {
+        return createResponse(command.id, CommandStatus::FAILED, "No devices match the selector");
+    }
+    
+    std::string packageName;
+    if (command.type == CommandType::ANDROID_LAUNCH_APP || command.type == CommandType::ANDROID_STOP_APP) {
+        auto it = command.parameters.find("package_name");
+        if (it == command.parameters.end()) {
+            return createResponse(command.id, CommandStatus::FAILED, "Missing package_name parameter");
+        }
+        if (!AndroidManager::isValidPackageName(it->second)) {
+            return createResponse(command.id, CommandStatus::FAILED, "Invalid package_name parameter");
+        }
+        packageName = it->second;
+    }
+    
+    AndroidManager* manager = androidManager_.get();
+    AndroidManager::DeviceAction action;
+    std::string description;
+    switch (command.type) {
+        case CommandType::ANDROID_SCREEN_ON:
+            action = [manager](const std::string& serial, std::string& message) {
+                return manager->turnScreenOn(serial, message);
+            };
+            description = "Screen on";
+            break;
+        case CommandType::ANDROID_SCREEN_OFF:
+            action = [manager](const std::string& serial, std::string& message) {
+                return manager->turnScreenOff(serial, message);
+            };
+            description = "Screen off";
+            break;
+        case CommandType::ANDROID_LOCK_DEVICE:
+            action = [manager](const std::string& serial, std::string& message) {
+                return manager->lockDevice(serial, message);
+            };
+            description = "Lock";
+            break;
+        case CommandType::ANDROID_LAUNCH_APP:
+            action = [manager, packageName](const std::string& serial, std::string& message) {
+                return manager->launchApp(serial, packageName, message);
+            };
+            description = "Launch " + packageName;
+            break;
+        default:
+            action = [manager, packageName](const std::string& serial, std::string& message) {
+                return manager->stopApp(serial, packageName, message);
+            };
+            description = "Stop " + packageName;
+            break;
+    }
+    
+    // One response for the whole fleet; devices run concurrently, so the
+    // command takes about as long as the slowest device
+    auto started = std::chrono::steady_clock::now();
+    std::vector<AndroidActionResult> results = androidManager_->runOnDevices(serials, action);
+    uint64_t durationMs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - started).count());
+    
+    size_t succeeded = std::count_if(results.begin(), results.end(),
+                                     [](const AndroidActionResult& result) { return result.success; });
+    std::string message = description + " succeeded on " + std::to_string(succeeded) + " of " +
+                          std::to_string(results.size()) + " devices";
+    return createResponse(command.id, succeeded > 0 ? CommandStatus::SUCCESS : CommandStatus::FAILED, message,
+                          {{"data", serializer_->serializeAndroidActionResults(results, durationMs)}});
+}
+
 Response AgentCore::handleAutomationCommand(const Command& command) {
     try {
         if (!automationEngine_) {
@@ -885,6 +1928,90 @@ Response AgentCore::handleAutomationCommand(const Command& command) {
     }
 }
 
+std::vector<FilesystemInfo> AgentCore::getFilesystems() const {
+    std::shared_lock<std::shared_mutex> lock(componentsMutex_);
+    if (!filesystemMonitor_) {
+        return {};
+    }
+    return filesystemMonitor_->getFilesystems();
+}
+
+std::vector<NetworkStatCounter> AgentCore::getNetworkStats() const {
+    std::shared_lock<std::shared_mutex> lock(componentsMutex_);
+    if (!netStatMonitor_) {
+        return {};
+    }
+    return netStatMonitor_->getCounters();
+}
+
+std::vector<PowerDomainInfo> AgentCore::getPowerDomains() const {
+    std::shared_lock<std::shared_mutex> lock(componentsMutex_);
+    if (!powerMonitor_) {
+        return {};
+    }
+    return powerMonitor_->getDomains();
+}
+
+std::vector<MetricSample> AgentCore::getCollectorSamples(const std::string& collectorName) const {
+    std::shared_lock<std::shared_mutex> lock(componentsMutex_);
+    if (!collectorRegistry_) {
+        return {};
+    }
+    return collectorRegistry_->getSamples(collectorName);
+}
+
+std::unique_ptr<HistoryExport> AgentCore::createHistoryExport(const std::map<std::string, std::string>& query,
+                                                             std::string& error) {
+    HistoryExport::Request request;
+    if (!HistoryExport::parseRequest(query, request, error)) {
+        return nullptr;
+    }
+
+    std::shared_lock<std::shared_mutex> lock(componentsMutex_);
+    if (historyArchive_) {
+        std::shared_ptr<HistoryArchive::Reader> reader =
+            historyArchive_->openReader(request.selectors, request.fromMs, request.toMs);
+        return std::make_unique<HistoryExport>([reader](MetricSample& sample) {
+            return reader->next(sample);
+        }, request.format);
+    }
+
+    if (!collectorRegistry_) {
+        error = "Collector registry not available";
+        return nullptr;
+    }
+
+    // Without an archive only the in-memory history is left; it is bounded
+    // by collectors.history_size, so it is merged by time up front
+    auto samples = std::make_shared<std::vector<MetricSample>>();
+    for (const auto& latest : collectorRegistry_->getSamples()) {
+        bool selected = std::any_of(request.selectors.begin(), request.selectors.end(),
+            [&latest](const SeriesSelector& selector) {
+                return selector.matches(latest.collector, latest.metric, latest.instance);
+            });
+        if (!selected) {
+            continue;
+        }
+        for (const auto& sample : collectorRegistry_->getHistory(latest.collector, latest.metric, latest.instance)) {
+            if (sample.timestampMs >= request.fromMs && sample.timestampMs <= request.toMs) {
+                samples->push_back(sample);
+            }
+        }
+    }
+    std::stable_sort(samples->begin(), samples->end(), [](const MetricSample& a, const MetricSample& b) {
+        return a.timestampMs < b.timestampMs;
+    });
+
+    auto position = std::make_shared<size_t>(0);
+    return std::make_unique<HistoryExport>([samples, position](MetricSample& sample) {
+        if (*position >= samples->size()) {
+            return false;
+        }
+        sample = (*samples)[(*position)++];
+        return true;
+    }, request.format);
+}
+
 Response AgentCore::handleGenericCommand(const Command& command) {
     switch (command.type) {
         case CommandType::PING:
@@ -898,6 +2025,58 @@ Response AgentCore::handleGenericCommand(const Command& command) {
     }
 }
 
+Response AgentCore::handleSubscription(const std::string& clientId, const Command& command) {
+    // Same checks and audit trail as handleCommand
+    logCommand(command, "started");
+    if (!securityManager_->validateCommand(IpcProtocol::serializeCommand(command))) {
+        logCommand(command, "invalid_command");
+        return createResponse(command.id, CommandStatus::FAILED, "Invalid command format");
+    }
+    
+    auto topicIt = command.parameters.find("topic");
+    if (topicIt == command.parameters.end() || topicIt->second != "logs") {
+        logCommand(command, "invalid_topic");
+        return createResponse(command.id, CommandStatus::FAILED, "Invalid topic (expected logs)");
+    }
+    if (!logStreamer_ || !logStreamer_->isRunning()) {
+        logCommand(command, "log_streamer_unavailable");
+        return createResponse(command.id, CommandStatus::FAILED, "Log streamer not available");
+    }
+    
+    if (command.type == CommandType::UNSUBSCRIBE) {
+        bool removed = logStreamer_->unsubscribe(clientId);
+        logCommand(command, "success");
+        return createResponse(command.id, CommandStatus::SUCCESS,
+                            removed ? "Unsubscribed from logs" : "Not subscribed to logs",
+                            {{"unsubscribed", removed ? "1" : "0"}});
+    }
+    
+    size_t backlog = 0;
+    auto backlogIt = command.parameters.find("backlog");
+    if (backlogIt != command.parameters.end()) {
+        try {
+            backlog = static_cast<size_t>(std::stoul(backlogIt->second));
+        } catch (const std::exception& e) {
+            logCommand(command, "invalid_parameters");
+            return createResponse(command.id, CommandStatus::FAILED, "Invalid backlog");
+        }
+    }
+    
+    auto levelIt = command.parameters.find("min_level");
+    auto categoriesIt = command.parameters.find("categories");
+    std::string error;
+    if (!logStreamer_->subscribe(clientId,
+                                 levelIt != command.parameters.end() ? levelIt->second : "",
+                                 categoriesIt != command.parameters.end() ? categoriesIt->second : "",
+                                 backlog, error)) {
+        logCommand(command, "subscribe_failed");
+        return createResponse(command.id, CommandStatus::FAILED, error);
+    }
+    
+    logCommand(command, "success");
+    return createResponse(command.id, CommandStatus::SUCCESS, "Subscribed to logs");
+}
+
 void AgentCore::handleEvent(const Event& event) {
     logger_->info("Handling event: " + event.type + " from module: " + std::to_string(static_cast<int>(event.module)));
     
@@ -906,11 +2085,89 @@ void AgentCore::handleEvent(const Event& event) {
 }
 
 void AgentCore::sendEventToClients(const Event& event) {
+    // Serialize once for both IPC and HTTP subscribers
+    std::string eventData = IpcProtocol::serializeEvent(event);
+    
     if (ipcServer_) {
-        ipcServer_->broadcastEvent(event);
+        ipcServer_->broadcastSerializedEvent(eventData);
+    }
+    if (httpServer_) {
+        httpServer_->publishEvent(event, eventData);
     }
 }
 
+Serialization::FieldMask AgentCore::getFieldMask(const Command& command) const {
+    // Optional comma-separated projection, e.g. "pid,name,cpu_usage"
+    auto it = command.parameters.find("fields");
+    return it != command.parameters.end() ? Serialization::FieldMask(it->second) : Serialization::FieldMask();
+}
+
+void AgentCore::annotateFreshness(const Command& command, Response& response) const {
+    if (response.status != CommandStatus::SUCCESS) {
+        return;
+    }
+    
+    std::string job = jobForCommand(command);
+    JobHealthInfo health;
+    if (job.empty() || !Watchdog::getInstance().getJobHealth(job, health)) {
+        return;
+    }
+    
+    // Clients keep rendering the last good data but can flag it
+    response.data["stale"] = health.isStale ? "1" : "0";
+    response.data["data_age_ms"] = std::to_string(health.ageMs);
+    if (health.isStale) {
+        response.message += " (stale: " + job + " last refreshed " + std::to_string(health.ageMs) + " ms ago)";
+    }
+}
+
+std::string AgentCore::jobForCommand(const Command& command) {
+    switch (command.type) {
+        case CommandType::GET_SYSTEM_INFO: return "system";
+        case CommandType::GET_PROCESS_LIST: return "process";
+        case CommandType::GET_PROCESS_AGGREGATES: return "process";
+        case CommandType::GET_EXECUTABLE_IDENTITIES: return "process";
+        case CommandType::GET_TOP_CONSUMERS: return "process";
+        case CommandType::GET_FILESYSTEM_INFO: return "filesystem";
+        case CommandType::GET_NETWORK_INTERFACES: return "network";
+        case CommandType::GET_NETWORK_STATS: return "netstat";
+        case CommandType::GET_PROCESS_DELAYS: return "taskstats";
+        case CommandType::GET_POWER_INFO: return "power";
+        case CommandType::GET_RUNQUEUE_LATENCY: return "ebpf";
+        case CommandType::GET_TASK_EVENTS: return "ebpf";
+        case CommandType::GET_ANDROID_DEVICES: return "android";
+        case CommandType::GET_COLLECTOR_METRICS: {
+            auto it = command.parameters.find("collector");
+            return it != command.parameters.end() ? "collector." + it->second : "";
+        }
+        default: return "";
+    }
+}
+
+bool AgentCore::parseNumber(const std::string& value, uint64_t maximum, uint64_t& number) {
+    // Plain digits only: std::stoul would take "-1" (wrapping it) and "12abc"
+    if (value.empty() || value.size() > 19 ||
+        !std::all_of(value.begin(), value.end(), [](char c) { return c >= '0' && c <= '9'; })) {
+        return false;
+    }
+    number = std::stoull(value);
+    return number <= maximum;
+}
+
+bool AgentCore::parseLimit(const Command& command, size_t& limit) {
+    // Leaves limit at its default when absent
+    auto it = command.parameters.find("limit");
+    if (it == command.parameters.end()) {
+        return true;
+    }
+    uint64_t value = 0;
+    if (!parseNumber(it->second, UINT32_MAX, value)) {
+        return false;
+    }
+    limit = static_cast<size_t>(value);
+    return true;
+}
+
 bool AgentCore::validateParameters(const Command& command, const std::vector<std::string>& requiredParams) {
     for (const auto& param : requiredParams) {
         if (command.parameters.find(param) == command.parameters.end()) {
@@ -17,12 +17,23 @@ namespace SysMon {
 
 // Forward declarations
 class IpcServer;
+class HttpServer;
 class SystemMonitor;
 class DeviceManager;
 class NetworkManager;
 class ProcessManager;
 class AndroidManager;
+class AdbTransferManager;
+class FilesystemMonitor;
+class NetStatMonitor;
+class TaskStatsMonitor;
+class PowerMonitor;
+class EbpfMonitor;
+class CollectorRegistry;
+class HistoryArchive;
+class HistoryExport;
 class AutomationEngine;
+class LogStreamer;
 class Logger;
 class ConfigManager;
 
@@ -53,6 +64,10 @@ public:
     std::vector<NetworkInterface> getNetworkInterfaces() const;
     std::vector<AndroidDeviceInfo> getAndroidDevices() const;
     std::vector<AutomationRule> getAutomationRules() const;
+    std::vector<FilesystemInfo> getFilesystems() const;
+    std::vector<NetworkStatCounter> getNetworkStats() const;
+    std::vector<PowerDomainInfo> getPowerDomains() const;
+    std::vector<MetricSample> getCollectorSamples(const std::string& collectorName = "") const;
     
     // Component control interface
     bool terminateProcess(uint32_t pid);
@@ -79,12 +94,22 @@ private:
     
     // Component management
     std::unique_ptr<IpcServer> ipcServer_;
+    std::unique_ptr<HttpServer> httpServer_;
     std::unique_ptr<SystemMonitor> systemMonitor_;
     std::unique_ptr<DeviceManager> deviceManager_;
     std::unique_ptr<NetworkManager> networkManager_;
     std::unique_ptr<ProcessManager> processManager_;
     std::unique_ptr<AndroidManager> androidManager_;
+    std::unique_ptr<AdbTransferManager> adbTransferManager_;
+    std::unique_ptr<FilesystemMonitor> filesystemMonitor_;
+    std::unique_ptr<NetStatMonitor> netStatMonitor_;
+    std::unique_ptr<TaskStatsMonitor> taskStatsMonitor_;
+    std::unique_ptr<PowerMonitor> powerMonitor_;
+    std::unique_ptr<EbpfMonitor> ebpfMonitor_;
+    std::unique_ptr<CollectorRegistry> collectorRegistry_;
+    std::unique_ptr<HistoryArchive> historyArchive_;
     std::unique_ptr<AutomationEngine> automationEngine_;
+    std::unique_ptr<LogStreamer> logStreamer_;
     std::unique_ptr<Logger> logger_;
     std::unique_ptr<ConfigManager> configManager_;
     
@@ -111,10 +136,21 @@ private:
     Response handleNetworkCommand(const Command& command);
     Response handleProcessCommand(const Command& command);
     Response handleAndroidCommand(const Command& command);
+    Response handleAndroidFleetCommand(const Command& command);
     Response handleAutomationCommand(const Command& command);
     Response handleGenericCommand(const Command& command);
+    Response handleSubscription(const std::string& clientId, const Command& command);
+    
+    // History export for the HTTP /export route
+    std::unique_ptr<HistoryExport> createHistoryExport(const std::map<std::string, std::string>& query,
+                                                       std::string& error);
     
     // Helper methods - removed serialize methods (now using Serializer)
+    Serialization::FieldMask getFieldMask(const Command& command) const;
+    void annotateFreshness(const Command& command, Response& response) const;
+    static std::string jobForCommand(const Command& command);
+    static bool parseNumber(const std::string& value, uint64_t maximum, uint64_t& number);
+    static bool parseLimit(const Command& command, size_t& limit);
     bool validateParameters(const Command& command, const std::vector<std::string>& requiredParams);
     void logCommand(const Command& command, const std::string& status);
     void logError(const std::string& function, const std::exception& e);
@@ -1,4 +1,6 @@
 #include "androidmanager.h"
+#include "processrunner.h"
+#include "watchdog.h"
 #include <thread>
 #include <chrono>
 #include <fstream>
@@ -6,6 +8,7 @@
 #include <iostream>
 #include <algorithm>
 #include <cstring>
+#include <cctype>
 #include <regex>
 #include <mutex>
 
@@ -24,11 +27,17 @@
 
 namespace SysMon {
 
+constexpr size_t AndroidManager::DEFAULT_PARALLELISM;
+constexpr size_t AndroidManager::MAX_PARALLELISM;
+constexpr std::chrono::milliseconds AndroidManager::INVENTORY_CHECK_INTERVAL;
+
 AndroidManager::AndroidManager() 
     : running_(false)
     , initialized_(false)
     , adbServerRunning_(false)
-    , scanInterval_(2000) {
+    , scanInterval_(2000)
+    , parallelism_(DEFAULT_PARALLELISM)
+    , inventoryCheckInterval_(INVENTORY_CHECK_INTERVAL) {
 }
 
 AndroidManager::~AndroidManager() {
@@ -76,6 +85,8 @@ bool AndroidManager::start() {
         return false;
     }
     
+    Watchdog::getInstance().registerJob("android", scanInterval_);
+    
     running_ = true;
     monitoringThread_ = std::thread(&AndroidManager::deviceMonitoringThread, this);
     
@@ -92,6 +103,8 @@ void AndroidManager::stop() {
     if (monitoringThread_.joinable()) {
         monitoringThread_.join();
     }
+
+    Watchdog::getInstance().unregisterJob("android");
     
     // Stop ADB server
     stopAdbServer();
@@ -106,6 +119,10 @@ bool AndroidManager::isRunning() const {
     return running_;
 }
 
+std::string AndroidManager::getAdbExecutable() const {
+    return adbPath_;
+}
+
 std::vector<AndroidDeviceInfo> AndroidManager::getConnectedDevices() {
     std::shared_lock<std::shared_mutex> lock(devicesMutex_);
     return connectedDevices_;
@@ -131,22 +148,19 @@ AndroidDeviceInfo AndroidManager::getDeviceInfo(const std::string& serialNumber)
     return AndroidDeviceInfo{};
 }
 
-bool AndroidManager::turnScreenOn(const std::string& serialNumber) {
-    std::string command = "shell input keyevent KEYCODE_POWER";
-    std::string result = executeAdbCommand(command, serialNumber);
-    return !result.empty();
+// WAKEUP and SLEEP (API 20+) are idempotent, unlike POWER which toggles, so
+// a fleet-wide "screen off" does not wake devices that were already off
+bool AndroidManager::turnScreenOn(const std::string& serialNumber, std::string& message) {
+    return runAdbAction("shell input keyevent KEYCODE_WAKEUP", serialNumber, message);
 }
 
-bool AndroidManager::turnScreenOff(const std::string& serialNumber) {
-    std::string command = "shell input keyevent KEYCODE_POWER";
-    std::string result = executeAdbCommand(command, serialNumber);
-    return !result.empty();
+bool AndroidManager::turnScreenOff(const std::string& serialNumber, std::string& message) {
+    return runAdbAction("shell input keyevent KEYCODE_SLEEP", serialNumber, message);
 }
 
-bool AndroidManager::lockDevice(const std::string& serialNumber) {
-    std::string command = "shell input keyevent KEYCODE_POWER";
-    std::string result = executeAdbCommand(command, serialNumber);
-    return !result.empty();
+bool AndroidManager::lockDevice(const std::string& serialNumber, std::string& message) {
+    // Sleeping engages the keyguard
+    return runAdbAction("shell input keyevent KEYCODE_SLEEP", serialNumber, message);
 }
 
 std::string AndroidManager::getForegroundApp(const std::string& serialNumber) {
@@ -185,40 +199,236 @@ std::string AndroidManager::getForegroundApp(const std::string& serialNumber) {
 }
 
 std::vector<std::string> AndroidManager::getInstalledApps(const std::string& serialNumber) {
-    std::string command = "shell pm list packages";
-    std::string result = executeAdbCommand(command, serialNumber);
-    
     std::vector<std::string> apps;
-    std::istringstream iss(result);
-    std::string line;
+    auto inventory = getAppInventory(serialNumber, false);
+    if (inventory) {
+        apps.reserve(inventory->apps.size());
+        for (const auto& app : inventory->apps) {
+            apps.push_back(app.packageName);
+        }
+    }
+    return apps;
+}
+
+bool AndroidManager::queryInstalledApps(const std::string& serialNumber, const std::string& filter,
+                                        const std::string& scope, size_t offset, size_t limit, bool refresh,
+                                        AppPage& page) {
+    auto inventory = getAppInventory(serialNumber, refresh);
+    if (!inventory) {
+        return false;
+    }
     
-    while (std::getline(iss, line)) {
-        // Remove 'package:' prefix
-        if (line.find("package:") == 0) {
-            std::string packageName = line.substr(8);
-            // Remove whitespace
-            packageName.erase(0, packageName.find_first_not_of(" \t\n\r"));
-            packageName.erase(packageName.find_last_not_of(" \t\n\r") + 1);
-            
-            if (!packageName.empty()) {
-                apps.push_back(packageName);
+    std::string needle = filter;
+    std::transform(needle.begin(), needle.end(), needle.begin(), ::tolower);
+    
+    page.apps.clear();
+    page.total = inventory->apps.size();
+    page.matched = 0;
+    page.refreshedAt = inventory->refreshedAt;
+    std::string name;
+    for (const auto& app : inventory->apps) {
+        if ((scope == "user" && app.isSystem) || (scope == "system" && !app.isSystem)) {
+            continue;
+        }
+        if (!needle.empty()) {
+            name = app.packageName;
+            std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+            if (name.find(needle) == std::string::npos) {
+                continue;
+            }
+        }
+        if (page.matched >= offset && page.apps.size() < limit) {
+            page.apps.push_back(app);
+        }
+        page.matched++;
+    }
+    return true;
+}
+
+void AndroidManager::invalidateAppInventory(const std::string& serialNumber) {
+    std::unique_lock<std::shared_mutex> lock(inventoryMutex_);
+    appInventories_.erase(serialNumber);
+}
+
+void AndroidManager::setInventoryCheckInterval(std::chrono::milliseconds interval) {
+    inventoryCheckInterval_ = interval;
+}
+
+std::shared_ptr<const AndroidManager::AppInventory> AndroidManager::getAppInventory(const std::string& serialNumber,
+                                                                                    bool refresh) {
+    if (!refresh) {
+        std::shared_lock<std::shared_mutex> lock(inventoryMutex_);
+        auto it = appInventories_.find(serialNumber);
+        if (it != appInventories_.end()) {
+            return it->second;
+        }
+    }
+    return fetchAppInventory(serialNumber, "");
+}
+
+std::shared_ptr<const AndroidManager::AppInventory> AndroidManager::fetchAppInventory(const std::string& serialNumber,
+                                                                                      std::string hash) {
+    // Hash first: if the set changes while listing, the next check sees a
+    // different hash and lists again
+    if (hash.empty()) {
+        hash = fetchPackageListHash(serialNumber);
+    }
+    
+    std::string output = executeAdbCommand("shell pm list packages -f -U", serialNumber);
+    if (output.find("package:") == std::string::npos) {
+        // -U needs Android 8
+        output = executeAdbCommand("shell pm list packages -f", serialNumber);
+    }
+    if (output.find("package:") == std::string::npos) {
+        return nullptr;
+    }
+    
+    auto inventory = std::make_shared<AppInventory>();
+    inventory->apps = parsePackageList(output);
+    inventory->hash = hash;
+    inventory->refreshedAt = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+    
+    std::unique_lock<std::shared_mutex> lock(inventoryMutex_);
+    appInventories_[serialNumber] = inventory;
+    return inventory;
+}
+
+std::string AndroidManager::fetchPackageListHash(const std::string& serialNumber) {
+    // md5sum runs on the device (toybox, Android 6+), so a check moves 35
+    // bytes instead of the whole list
+    std::string output = executeAdbCommand(
+        "shell (pm list packages -U 2>/dev/null || pm list packages) | md5sum", serialNumber);
+    std::string hash = output.substr(0, std::min(output.size(), output.find_first_of(" \t\r\n")));
+    if (hash.size() == 32 && hash.find_first_not_of("0123456789abcdef") == std::string::npos) {
+        return hash;
+    }
+    
+    // No md5sum on the device; hash the list here
+    output = executeAdbCommand("shell pm list packages -U", serialNumber);
+    if (output.find("package:") == std::string::npos) {
+        output = executeAdbCommand("shell pm list packages", serialNumber);
+    }
+    return output.empty() ? std::string() : "local:" + std::to_string(std::hash<std::string>()(output));
+}
+
+void AndroidManager::checkAppInventories() {
+    std::vector<std::string> serials;
+    {
+        // Only devices someone asked about are tracked; forget disconnected ones
+        std::vector<AndroidDeviceInfo> devices = getConnectedDevices();
+        std::unique_lock<std::shared_mutex> lock(inventoryMutex_);
+        for (auto it = appInventories_.begin(); it != appInventories_.end();) {
+            bool connected = std::any_of(devices.begin(), devices.end(), [&it](const AndroidDeviceInfo& device) {
+                return device.serialNumber == it->first;
+            });
+            if (connected) {
+                serials.push_back(it->first);
+                ++it;
+            } else {
+                it = appInventories_.erase(it);
             }
         }
     }
     
+    runOnDevices(serials, [this](const std::string& serialNumber, std::string& message) {
+        std::string hash = fetchPackageListHash(serialNumber);
+        if (hash.empty()) {
+            message = "Package list unavailable";
+            return false;
+        }
+        
+        {
+            std::shared_lock<std::shared_mutex> lock(inventoryMutex_);
+            auto it = appInventories_.find(serialNumber);
+            if (it == appInventories_.end() || it->second->hash == hash) {
+                return true;
+            }
+        }
+        return fetchAppInventory(serialNumber, hash) != nullptr;
+    });
+}
+
+std::vector<AndroidAppInfo> AndroidManager::parsePackageList(const std::string& output) {
+    // "package:<apk path>=<name> uid:<uid>"; the path may itself contain '='
+    std::vector<AndroidAppInfo> apps;
+    std::istringstream stream(output);
+    std::string line;
+    while (std::getline(stream, line)) {
+        if (line.compare(0, 8, "package:") != 0) {
+            continue;
+        }
+        line.erase(line.find_last_not_of(" \t\r") + 1);
+        
+        AndroidAppInfo app;
+        size_t uidPos = line.find(" uid:");
+        if (uidPos != std::string::npos) {
+            app.uid = static_cast<uint32_t>(std::strtoul(line.c_str() + uidPos + 5, nullptr, 10));
+            line.erase(uidPos);
+        }
+        
+        size_t equals = line.rfind('=');
+        if (equals == std::string::npos) {
+            app.packageName = line.substr(8);
+        } else {
+            app.apkPath = line.substr(8, equals - 8);
+            app.packageName = line.substr(equals + 1);
+        }
+        app.isSystem = !app.apkPath.empty() && app.apkPath.compare(0, 6, "/data/") != 0;
+        app.sanitize();
+        if (app.isValid()) {
+            apps.push_back(std::move(app));
+        }
+    }
+    
+    std::sort(apps.begin(), apps.end(), [](const AndroidAppInfo& a, const AndroidAppInfo& b) {
+        return a.packageName < b.packageName;
+    });
     return apps;
 }
 
-bool AndroidManager::launchApp(const std::string& serialNumber, const std::string& packageName) {
+bool AndroidManager::isValidPackageName(const std::string& packageName) {
+    if (packageName.empty() || !std::isalpha(static_cast<unsigned char>(packageName[0]))) {
+        return false;
+    }
+    
+    size_t segments = 1;
+    bool segmentEmpty = false;
+    for (size_t i = 1; i < packageName.size(); ++i) {
+        char c = packageName[i];
+        if (c == '.') {
+            if (segmentEmpty) {
+                return false;
+            }
+            ++segments;
+            segmentEmpty = true;
+        } else if (std::isalnum(static_cast<unsigned char>(c)) || c == '_') {
+            segmentEmpty = false;
+        } else {
+            return false;
+        }
+    }
+    return segments >= 2 && !segmentEmpty;
+}
+
+bool AndroidManager::launchApp(const std::string& serialNumber, const std::string& packageName,
+                               std::string& message) {
+    if (!isValidPackageName(packageName)) {
+        message = "Invalid package name";
+        return false;
+    }
     std::string command = "shell monkey -p " + packageName + " -c android.intent.category.LAUNCHER 1";
-    std::string result = executeAdbCommand(command, serialNumber);
-    return !result.empty();
+    return runAdbAction(command, serialNumber, message);
 }
 
-bool AndroidManager::stopApp(const std::string& serialNumber, const std::string& packageName) {
+bool AndroidManager::stopApp(const std::string& serialNumber, const std::string& packageName,
+                             std::string& message) {
+    if (!isValidPackageName(packageName)) {
+        message = "Invalid package name";
+        return false;
+    }
     std::string command = "shell am force-stop " + packageName;
-    std::string result = executeAdbCommand(command, serialNumber);
-    return !result.empty();
+    return runAdbAction(command, serialNumber, message);
 }
 
 std::string AndroidManager::takeScreenshot(const std::string& serialNumber) {
@@ -301,12 +511,113 @@ std::vector<std::string> AndroidManager::getLogcat(const std::string& serialNumb
     return logcat;
 }
 
+std::vector<std::string> AndroidManager::selectDevices(const std::string& selector) {
+    std::vector<AndroidDeviceInfo> devices = getConnectedDevices();
+    std::vector<std::string> serials;
+    
+    if (selector.empty() || selector == "all") {
+        for (const auto& device : devices) {
+            serials.push_back(device.serialNumber);
+        }
+        return serials;
+    }
+    
+    size_t equals = selector.find('=');
+    if (equals == std::string::npos) {
+        // Explicit list; serials that are not connected fail individually
+        std::stringstream stream(selector);
+        std::string serial;
+        while (std::getline(stream, serial, ',')) {
+            serial.erase(0, serial.find_first_not_of(" \t"));
+            serial.erase(serial.find_last_not_of(" \t") + 1);
+            if (!serial.empty() && std::find(serials.begin(), serials.end(), serial) == serials.end()) {
+                serials.push_back(serial);
+            }
+        }
+        return serials;
+    }
+    
+    std::string key = selector.substr(0, equals);
+    std::string pattern = selector.substr(equals + 1);
+    bool prefix = !pattern.empty() && pattern.back() == '*';
+    if (prefix) {
+        pattern.pop_back();
+    }
+    
+    for (const auto& device : devices) {
+        std::string value;
+        if (key == "serial") value = device.serialNumber;
+        else if (key == "model") value = device.model;
+        else if (key == "android_version") value = device.androidVersion;
+        else if (key == "foreground_app") value = device.foregroundApp;
+        else if (key == "screen_on") value = device.isScreenOn ? "1" : "0";
+        else if (key == "locked") value = device.isLocked ? "1" : "0";
+        else return serials;  // unknown property matches nothing
+        
+        bool matches = prefix ? value.compare(0, pattern.size(), pattern) == 0 : value == pattern;
+        if (matches) {
+            serials.push_back(device.serialNumber);
+        }
+    }
+    return serials;
+}
+
+std::vector<AndroidActionResult> AndroidManager::runOnDevices(const std::vector<std::string>& serialNumbers,
+                                                              const DeviceAction& action) {
+    std::vector<AndroidActionResult> results(serialNumbers.size());
+    std::atomic<size_t> next{0};
+    
+    // Each worker claims the next device until none are left; every device
+    // is its own adb process, so they run fully in parallel
+    auto worker = [&]() {
+        for (size_t index = next++; index < serialNumbers.size(); index = next++) {
+            AndroidActionResult& result = results[index];
+            result.serial = serialNumbers[index];
+            auto started = std::chrono::steady_clock::now();
+            try {
+                result.success = action(result.serial, result.message);
+            } catch (const std::exception& e) {
+                result.success = false;
+                result.message = e.what();
+            }
+            result.durationMs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - started).count());
+            result.sanitize();
+        }
+    };
+    
+    size_t workerCount = std::min(parallelism_, serialNumbers.size());
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < workerCount; ++i) {
+        workers.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : workers) {
+        thread.join();
+    }
+    
+    return results;
+}
+
+void AndroidManager::setParallelism(size_t workers) {
+    parallelism_ = std::max<size_t>(1, std::min(workers, MAX_PARALLELISM));
+}
+
 void AndroidManager::deviceMonitoringThread() {
     while (running_) {
         try {
-            scanForDevices();
+            {
+                Watchdog::RunGuard guard("android");
+                scanForDevices();
+            }
             lastScan_ = std::chrono::steady_clock::now();
             
+            // Outside the scan's watchdog deadline; runs on all tracked devices at once
+            if (lastScan_ - lastInventoryCheck_ >= inventoryCheckInterval_) {
+                checkAppInventories();
+                lastInventoryCheck_ = lastScan_;
+            }
+            
             std::this_thread::sleep_for(scanInterval_);
             
         } catch (const std::exception& e) {
@@ -396,47 +707,72 @@ std::string AndroidManager::executeAdbCommandWithTimeout(const std::string& comm
     CloseHandle(hWritePipe);
     
 #else
-    // Linux/macOS implementation with timeout
-    FILE* pipe = popen(fullCommand.c_str(), "r");
-    if (!pipe) {
+    // Linux/macOS implementation - spawned directly, no host shell
+    ProcessResult processResult = ProcessRunner::run(buildAdbArguments(command, serialNumber), timeout);
+    if (processResult.timedOut) {
         return "";
     }
+    result = processResult.output;
+#endif
     
-    // Simple timeout implementation using select
-    int pipeFd = fileno(pipe);
-    fd_set readFds;
-    struct timeval tv;
+    return result;
+}
+
+std::vector<std::string> AndroidManager::buildAdbArguments(const std::string& command,
+                                                          const std::string& serialNumber) const {
+    std::vector<std::string> args{adbPath_};
+    if (!serialNumber.empty()) {
+        args.push_back("-s");
+        args.push_back(serialNumber);
+    }
     
-    FD_ZERO(&readFds);
-    FD_SET(pipeFd, &readFds);
-    tv.tv_sec = timeout.count() / 1000;
-    tv.tv_usec = (timeout.count() % 1000) * 1000;
+    // Everything after "shell" goes to the device shell as one argument, so
+    // pipes and quotes are interpreted on the device rather than on the host
+    std::string trimmed = command.substr(std::min(command.size(), command.find_first_not_of(" \t")));
+    if (trimmed.compare(0, 6, "shell ") == 0) {
+        args.push_back("shell");
+        std::string shellCommand = trimmed.substr(6);
+        shellCommand.erase(0, shellCommand.find_first_not_of(" \t"));
+        args.push_back(shellCommand);
+        return args;
+    }
     
-    char buffer[128];
-    while (true) {
-        int selectResult = select(pipeFd + 1, &readFds, nullptr, nullptr, &tv);
-        
-        if (selectResult > 0 && FD_ISSET(pipeFd, &readFds)) {
-            if (fgets(buffer, sizeof(buffer), pipe) != nullptr) {
-                result += buffer;
-            } else {
-                break; // EOF
-            }
-        } else {
-            // Timeout or error
-            pclose(pipe);
-            return "";
-        }
+    for (const auto& arg : ProcessRunner::splitArguments(trimmed)) {
+        args.push_back(arg);
+    }
+    return args;
+}
+
+bool AndroidManager::runAdbAction(const std::string& command, const std::string& serialNumber,
+                                  std::string& message) {
+#ifdef _WIN32
+    std::string result = executeAdbCommand(command, serialNumber);
+    message = result;
+    return !result.empty();
+#else
+    // Success is adb's exit status (the device command's, with shell v2)
+    ProcessResult result = ProcessRunner::run(buildAdbArguments(command, serialNumber), ADB_TIMEOUT);
+    if (result.succeeded()) {
+        return true;
     }
     
-    pclose(pipe);
+    if (!result.started) {
+        message = "Failed to run adb";
+    } else if (result.timedOut) {
+        message = "Timed out";
+    } else {
+        message = !result.errorOutput.empty() ? result.errorOutput : result.output;
+        message.erase(message.find_last_not_of(" \t\n\r") + 1);
+        if (message.empty()) {
+            message = "adb exited with code " + std::to_string(result.exitCode);
+        }
+    }
+    return false;
 #endif
-    
-    return result;
 }
 
 bool AndroidManager::isAdbAvailable() {
-    std::string command = adbPath_ + " version";
+    std::string command = "version";
     std::string result = executeAdbCommand(command);
     return !result.empty();
 }
@@ -612,11 +948,17 @@ std::string AndroidManager::getAdbPath() {
     
     // Test each path
     for (const auto& path : possiblePaths) {
+#ifdef _WIN32
         std::string testCommand = path + " version";
         std::string result = executeAdbCommand(testCommand);
         if (!result.empty()) {
             return path;
         }
+#else
+        if (ProcessRunner::run({path, "version"}, ADB_TIMEOUT).succeeded()) {
+            return path;
+        }
+#endif
     }
     
     return ""; // Not found
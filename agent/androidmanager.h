@@ -5,6 +5,8 @@
 #include <thread>
 #include <atomic>
 #include <shared_mutex>
+#include <functional>
+#include <map>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -32,24 +34,49 @@ public:
     bool isDeviceConnected(const std::string& serialNumber);
     AndroidDeviceInfo getDeviceInfo(const std::string& serialNumber);
     
-    // Device control
-    bool turnScreenOn(const std::string& serialNumber);
-    bool turnScreenOff(const std::string& serialNumber);
-    bool lockDevice(const std::string& serialNumber);
+    // Device control; on failure message holds adb's error output
+    bool turnScreenOn(const std::string& serialNumber, std::string& message);
+    bool turnScreenOff(const std::string& serialNumber, std::string& message);
+    bool lockDevice(const std::string& serialNumber, std::string& message);
     std::string getForegroundApp(const std::string& serialNumber);
     
-    // App management
+    // App management - the inventory is cached per device and re-read only
+    // when an on-device hash of the package list changes
+    struct AppPage {
+        std::vector<AndroidAppInfo> apps;
+        size_t total = 0;           // packages on the device
+        size_t matched = 0;         // packages passing filter and scope
+        uint64_t refreshedAt = 0;   // milliseconds since the epoch
+    };
     std::vector<std::string> getInstalledApps(const std::string& serialNumber);
-    bool launchApp(const std::string& serialNumber, const std::string& packageName);
-    bool stopApp(const std::string& serialNumber, const std::string& packageName);
+    // scope: "all", "user" or "system"; filter is a case-insensitive substring
+    bool queryInstalledApps(const std::string& serialNumber, const std::string& filter, const std::string& scope,
+                            size_t offset, size_t limit, bool refresh, AppPage& page);
+    void invalidateAppInventory(const std::string& serialNumber);
+    // packageName must pass isValidPackageName; it is run in the device shell
+    bool launchApp(const std::string& serialNumber, const std::string& packageName, std::string& message);
+    bool stopApp(const std::string& serialNumber, const std::string& packageName, std::string& message);
+    // Java package syntax: [A-Za-z][A-Za-z0-9_]*(\.[A-Za-z0-9_]+)+
+    static bool isValidPackageName(const std::string& packageName);
     
     // System operations
     std::string takeScreenshot(const std::string& serialNumber);
     std::string getScreenOrientation(const std::string& serialNumber);
     std::vector<std::string> getLogcat(const std::string& serialNumber, int lines = 100);
     
+    // Fleet operations - "all" (or empty), "<serial>,<serial>,...", or a
+    // property match "model=Pixel*", "android_version=14", "screen_on=1",
+    // "locked=0"; a trailing '*' matches a prefix
+    using DeviceAction = std::function<bool(const std::string& serialNumber, std::string& message)>;
+    std::vector<std::string> selectDevices(const std::string& selector);
+    std::vector<AndroidActionResult> runOnDevices(const std::vector<std::string>& serialNumbers,
+                                                  const DeviceAction& action);
+    void setParallelism(size_t workers);
+    void setInventoryCheckInterval(std::chrono::milliseconds interval);
+    
     // Status
     bool isRunning() const;
+    std::string getAdbExecutable() const;    // resolved by initialize()
 
 private:
     // Device monitoring
@@ -61,8 +88,23 @@ private:
     std::string executeAdbCommandWithTimeout(const std::string& command, 
                                            const std::string& serialNumber, 
                                            std::chrono::milliseconds timeout);
+    std::vector<std::string> buildAdbArguments(const std::string& command,
+                                               const std::string& serialNumber) const;
+    bool runAdbAction(const std::string& command, const std::string& serialNumber, std::string& message);
     bool isAdbAvailable();
     
+    // App inventory
+    struct AppInventory {
+        std::vector<AndroidAppInfo> apps;   // sorted by package name
+        std::string hash;
+        uint64_t refreshedAt = 0;
+    };
+    std::shared_ptr<const AppInventory> getAppInventory(const std::string& serialNumber, bool refresh);
+    std::shared_ptr<const AppInventory> fetchAppInventory(const std::string& serialNumber, std::string hash);
+    std::string fetchPackageListHash(const std::string& serialNumber);
+    void checkAppInventories();
+    static std::vector<AndroidAppInfo> parsePackageList(const std::string& output);
+    
     // Device information parsing
     AndroidDeviceInfo parseDeviceInfo(const std::string& serialNumber);
     std::vector<std::string> parseDeviceList();
@@ -90,10 +132,22 @@ private:
     std::chrono::steady_clock::time_point lastScan_;
     std::chrono::milliseconds scanInterval_;
     
+    // Fleet operations
+    size_t parallelism_;
+    
+    // App inventory cache
+    std::map<std::string, std::shared_ptr<const AppInventory>> appInventories_;
+    mutable std::shared_mutex inventoryMutex_;
+    std::chrono::milliseconds inventoryCheckInterval_;
+    std::chrono::steady_clock::time_point lastInventoryCheck_;
+    
     // Constants
     static constexpr std::chrono::milliseconds ADB_TIMEOUT{5000};
     static constexpr std::chrono::milliseconds SCAN_INTERVAL{2000};
     static constexpr int MAX_LOGCAT_LINES = 100;
+    static constexpr size_t DEFAULT_PARALLELISM = 8;
+    static constexpr size_t MAX_PARALLELISM = 64;
+    static constexpr std::chrono::milliseconds INVENTORY_CHECK_INTERVAL{30000};
 };
 
 } // namespace SysMon
@@ -0,0 +1,347 @@
+#include "androidtelemetry.h"
+#include <algorithm>
+#include <set>
+
+namespace SysMon {
+
+constexpr std::chrono::milliseconds AndroidTelemetry::LIST_TIMEOUT;
+constexpr std::chrono::milliseconds AndroidTelemetry::SAMPLE_TIMEOUT;
+constexpr size_t AndroidTelemetry::MAX_APPS_PER_DEVICE;
+constexpr size_t AndroidTelemetry::MAX_THERMAL_ZONES;
+
+namespace {
+
+const sysmon_metric_desc ANDROID_METRICS[] = {
+    {"cpu_usage", "percent", "Device CPU busy time", SYSMON_METRIC_GAUGE},
+    {"memory_total", "bytes", "Device physical memory", SYSMON_METRIC_GAUGE},
+    {"memory_available", "bytes", "Device memory available without swapping", SYSMON_METRIC_GAUGE},
+    {"memory_used", "bytes", "Device memory in use", SYSMON_METRIC_GAUGE},
+    {"temperature", "celsius", "Thermal zone temperature, instance <serial>/<zone type>", SYSMON_METRIC_GAUGE},
+    {"temperature_max", "celsius", "Hottest thermal zone", SYSMON_METRIC_GAUGE},
+    {"app_cpu_usage", "percent", "Share of device CPU per process, instance <serial>/<name>", SYSMON_METRIC_GAUGE},
+    {"processes", "", "Processes running on the device", SYSMON_METRIC_GAUGE},
+};
+
+const std::chrono::milliseconds ADB_PROBE_TIMEOUT{2000};
+
+void* createTelemetry(const char* config) {
+    std::string adbPath = config && *config ? config : "adb";
+
+    // Without a working adb the collector stays listed but inactive
+    if (!ProcessRunner::run({adbPath, "version"}, ADB_PROBE_TIMEOUT).succeeded()) {
+        return nullptr;
+    }
+    return new AndroidTelemetry(adbPath);
+}
+
+int collectTelemetry(void* instance, const sysmon_sample_sink* sink) {
+    return static_cast<AndroidTelemetry*>(instance)->collect(sink) ? 0 : -1;
+}
+
+void destroyTelemetry(void* instance) {
+    delete static_cast<AndroidTelemetry*>(instance);
+}
+
+const sysmon_collector ANDROID_COLLECTOR = {
+    SYSMON_COLLECTOR_ABI_VERSION,
+    "android",
+    "1.0",
+    ANDROID_METRICS,
+    sizeof(ANDROID_METRICS) / sizeof(ANDROID_METRICS[0]),
+    5000,
+    SYSMON_COST_HIGH,
+    createTelemetry,
+    collectTelemetry,
+    destroyTelemetry,
+};
+
+} // anonymous namespace
+
+AndroidTelemetry::AndroidTelemetry(const std::string& adbPath)
+    : adbPath_(adbPath) {
+}
+
+AndroidTelemetry::~AndroidTelemetry() {
+    // Device shells are killed by their ShellSession destructors
+}
+
+const sysmon_collector* AndroidTelemetry::collector() {
+    return &ANDROID_COLLECTOR;
+}
+
+bool AndroidTelemetry::collect(const sysmon_sample_sink* sink) {
+    std::vector<std::string> serials;
+    if (!listDevices(serials)) {
+        return false;
+    }
+
+    // Shells of unplugged devices go away with their state
+    std::set<std::string> connected(serials.begin(), serials.end());
+    for (auto it = devices_.begin(); it != devices_.end();) {
+        if (connected.count(it->first) == 0) {
+            it = devices_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    // Send to every device first so they all work at the same time
+    struct Pending {
+        std::string serial;
+        Device* device;
+        std::string marker;
+    };
+    std::vector<Pending> pending;
+    for (const auto& serial : serials) {
+        auto& device = devices_[serial];
+        if (!device) {
+            device = std::make_unique<Device>();
+        }
+        if (!device->shell.isRunning() && !startShell(serial, *device)) {
+            continue;
+        }
+
+        std::string marker = "@@sysmon_end_" + std::to_string(++device->sequence);
+        if (!device->shell.send(sampleScript(marker))) {
+            device->hasBaseline = false;
+            continue;
+        }
+        pending.push_back({serial, device.get(), marker});
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + SAMPLE_TIMEOUT;
+    std::string output;
+    for (const auto& request : pending) {
+        auto remaining = std::max(std::chrono::milliseconds(1), std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now()));
+        if (!request.device->shell.receive(request.marker, output, remaining)) {
+            // The shell was killed; the next run starts a new one
+            request.device->hasBaseline = false;
+            continue;
+        }
+        parseSample(request.serial, *request.device, output, sink);
+    }
+
+    return true;
+}
+
+bool AndroidTelemetry::listDevices(std::vector<std::string>& serials) {
+    ProcessResult result = ProcessRunner::run({adbPath_, "devices"}, LIST_TIMEOUT);
+    if (!result.succeeded()) {
+        return false;
+    }
+
+    // "List of devices attached" then "<serial>\t<state>"; only "device"
+    // is usable (not "offline" or "unauthorized")
+    std::string_view text = result.output;
+    std::string_view line;
+    while (ProcParsers::nextLine(text, line)) {
+        size_t tab = line.find('\t');
+        if (tab == std::string_view::npos || line.substr(tab + 1) != "device") {
+            continue;
+        }
+        serials.emplace_back(line.substr(0, tab));
+    }
+    return true;
+}
+
+bool AndroidTelemetry::startShell(const std::string& serial, Device& device) {
+    device.hasBaseline = false;
+    device.processes.clear();
+    return device.shell.start({adbPath_, "-s", serial, "shell"});
+}
+
+void AndroidTelemetry::parseSample(const std::string& serial, Device& device, std::string_view output,
+                                   const sysmon_sample_sink* sink) {
+    auto sections = splitSections(output);
+
+    uint64_t cpuTicks = 0;
+    ProcParsers::CpuTimes cpu;
+    if (ProcParsers::parseCpuStat(sections["stat"], cpu)) {
+        if (device.hasBaseline) {
+            emit(sink, "cpu_usage", serial, ProcParsers::cpuUsagePercent(device.cpu, cpu));
+            cpuTicks = cpu.total() > device.cpu.total() ? cpu.total() - device.cpu.total() : 0;
+        }
+        device.cpu = cpu;
+    }
+
+    ProcParsers::MemInfo memory;
+    if (ProcParsers::parseMemInfo(sections["meminfo"], memory)) {
+        emit(sink, "memory_total", serial, static_cast<double>(memory.totalBytes));
+        emit(sink, "memory_available", serial, static_cast<double>(memory.availableBytes));
+        emit(sink, "memory_used", serial,
+             static_cast<double>(memory.totalBytes - std::min(memory.totalBytes, memory.availableBytes)));
+    }
+
+    emitThermal(serial, sections["thermal"], sink);
+    emitAppUsage(serial, device, sections["ps"], sections["procs"], cpuTicks, sink);
+    device.hasBaseline = true;
+}
+
+void AndroidTelemetry::emitThermal(const std::string& serial, std::string_view section,
+                                   const sysmon_sample_sink* sink) {
+    // "/sys/class/thermal/thermal_zone3/type:cpu-1-0-usr" and ".../temp:45000"
+    struct Zone {
+        std::string_view type;
+        double celsius = 0.0;
+        bool hasTemperature = false;
+    };
+    std::map<uint64_t, Zone> zones;
+
+    std::string_view line;
+    while (ProcParsers::nextLine(section, line)) {
+        size_t zoneStart = line.find("thermal_zone");
+        size_t colon = line.find(':');
+        if (zoneStart == std::string_view::npos || colon == std::string_view::npos || colon < zoneStart) {
+            continue;
+        }
+
+        std::string_view cursor = line.substr(zoneStart + 12);
+        uint64_t index = 0;
+        if (!ProcParsers::parseUnsigned(cursor, index)) {
+            continue;
+        }
+        std::string_view file = line.substr(0, colon);
+        file = file.substr(file.rfind('/') + 1);
+        std::string_view value = line.substr(colon + 1);
+
+        Zone& zone = zones[index];
+        int64_t temperature = 0;
+        if (file == "type") {
+            zone.type = value;
+        } else if (file == "temp" && ProcParsers::parseSigned(value, temperature)) {
+            // Most drivers report millidegrees, a few report degrees
+            zone.celsius = (temperature > 1000 || temperature < -1000) ? temperature / 1000.0
+                                                                       : static_cast<double>(temperature);
+            zone.hasTemperature = zone.celsius > -40.0 && zone.celsius < 150.0;
+        }
+    }
+
+    // Hottest zones first; a type seen twice keeps its hottest reading
+    std::vector<const Zone*> readings;
+    for (const auto& entry : zones) {
+        if (entry.second.hasTemperature && !entry.second.type.empty()) {
+            readings.push_back(&entry.second);
+        }
+    }
+    if (readings.empty()) {
+        return;
+    }
+    std::sort(readings.begin(), readings.end(), [](const Zone* a, const Zone* b) {
+        return a->celsius > b->celsius;
+    });
+
+    emit(sink, "temperature_max", serial, readings.front()->celsius);
+
+    std::set<std::string_view> emitted;
+    for (const Zone* zone : readings) {
+        if (emitted.size() >= MAX_THERMAL_ZONES) {
+            break;
+        }
+        if (emitted.insert(zone->type).second) {
+            emit(sink, "temperature", serial + "/" + std::string(zone->type), zone->celsius);
+        }
+    }
+}
+
+void AndroidTelemetry::emitAppUsage(const std::string& serial, Device& device, std::string_view psSection,
+                                    std::string_view statSection, uint64_t cpuTicks,
+                                    const sysmon_sample_sink* sink) {
+    // Full process names from ps; stat truncates them to 15 characters,
+    // which cuts most package names
+    std::unordered_map<uint32_t, std::string_view> names;
+    std::string_view line;
+    while (ProcParsers::nextLine(psSection, line)) {
+        uint64_t pid = 0;
+        if (!ProcParsers::parseUnsigned(line, pid)) {
+            continue; // Header
+        }
+        size_t nameStart = line.find_first_not_of(' ');
+        if (nameStart != std::string_view::npos) {
+            names[static_cast<uint32_t>(pid)] = line.substr(nameStart);
+        }
+    }
+
+    // Ticks since the previous sample, summed per name; a reused pid has
+    // a different start time
+    std::unordered_map<uint32_t, ProcessTicks> current;
+    current.reserve(device.processes.size());
+    std::unordered_map<std::string_view, uint64_t> usage;
+    while (ProcParsers::nextLine(statSection, line)) {
+        ProcParsers::ProcessStat stat;
+        if (!ProcParsers::parseProcessStat(line, stat)) {
+            continue;
+        }
+
+        uint64_t ticks = stat.utime + stat.stime;
+        current[stat.pid] = {ticks, stat.startTime};
+
+        auto previous = device.processes.find(stat.pid);
+        if (previous == device.processes.end() || previous->second.startTime != stat.startTime ||
+            ticks <= previous->second.ticks) {
+            continue;
+        }
+        auto name = names.find(stat.pid);
+        usage[name != names.end() ? name->second : stat.name] += ticks - previous->second.ticks;
+    }
+    device.processes.swap(current);
+
+    emit(sink, "processes", serial, static_cast<double>(device.processes.size()));
+    if (cpuTicks == 0 || usage.empty()) {
+        return;
+    }
+
+    std::vector<std::pair<std::string_view, uint64_t>> ranked(usage.begin(), usage.end());
+    size_t count = std::min(ranked.size(), MAX_APPS_PER_DEVICE);
+    std::partial_sort(ranked.begin(), ranked.begin() + count, ranked.end(),
+                      [](const std::pair<std::string_view, uint64_t>& a,
+                         const std::pair<std::string_view, uint64_t>& b) { return a.second > b.second; });
+    for (size_t i = 0; i < count; ++i) {
+        emit(sink, "app_cpu_usage", serial + "/" + std::string(ranked[i].first),
+             100.0 * static_cast<double>(ranked[i].second) / static_cast<double>(cpuTicks));
+    }
+}
+
+std::string AndroidTelemetry::sampleScript(const std::string& marker) {
+    // One line, so the device shell parses it once; "ps -o NAME" is the full
+    // process name and one extra fork, cheaper than reading every cmdline
+    return "echo @@stat; cat /proc/stat; "
+           "echo @@meminfo; cat /proc/meminfo; "
+           "echo @@thermal; grep -H . /sys/class/thermal/thermal_zone*/type "
+           "/sys/class/thermal/thermal_zone*/temp 2>/dev/null; "
+           "echo @@ps; ps -A -o PID,NAME 2>/dev/null; "
+           "echo @@procs; cat /proc/[0-9]*/stat 2>/dev/null; echo; "
+           "echo " + marker + "\n";
+}
+
+std::map<std::string_view, std::string_view> AndroidTelemetry::splitSections(std::string_view output) {
+    // Sections are views into output, from after an "@@name" line up to the next
+    std::map<std::string_view, std::string_view> sections;
+    std::string_view name;
+    size_t begin = std::string_view::npos;
+
+    std::string_view text = output;
+    std::string_view line;
+    while (ProcParsers::nextLine(text, line)) {
+        if (line.size() <= 2 || line[0] != '@' || line[1] != '@') {
+            continue;
+        }
+        size_t lineStart = static_cast<size_t>(line.data() - output.data());
+        if (begin != std::string_view::npos) {
+            sections[name] = output.substr(begin, lineStart - begin);
+        }
+        name = line.substr(2);
+        begin = std::min(lineStart + line.size() + 1, output.size());
+    }
+    if (begin != std::string_view::npos) {
+        sections[name] = output.substr(begin);
+    }
+    return sections;
+}
+
+void AndroidTelemetry::emit(const sysmon_sample_sink* sink, const char* metric, const std::string& instance,
+                            double value) {
+    sink->emit(sink->context, metric, instance.c_str(), value);
+}
+
+} // namespace SysMon
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "../shared/collectorapi.h"
+#include "../shared/procparsers.h"
+#include "processrunner.h"
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <chrono>
+
+namespace SysMon {
+
+// Android Telemetry - on-device CPU, memory, temperature and per-app CPU
+//
+// Runs as a collector, so samples land in the agent's history store with
+// the device serial as the instance ("<serial>", or "<serial>/<app>" and
+// "<serial>/<thermal zone>"). Each device keeps one persistent adb shell;
+// a sample is a single script round trip per device, sent to all devices
+// before any reply is read. The output is cut into sections and parsed in
+// place with the same procfs parsers the host monitors use.
+class AndroidTelemetry {
+public:
+    explicit AndroidTelemetry(const std::string& adbPath);
+    ~AndroidTelemetry();
+
+    // Samples every connected device; false if adb itself could not be run
+    bool collect(const sysmon_sample_sink* sink);
+
+    // Collector descriptor; its config string is the adb path ("" for PATH)
+    static const sysmon_collector* collector();
+
+private:
+    struct ProcessTicks {
+        uint64_t ticks;
+        uint64_t startTime;
+    };
+
+    struct Device {
+        ShellSession shell;
+        ProcParsers::CpuTimes cpu;
+        std::unordered_map<uint32_t, ProcessTicks> processes;
+        bool hasBaseline = false;
+        uint64_t sequence = 0;
+    };
+
+    // Sampling
+    bool listDevices(std::vector<std::string>& serials);
+    bool startShell(const std::string& serial, Device& device);
+    void parseSample(const std::string& serial, Device& device, std::string_view output,
+                     const sysmon_sample_sink* sink);
+    void emitThermal(const std::string& serial, std::string_view section, const sysmon_sample_sink* sink);
+    void emitAppUsage(const std::string& serial, Device& device, std::string_view psSection,
+                      std::string_view statSection, uint64_t cpuTicks, const sysmon_sample_sink* sink);
+
+    // Helpers
+    static std::string sampleScript(const std::string& marker);
+    static std::map<std::string_view, std::string_view> splitSections(std::string_view output);
+    static void emit(const sysmon_sample_sink* sink, const char* metric, const std::string& instance, double value);
+
+    std::string adbPath_;
+    std::map<std::string, std::unique_ptr<Device>> devices_;
+
+    // Constants
+    static constexpr std::chrono::milliseconds LIST_TIMEOUT{2000};
+    static constexpr std::chrono::milliseconds SAMPLE_TIMEOUT{3000};
+    static constexpr size_t MAX_APPS_PER_DEVICE = 10;
+    static constexpr size_t MAX_THERMAL_ZONES = 16;
+};
+
+} // namespace SysMon
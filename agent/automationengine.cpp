@@ -107,7 +107,179 @@ void AutomationEngine::evaluateRules() {
 }
 
 bool AutomationEngine::evaluateCondition(const std::string& condition) {
-    // Temporary simplified implementation
+    std::string conditionType = extractConditionType(condition);
+    
+    if (conditionType.compare(0, 5, "DISK_") == 0) {
+        return evaluateFilesystemCondition(condition);
+    }
+    
+    if (conditionType == "NET_COUNTER" || conditionType == "NET_RATE") {
+        return evaluateNetworkStatsCondition(condition);
+    }
+    
+    if (conditionType == "POWER_WATTS") {
+        return evaluatePowerCondition(condition);
+    }
+    
+    if (conditionType == "METRIC") {
+        return evaluateMetricCondition(condition);
+    }
+    
+    // Other condition types are not evaluated yet
+    return false;
+}
+
+bool AutomationEngine::evaluateFilesystemCondition(const std::string& condition) {
+    // Parse filesystem condition: "DISK_USAGE /var > 90%", "DISK_TIME_TO_FULL < 3600"
+    // Without a mount point the condition holds if any filesystem matches
+    static const std::regex diskRegex(
+        R"((DISK_USAGE|DISK_INODES|DISK_FILL_RATE|DISK_TIME_TO_FULL)\s*(/\S*)?\s*(>=|<=|==|>|<)\s*(\d+(?:\.\d+)?)%?)");
+    std::smatch match;
+    
+    if (!core_ || !std::regex_search(condition, match, diskRegex)) {
+        return false;
+    }
+    
+    std::string metric = match[1].str();
+    std::string mountPoint = match[2].str();
+    std::string op = match[3].str();
+    double threshold;
+    
+    try {
+        threshold = std::stod(match[4].str());
+    } catch (const std::exception& e) {
+        return false;
+    }
+    
+    for (const auto& fs : core_->getFilesystems()) {
+        if (!mountPoint.empty() && fs.mountPoint != mountPoint) {
+            continue;
+        }
+        
+        double value;
+        if (metric == "DISK_USAGE") {
+            value = fs.usagePercent;
+        } else if (metric == "DISK_INODES") {
+            value = fs.inodeUsagePercent;
+        } else if (metric == "DISK_FILL_RATE") {
+            value = fs.fillRate;
+        } else {
+            if (fs.timeToFull < 0.0) {
+                continue; // Not filling up
+            }
+            value = fs.timeToFull;
+        }
+        
+        if (compareThreshold(value, op, threshold)) {
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+bool AutomationEngine::evaluateNetworkStatsCondition(const std::string& condition) {
+    // Parse stack counter condition: "NET_RATE Tcp.RetransSegs > 50", "NET_COUNTER TcpExt.ListenOverflows > 0"
+    static const std::regex netRegex(
+        R"((NET_COUNTER|NET_RATE)\s+([A-Za-z]+\.[A-Za-z0-9]+)\s*(>=|<=|==|>|<)\s*(\d+(?:\.\d+)?))");
+    std::smatch match;
+    
+    if (!core_ || !std::regex_search(condition, match, netRegex)) {
+        return false;
+    }
+    
+    std::string name = match[2].str();
+    double threshold;
+    
+    try {
+        threshold = std::stod(match[4].str());
+    } catch (const std::exception& e) {
+        return false;
+    }
+    
+    for (const auto& counter : core_->getNetworkStats()) {
+        if (counter.name == name) {
+            double value = match[1].str() == "NET_RATE" ? counter.rate : static_cast<double>(counter.value);
+            return compareThreshold(value, match[3].str(), threshold);
+        }
+    }
+    
+    return false;
+}
+
+bool AutomationEngine::evaluatePowerCondition(const std::string& condition) {
+    // Parse power condition: "POWER_WATTS package-0 > 120", "POWER_WATTS total > 200"
+    static const std::regex powerRegex(
+        R"(POWER_WATTS\s+([A-Za-z0-9:_-]+)\s*(>=|<=|==|>|<)\s*(\d+(?:\.\d+)?))");
+    std::smatch match;
+    
+    if (!core_ || !std::regex_search(condition, match, powerRegex)) {
+        return false;
+    }
+    
+    std::string domainName = match[1].str();
+    double threshold;
+    
+    try {
+        threshold = std::stod(match[3].str());
+    } catch (const std::exception& e) {
+        return false;
+    }
+    
+    // "total" sums the package domains of all sockets
+    bool found = false;
+    double watts = 0.0;
+    for (const auto& domain : core_->getPowerDomains()) {
+        if (domainName == "total" ? domain.name.compare(0, 8, "package-") == 0
+                                  : (domain.name == domainName || domain.zone == domainName)) {
+            watts += domain.watts;
+            found = true;
+        }
+    }
+    
+    return found && compareThreshold(watts, match[2].str(), threshold);
+}
+
+bool AutomationEngine::evaluateMetricCondition(const std::string& condition) {
+    // Parse collector metric condition: "METRIC loadavg.load1 > 4", "METRIC pressure.some_avg10[io] > 20"
+    // Without an instance the condition holds if any instance matches
+    static const std::regex metricRegex(
+        R"(METRIC\s+([a-z0-9_]+)\.([A-Za-z0-9_]+)(?:\[([^\]]*)\])?\s*(>=|<=|==|>|<)\s*(-?\d+(?:\.\d+)?))");
+    std::smatch match;
+    
+    if (!core_ || !std::regex_search(condition, match, metricRegex)) {
+        return false;
+    }
+    
+    std::string metric = match[2].str();
+    bool anyInstance = !match[3].matched;
+    std::string instance = match[3].str();
+    double threshold;
+    
+    try {
+        threshold = std::stod(match[5].str());
+    } catch (const std::exception& e) {
+        return false;
+    }
+    
+    for (const auto& sample : core_->getCollectorSamples(match[1].str())) {
+        if (sample.metric != metric || (!anyInstance && sample.instance != instance)) {
+            continue;
+        }
+        if (compareThreshold(sample.value, match[4].str(), threshold)) {
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+bool AutomationEngine::compareThreshold(double value, const std::string& op, double threshold) const {
+    if (op == ">") return value > threshold;
+    if (op == "<") return value < threshold;
+    if (op == ">=") return value >= threshold;
+    if (op == "<=") return value <= threshold;
+    if (op == "==") return value == threshold;
     return false;
 }
 
@@ -53,6 +53,11 @@ private:
     bool evaluateDeviceCondition(const std::string& condition);
     bool evaluateNetworkCondition(const std::string& condition);
     bool evaluateAndroidCondition(const std::string& condition);
+    bool evaluateFilesystemCondition(const std::string& condition);
+    bool evaluateNetworkStatsCondition(const std::string& condition);
+    bool evaluatePowerCondition(const std::string& condition);
+    bool evaluateMetricCondition(const std::string& condition);
+    bool compareThreshold(double value, const std::string& op, double threshold) const;
     
     // Action execution helpers
     void executeSystemAction(const std::string& action);
@@ -0,0 +1,194 @@
+// SysMon3 eBPF programs: run-queue latency histograms and exec/exit tracing
+//
+// Built as a CO-RE object without vmlinux.h: the few kernel fields used are
+// declared below with preserve_access_index, and libbpf relocates them
+// against the running kernel's BTF at load time. Needs BTF-enabled
+// tracepoints (5.5+) and the BPF ring buffer (5.8+).
+
+#include <stdbool.h>
+#include <linux/bpf.h>
+#include <bpf/bpf_helpers.h>
+#include <bpf/bpf_tracing.h>
+#include <bpf/bpf_core_read.h>
+#include "sysmon_bpf.h"
+
+#define TASK_RUNNING 0
+#define MAX_QUEUED_TASKS 16384
+#define TASK_EVENTS_SIZE (256 * 1024)
+
+struct task_struct {
+    int pid;
+    int tgid;
+    unsigned int __state;
+    int exit_code;
+    __u64 start_time;
+    struct task_struct *real_parent;
+} __attribute__((preserve_access_index));
+
+// Kernels before 5.14 name the state field "state"
+struct task_struct___pre514 {
+    long state;
+} __attribute__((preserve_access_index));
+
+struct linux_binprm {
+    const char *filename;
+} __attribute__((preserve_access_index));
+
+// Enqueue time per thread, consumed when the thread gets a CPU
+struct {
+    __uint(type, BPF_MAP_TYPE_HASH);
+    __uint(max_entries, MAX_QUEUED_TASKS);
+    __type(key, __u32);
+    __type(value, __u64);
+} queued_at SEC(".maps");
+
+// One histogram per CPU; each CPU only touches its own copy
+struct {
+    __uint(type, BPF_MAP_TYPE_PERCPU_ARRAY);
+    __uint(max_entries, 1);
+    __type(key, __u32);
+    __type(value, struct sysmon_rq_hist);
+} rq_hist SEC(".maps");
+
+struct {
+    __uint(type, BPF_MAP_TYPE_RINGBUF);
+    __uint(max_entries, TASK_EVENTS_SIZE);
+} task_events SEC(".maps");
+
+static __always_inline __u32 log2_u32(__u32 v) {
+    __u32 shift, r;
+
+    r = (v > 0xFFFF) << 4; v >>= r;
+    shift = (v > 0xFF) << 3; v >>= shift; r |= shift;
+    shift = (v > 0xF) << 2; v >>= shift; r |= shift;
+    shift = (v > 0x3) << 1; v >>= shift; r |= shift;
+    r |= (v >> 1);
+    return r;
+}
+
+static __always_inline __u32 log2_u64(__u64 v) {
+    __u32 high = v >> 32;
+    return high ? log2_u32(high) + 32 : log2_u32((__u32)v);
+}
+
+static __always_inline long task_state(struct task_struct *task) {
+    if (bpf_core_field_exists(task->__state)) {
+        return BPF_CORE_READ(task, __state);
+    }
+    return BPF_CORE_READ((struct task_struct___pre514 *)task, state);
+}
+
+static __always_inline int mark_queued(__u32 pid) {
+    __u64 now;
+
+    if (pid == 0) {
+        return 0;
+    }
+    now = bpf_ktime_get_ns();
+    bpf_map_update_elem(&queued_at, &pid, &now, BPF_ANY);
+    return 0;
+}
+
+SEC("tp_btf/sched_wakeup")
+int BPF_PROG(sysmon_sched_wakeup, struct task_struct *task) {
+    return mark_queued(task->pid);
+}
+
+SEC("tp_btf/sched_wakeup_new")
+int BPF_PROG(sysmon_sched_wakeup_new, struct task_struct *task) {
+    return mark_queued(task->pid);
+}
+
+SEC("tp_btf/sched_switch")
+int BPF_PROG(sysmon_sched_switch, bool preempt, struct task_struct *prev, struct task_struct *next) {
+    struct sysmon_rq_hist *hist;
+    __u32 pid = next->pid;
+    __u32 zero = 0;
+    __u64 *queued;
+    __u64 wait_us;
+    __u32 slot;
+
+    // A preempted task goes straight back on the run queue
+    if (task_state(prev) == TASK_RUNNING) {
+        mark_queued(prev->pid);
+    }
+
+    queued = bpf_map_lookup_elem(&queued_at, &pid);
+    if (!queued) {
+        return 0;
+    }
+
+    wait_us = (bpf_ktime_get_ns() - *queued) / 1000;
+    bpf_map_delete_elem(&queued_at, &pid);
+
+    slot = log2_u64(wait_us);
+    if (slot >= SYSMON_RQ_SLOTS) {
+        slot = SYSMON_RQ_SLOTS - 1;
+    }
+
+    hist = bpf_map_lookup_elem(&rq_hist, &zero);
+    if (!hist) {
+        return 0;
+    }
+    hist->slots[slot]++;
+    hist->count++;
+    hist->total_us += wait_us;
+    return 0;
+}
+
+SEC("tp_btf/sched_process_exec")
+int BPF_PROG(sysmon_process_exec, struct task_struct *task, int old_pid, struct linux_binprm *bprm) {
+    struct sysmon_task_event *event;
+
+    event = bpf_ringbuf_reserve(&task_events, sizeof(*event), 0);
+    if (!event) {
+        return 0;
+    }
+
+    event->type = SYSMON_TASK_EXEC;
+    event->pid = task->tgid;
+    event->ppid = BPF_CORE_READ(task, real_parent, tgid);
+    event->uid = (__u32)bpf_get_current_uid_gid();
+    event->exit_code = 0;
+    event->reserved = 0;
+    event->timestamp_ns = bpf_ktime_get_ns();
+    event->duration_ns = 0;
+    bpf_get_current_comm(event->comm, sizeof(event->comm));
+    bpf_probe_read_kernel_str(event->filename, sizeof(event->filename), BPF_CORE_READ(bprm, filename));
+
+    bpf_ringbuf_submit(event, 0);
+    return 0;
+}
+
+SEC("tp_btf/sched_process_exit")
+int BPF_PROG(sysmon_process_exit, struct task_struct *task) {
+    struct sysmon_task_event *event;
+    __u64 now;
+
+    // Only whole processes, not every thread
+    if (task->pid != task->tgid) {
+        return 0;
+    }
+
+    event = bpf_ringbuf_reserve(&task_events, sizeof(*event), 0);
+    if (!event) {
+        return 0;
+    }
+
+    now = bpf_ktime_get_ns();
+    event->type = SYSMON_TASK_EXIT;
+    event->pid = task->tgid;
+    event->ppid = BPF_CORE_READ(task, real_parent, tgid);
+    event->uid = (__u32)bpf_get_current_uid_gid();
+    event->exit_code = task->exit_code;
+    event->reserved = 0;
+    event->timestamp_ns = now;
+    event->duration_ns = now - task->start_time;
+    bpf_get_current_comm(event->comm, sizeof(event->comm));
+    event->filename[0] = '\0';
+
+    bpf_ringbuf_submit(event, 0);
+    return 0;
+}
+
+char LICENSE[] SEC("license") = "Dual MIT/GPL";
@@ -0,0 +1,37 @@
+#pragma once
+
+// Records shared by the eBPF programs in sysmon.bpf.c and EbpfMonitor.
+// Plain C so both the BPF target and the agent can include it; any change
+// here needs the object file rebuilt together with the agent.
+
+#include <linux/types.h>
+
+#define SYSMON_RQ_SLOTS 27          // log2 microsecond buckets, the last one is open-ended
+#define SYSMON_COMM_LEN 16
+#define SYSMON_FILENAME_LEN 128
+
+enum sysmon_task_event_type {
+    SYSMON_TASK_EXEC = 1,
+    SYSMON_TASK_EXIT = 2
+};
+
+// Run-queue latency of one CPU: slot i counts waits of [2^i, 2^(i+1)) us
+struct sysmon_rq_hist {
+    __u64 slots[SYSMON_RQ_SLOTS];
+    __u64 count;
+    __u64 total_us;
+};
+
+// One exec or exit, sent through the task_events ring buffer
+struct sysmon_task_event {
+    __u32 type;
+    __u32 pid;
+    __u32 ppid;
+    __u32 uid;
+    __s32 exit_code;
+    __u32 reserved;
+    __u64 timestamp_ns;             // CLOCK_MONOTONIC
+    __u64 duration_ns;              // process lifetime, exits only
+    char comm[SYSMON_COMM_LEN];
+    char filename[SYSMON_FILENAME_LEN];
+};
@@ -0,0 +1,171 @@
+#include "builtincollectors.h"
+#include "../shared/procparsers.h"
+#include <cstdio>
+#include <string>
+
+namespace SysMon {
+namespace BuiltinCollectors {
+
+namespace {
+
+// Built-ins take an optional procfs root as their config string
+struct ProcState {
+    std::string root;
+    std::string buffer;     // reused by every collection
+};
+
+void* createProcState(const char* config, const char* probe) {
+    ProcState* state = new ProcState{config && *config ? config : "/proc", std::string()};
+
+    // Kernels without the source file leave the collector inactive
+    FILE* file = std::fopen((state->root + probe).c_str(), "r");
+    if (!file) {
+        delete state;
+        return nullptr;
+    }
+    std::fclose(file);
+    return state;
+}
+
+void destroyProcState(void* instance) {
+    delete static_cast<ProcState*>(instance);
+}
+
+// ---------------------------------------------------------------------------
+// loadavg
+
+const sysmon_metric_desc LOADAVG_METRICS[] = {
+    {"load1", "", "Load average over 1 minute", SYSMON_METRIC_GAUGE},
+    {"load5", "", "Load average over 5 minutes", SYSMON_METRIC_GAUGE},
+    {"load15", "", "Load average over 15 minutes", SYSMON_METRIC_GAUGE},
+    {"runnable", "tasks", "Currently runnable scheduling entities", SYSMON_METRIC_GAUGE},
+    {"entities", "tasks", "Existing scheduling entities", SYSMON_METRIC_GAUGE},
+};
+
+void* createLoadAverage(const char* config) {
+    return createProcState(config, "/loadavg");
+}
+
+int collectLoadAverage(void* instance, const sysmon_sample_sink* sink) {
+    auto* state = static_cast<ProcState*>(instance);
+    if (!ProcParsers::readFile(state->root + "/loadavg", state->buffer)) {
+        return -1;
+    }
+
+    // "0.52 0.58 0.59 2/1189 12345"
+    std::string_view text = state->buffer;
+    double load1, load5, load15;
+    uint64_t runnable, entities;
+    if (!ProcParsers::parseDecimal(text, load1) || !ProcParsers::parseDecimal(text, load5) ||
+        !ProcParsers::parseDecimal(text, load15) || !ProcParsers::parseUnsigned(text, runnable) ||
+        !ProcParsers::consumePrefix(text, "/") || !ProcParsers::parseUnsigned(text, entities)) {
+        return -1;
+    }
+
+    sink->emit(sink->context, "load1", nullptr, load1);
+    sink->emit(sink->context, "load5", nullptr, load5);
+    sink->emit(sink->context, "load15", nullptr, load15);
+    sink->emit(sink->context, "runnable", nullptr, static_cast<double>(runnable));
+    sink->emit(sink->context, "entities", nullptr, static_cast<double>(entities));
+    return 0;
+}
+
+const sysmon_collector LOADAVG_COLLECTOR = {
+    SYSMON_COLLECTOR_ABI_VERSION,
+    "loadavg",
+    "1.0",
+    LOADAVG_METRICS,
+    sizeof(LOADAVG_METRICS) / sizeof(LOADAVG_METRICS[0]),
+    1000,
+    SYSMON_COST_LOW,
+    createLoadAverage,
+    collectLoadAverage,
+    destroyProcState,
+};
+
+// ---------------------------------------------------------------------------
+// pressure
+
+const sysmon_metric_desc PRESSURE_METRICS[] = {
+    {"some_avg10", "percent", "Share of time some tasks stalled, 10s average", SYSMON_METRIC_GAUGE},
+    {"some_avg60", "percent", "Share of time some tasks stalled, 60s average", SYSMON_METRIC_GAUGE},
+    {"some_total", "us", "Total time some tasks stalled", SYSMON_METRIC_COUNTER},
+    {"full_avg10", "percent", "Share of time all tasks stalled, 10s average", SYSMON_METRIC_GAUGE},
+    {"full_avg60", "percent", "Share of time all tasks stalled, 60s average", SYSMON_METRIC_GAUGE},
+    {"full_total", "us", "Total time all tasks stalled", SYSMON_METRIC_COUNTER},
+};
+
+const char* const PRESSURE_RESOURCES[] = {"cpu", "memory", "io"};
+
+// Value of the next "label=value" field of a pressure line
+bool nextLabeledField(std::string_view& line, std::string_view label, std::string_view& value) {
+    return ProcParsers::nextField(line, value) && ProcParsers::consumePrefix(value, label);
+}
+
+void* createPressure(const char* config) {
+    return createProcState(config, "/pressure/cpu");
+}
+
+int collectPressure(void* instance, const sysmon_sample_sink* sink) {
+    auto* state = static_cast<ProcState*>(instance);
+    int resourcesRead = 0;
+
+    for (const char* resource : PRESSURE_RESOURCES) {
+        if (!ProcParsers::readFile(state->root + "/pressure/" + resource, state->buffer)) {
+            continue;
+        }
+
+        // "some avg10=0.00 avg60=0.00 avg300=0.00 total=12345"
+        std::string_view text = state->buffer;
+        std::string_view line, kind, field;
+        while (ProcParsers::nextLine(text, line)) {
+            double avg10, avg60;
+            uint64_t total;
+            if (!ProcParsers::nextField(line, kind) ||
+                !nextLabeledField(line, "avg10=", field) || !ProcParsers::parseDecimal(field, avg10) ||
+                !nextLabeledField(line, "avg60=", field) || !ProcParsers::parseDecimal(field, avg60) ||
+                !nextLabeledField(line, "avg300=", field) ||
+                !nextLabeledField(line, "total=", field) || !ProcParsers::parseUnsigned(field, total)) {
+                break;
+            }
+
+            bool some = kind == "some";
+            sink->emit(sink->context, some ? "some_avg10" : "full_avg10", resource, avg10);
+            sink->emit(sink->context, some ? "some_avg60" : "full_avg60", resource, avg60);
+            sink->emit(sink->context, some ? "some_total" : "full_total", resource, static_cast<double>(total));
+        }
+        resourcesRead++;
+    }
+
+    return resourcesRead > 0 ? 0 : -1;
+}
+
+const sysmon_collector PRESSURE_COLLECTOR = {
+    SYSMON_COLLECTOR_ABI_VERSION,
+    "pressure",
+    "1.0",
+    PRESSURE_METRICS,
+    sizeof(PRESSURE_METRICS) / sizeof(PRESSURE_METRICS[0]),
+    2000,
+    SYSMON_COST_LOW,
+    createPressure,
+    collectPressure,
+    destroyProcState,
+};
+
+} // anonymous namespace
+
+const sysmon_collector* loadAverage() {
+    return &LOADAVG_COLLECTOR;
+}
+
+const sysmon_collector* pressure() {
+    return &PRESSURE_COLLECTOR;
+}
+
+std::vector<const sysmon_collector*> all() {
+    return {loadAverage(), pressure()};
+}
+
+} // namespace BuiltinCollectors
+} // namespace SysMon
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "../shared/collectorapi.h"
+#include <vector>
+
+namespace SysMon {
+
+// Built-in collectors, written against the same C ABI as plugins
+namespace BuiltinCollectors {
+
+// /proc/loadavg: load averages, runnable and total scheduling entities
+const sysmon_collector* loadAverage();
+
+// /proc/pressure/{cpu,memory,io}: PSI stall averages, one instance per resource
+const sysmon_collector* pressure();
+
+std::vector<const sysmon_collector*> all();
+
+} // namespace BuiltinCollectors
+
+} // namespace SysMon
@@ -0,0 +1,549 @@
+#include "collectorregistry.h"
+#include "watchdog.h"
+#include <algorithm>
+#include <cstring>
+
+#ifndef _WIN32
+#include <dlfcn.h>
+#include <dirent.h>
+#endif
+
+namespace SysMon {
+
+constexpr size_t CollectorRegistry::DEFAULT_HISTORY_SIZE;
+constexpr size_t CollectorRegistry::MAX_SAMPLES_PER_RUN;
+constexpr size_t CollectorRegistry::MAX_SERIES_PER_COLLECTOR;
+constexpr std::chrono::milliseconds CollectorRegistry::MAX_BACKOFF_INTERVAL;
+
+CollectorRegistry::CollectorRegistry()
+    : running_(false)
+    , initialized_(false)
+    , fallbackMode_(false)
+    , historySize_(DEFAULT_HISTORY_SIZE) {
+}
+
+CollectorRegistry::~CollectorRegistry() {
+    shutdown();
+}
+
+bool CollectorRegistry::initialize() {
+    if (initialized_) {
+        return true;
+    }
+
+    initialized_ = true;
+    return true;
+}
+
+void CollectorRegistry::shutdown() {
+    if (!initialized_) {
+        return;
+    }
+
+    stop();
+
+    // Runners still stuck in collect() are left behind; their collectors
+    // are neither destroyed nor unloaded under them
+    for (auto& runner : quarantined_) {
+        runner->thread.detach();
+    }
+    quarantined_.clear();
+
+    // Instances go before the code that implements them
+    for (auto& collector : collectors_) {
+        if (collector->info.isQuarantined) {
+            continue;
+        }
+        if (collector->instance && collector->descriptor->destroy) {
+            collector->descriptor->destroy(collector->instance);
+        }
+#ifndef _WIN32
+        if (collector->library) {
+            dlclose(collector->library);
+        }
+#endif
+    }
+    collectors_.clear();
+
+    initialized_ = false;
+}
+
+bool CollectorRegistry::start() {
+    if (!initialized_) {
+        return false;
+    }
+
+    if (running_ || fallbackMode_) {
+        return true;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    for (auto& collector : collectors_) {
+        collector->nextRun = now;
+        if (collector->info.isActive) {
+            collector->deadline = Watchdog::getInstance().registerJob(jobName(*collector), collector->interval);
+        }
+    }
+
+    runner_ = createRunner();
+    running_ = true;
+    schedulerThread_ = std::thread(&CollectorRegistry::schedulerThread, this);
+
+    return true;
+}
+
+void CollectorRegistry::stop() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex_);
+        running_ = false;
+    }
+    wakeCondition_.notify_all();
+
+    if (schedulerThread_.joinable()) {
+        schedulerThread_.join();
+    }
+
+    if (runner_) {
+        {
+            std::lock_guard<std::mutex> lock(runner_->mutex);
+            runner_->exit = true;
+        }
+        runner_->condition.notify_all();
+        runner_->thread.join();
+        runner_.reset();
+    }
+    releaseQuarantined();
+
+    for (const auto& collector : collectors_) {
+        Watchdog::getInstance().unregisterJob(jobName(*collector));
+    }
+}
+
+void CollectorRegistry::enableFallbackMode(bool enable) {
+    fallbackMode_ = enable;
+}
+
+bool CollectorRegistry::isFallbackMode() const {
+    return fallbackMode_;
+}
+
+bool CollectorRegistry::registerCollector(const sysmon_collector* descriptor, const std::string& source) {
+    if (running_ || !validateDescriptor(descriptor)) {
+        return false;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(dataMutex_);
+
+    for (const auto& existing : collectors_) {
+        if (existing->info.name == descriptor->name) {
+            return false;
+        }
+    }
+
+    auto collector = std::make_unique<Collector>();
+    collector->descriptor = descriptor;
+    collector->instance = nullptr;
+    collector->library = nullptr;
+    collector->interval = std::max(std::chrono::milliseconds(descriptor->interval_ms),
+                                   intervalFloor(descriptor->cost_class));
+    collector->deadline = collector->interval * 2;
+    collector->consecutiveFailures = 0;
+
+    CollectorInfo& info = collector->info;
+    info.name = descriptor->name;
+    info.version = descriptor->version ? descriptor->version : "";
+    info.source = source;
+    info.costClass = costClassToString(descriptor->cost_class);
+    info.intervalMs = static_cast<uint32_t>(collector->interval.count());
+    for (uint32_t i = 0; i < descriptor->metric_count; ++i) {
+        CollectorMetricInfo metric;
+        metric.name = descriptor->metrics[i].name;
+        metric.unit = descriptor->metrics[i].unit ? descriptor->metrics[i].unit : "";
+        metric.description = descriptor->metrics[i].description ? descriptor->metrics[i].description : "";
+        metric.isCounter = descriptor->metrics[i].kind == SYSMON_METRIC_COUNTER;
+        info.metrics.push_back(metric);
+    }
+    info.sanitize();
+
+    // A collector that fails to create stays listed, inactive, so the
+    // failure is visible to clients
+    std::string config = configProvider_ ? configProvider_(info.name) : "";
+    collector->instance = descriptor->create ? descriptor->create(config.c_str()) : nullptr;
+    info.isActive = collector->instance != nullptr;
+
+    collectors_.push_back(std::move(collector));
+    return true;
+}
+
+size_t CollectorRegistry::loadPlugins(const std::string& directory) {
+#ifdef _WIN32
+    (void)directory;
+    return 0;
+#else
+    DIR* dir = opendir(directory.c_str());
+    if (!dir) {
+        return 0;
+    }
+
+    std::vector<std::string> paths;
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != nullptr) {
+        std::string name = entry->d_name;
+        if (name.size() > 3 && name.compare(name.size() - 3, 3, ".so") == 0) {
+            paths.push_back(directory + "/" + name);
+        }
+    }
+    closedir(dir);
+    std::sort(paths.begin(), paths.end());
+
+    size_t loaded = 0;
+    for (const auto& path : paths) {
+        void* library = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+        if (!library) {
+            continue;
+        }
+
+        auto entryPoint = reinterpret_cast<sysmon_collector_entry_fn>(dlsym(library, SYSMON_COLLECTOR_ENTRY));
+        const sysmon_collector* descriptor = entryPoint ? entryPoint() : nullptr;
+        if (!descriptor || !registerCollector(descriptor, path)) {
+            dlclose(library);
+            continue;
+        }
+
+        std::unique_lock<std::shared_mutex> lock(dataMutex_);
+        collectors_.back()->library = library;
+        loaded++;
+    }
+
+    return loaded;
+#endif
+}
+
+void CollectorRegistry::setConfigProvider(ConfigProvider provider) {
+    configProvider_ = std::move(provider);
+}
+
+void CollectorRegistry::setSampleCallback(SampleCallback callback) {
+    sampleCallback_ = std::move(callback);
+}
+
+void CollectorRegistry::setHistorySize(size_t samples) {
+    std::unique_lock<std::shared_mutex> lock(dataMutex_);
+    historySize_ = std::max<size_t>(samples, 1);
+}
+
+std::vector<CollectorInfo> CollectorRegistry::getCollectors() const {
+    std::shared_lock<std::shared_mutex> lock(dataMutex_);
+
+    std::vector<CollectorInfo> collectors;
+    collectors.reserve(collectors_.size());
+    for (const auto& collector : collectors_) {
+        collectors.push_back(collector->info);
+    }
+    return collectors;
+}
+
+std::vector<MetricSample> CollectorRegistry::getSamples(const std::string& collectorName) const {
+    std::shared_lock<std::shared_mutex> lock(dataMutex_);
+
+    std::vector<MetricSample> samples;
+    for (const auto& collector : collectors_) {
+        if (collectorName.empty() || collector->info.name == collectorName) {
+            samples.insert(samples.end(), collector->latest.begin(), collector->latest.end());
+        }
+    }
+    return samples;
+}
+
+std::vector<MetricSample> CollectorRegistry::getHistory(const std::string& collectorName, const std::string& metric,
+                                                        const std::string& instance) const {
+    std::shared_lock<std::shared_mutex> lock(dataMutex_);
+
+    for (const auto& collector : collectors_) {
+        if (collector->info.name != collectorName) {
+            continue;
+        }
+        auto it = collector->history.find(seriesKey(metric, instance));
+        if (it != collector->history.end()) {
+            return std::vector<MetricSample>(it->second.begin(), it->second.end());
+        }
+        break;
+    }
+    return {};
+}
+
+void CollectorRegistry::schedulerThread() {
+    while (running_) {
+        try {
+            releaseQuarantined();
+
+            auto now = std::chrono::steady_clock::now();
+            auto nextWake = now + std::chrono::seconds(1);
+
+            // Among due collectors the cheapest runs first, so one slow
+            // collector cannot starve the others
+            Collector* due = nullptr;
+            for (auto& collector : collectors_) {
+                if (!collector->info.isActive || collector->info.isQuarantined) {
+                    continue;
+                }
+                if (collector->nextRun > now) {
+                    nextWake = std::min(nextWake, collector->nextRun);
+                    continue;
+                }
+                if (!due || collector->descriptor->cost_class < due->descriptor->cost_class ||
+                    (collector->descriptor->cost_class == due->descriptor->cost_class &&
+                     collector->nextRun < due->nextRun)) {
+                    due = collector.get();
+                }
+            }
+
+            if (due) {
+                runCollector(*due);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(wakeMutex_);
+            wakeCondition_.wait_until(lock, nextWake, [this]() { return !running_; });
+
+        } catch (const std::exception& e) {
+            // Log error but continue
+            std::this_thread::sleep_for(std::chrono::seconds(1));
+        }
+    }
+}
+
+void CollectorRegistry::runCollector(Collector& collector) {
+    Runner& runner = *runner_;
+    uint64_t timestampMs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+    {
+        std::lock_guard<std::mutex> lock(runner.mutex);
+        runner.descriptor = collector.descriptor;
+        runner.instance = collector.instance;
+        runner.info = collector.info;
+        runner.timestampMs = timestampMs;
+        runner.samples.clear();
+        runner.done = false;
+        runner.pending = true;
+    }
+    runner.condition.notify_all();
+
+    Watchdog& watchdog = Watchdog::getInstance();
+    const std::string job = jobName(collector);
+    watchdog.beginRun(job);
+
+    auto started = std::chrono::steady_clock::now();
+    int result = -1;
+    bool completed = false;
+    std::vector<MetricSample> samples;
+    {
+        std::unique_lock<std::mutex> lock(runner.mutex);
+        completed = runner.condition.wait_until(lock, started + collector.deadline,
+                                                [&runner]() { return runner.done; });
+        if (completed) {
+            result = runner.result;
+            samples.swap(runner.samples);
+        } else {
+            runner.abandoned = true;
+            runner.collector = &collector;
+        }
+    }
+    auto finished = std::chrono::steady_clock::now();
+    watchdog.endRun(job, completed && result == 0);
+
+    if (!completed) {
+        // The hung call keeps its runner; the collector sits out until it
+        // returns and the others carry on with a fresh runner
+        {
+            std::unique_lock<std::shared_mutex> lock(dataMutex_);
+            collector.info.runs++;
+            collector.info.failures++;
+            collector.info.timeouts++;
+            collector.info.lastRunMs = std::chrono::duration<double, std::milli>(finished - started).count();
+            collector.info.isQuarantined = true;
+        }
+        watchdog.setQuarantined(job, true);
+        quarantined_.push_back(runner_);
+        runner_ = createRunner();
+        return;
+    }
+
+    {
+        std::unique_lock<std::shared_mutex> lock(dataMutex_);
+
+        collector.info.runs++;
+        collector.info.lastRunMs = std::chrono::duration<double, std::milli>(finished - started).count();
+
+        if (result != 0) {
+            // Back off exponentially while a collector keeps failing
+            collector.info.failures++;
+            collector.consecutiveFailures = std::min<uint32_t>(collector.consecutiveFailures + 1, 16);
+            auto backoff = collector.interval * (1LL << std::min<uint32_t>(collector.consecutiveFailures, 10));
+            collector.nextRun = finished + std::min<std::chrono::milliseconds>(backoff, MAX_BACKOFF_INTERVAL);
+            return;
+        }
+
+        collector.consecutiveFailures = 0;
+        collector.nextRun = finished + collector.interval;
+        collector.latest = samples;
+
+        for (const auto& sample : samples) {
+            auto& series = collector.history[seriesKey(sample.metric, sample.instance)];
+            series.push_back(sample);
+            while (series.size() > historySize_) {
+                series.pop_front();
+            }
+        }
+
+        // Instances that vanished (exited processes, removed disks) are
+        // dropped once the series count gets out of hand
+        if (collector.history.size() > MAX_SERIES_PER_COLLECTOR) {
+            for (auto it = collector.history.begin(); it != collector.history.end();) {
+                if (it->second.back().timestampMs < timestampMs) {
+                    it = collector.history.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+        }
+    }
+
+    if (sampleCallback_ && !samples.empty()) {
+        sampleCallback_(collector.info.name, samples);
+    }
+}
+
+void CollectorRegistry::releaseQuarantined() {
+    for (auto it = quarantined_.begin(); it != quarantined_.end();) {
+        Runner& runner = **it;
+        {
+            std::lock_guard<std::mutex> lock(runner.mutex);
+            if (!runner.done) {
+                ++it;
+                continue;
+            }
+        }
+        runner.thread.join();
+
+        // Whatever the late call produced is stale by now and is dropped
+        Collector& collector = *runner.collector;
+        {
+            std::unique_lock<std::shared_mutex> lock(dataMutex_);
+            collector.info.isQuarantined = false;
+            collector.nextRun = std::chrono::steady_clock::now() + collector.interval;
+        }
+        Watchdog::getInstance().setQuarantined(jobName(collector), false);
+        it = quarantined_.erase(it);
+    }
+}
+
+std::shared_ptr<CollectorRegistry::Runner> CollectorRegistry::createRunner() {
+    auto runner = std::make_shared<Runner>();
+    runner->thread = std::thread(&CollectorRegistry::runnerThread, runner);
+    return runner;
+}
+
+void CollectorRegistry::runnerThread(std::shared_ptr<Runner> runner) {
+    std::unique_lock<std::mutex> lock(runner->mutex);
+    while (true) {
+        runner->condition.wait(lock, [&runner]() { return runner->pending || runner->exit; });
+        if (!runner->pending) {
+            return;
+        }
+        runner->pending = false;
+        lock.unlock();
+
+        // Samples are only touched by this thread until done is set
+        sysmon_sample_sink sink{runner.get(), &CollectorRegistry::emitSample};
+        int result = -1;
+        try {
+            result = runner->descriptor->collect(runner->instance, &sink);
+        } catch (...) {
+            // Built-ins are C++; plugins must not throw across the ABI
+            result = -1;
+        }
+
+        lock.lock();
+        runner->result = result;
+        runner->done = true;
+        runner->condition.notify_all();
+        if (runner->abandoned) {
+            return;
+        }
+    }
+}
+
+void CollectorRegistry::emitSample(void* context, const char* metric, const char* instance, double value) {
+    auto* run = static_cast<Runner*>(context);
+    if (!run || !metric || run->samples.size() >= MAX_SAMPLES_PER_RUN) {
+        return;
+    }
+
+    // Only declared metrics are accepted, so clients can trust GET_COLLECTORS
+    const auto& metrics = run->info.metrics;
+    if (std::none_of(metrics.begin(), metrics.end(),
+                     [metric](const CollectorMetricInfo& info) { return info.name == metric; })) {
+        return;
+    }
+
+    MetricSample sample;
+    sample.collector = run->info.name;
+    sample.metric = metric;
+    sample.instance = instance ? instance : "";
+    sample.value = value;
+    sample.timestampMs = run->timestampMs;
+    sample.sanitize();
+    run->samples.push_back(sample);
+}
+
+bool CollectorRegistry::validateDescriptor(const sysmon_collector* descriptor) {
+    if (!descriptor || descriptor->abi_version != SYSMON_COLLECTOR_ABI_VERSION) {
+        return false;
+    }
+    if (!descriptor->name || !*descriptor->name || !descriptor->collect || !descriptor->create) {
+        return false;
+    }
+    if (descriptor->metric_count > 0 && !descriptor->metrics) {
+        return false;
+    }
+    for (uint32_t i = 0; i < descriptor->metric_count; ++i) {
+        if (!descriptor->metrics[i].name || !*descriptor->metrics[i].name) {
+            return false;
+        }
+    }
+
+    const std::string name = descriptor->name;
+    return std::all_of(name.begin(), name.end(), [](char c) {
+        return (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c == '_';
+    });
+}
+
+std::chrono::milliseconds CollectorRegistry::intervalFloor(int32_t costClass) {
+    switch (costClass) {
+        case SYSMON_COST_LOW: return std::chrono::milliseconds(100);
+        case SYSMON_COST_MEDIUM: return std::chrono::milliseconds(1000);
+        default: return std::chrono::milliseconds(5000);
+    }
+}
+
+std::string CollectorRegistry::costClassToString(int32_t costClass) {
+    switch (costClass) {
+        case SYSMON_COST_LOW: return "low";
+        case SYSMON_COST_MEDIUM: return "medium";
+        default: return "high";
+    }
+}
+
+std::string CollectorRegistry::jobName(const Collector& collector) {
+    return "collector." + collector.info.name;
+}
+
+std::string CollectorRegistry::seriesKey(const std::string& metric, const std::string& instance) {
+    std::string key = metric;
+    key += '\0';
+    key += instance;
+    return key;
+}
+
+} // namespace SysMon
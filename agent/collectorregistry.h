@@ -0,0 +1,136 @@
+#pragma once
+
+#include "../shared/systemtypes.h"
+#include "../shared/collectorapi.h"
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <condition_variable>
+#include <functional>
+#include <chrono>
+#include <deque>
+#include <map>
+
+namespace SysMon {
+
+// Collector Registry - loads collectors behind the C plugin ABI and runs
+// them on one scheduler thread
+//
+// Built-in and .so collectors share the sysmon_collector descriptor. Each
+// run's samples replace the collector's snapshot and are appended to a
+// bounded per-series history, so new data sources need no agent changes.
+//
+// collect() runs on a runner thread under a watchdog deadline. A run that
+// misses it is abandoned with its runner and the collector is quarantined
+// until that call returns, so one hung plugin cannot stall the others.
+class CollectorRegistry {
+public:
+    using ConfigProvider = std::function<std::string(const std::string& collectorName)>;
+    using SampleCallback = std::function<void(const std::string& collectorName,
+                                              const std::vector<MetricSample>& samples)>;
+
+    CollectorRegistry();
+    ~CollectorRegistry();
+
+    // Lifecycle
+    bool initialize();
+    bool start();
+    void stop();
+    void shutdown();
+
+    // Fallback mode
+    void enableFallbackMode(bool enable = true);
+    bool isFallbackMode() const;
+
+    // Registration (before start)
+    bool registerCollector(const sysmon_collector* descriptor, const std::string& source = "builtin");
+    size_t loadPlugins(const std::string& directory);
+
+    // Configuration
+    void setConfigProvider(ConfigProvider provider);
+    void setSampleCallback(SampleCallback callback);
+    void setHistorySize(size_t samples);
+
+    // Data access
+    std::vector<CollectorInfo> getCollectors() const;
+    std::vector<MetricSample> getSamples(const std::string& collectorName = "") const;
+    std::vector<MetricSample> getHistory(const std::string& collectorName, const std::string& metric,
+                                         const std::string& instance = "") const;
+
+private:
+    struct Collector {
+        const sysmon_collector* descriptor;
+        void* instance;
+        void* library;              // dlopen handle, null for built-ins
+        CollectorInfo info;
+        std::chrono::milliseconds interval;
+        std::chrono::milliseconds deadline;
+        std::chrono::steady_clock::time_point nextRun;
+        uint32_t consecutiveFailures;
+        std::vector<MetricSample> latest;
+        std::map<std::string, std::deque<MetricSample>> history;   // by metric + '\0' + instance
+    };
+
+    // One collect() call at a time; shared with the thread that runs it so
+    // an abandoned runner can outlive the registry
+    struct Runner {
+        std::thread thread;
+        std::mutex mutex;
+        std::condition_variable condition;
+        const sysmon_collector* descriptor = nullptr;
+        void* instance = nullptr;
+        CollectorInfo info;                 // copy, for emitSample()
+        uint64_t timestampMs = 0;
+        std::vector<MetricSample> samples;
+        int result = -1;
+        bool pending = false;
+        bool done = false;
+        bool abandoned = false;
+        bool exit = false;
+        Collector* collector = nullptr;     // set once abandoned
+    };
+
+    // Scheduler
+    void schedulerThread();
+    void runCollector(Collector& collector);
+    void releaseQuarantined();
+    std::shared_ptr<Runner> createRunner();
+    static void runnerThread(std::shared_ptr<Runner> runner);
+    static void emitSample(void* context, const char* metric, const char* instance, double value);
+    static std::string jobName(const Collector& collector);
+
+    // Helpers
+    static bool validateDescriptor(const sysmon_collector* descriptor);
+    static std::chrono::milliseconds intervalFloor(int32_t costClass);
+    static std::string costClassToString(int32_t costClass);
+    static std::string seriesKey(const std::string& metric, const std::string& instance);
+
+    // Thread management
+    std::atomic<bool> running_;
+    std::atomic<bool> initialized_;
+    std::atomic<bool> fallbackMode_;
+    std::thread schedulerThread_;
+    std::mutex wakeMutex_;
+    std::condition_variable wakeCondition_;
+    std::shared_ptr<Runner> runner_;
+    std::vector<std::shared_ptr<Runner>> quarantined_;
+
+    // Collectors; the list itself is fixed once the scheduler runs
+    std::vector<std::unique_ptr<Collector>> collectors_;
+    mutable std::shared_mutex dataMutex_;
+
+    // Configuration
+    ConfigProvider configProvider_;
+    SampleCallback sampleCallback_;
+    size_t historySize_;
+
+    // Constants
+    static constexpr size_t DEFAULT_HISTORY_SIZE = 120;
+    static constexpr size_t MAX_SAMPLES_PER_RUN = 4096;
+    static constexpr size_t MAX_SERIES_PER_COLLECTOR = 1024;
+    static constexpr std::chrono::milliseconds MAX_BACKOFF_INTERVAL{60000};
+};
+
+} // namespace SysMon
@@ -1,4 +1,5 @@
 #include "devicemanager.h"
+#include "../shared/procparsers.h"
 #include <thread>
 #include <chrono>
 #include <fstream>
@@ -12,6 +13,8 @@
 #ifndef _WIN32
 #include <libudev.h>
 #include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
 #include <sys/ioctl.h>
 #include <linux/usbdevice_fs.h>
 #else
@@ -23,10 +26,13 @@
 
 namespace SysMon {
 
+constexpr std::chrono::seconds DeviceManager::SCAN_INTERVAL;
+
 DeviceManager::DeviceManager() 
     : running_(false)
     , initialized_(false)
-    , fallbackMode_(false) {
+    , fallbackMode_(false)
+    , deauthorizeByDefault_(false) {
     
 #ifndef _WIN32
     udev_ = nullptr;
@@ -75,6 +81,9 @@ bool DeviceManager::start() {
         return true;
     }
     
+    // Devices plugged in before the agent started are judged once up front
+    applyPolicyToConnectedDevices();
+    
     running_ = true;
     monitoringThread_ = std::thread(&DeviceManager::deviceMonitoringThread, this);
     
@@ -96,6 +105,11 @@ void DeviceManager::stop() {
 void DeviceManager::shutdown() {
     stop();
     
+    // Don't leave ports closed once nothing enforces the policy
+    if (deauthorizeByDefault_) {
+        setDeauthorizeByDefault(false);
+    }
+    
 #ifndef _WIN32
     // Clean up udev resources
     if (udevMonitor_) {
@@ -162,27 +176,105 @@ bool DeviceManager::disableUsbDevice(const std::string& vid, const std::string&
 }
 
 bool DeviceManager::preventAutoConnect(const std::string& vid, const std::string& pid, bool prevent) {
-    std::unique_lock<std::shared_mutex> lock(devicesMutex_);
-    
-    if (prevent) {
-        preventedDevices_.push_back({vid, pid});
-    } else {
-        preventedDevices_.erase(
-            std::remove_if(preventedDevices_.begin(), preventedDevices_.end(),
-                [&vid, &pid](const auto& pair) {
-                    return pair.first == vid && pair.second == pid;
-                }),
-            preventedDevices_.end());
+    // Prevention is a VID:PID deny rule; it takes effect on the next plug-in
+    // and for matching devices that are already connected
+    UsbPolicyRule rule;
+    rule.id = "prevent-" + vid + "-" + pid;
+    rule.allow = false;
+    rule.vid = vid;
+    rule.pid = pid;
+    rule.sanitize();
+    
+    if (!prevent) {
+        // Re-authorize the devices the rule had blocked
+        if (policy_.removeRule(rule.id)) {
+            applyPolicyToConnectedDevices();
+        }
+        return true;
     }
     
+    if (!policy_.addRule(rule)) {
+        return false;
+    }
+    applyPolicyToConnectedDevices();
+    return true;
+}
+
+bool DeviceManager::addPolicyRule(const UsbPolicyRule& rule) {
+    if (!policy_.addRule(rule)) {
+        return false;
+    }
+    applyPolicyToConnectedDevices();
+    return true;
+}
+
+bool DeviceManager::removePolicyRule(const std::string& ruleId) {
+    if (!policy_.removeRule(ruleId)) {
+        return false;
+    }
+    applyPolicyToConnectedDevices();
     return true;
 }
 
+std::vector<UsbPolicyRule> DeviceManager::getPolicyRules() const {
+    return policy_.getRules();
+}
+
+void DeviceManager::setDefaultPolicy(bool allow) {
+    policy_.setDefaultAllow(allow);
+}
+
+bool DeviceManager::isDefaultPolicyAllow() const {
+    return policy_.isDefaultAllow();
+}
+
+bool DeviceManager::setDeauthorizeByDefault(bool deauthorize) {
+    // With authorized_default=0 new devices come up unconfigured, so no driver
+    // binds before the policy has been evaluated
+    if (!writeAuthorizedDefault(!deauthorize)) {
+        return false;
+    }
+    deauthorizeByDefault_ = deauthorize;
+    return true;
+}
+
+bool DeviceManager::isDeauthorizeByDefault() const {
+    return deauthorizeByDefault_;
+}
+
+void DeviceManager::setPolicyEventCallback(PolicyEventCallback callback) {
+    std::lock_guard<std::mutex> lock(callbackMutex_);
+    policyEventCallback_ = std::move(callback);
+}
+
 void DeviceManager::deviceMonitoringThread() {
+    auto nextScan = std::chrono::steady_clock::now();
+    
     while (running_) {
         try {
-            scanUsbDevices();
-            std::this_thread::sleep_for(std::chrono::seconds(5));
+            auto now = std::chrono::steady_clock::now();
+            if (now >= nextScan) {
+                scanUsbDevices();
+                nextScan = now + SCAN_INTERVAL;
+            }
+            
+#ifndef _WIN32
+            // Plug-in events are handled as they arrive; the scan only refreshes the list
+            if (monitorFd_ >= 0) {
+                auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    nextScan - std::chrono::steady_clock::now());
+                pollfd pfd;
+                pfd.fd = monitorFd_;
+                pfd.events = POLLIN;
+                pfd.revents = 0;
+                int timeout = static_cast<int>(std::min<long long>(500, std::max<long long>(0, remaining.count())));
+                if (poll(&pfd, 1, timeout) > 0) {
+                    processUdevEvents();
+                }
+                continue;
+            }
+#endif
+            std::this_thread::sleep_for(std::chrono::milliseconds(500));
             
         } catch (const std::exception& e) {
             // Log error but continue
@@ -222,33 +314,12 @@ std::vector<UsbDevice> DeviceManager::scanUsbDevicesLinux() {
         
         std::string device_path = "/sys/bus/usb/devices/" + std::string(entry->d_name);
         
-        // Read vendor ID
-        std::ifstream vid_file(device_path + "/idVendor");
-        std::string vid;
-        if (vid_file.is_open()) {
-            std::getline(vid_file, vid);
-        }
-        
-        // Read product ID
-        std::ifstream pid_file(device_path + "/idProduct");
-        std::string pid;
-        if (pid_file.is_open()) {
-            std::getline(pid_file, pid);
-        }
-        
-        // Read manufacturer
-        std::ifstream man_file(device_path + "/manufacturer");
-        std::string manufacturer;
-        if (man_file.is_open()) {
-            std::getline(man_file, manufacturer);
-        }
-        
-        // Read product
-        std::ifstream prod_file(device_path + "/product");
-        std::string product;
-        if (prod_file.is_open()) {
-            std::getline(prod_file, product);
-        }
+        // Read vendor and product IDs, manufacturer and product
+        std::string vid, pid, manufacturer, product;
+        ProcParsers::readAttribute(device_path + "/idVendor", vid);
+        ProcParsers::readAttribute(device_path + "/idProduct", pid);
+        ProcParsers::readAttribute(device_path + "/manufacturer", manufacturer);
+        ProcParsers::readAttribute(device_path + "/product", product);
         
         if (!vid.empty() && !pid.empty()) {
             UsbDevice device;
@@ -363,18 +434,12 @@ bool DeviceManager::enableUsbDeviceLinux(const std::string& vid, const std::stri
         
         std::string path = "/sys/bus/usb/devices/" + std::string(entry->d_name);
         
-        std::ifstream vid_file(path + "/idVendor");
-        std::ifstream pid_file(path + "/idProduct");
-        
-        if (vid_file.is_open() && pid_file.is_open()) {
-            std::string device_vid, device_pid;
-            std::getline(vid_file, device_vid);
-            std::getline(pid_file, device_pid);
-            
-            if (device_vid == vid && device_pid == pid) {
-                device_path = path;
-                break;
-            }
+        std::string device_vid, device_pid;
+        if (ProcParsers::readAttribute(path + "/idVendor", device_vid) &&
+            ProcParsers::readAttribute(path + "/idProduct", device_pid) &&
+            device_vid == vid && device_pid == pid) {
+            device_path = path;
+            break;
         }
     }
     closedir(usb_dir);
@@ -477,18 +542,12 @@ bool DeviceManager::disableUsbDeviceLinux(const std::string& vid, const std::str
         
         std::string path = "/sys/bus/usb/devices/" + std::string(entry->d_name);
         
-        std::ifstream vid_file(path + "/idVendor");
-        std::ifstream pid_file(path + "/idProduct");
-        
-        if (vid_file.is_open() && pid_file.is_open()) {
-            std::string device_vid, device_pid;
-            std::getline(vid_file, device_vid);
-            std::getline(pid_file, device_pid);
-            
-            if (device_vid == vid && device_pid == pid) {
-                device_path = path;
-                break;
-            }
+        std::string device_vid, device_pid;
+        if (ProcParsers::readAttribute(path + "/idVendor", device_vid) &&
+            ProcParsers::readAttribute(path + "/idProduct", device_pid) &&
+            device_vid == vid && device_pid == pid) {
+            device_path = path;
+            break;
         }
     }
     closedir(usb_dir);
@@ -575,22 +634,211 @@ bool DeviceManager::disableUsbDeviceWindows(const std::string& vid, const std::s
 }
 
 void DeviceManager::handleDeviceConnect(const UsbDevice& device) {
-    // Check if this device is in the prevented list
-    std::shared_lock<std::shared_mutex> lock(devicesMutex_);
+    // Fallback for platforms without per-device sysfs paths: VID:PID and serial only
+    UsbPolicyDevice policyDevice;
+    policyDevice.vid = device.vid;
+    policyDevice.pid = device.pid;
+    policyDevice.serialNumber = device.serialNumber;
+    std::transform(policyDevice.vid.begin(), policyDevice.vid.end(), policyDevice.vid.begin(), ::tolower);
+    std::transform(policyDevice.pid.begin(), policyDevice.pid.end(), policyDevice.pid.begin(), ::tolower);
     
-    for (const auto& prevented : preventedDevices_) {
-        if (prevented.first == device.vid && prevented.second == device.pid) {
-            // Device is prevented, disable it
-            lock.unlock();
-            disableUsbDevice(device.vid, device.pid);
-            return;
-        }
+    if (!policy_.evaluate(policyDevice).allow) {
+        disableUsbDevice(device.vid, device.pid);
     }
     
     // Device is allowed, add to the list
     // The scanUsbDevices() function will handle the actual addition
 }
 
+#ifndef _WIN32
+void DeviceManager::processUdevEvents() {
+    struct udev_device* device;
+    while ((device = udev_monitor_receive_device(udevMonitor_)) != nullptr) {
+        const char* action = udev_device_get_action(device);
+        const char* devtype = udev_device_get_devtype(device);
+        const char* syspath = udev_device_get_syspath(device);
+        
+        // Interfaces ("usb_interface") inherit the device's authorization
+        if (action && devtype && syspath && strcmp(action, "add") == 0 && strcmp(devtype, "usb_device") == 0) {
+            applyPolicy(syspath, true);
+        }
+        
+        udev_device_unref(device);
+    }
+}
+
+void DeviceManager::applyPolicy(const std::string& devicePath, bool isHotplug) {
+    UsbPolicyDevice device;
+    if (!readPolicyDevice(devicePath, device)) {
+        return;
+    }
+    
+    UsbPolicyEvent event;
+    event.devicePath = devicePath;
+    event.decision = policy_.evaluate(device);
+    event.device = std::move(device);
+    
+    // Allowed devices only need a write when ports start out deauthorized
+    std::string current;
+    bool authorized = !ProcParsers::readAttribute(devicePath + "/authorized", current) || current != "0";
+    bool changed = authorized != event.decision.allow;
+    event.applied = !changed || writeAuthorized(devicePath, event.decision.allow);
+    
+    // Plug-ins of blocked devices are always reported; re-evaluations only on change
+    if (!changed && (event.decision.allow || !isHotplug)) {
+        return;
+    }
+    
+    std::lock_guard<std::mutex> lock(callbackMutex_);
+    if (policyEventCallback_) {
+        policyEventCallback_(event);
+    }
+}
+
+void DeviceManager::applyPolicyToConnectedDevices() {
+    DIR* usb_dir = opendir("/sys/bus/usb/devices/");
+    if (!usb_dir) {
+        return;
+    }
+    
+    std::vector<std::string> devicePaths;
+    struct dirent* entry;
+    while ((entry = readdir(usb_dir)) != nullptr) {
+        // Interfaces are named "1-2:1.0"; root hubs "usb1" are never blocked
+        if (entry->d_name[0] == '.' || strchr(entry->d_name, ':') || strncmp(entry->d_name, "usb", 3) == 0) {
+            continue;
+        }
+        devicePaths.push_back("/sys/bus/usb/devices/" + std::string(entry->d_name));
+    }
+    closedir(usb_dir);
+    
+    for (const auto& devicePath : devicePaths) {
+        applyPolicy(devicePath, false);
+    }
+}
+
+bool DeviceManager::readPolicyDevice(const std::string& devicePath, UsbPolicyDevice& device) const {
+    if (!ProcParsers::readAttribute(devicePath + "/idVendor", device.vid) ||
+        !ProcParsers::readAttribute(devicePath + "/idProduct", device.pid)) {
+        return false;
+    }
+    ProcParsers::readAttribute(devicePath + "/serial", device.serialNumber);
+    
+    // Interface classes come from the raw descriptors, which are available
+    // even while the device is deauthorized and has no interfaces bound
+    int fd = open((devicePath + "/descriptors").c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        std::string deviceClass;
+        if (ProcParsers::readAttribute(devicePath + "/bDeviceClass", deviceClass)) {
+            device.classes.push_back(deviceClass);
+        }
+        return true;
+    }
+    
+    unsigned char descriptors[4096];
+    ssize_t length = read(fd, descriptors, sizeof(descriptors));
+    close(fd);
+    
+    auto addClass = [&device](unsigned char value) {
+        char hex[3];
+        snprintf(hex, sizeof(hex), "%02x", value);
+        if (std::find(device.classes.begin(), device.classes.end(), hex) == device.classes.end()) {
+            device.classes.push_back(hex);
+        }
+    };
+    
+    for (ssize_t offset = 0; offset + 1 < length; ) {
+        unsigned char descriptorLength = descriptors[offset];
+        unsigned char descriptorType = descriptors[offset + 1];
+        if (descriptorLength < 2 || offset + descriptorLength > length) {
+            break;
+        }
+        // Device descriptor: bDeviceClass at 4 (0 = defined per interface)
+        if (descriptorType == 1 && descriptorLength >= 5 && descriptors[offset + 4] != 0) {
+            addClass(descriptors[offset + 4]);
+        }
+        // Interface descriptor: bInterfaceClass at 5
+        if (descriptorType == 4 && descriptorLength >= 6) {
+            addClass(descriptors[offset + 5]);
+        }
+        offset += descriptorLength;
+    }
+    
+    return true;
+}
+
+bool DeviceManager::writeAuthorized(const std::string& devicePath, bool authorized) const {
+    int fd = open((devicePath + "/authorized").c_str(), O_WRONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    bool success = write(fd, authorized ? "1" : "0", 1) == 1;
+    close(fd);
+    return success;
+}
+
+bool DeviceManager::writeAuthorizedDefault(bool authorized) const {
+    DIR* usb_dir = opendir("/sys/bus/usb/devices/");
+    if (!usb_dir) {
+        return false;
+    }
+    
+    bool found = false;
+    bool success = true;
+    struct dirent* entry;
+    while ((entry = readdir(usb_dir)) != nullptr) {
+        if (strncmp(entry->d_name, "usb", 3) != 0) {
+            continue;
+        }
+        
+        found = true;
+        std::string path = "/sys/bus/usb/devices/" + std::string(entry->d_name) + "/authorized_default";
+        int fd = open(path.c_str(), O_WRONLY | O_CLOEXEC);
+        if (fd < 0 || write(fd, authorized ? "1" : "0", 1) != 1) {
+            success = false;
+        }
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+    closedir(usb_dir);
+    
+    return found && success;
+}
+#else
+void DeviceManager::processUdevEvents() {
+}
+
+void DeviceManager::applyPolicy(const std::string& devicePath, bool isHotplug) {
+    (void)devicePath;
+    (void)isHotplug;
+}
+
+void DeviceManager::applyPolicyToConnectedDevices() {
+    for (const auto& device : scanUsbDevicesWindows()) {
+        handleDeviceConnect(device);
+    }
+}
+
+bool DeviceManager::readPolicyDevice(const std::string& devicePath, UsbPolicyDevice& device) const {
+    (void)devicePath;
+    (void)device;
+    return false;
+}
+
+bool DeviceManager::writeAuthorized(const std::string& devicePath, bool authorized) const {
+    (void)devicePath;
+    (void)authorized;
+    return false;
+}
+
+bool DeviceManager::writeAuthorizedDefault(bool authorized) const {
+    (void)authorized;
+    return false;
+}
+
+#endif
+
 void DeviceManager::handleDeviceDisconnect(const UsbDevice& device) {
     // Remove device from the list
     std::unique_lock<std::shared_mutex> lock(devicesMutex_);
@@ -611,7 +859,6 @@ void DeviceManager::enableFallbackMode() {
     // Clear device list in fallback mode
     std::lock_guard<std::shared_mutex> lock(devicesMutex_);
     usbDevices_.clear();
-    preventedDevices_.clear();
 }
 
 bool DeviceManager::isFallbackMode() const {
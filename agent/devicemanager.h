@@ -1,10 +1,13 @@
 #pragma once
 
 #include "../shared/systemtypes.h"
+#include "usbpolicy.h"
 #include <memory>
 #include <thread>
 #include <atomic>
 #include <shared_mutex>
+#include <functional>
+#include <mutex>
 
 #ifndef _WIN32
 #include <libudev.h>
@@ -15,6 +18,8 @@ namespace SysMon {
 // Device Manager - manages USB and other devices
 class DeviceManager {
 public:
+    using PolicyEventCallback = std::function<void(const UsbPolicyEvent&)>;
+    
     DeviceManager();
     ~DeviceManager();
     
@@ -34,6 +39,16 @@ public:
     bool disableUsbDevice(const std::string& vid, const std::string& pid);
     bool preventAutoConnect(const std::string& vid, const std::string& pid, bool prevent);
     
+    // USB authorization policy, enforced on plug-in
+    bool addPolicyRule(const UsbPolicyRule& rule);
+    bool removePolicyRule(const std::string& ruleId);
+    std::vector<UsbPolicyRule> getPolicyRules() const;
+    void setDefaultPolicy(bool allow);
+    bool isDefaultPolicyAllow() const;
+    bool setDeauthorizeByDefault(bool deauthorize);
+    bool isDeauthorizeByDefault() const;
+    void setPolicyEventCallback(PolicyEventCallback callback);
+    
     // Status
     bool isRunning() const;
 
@@ -54,6 +69,14 @@ private:
     void handleDeviceConnect(const UsbDevice& device);
     void handleDeviceDisconnect(const UsbDevice& device);
     
+    // Policy enforcement (Linux sysfs authorized flags)
+    void processUdevEvents();
+    void applyPolicy(const std::string& devicePath, bool isHotplug);
+    void applyPolicyToConnectedDevices();
+    bool readPolicyDevice(const std::string& devicePath, UsbPolicyDevice& device) const;
+    bool writeAuthorized(const std::string& devicePath, bool authorized) const;
+    bool writeAuthorizedDefault(bool authorized) const;
+    
     // Thread management
     std::thread monitoringThread_;
     std::atomic<bool> running_;
@@ -62,9 +85,14 @@ private:
     
     // Device storage
     std::vector<UsbDevice> usbDevices_;
-    std::vector<std::pair<std::string, std::string>> preventedDevices_; // VID,PID pairs
     mutable std::shared_mutex devicesMutex_;
     
+    // Policy
+    UsbPolicyEngine policy_;
+    PolicyEventCallback policyEventCallback_;
+    std::atomic<bool> deauthorizeByDefault_;
+    std::mutex callbackMutex_;
+    
     // Platform-specific data
 #ifdef _WIN32
     // Windows-specific handles and data
@@ -74,6 +102,9 @@ private:
     struct udev_monitor* udevMonitor_;
     int monitorFd_;
 #endif
+    
+    // Constants
+    static constexpr std::chrono::seconds SCAN_INTERVAL{5};
 };
 
 } // namespace SysMon
@@ -0,0 +1,457 @@
+#include "ebpfmonitor.h"
+#include "watchdog.h"
+#include <thread>
+#include <chrono>
+#include <cstring>
+#include <cstdio>
+#include <cstdarg>
+#include <algorithm>
+#include <mutex>
+
+#ifdef SYSMON_HAVE_LIBBPF
+#include <time.h>
+#include <bpf/libbpf.h>
+#include <bpf/bpf.h>
+#include "bpf/sysmon_bpf.h"
+#endif
+
+#ifndef SYSMON_EBPF_OBJECT_PATH
+#define SYSMON_EBPF_OBJECT_PATH "/usr/local/lib/sysmon/sysmon.bpf.o"
+#endif
+
+namespace SysMon {
+
+constexpr std::chrono::milliseconds EbpfMonitor::DEFAULT_UPDATE_INTERVAL;
+constexpr std::chrono::milliseconds EbpfMonitor::POLL_TIMEOUT;
+constexpr size_t EbpfMonitor::MAX_TASK_EVENTS;
+constexpr size_t EbpfMonitor::MAX_CALLBACKS_PER_SECOND;
+
+#ifdef SYSMON_HAVE_LIBBPF
+
+namespace {
+
+// libbpf debug output is very verbose; keep warnings and errors only
+int libbpfPrint(enum libbpf_print_level level, const char* format, va_list args) {
+    if (level == LIBBPF_DEBUG) {
+        return 0;
+    }
+    return vfprintf(stderr, format, args);
+}
+
+int64_t clockMs(clockid_t clock) {
+    timespec ts;
+    clock_gettime(clock, &ts);
+    return static_cast<int64_t>(ts.tv_sec) * 1000 + ts.tv_nsec / 1000000;
+}
+
+} // anonymous namespace
+
+#endif
+
+EbpfMonitor::EbpfMonitor()
+    : running_(false)
+    , initialized_(false)
+    , fallbackMode_(false)
+    , droppedEvents_(0)
+    , objectPath_(SYSMON_EBPF_OBJECT_PATH)
+    , object_(nullptr)
+    , ringBuffer_(nullptr)
+    , histogramFd_(-1)
+    , cpuCount_(0)
+    , monotonicToEpochMs_(0)
+    , callbacksInWindow_(0)
+    , updateInterval_(DEFAULT_UPDATE_INTERVAL) {
+}
+
+EbpfMonitor::~EbpfMonitor() {
+    shutdown();
+}
+
+bool EbpfMonitor::initialize() {
+    if (initialized_) {
+        return true;
+    }
+
+#ifndef SYSMON_HAVE_LIBBPF
+    // Built without libbpf (or not on Linux)
+    return false;
+#else
+    if (!loadObject()) {
+        unloadObject();
+        return false;
+    }
+
+    // Ring buffer timestamps are CLOCK_MONOTONIC
+    monotonicToEpochMs_ = clockMs(CLOCK_REALTIME) - clockMs(CLOCK_MONOTONIC);
+
+    // First read only establishes the baseline
+    readHistograms(previousSlots_, previousCounts_, previousTotals_);
+
+    initialized_ = true;
+    return true;
+#endif
+}
+
+void EbpfMonitor::shutdown() {
+    if (!initialized_) {
+        return;
+    }
+
+    running_ = false;
+
+    if (monitoringThread_.joinable()) {
+        monitoringThread_.join();
+    }
+
+    unloadObject();
+
+    initialized_ = false;
+}
+
+bool EbpfMonitor::start() {
+    if (!initialized_) {
+        return false;
+    }
+
+    if (running_ || fallbackMode_) {
+        return true;
+    }
+
+    Watchdog::getInstance().registerJob("ebpf", updateInterval_);
+
+    running_ = true;
+    monitoringThread_ = std::thread(&EbpfMonitor::monitoringThread, this);
+
+    return true;
+}
+
+void EbpfMonitor::stop() {
+    running_ = false;
+
+    if (monitoringThread_.joinable()) {
+        monitoringThread_.join();
+    }
+
+    Watchdog::getInstance().unregisterJob("ebpf");
+}
+
+void EbpfMonitor::monitoringThread() {
+    auto nextUpdate = std::chrono::steady_clock::now() + updateInterval_;
+
+    while (running_) {
+        try {
+            auto now = std::chrono::steady_clock::now();
+            if (now >= nextUpdate) {
+                Watchdog::RunGuard guard("ebpf");
+                updateHistograms();
+                nextUpdate = now + updateInterval_;
+            }
+
+            // Wait for exec/exit records until the next histogram read
+            auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                nextUpdate - std::chrono::steady_clock::now());
+            remaining = std::max(std::chrono::milliseconds(1), std::min(remaining, POLL_TIMEOUT));
+#ifdef SYSMON_HAVE_LIBBPF
+            if (ringBuffer_) {
+                ring_buffer__poll(ringBuffer_, static_cast<int>(remaining.count()));
+                continue;
+            }
+#endif
+            std::this_thread::sleep_for(remaining);
+
+        } catch (const std::exception& e) {
+            // Log error but continue
+            std::this_thread::sleep_for(std::chrono::seconds(1));
+        }
+    }
+}
+
+void EbpfMonitor::updateHistograms() {
+    std::vector<std::vector<uint64_t>> slots;
+    std::vector<uint64_t> counts;
+    std::vector<uint64_t> totals;
+    if (!readHistograms(slots, counts, totals)) {
+        return;
+    }
+
+    // The map holds totals since load; report the last interval only
+    std::vector<RunQueueLatencyInfo> cpus;
+    std::vector<uint64_t> allBuckets;
+    uint64_t allCount = 0;
+    uint64_t allTotalUs = 0;
+    for (size_t cpu = 0; cpu < slots.size(); ++cpu) {
+        bool hasPrevious = cpu < previousSlots_.size();
+        std::vector<uint64_t> buckets(slots[cpu].size());
+        for (size_t slot = 0; slot < buckets.size(); ++slot) {
+            uint64_t previous = hasPrevious ? previousSlots_[cpu][slot] : 0;
+            buckets[slot] = slots[cpu][slot] - std::min(slots[cpu][slot], previous);
+        }
+        uint64_t count = counts[cpu] - std::min(counts[cpu], hasPrevious ? previousCounts_[cpu] : 0);
+        uint64_t totalUs = totals[cpu] - std::min(totals[cpu], hasPrevious ? previousTotals_[cpu] : 0);
+
+        allBuckets.resize(std::max(allBuckets.size(), buckets.size()), 0);
+        for (size_t slot = 0; slot < buckets.size(); ++slot) {
+            allBuckets[slot] += buckets[slot];
+        }
+        allCount += count;
+        allTotalUs += totalUs;
+
+        // CPUs that never ran anything (offline or not present) are left out
+        if (counts[cpu] > 0) {
+            cpus.push_back(makeLatency(static_cast<uint32_t>(cpu), buckets, count, totalUs));
+        }
+    }
+
+    previousSlots_.swap(slots);
+    previousCounts_.swap(counts);
+    previousTotals_.swap(totals);
+
+    std::unique_lock<std::shared_mutex> lock(dataMutex_);
+    cpuLatency_ = std::move(cpus);
+    totalLatency_ = makeLatency(0, allBuckets, allCount, allTotalUs);
+}
+
+RunQueueLatencyInfo EbpfMonitor::makeLatency(uint32_t cpu, const std::vector<uint64_t>& buckets,
+                                             uint64_t count, uint64_t totalUs) {
+    RunQueueLatencyInfo latency;
+    latency.cpu = cpu;
+    latency.buckets = buckets;
+    latency.count = count;
+    latency.averageUs = count > 0 ? static_cast<double>(totalUs) / static_cast<double>(count) : 0.0;
+
+    // Percentiles resolve to the upper edge of a log2 bucket
+    uint64_t seen = 0;
+    bool hasP50 = false;
+    for (size_t slot = 0; slot < buckets.size() && count > 0; ++slot) {
+        seen += buckets[slot];
+        double upperEdge = static_cast<double>(uint64_t(1) << (slot + 1));
+        if (!hasP50 && seen * 2 >= count) {
+            latency.p50Us = upperEdge;
+            hasP50 = true;
+        }
+        if (seen * 100 >= count * 99) {
+            latency.p99Us = upperEdge;
+            break;
+        }
+    }
+
+    latency.sanitize();
+    return latency;
+}
+
+bool EbpfMonitor::readHistograms(std::vector<std::vector<uint64_t>>& slots,
+                                 std::vector<uint64_t>& counts, std::vector<uint64_t>& totals) const {
+#ifdef SYSMON_HAVE_LIBBPF
+    if (histogramFd_ < 0 || cpuCount_ <= 0) {
+        return false;
+    }
+
+    // A per-CPU array lookup returns one value per possible CPU
+    std::vector<sysmon_rq_hist> values(static_cast<size_t>(cpuCount_));
+    uint32_t key = 0;
+    if (bpf_map_lookup_elem(histogramFd_, &key, values.data()) != 0) {
+        return false;
+    }
+
+    slots.assign(values.size(), std::vector<uint64_t>(SYSMON_RQ_SLOTS, 0));
+    counts.assign(values.size(), 0);
+    totals.assign(values.size(), 0);
+    for (size_t cpu = 0; cpu < values.size(); ++cpu) {
+        std::copy(values[cpu].slots, values[cpu].slots + SYSMON_RQ_SLOTS, slots[cpu].begin());
+        counts[cpu] = values[cpu].count;
+        totals[cpu] = values[cpu].total_us;
+    }
+    return true;
+#else
+    (void)slots;
+    (void)counts;
+    (void)totals;
+    return false;
+#endif
+}
+
+int EbpfMonitor::onRingBufferEvent(void* context, void* data, size_t size) {
+    static_cast<EbpfMonitor*>(context)->handleTaskEvent(data, size);
+    return 0;
+}
+
+void EbpfMonitor::handleTaskEvent(const void* data, size_t size) {
+#ifdef SYSMON_HAVE_LIBBPF
+    if (size < sizeof(sysmon_task_event)) {
+        return;
+    }
+
+    sysmon_task_event record;
+    memcpy(&record, data, sizeof(record));
+
+    TaskTraceEvent event;
+    event.type = record.type == SYSMON_TASK_EXEC ? "exec" : "exit";
+    event.pid = record.pid;
+    event.parentPid = record.ppid;
+    event.uid = record.uid;
+    event.name.assign(record.comm, strnlen(record.comm, sizeof(record.comm)));
+    event.filename.assign(record.filename, strnlen(record.filename, sizeof(record.filename)));
+    if (record.type == SYSMON_TASK_EXIT) {
+        // exit_code holds the wait status: exit status in bits 8-15, signal in 0-6
+        int signal = record.exit_code & 0x7f;
+        event.exitCode = signal != 0 ? -signal : (record.exit_code >> 8) & 0xff;
+        event.lifetimeMs = record.duration_ns / 1000000;
+    }
+    event.timestamp = static_cast<uint64_t>(monotonicToEpochMs_ + static_cast<int64_t>(record.timestamp_ns / 1000000));
+    event.sanitize();
+
+    {
+        std::unique_lock<std::shared_mutex> lock(dataMutex_);
+        taskEvents_.push_back(event);
+        if (taskEvents_.size() > MAX_TASK_EVENTS) {
+            taskEvents_.pop_front();
+        }
+    }
+
+    if (!taskEventCallback_) {
+        return;
+    }
+
+    // Exec storms (builds, shell loops) must not flood the client event path
+    auto now = std::chrono::steady_clock::now();
+    if (now - callbackWindow_ >= std::chrono::seconds(1)) {
+        callbackWindow_ = now;
+        callbacksInWindow_ = 0;
+    }
+    if (callbacksInWindow_ >= MAX_CALLBACKS_PER_SECOND) {
+        droppedEvents_++;
+        return;
+    }
+    callbacksInWindow_++;
+    taskEventCallback_(event);
+#else
+    (void)data;
+    (void)size;
+#endif
+}
+
+bool EbpfMonitor::loadObject() {
+#ifdef SYSMON_HAVE_LIBBPF
+    libbpf_set_print(libbpfPrint);
+
+    object_ = bpf_object__open_file(objectPath_.c_str(), nullptr);
+    if (!object_ || libbpf_get_error(object_)) {
+        object_ = nullptr;
+        return false;
+    }
+
+    // Fails without privileges, BTF or a new enough kernel
+    if (bpf_object__load(object_) != 0) {
+        return false;
+    }
+
+    bpf_program* program = nullptr;
+    bpf_object__for_each_program(program, object_) {
+        bpf_link* link = bpf_program__attach(program);
+        if (!link || libbpf_get_error(link)) {
+            return false;
+        }
+        links_.push_back(link);
+    }
+
+    histogramFd_ = bpf_object__find_map_fd_by_name(object_, "rq_hist");
+    int eventsFd = bpf_object__find_map_fd_by_name(object_, "task_events");
+    cpuCount_ = libbpf_num_possible_cpus();
+    if (histogramFd_ < 0 || eventsFd < 0 || cpuCount_ <= 0) {
+        return false;
+    }
+
+    ringBuffer_ = ring_buffer__new(eventsFd, &EbpfMonitor::onRingBufferEvent, this, nullptr);
+    if (!ringBuffer_ || libbpf_get_error(ringBuffer_)) {
+        ringBuffer_ = nullptr;
+        return false;
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+void EbpfMonitor::unloadObject() {
+#ifdef SYSMON_HAVE_LIBBPF
+    if (ringBuffer_) {
+        ring_buffer__free(ringBuffer_);
+        ringBuffer_ = nullptr;
+    }
+    for (auto* link : links_) {
+        bpf_link__destroy(link);
+    }
+    links_.clear();
+    if (object_) {
+        bpf_object__close(object_);
+        object_ = nullptr;
+    }
+#endif
+    histogramFd_ = -1;
+}
+
+void EbpfMonitor::setObjectPath(const std::string& path) {
+    objectPath_ = path;
+}
+
+void EbpfMonitor::setUpdateInterval(std::chrono::milliseconds interval) {
+    updateInterval_ = interval;
+}
+
+std::chrono::milliseconds EbpfMonitor::getUpdateInterval() const {
+    return updateInterval_;
+}
+
+void EbpfMonitor::setTaskEventCallback(TaskEventCallback callback) {
+    taskEventCallback_ = std::move(callback);
+}
+
+std::vector<RunQueueLatencyInfo> EbpfMonitor::getRunQueueLatency() const {
+    std::shared_lock<std::shared_mutex> lock(dataMutex_);
+    return cpuLatency_;
+}
+
+RunQueueLatencyInfo EbpfMonitor::getTotalRunQueueLatency() const {
+    std::shared_lock<std::shared_mutex> lock(dataMutex_);
+    return totalLatency_;
+}
+
+std::vector<TaskTraceEvent> EbpfMonitor::getTaskEvents(size_t limit) const {
+    // Newest first
+    std::shared_lock<std::shared_mutex> lock(dataMutex_);
+    size_t count = limit > 0 ? std::min(limit, taskEvents_.size()) : taskEvents_.size();
+    return std::vector<TaskTraceEvent>(taskEvents_.rbegin(), taskEvents_.rbegin() + static_cast<std::ptrdiff_t>(count));
+}
+
+uint64_t EbpfMonitor::getDroppedEvents() const {
+    return droppedEvents_;
+}
+
+bool EbpfMonitor::isRunning() const {
+    return running_;
+}
+
+bool EbpfMonitor::isSupported() {
+#ifdef SYSMON_HAVE_LIBBPF
+    return true;
+#else
+    return false;
+#endif
+}
+
+// Fallback mode support
+void EbpfMonitor::enableFallbackMode() {
+    fallbackMode_ = true;
+    initialized_ = true;
+
+    std::unique_lock<std::shared_mutex> lock(dataMutex_);
+    cpuLatency_.clear();
+    totalLatency_ = RunQueueLatencyInfo();
+    taskEvents_.clear();
+}
+
+bool EbpfMonitor::isFallbackMode() const {
+    return fallbackMode_;
+}
+
+} // namespace SysMon
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "../shared/systemtypes.h"
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <shared_mutex>
+#include <functional>
+#include <deque>
+
+struct bpf_object;
+struct bpf_link;
+struct ring_buffer;
+
+namespace SysMon {
+
+// eBPF Monitor - run-queue latency histograms per CPU and exec/exit tracing
+// (Linux only, optional)
+//
+// Loads the CO-RE object built from bpf/sysmon.bpf.c. Histograms are kept
+// in a per-CPU map and read as deltas each interval; exec and exit records
+// arrive through a ring buffer, so processes that live for a few
+// milliseconds are seen too. Built only when libbpf is found
+// (SYSMON_HAVE_LIBBPF) and loading needs root or CAP_BPF + CAP_PERFMON;
+// otherwise initialize() fails and the agent runs it in fallback mode.
+class EbpfMonitor {
+public:
+    using TaskEventCallback = std::function<void(const TaskTraceEvent&)>;
+
+    EbpfMonitor();
+    ~EbpfMonitor();
+
+    // Lifecycle
+    bool initialize();
+    bool start();
+    void stop();
+    void shutdown();
+
+    // Fallback mode support
+    void enableFallbackMode();
+    bool isFallbackMode() const;
+
+    // Configuration (before initialize)
+    void setObjectPath(const std::string& path);
+    void setUpdateInterval(std::chrono::milliseconds interval);
+    std::chrono::milliseconds getUpdateInterval() const;
+
+    // Called from the monitoring thread, at most MAX_CALLBACKS_PER_SECOND times
+    void setTaskEventCallback(TaskEventCallback callback);
+
+    // Data access
+    std::vector<RunQueueLatencyInfo> getRunQueueLatency() const;
+    RunQueueLatencyInfo getTotalRunQueueLatency() const;
+    std::vector<TaskTraceEvent> getTaskEvents(size_t limit) const;
+    uint64_t getDroppedEvents() const;
+
+    // Status
+    bool isRunning() const;
+    static bool isSupported();
+
+private:
+    // Monitoring thread
+    void monitoringThread();
+    void updateHistograms();
+    void handleTaskEvent(const void* data, size_t size);
+    static int onRingBufferEvent(void* context, void* data, size_t size);
+
+    // Helpers
+    bool loadObject();
+    void unloadObject();
+    bool readHistograms(std::vector<std::vector<uint64_t>>& slots,
+                        std::vector<uint64_t>& counts, std::vector<uint64_t>& totals) const;
+    static RunQueueLatencyInfo makeLatency(uint32_t cpu, const std::vector<uint64_t>& buckets,
+                                           uint64_t count, uint64_t totalUs);
+
+    // Thread management
+    std::thread monitoringThread_;
+    std::atomic<bool> running_;
+    std::atomic<bool> initialized_;
+    std::atomic<bool> fallbackMode_;
+
+    // Data storage
+    std::vector<RunQueueLatencyInfo> cpuLatency_;
+    RunQueueLatencyInfo totalLatency_;
+    std::deque<TaskTraceEvent> taskEvents_;
+    std::atomic<uint64_t> droppedEvents_;
+    mutable std::shared_mutex dataMutex_;
+
+    // libbpf state
+    std::string objectPath_;
+    bpf_object* object_;
+    std::vector<bpf_link*> links_;
+    ring_buffer* ringBuffer_;
+    int histogramFd_;
+    int cpuCount_;
+
+    // Monitoring thread state
+    TaskEventCallback taskEventCallback_;
+    std::vector<std::vector<uint64_t>> previousSlots_;
+    std::vector<uint64_t> previousCounts_;
+    std::vector<uint64_t> previousTotals_;
+    int64_t monotonicToEpochMs_;
+    std::chrono::steady_clock::time_point callbackWindow_;
+    size_t callbacksInWindow_;
+
+    // Timing
+    std::chrono::milliseconds updateInterval_;
+
+    // Constants
+    static constexpr std::chrono::milliseconds DEFAULT_UPDATE_INTERVAL{5000};
+    static constexpr std::chrono::milliseconds POLL_TIMEOUT{250};
+    static constexpr size_t MAX_TASK_EVENTS = 1024;
+    static constexpr size_t MAX_CALLBACKS_PER_SECOND = 100;
+};
+
+} // namespace SysMon
@@ -0,0 +1,396 @@
+#include "exeidentitycache.h"
+#include "../shared/security.h"
+#include <cstring>
+#include <cerrno>
+
+#ifndef _WIN32
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#endif
+
+namespace SysMon {
+
+#ifndef _WIN32
+namespace {
+
+uint64_t modificationTimeNs(const struct stat& st) {
+#ifdef __APPLE__
+    const struct timespec& mtime = st.st_mtimespec;
+#else
+    const struct timespec& mtime = st.st_mtim;
+#endif
+    return static_cast<uint64_t>(mtime.tv_sec) * 1000000000ULL + static_cast<uint64_t>(mtime.tv_nsec);
+}
+
+} // namespace
+#endif
+
+constexpr uint64_t ExecutableIdentityCache::IDENTITY_TTL_SCANS;
+constexpr uint64_t ExecutableIdentityCache::MAX_HASH_SIZE;
+constexpr size_t ExecutableIdentityCache::HASH_CHUNK_SIZE;
+
+bool ExecutableIdentityCache::FileKey::operator==(const FileKey& other) const {
+    return device == other.device && inode == other.inode && mtimeNs == other.mtimeNs && size == other.size;
+}
+
+size_t ExecutableIdentityCache::FileKeyHash::operator()(const FileKey& key) const {
+    uint64_t hash = key.inode * 0x9e3779b97f4a7c15ULL;
+    hash ^= key.device + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+    hash ^= key.mtimeNs + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+    hash ^= key.size + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+    return static_cast<size_t>(hash);
+}
+
+ExecutableIdentityCache::ExecutableIdentityCache()
+    : scan_(0)
+    , nextId_(1)
+    , running_(false)
+    , hashing_(false)
+    , hashingEnabled_(true) {
+}
+
+ExecutableIdentityCache::~ExecutableIdentityCache() {
+    stop();
+}
+
+bool ExecutableIdentityCache::start() {
+    if (running_) {
+        return true;
+    }
+
+    running_ = true;
+    if (hashingEnabled_ && Security::Sha256::isAvailable()) {
+        hashing_ = true;
+        // Identities found before start still need their hash
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex_);
+            std::lock_guard<std::mutex> queueLock(queueMutex_);
+            hashQueue_.clear();
+            for (const auto& entry : identities_) {
+                if (entry.second.identity.sha256.empty() && entry.second.identity.hashError.empty()) {
+                    hashQueue_.push_back(entry.first);
+                }
+            }
+        }
+        hashThread_ = std::thread(&ExecutableIdentityCache::hashThread, this);
+    }
+    return true;
+}
+
+void ExecutableIdentityCache::stop() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        running_ = false;
+        hashing_ = false;
+        hashQueue_.clear();
+    }
+    queueCondition_.notify_all();
+
+    if (hashThread_.joinable()) {
+        hashThread_.join();
+    }
+}
+
+void ExecutableIdentityCache::setHashingEnabled(bool enabled) {
+    hashingEnabled_ = enabled;
+}
+
+void ExecutableIdentityCache::beginScan() {
+    ++scan_;
+}
+
+uint32_t ExecutableIdentityCache::resolve(uint32_t pid, uint64_t startTime, const std::string& comm,
+                                          std::string& executable) {
+    // stat() through the link reaches the inode the process runs, even when
+    // the path has since been replaced or deleted
+    std::string link = "/proc/" + std::to_string(pid) + "/exe";
+    FileKey key{0, 0, 0, 0};
+    bool hasKey = statExecutable(link, key);
+
+    // Same pid, start time, comm and file: same process image as last scan
+    auto known = processes_.find(pid);
+    if (known != processes_.end() && known->second.startTime == startTime && known->second.comm == comm &&
+        known->second.hasKey == hasKey && (!hasKey || known->second.key == key)) {
+        known->second.lastSeenScan = scan_;
+        executable = known->second.executable;
+        return known->second.identityId;
+    }
+
+    ProcessEntry entry{startTime, comm, key, hasKey, 0, std::string(), scan_};
+#ifndef _WIN32
+    // Kernel threads and other users' processes may have no readable exe;
+    // the miss is remembered like any other result
+    if (hasKey) {
+        char target[4096];
+        ssize_t length = readlink(link.c_str(), target, sizeof(target) - 1);
+        if (length > 0) {
+            entry.executable.assign(target, static_cast<size_t>(length));
+            entry.identityId = lookupIdentity(pid, key, entry.executable);
+        }
+    }
+#endif
+
+    executable = entry.executable;
+    uint32_t id = entry.identityId;
+    processes_[pid] = std::move(entry);
+    return id;
+}
+
+void ExecutableIdentityCache::endScan() {
+    for (auto it = processes_.begin(); it != processes_.end();) {
+        if (it->second.lastSeenScan != scan_) {
+            it = processes_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    for (const auto& process : processes_) {
+        auto identity = identities_.find(process.second.identityId);
+        if (identity != identities_.end()) {
+            identity->second.lastSeenScan = scan_;
+            identity->second.hashPid = process.first;
+        }
+    }
+
+    // Binaries nobody has run for a while are forgotten; ids are never reused
+    for (auto it = identities_.begin(); it != identities_.end();) {
+        if (scan_ - it->second.lastSeenScan > IDENTITY_TTL_SCANS) {
+            const ExecutableIdentity& identity = it->second.identity;
+            keys_.erase(FileKey{identity.device, identity.inode, identity.mtimeNs, identity.size});
+            it = identities_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+std::vector<ExecutableIdentity> ExecutableIdentityCache::getIdentities() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    std::vector<ExecutableIdentity> identities;
+    identities.reserve(identities_.size());
+    for (const auto& entry : identities_) {
+        identities.push_back(entry.second.identity);
+    }
+    return identities;
+}
+
+bool ExecutableIdentityCache::getIdentity(uint32_t id, ExecutableIdentity& identity) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto it = identities_.find(id);
+    if (it == identities_.end()) {
+        return false;
+    }
+    identity = it->second.identity;
+    return true;
+}
+
+uint32_t ExecutableIdentityCache::lookupIdentity(uint32_t pid, const FileKey& key, const std::string& executable) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    auto existing = keys_.find(key);
+    if (existing != keys_.end()) {
+        return existing->second;
+    }
+
+    uint32_t id = nextId_++;
+    if (nextId_ == 0) {
+        nextId_ = 1;
+    }
+
+    Entry entry;
+    entry.identity.id = id;
+    entry.identity.path = executable;
+    entry.identity.device = key.device;
+    entry.identity.inode = key.inode;
+    entry.identity.size = key.size;
+    entry.identity.mtimeNs = key.mtimeNs;
+    entry.identity.sanitize();
+    entry.hashPid = pid;
+    entry.lastSeenScan = scan_;
+    keys_.emplace(key, id);
+    identities_.emplace(id, std::move(entry));
+    lock.unlock();
+
+    if (hashing_) {
+        {
+            std::lock_guard<std::mutex> queueLock(queueMutex_);
+            hashQueue_.push_back(id);
+        }
+        queueCondition_.notify_one();
+    }
+    return id;
+}
+
+void ExecutableIdentityCache::hashThread() {
+    lowerThreadPriority();
+
+    while (true) {
+        uint32_t id;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex_);
+            queueCondition_.wait(lock, [this] { return !running_ || !hashQueue_.empty(); });
+            if (!running_) {
+                break;
+            }
+            id = hashQueue_.front();
+            hashQueue_.pop_front();
+        }
+
+        uint32_t pid;
+        std::string path;
+        FileKey key;
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex_);
+            auto it = identities_.find(id);
+            if (it == identities_.end()) {
+                continue; // Evicted while queued
+            }
+            const ExecutableIdentity& identity = it->second.identity;
+            pid = it->second.hashPid;
+            path = identity.path;
+            key = FileKey{identity.device, identity.inode, identity.mtimeNs, identity.size};
+        }
+
+        std::string digest;
+        std::string error;
+        if (!hashExecutable(pid, path, key, digest, error) && !running_) {
+            break;
+        }
+
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        auto it = identities_.find(id);
+        if (it != identities_.end()) {
+            it->second.identity.sha256 = digest;
+            it->second.identity.hashError = error;
+            it->second.identity.sanitize();
+        }
+    }
+}
+
+bool ExecutableIdentityCache::hashExecutable(uint32_t pid, const std::string& path, const FileKey& key,
+                                             std::string& digest, std::string& error) const {
+#ifdef _WIN32
+    (void)pid;
+    (void)path;
+    (void)key;
+    (void)digest;
+    error = "Not supported on Windows";
+    return false;
+#else
+    if (key.size > MAX_HASH_SIZE) {
+        error = "File too large to hash";
+        return false;
+    }
+
+    // /proc/[pid]/exe opens the running image itself; the path is only a
+    // fallback once the process is gone, and must still be the same file
+    std::string link = "/proc/" + std::to_string(pid) + "/exe";
+    int fd = ::open(link.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd >= 0 && !sameFile(fd, key)) {
+        close(fd);
+        fd = -1;
+    }
+    if (fd < 0) {
+        fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            error = std::string("Cannot open executable: ") + std::strerror(errno);
+            return false;
+        }
+        if (!sameFile(fd, key)) {
+            close(fd);
+            error = "Executable changed before it could be hashed";
+            return false;
+        }
+    }
+
+#ifdef __linux__
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+
+    Security::Sha256 sha;
+    std::vector<char> buffer(HASH_CHUNK_SIZE);
+    bool success = true;
+    while (running_) {
+        ssize_t bytes = read(fd, buffer.data(), buffer.size());
+        if (bytes < 0 && errno == EINTR) {
+            continue;
+        }
+        if (bytes < 0) {
+            error = std::string("Read failed: ") + std::strerror(errno);
+            success = false;
+            break;
+        }
+        if (bytes == 0) {
+            break;
+        }
+        sha.update(buffer.data(), static_cast<size_t>(bytes));
+    }
+
+#ifdef __linux__
+    // Don't leave whole binaries in the page cache on our account
+    posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+#endif
+    close(fd);
+
+    if (!running_) {
+        return false;
+    }
+    if (success) {
+        digest = sha.finish();
+    }
+    return success;
+#endif
+}
+
+bool ExecutableIdentityCache::statExecutable(const std::string& path, FileKey& key) {
+#ifdef _WIN32
+    (void)path;
+    (void)key;
+    return false;
+#else
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0 || !S_ISREG(st.st_mode)) {
+        return false;
+    }
+    key.device = static_cast<uint64_t>(st.st_dev);
+    key.inode = static_cast<uint64_t>(st.st_ino);
+    key.mtimeNs = modificationTimeNs(st);
+    key.size = static_cast<uint64_t>(st.st_size);
+    return true;
+#endif
+}
+
+bool ExecutableIdentityCache::sameFile(int fd, const FileKey& key) {
+#ifdef _WIN32
+    (void)fd;
+    (void)key;
+    return false;
+#else
+    struct stat st;
+    return fstat(fd, &st) == 0 &&
+           static_cast<uint64_t>(st.st_dev) == key.device &&
+           static_cast<uint64_t>(st.st_ino) == key.inode &&
+           modificationTimeNs(st) == key.mtimeNs &&
+           static_cast<uint64_t>(st.st_size) == key.size;
+#endif
+}
+
+void ExecutableIdentityCache::lowerThreadPriority() {
+#ifdef __linux__
+    // Both apply to the calling thread only: nice 19 and the idle I/O class
+    static constexpr int IOPRIO_WHO_PROCESS = 1;
+    static constexpr int IOPRIO_CLASS_IDLE = 3;
+    static constexpr int IOPRIO_CLASS_SHIFT = 13;
+    setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), 19);
+    syscall(SYS_ioprio_set, IOPRIO_WHO_PROCESS, 0, IOPRIO_CLASS_IDLE << IOPRIO_CLASS_SHIFT);
+#endif
+}
+
+} // namespace SysMon
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "../shared/systemtypes.h"
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <condition_variable>
+#include <unordered_map>
+#include <deque>
+
+namespace SysMon {
+
+// Executable Identity Cache - maps processes to the binaries they run
+//
+// Each distinct executable file gets a small integer id, keyed by
+// (st_dev, st_ino, mtime, size) of /proc/[pid]/exe, so a binary replaced on
+// disk gets a new id while processes still running the old one keep theirs.
+// Processes are remembered by (pid, start time, comm) together with the file
+// key: a process seen in an earlier scan costs one stat() of its exe, and
+// only new processes, or ones that have exec'd another file since, pay for
+// the readlink(). Each identity is hashed (SHA-256) once on a background
+// thread running at idle CPU and I/O priority.
+//
+// resolve(), beginScan() and endScan() belong to the scanning thread; the
+// accessors may be called from any thread.
+class ExecutableIdentityCache {
+public:
+    ExecutableIdentityCache();
+    ~ExecutableIdentityCache();
+
+    // Lifecycle of the hashing thread
+    bool start();
+    void stop();
+
+    // Configuration (before start)
+    void setHashingEnabled(bool enabled);
+
+    // Scanning thread; resolve() returns 0 for kernel threads and processes
+    // whose exe is unreadable, and sets executable to the link target
+    void beginScan();
+    uint32_t resolve(uint32_t pid, uint64_t startTime, const std::string& comm, std::string& executable);
+    void endScan();
+
+    // Data access; pids are left empty
+    std::vector<ExecutableIdentity> getIdentities() const;
+    bool getIdentity(uint32_t id, ExecutableIdentity& identity) const;
+
+private:
+    struct FileKey {
+        uint64_t device;
+        uint64_t inode;
+        uint64_t mtimeNs;
+        uint64_t size;
+
+        bool operator==(const FileKey& other) const;
+    };
+
+    struct FileKeyHash {
+        size_t operator()(const FileKey& key) const;
+    };
+
+    struct Entry {
+        ExecutableIdentity identity;
+        uint32_t hashPid;           // a live process running it, for /proc/[pid]/exe
+        uint64_t lastSeenScan;
+    };
+
+    struct ProcessEntry {
+        uint64_t startTime;
+        std::string comm;
+        FileKey key;                // of /proc/[pid]/exe; execve keeps pid and start time
+        bool hasKey;
+        uint32_t identityId;
+        std::string executable;
+        uint64_t lastSeenScan;
+    };
+
+    // Hashing
+    void hashThread();
+    bool hashExecutable(uint32_t pid, const std::string& path, const FileKey& key,
+                        std::string& digest, std::string& error) const;
+    static bool statExecutable(const std::string& path, FileKey& key);
+    static bool sameFile(int fd, const FileKey& key);
+    static void lowerThreadPriority();
+
+    uint32_t lookupIdentity(uint32_t pid, const FileKey& key, const std::string& executable);
+
+    // Processes from the previous scans (scanning thread only)
+    std::unordered_map<uint32_t, ProcessEntry> processes_;
+    uint64_t scan_;
+
+    // Identities
+    std::unordered_map<FileKey, uint32_t, FileKeyHash> keys_;
+    std::unordered_map<uint32_t, Entry> identities_;
+    uint32_t nextId_;
+    mutable std::shared_mutex mutex_;
+
+    // Hash queue
+    std::thread hashThread_;
+    std::deque<uint32_t> hashQueue_;
+    std::mutex queueMutex_;
+    std::condition_variable queueCondition_;
+    std::atomic<bool> running_;
+    std::atomic<bool> hashing_;
+    bool hashingEnabled_;
+
+    // Constants
+    static constexpr uint64_t IDENTITY_TTL_SCANS = 30;      // keep ids of exited binaries this long
+    static constexpr uint64_t MAX_HASH_SIZE = 1ULL << 30;   // larger files are not hashed
+    static constexpr size_t HASH_CHUNK_SIZE = 1 << 20;
+};
+
+} // namespace SysMon
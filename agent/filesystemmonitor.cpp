@@ -0,0 +1,456 @@
+#include "filesystemmonitor.h"
+#include "watchdog.h"
+#include "../shared/procparsers.h"
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+#include <mutex>
+#include <cstring>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/statvfs.h>
+#endif
+
+namespace SysMon {
+
+constexpr std::chrono::milliseconds FilesystemMonitor::DEFAULT_UPDATE_INTERVAL;
+constexpr std::chrono::milliseconds FilesystemMonitor::POLL_SLICE;
+constexpr double FilesystemMonitor::FILL_RATE_SMOOTHING;
+
+FilesystemMonitor::FilesystemMonitor()
+    : running_(false)
+    , initialized_(false)
+    , fallbackMode_(false)
+    , mountInfoFd_(-1)
+    , updateInterval_(DEFAULT_UPDATE_INTERVAL) {
+}
+
+FilesystemMonitor::~FilesystemMonitor() {
+    shutdown();
+}
+
+bool FilesystemMonitor::initialize() {
+    if (initialized_) {
+        return true;
+    }
+
+#ifndef _WIN32
+    // mountinfo raises POLLPRI/POLLERR whenever the mount table changes
+    mountInfoFd_ = open("/proc/self/mountinfo", O_RDONLY | O_CLOEXEC);
+    if (mountInfoFd_ < 0) {
+        return false;
+    }
+
+    if (!reloadMountTableLinux()) {
+        close(mountInfoFd_);
+        mountInfoFd_ = -1;
+        return false;
+    }
+#endif
+
+    updateUsage();
+
+    initialized_ = true;
+    return true;
+}
+
+void FilesystemMonitor::shutdown() {
+    if (!initialized_) {
+        return;
+    }
+
+    running_ = false;
+
+    if (monitoringThread_.joinable()) {
+        monitoringThread_.join();
+    }
+
+#ifndef _WIN32
+    if (mountInfoFd_ >= 0) {
+        close(mountInfoFd_);
+        mountInfoFd_ = -1;
+    }
+#endif
+
+    initialized_ = false;
+}
+
+bool FilesystemMonitor::start() {
+    if (!initialized_) {
+        return false;
+    }
+
+    if (running_) {
+        return true;
+    }
+
+    // Nothing to sample in fallback mode
+    if (fallbackMode_) {
+        return true;
+    }
+
+    Watchdog::getInstance().registerJob("filesystem", updateInterval_);
+
+    running_ = true;
+    monitoringThread_ = std::thread(&FilesystemMonitor::monitoringThread, this);
+
+    return true;
+}
+
+void FilesystemMonitor::stop() {
+    running_ = false;
+
+    if (monitoringThread_.joinable()) {
+        monitoringThread_.join();
+    }
+
+    Watchdog::getInstance().unregisterJob("filesystem");
+}
+
+void FilesystemMonitor::monitoringThread() {
+    while (running_) {
+        try {
+            {
+                Watchdog::RunGuard guard("filesystem");
+                updateUsage();
+            }
+
+            // Sleep until the next sample, waking up early on mount changes
+            auto nextUpdate = lastUpdate_ + updateInterval_;
+            while (running_ && std::chrono::steady_clock::now() < nextUpdate) {
+                auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    nextUpdate - std::chrono::steady_clock::now());
+                remaining = std::max(std::chrono::milliseconds(1), std::min(remaining, POLL_SLICE));
+#ifdef _WIN32
+                std::this_thread::sleep_for(remaining);
+#else
+                if (waitForMountChangeLinux(remaining)) {
+                    reloadMountTableLinux();
+                    break;
+                }
+#endif
+            }
+
+        } catch (const std::exception& e) {
+            // Log error but continue
+            std::this_thread::sleep_for(std::chrono::seconds(1));
+        }
+    }
+}
+
+void FilesystemMonitor::updateUsage() {
+#ifdef _WIN32
+    std::vector<FilesystemInfo> filesystems = collectUsageWindows();
+#else
+    std::vector<FilesystemInfo> filesystems = collectUsageLinux();
+#endif
+
+    auto now = std::chrono::steady_clock::now();
+    std::map<std::string, UsageSample> currentSamples;
+    for (auto& info : filesystems) {
+        updateFillRate(info, now);
+        info.sanitize();
+        currentSamples[info.mountPoint] = previousSamples_[info.mountPoint];
+    }
+    // Drop samples of filesystems that are gone
+    previousSamples_.swap(currentSamples);
+
+    std::unique_lock<std::shared_mutex> lock(dataMutex_);
+    filesystems_ = std::move(filesystems);
+    lastUpdate_ = now;
+}
+
+void FilesystemMonitor::updateFillRate(FilesystemInfo& info, std::chrono::steady_clock::time_point now) {
+    auto it = previousSamples_.find(info.mountPoint);
+    if (it == previousSamples_.end()) {
+        previousSamples_[info.mountPoint] = {info.usedBytes, 0.0, now};
+        info.fillRate = 0.0;
+        info.timeToFull = -1.0;
+        return;
+    }
+
+    UsageSample& sample = it->second;
+    double elapsed = std::chrono::duration<double>(now - sample.timestamp).count();
+    if (elapsed > 0.0) {
+        double rate = (static_cast<double>(info.usedBytes) - static_cast<double>(sample.usedBytes)) / elapsed;
+        sample.fillRate = FILL_RATE_SMOOTHING * rate + (1.0 - FILL_RATE_SMOOTHING) * sample.fillRate;
+        sample.usedBytes = info.usedBytes;
+        sample.timestamp = now;
+    }
+
+    info.fillRate = sample.fillRate;
+    info.timeToFull = sample.fillRate > 0.0 ?
+        static_cast<double>(info.availableBytes) / sample.fillRate : -1.0;
+}
+
+#ifndef _WIN32
+
+bool FilesystemMonitor::reloadMountTableLinux() {
+    if (mountInfoFd_ < 0) {
+        return false;
+    }
+
+    // Re-reading from offset 0 also acknowledges the pending change event
+    std::string content;
+    if (!ProcParsers::readFile(mountInfoFd_, content)) {
+        return false;
+    }
+
+    mounts_ = parseMountInfo(content);
+    return true;
+}
+
+bool FilesystemMonitor::waitForMountChangeLinux(std::chrono::milliseconds timeout) {
+    pollfd pfd;
+    pfd.fd = mountInfoFd_;
+    pfd.events = POLLPRI;
+    pfd.revents = 0;
+
+    if (mountInfoFd_ < 0) {
+        std::this_thread::sleep_for(timeout);
+        return false;
+    }
+
+    int result = poll(&pfd, 1, static_cast<int>(timeout.count()));
+    return result > 0 && (pfd.revents & (POLLPRI | POLLERR));
+}
+
+std::vector<FilesystemInfo> FilesystemMonitor::collectUsageLinux() {
+    std::vector<FilesystemInfo> filesystems;
+    filesystems.reserve(mounts_.size());
+
+    for (const auto& mount : mounts_) {
+        struct statvfs stats;
+        if (statvfs(mount.mountPoint.c_str(), &stats) != 0 || stats.f_blocks == 0) {
+            continue;
+        }
+
+        FilesystemInfo info;
+        info.mountPoint = mount.mountPoint;
+        info.device = mount.device;
+        info.fsType = mount.fsType;
+        info.isReadOnly = mount.isReadOnly;
+
+        uint64_t blockSize = stats.f_frsize ? stats.f_frsize : stats.f_bsize;
+        info.totalBytes = static_cast<uint64_t>(stats.f_blocks) * blockSize;
+        info.availableBytes = static_cast<uint64_t>(stats.f_bavail) * blockSize;
+        uint64_t freeBytes = static_cast<uint64_t>(stats.f_bfree) * blockSize;
+        info.usedBytes = info.totalBytes - std::min(freeBytes, info.totalBytes);
+
+        // Same definition as df: reserved blocks do not count as available
+        uint64_t usable = info.usedBytes + info.availableBytes;
+        info.usagePercent = usable > 0 ?
+            100.0 * static_cast<double>(info.usedBytes) / static_cast<double>(usable) : 0.0;
+
+        info.totalInodes = stats.f_files;
+        info.usedInodes = stats.f_files - std::min<uint64_t>(stats.f_ffree, stats.f_files);
+        info.inodeUsagePercent = info.totalInodes > 0 ?
+            100.0 * static_cast<double>(info.usedInodes) / static_cast<double>(info.totalInodes) : 0.0;
+
+        filesystems.push_back(info);
+    }
+
+    return filesystems;
+}
+
+#else
+
+bool FilesystemMonitor::reloadMountTableLinux() {
+    return false;
+}
+
+bool FilesystemMonitor::waitForMountChangeLinux(std::chrono::milliseconds timeout) {
+    std::this_thread::sleep_for(timeout);
+    return false;
+}
+
+std::vector<FilesystemInfo> FilesystemMonitor::collectUsageLinux() {
+    return {};
+}
+
+#endif
+
+std::vector<FilesystemInfo> FilesystemMonitor::collectUsageWindows() {
+    std::vector<FilesystemInfo> filesystems;
+
+#ifdef _WIN32
+    char drives[256];
+    DWORD length = GetLogicalDriveStringsA(sizeof(drives) - 1, drives);
+    if (length == 0 || length >= sizeof(drives)) {
+        return filesystems;
+    }
+
+    for (const char* drive = drives; *drive; drive += strlen(drive) + 1) {
+        if (GetDriveTypeA(drive) != DRIVE_FIXED) {
+            continue;
+        }
+
+        ULARGE_INTEGER available, total, totalFree;
+        if (!GetDiskFreeSpaceExA(drive, &available, &total, &totalFree) || total.QuadPart == 0) {
+            continue;
+        }
+
+        FilesystemInfo info;
+        info.mountPoint = drive;
+        info.device = drive;
+
+        char fsName[MAX_PATH + 1] = {0};
+        DWORD flags = 0;
+        if (GetVolumeInformationA(drive, nullptr, 0, nullptr, nullptr, &flags, fsName, sizeof(fsName))) {
+            info.fsType = fsName;
+            info.isReadOnly = (flags & FILE_READ_ONLY_VOLUME) != 0;
+        }
+
+        info.totalBytes = total.QuadPart;
+        info.availableBytes = available.QuadPart;
+        info.usedBytes = total.QuadPart - totalFree.QuadPart;
+        info.usagePercent = 100.0 * static_cast<double>(info.usedBytes) / static_cast<double>(info.totalBytes);
+
+        filesystems.push_back(info);
+    }
+#endif
+
+    return filesystems;
+}
+
+std::vector<FilesystemMonitor::MountEntry> FilesystemMonitor::parseMountInfo(const std::string& content) const {
+    // Format: id parent major:minor root mount-point options [optional...] - fstype source super-options
+    std::vector<MountEntry> mounts;
+    std::unordered_map<std::string, size_t> byDevice;
+    std::string_view text = content;
+    std::string_view line;
+
+    while (ProcParsers::nextLine(text, line)) {
+        std::string_view fields[6];
+        size_t count = 0;
+        while (count < 6 && ProcParsers::nextField(line, fields[count])) {
+            ++count;
+        }
+
+        // Optional fields run up to the "-" separator
+        std::string_view field, fsType, source;
+        bool separated = false;
+        while (!separated && ProcParsers::nextField(line, field)) {
+            separated = field == "-";
+        }
+        if (count < 6 || !separated || !ProcParsers::nextField(line, fsType) ||
+            !ProcParsers::nextField(line, source)) {
+            continue;
+        }
+
+        std::string_view options = fields[5];
+        if (isPseudoFilesystem(std::string(fsType))) {
+            continue;
+        }
+
+        MountEntry entry;
+        entry.deviceNumber = std::string(fields[2]);
+        entry.root = unescapeMountField(fields[3]);
+        entry.mountPoint = unescapeMountField(fields[4]);
+        entry.isReadOnly = ProcParsers::consumePrefix(options, "ro") && (options.empty() || options[0] == ',');
+        entry.fsType = std::string(fsType);
+        entry.device = unescapeMountField(source);
+
+        // Bind mounts and container views share the device number; keep one
+        // entry per filesystem, preferring the mount of its root directory
+        auto existing = byDevice.find(entry.deviceNumber);
+        if (existing == byDevice.end()) {
+            byDevice[entry.deviceNumber] = mounts.size();
+            mounts.push_back(entry);
+            continue;
+        }
+
+        MountEntry& current = mounts[existing->second];
+        bool entryIsRoot = entry.root == "/";
+        bool currentIsRoot = current.root == "/";
+        if ((entryIsRoot && !currentIsRoot) ||
+            (entryIsRoot == currentIsRoot && entry.mountPoint.size() < current.mountPoint.size())) {
+            current = entry;
+        }
+    }
+
+    return mounts;
+}
+
+std::string FilesystemMonitor::unescapeMountField(std::string_view field) {
+    // The kernel escapes space, tab, newline and backslash as \ooo
+    std::string result;
+    result.reserve(field.size());
+    for (size_t i = 0; i < field.size(); ++i) {
+        if (field[i] == '\\' && i + 3 < field.size() &&
+            field[i + 1] >= '0' && field[i + 1] <= '7' &&
+            field[i + 2] >= '0' && field[i + 2] <= '7' &&
+            field[i + 3] >= '0' && field[i + 3] <= '7') {
+            result += static_cast<char>(((field[i + 1] - '0') << 6) |
+                                        ((field[i + 2] - '0') << 3) |
+                                        (field[i + 3] - '0'));
+            i += 3;
+        } else {
+            result += field[i];
+        }
+    }
+    return result;
+}
+
+bool FilesystemMonitor::isPseudoFilesystem(const std::string& fsType) {
+    // Kernel interfaces, memory-backed and image filesystems - none of them
+    // can fill up a disk, and container hosts mount them by the thousand
+    static const std::unordered_set<std::string> pseudoTypes = {
+        "autofs", "binfmt_misc", "bpf", "cgroup", "cgroup2", "configfs",
+        "debugfs", "devpts", "devtmpfs", "efivarfs", "fusectl", "hugetlbfs",
+        "mqueue", "nsfs", "overlay", "proc", "pstore", "ramfs", "rpc_pipefs",
+        "securityfs", "selinuxfs", "squashfs", "sysfs", "tmpfs", "tracefs",
+        "fuse.gvfsd-fuse", "fuse.portal", "fuse.lxcfs", "nfsd"
+    };
+    return pseudoTypes.count(fsType) > 0;
+}
+
+std::vector<FilesystemInfo> FilesystemMonitor::getFilesystems() const {
+    std::shared_lock<std::shared_mutex> lock(dataMutex_);
+    return filesystems_;
+}
+
+bool FilesystemMonitor::getFilesystem(const std::string& mountPoint, FilesystemInfo& info) const {
+    std::shared_lock<std::shared_mutex> lock(dataMutex_);
+    for (const auto& fs : filesystems_) {
+        if (fs.mountPoint == mountPoint) {
+            info = fs;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool FilesystemMonitor::isRunning() const {
+    return running_;
+}
+
+std::chrono::milliseconds FilesystemMonitor::getUpdateInterval() const {
+    return updateInterval_;
+}
+
+void FilesystemMonitor::setUpdateInterval(std::chrono::milliseconds interval) {
+    updateInterval_ = interval;
+}
+
+// Fallback mode support
+void FilesystemMonitor::enableFallbackMode() {
+    fallbackMode_ = true;
+    initialized_ = true;
+
+    std::unique_lock<std::shared_mutex> lock(dataMutex_);
+    filesystems_.clear();
+}
+
+bool FilesystemMonitor::isFallbackMode() const {
+    return fallbackMode_;
+}
+
+} // namespace SysMon
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "../shared/systemtypes.h"
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <shared_mutex>
+#include <map>
+#include <string_view>
+
+namespace SysMon {
+
+// Filesystem Monitor - tracks space and inode usage of mounted filesystems
+class FilesystemMonitor {
+public:
+    FilesystemMonitor();
+    ~FilesystemMonitor();
+
+    // Lifecycle
+    bool initialize();
+    bool start();
+    void stop();
+    void shutdown();
+
+    // Fallback mode support
+    void enableFallbackMode();
+    bool isFallbackMode() const;
+
+    // Data access
+    std::vector<FilesystemInfo> getFilesystems() const;
+    bool getFilesystem(const std::string& mountPoint, FilesystemInfo& info) const;
+
+    // Status
+    bool isRunning() const;
+    std::chrono::milliseconds getUpdateInterval() const;
+    void setUpdateInterval(std::chrono::milliseconds interval);
+
+private:
+    // Mount table entry (one per distinct filesystem after deduplication)
+    struct MountEntry {
+        std::string mountPoint;
+        std::string device;
+        std::string fsType;
+        std::string root;
+        std::string deviceNumber;   // "major:minor" from mountinfo
+        bool isReadOnly;
+    };
+
+    // Previous usage sample for fill-rate estimation
+    struct UsageSample {
+        uint64_t usedBytes;
+        double fillRate;
+        std::chrono::steady_clock::time_point timestamp;
+    };
+
+    // Monitoring thread
+    void monitoringThread();
+    void updateUsage();
+
+    // Platform-specific implementations
+    bool reloadMountTableLinux();
+    bool waitForMountChangeLinux(std::chrono::milliseconds timeout);
+    std::vector<FilesystemInfo> collectUsageLinux();
+    std::vector<FilesystemInfo> collectUsageWindows();
+
+    // Mount table parsing
+    std::vector<MountEntry> parseMountInfo(const std::string& content) const;
+    static std::string unescapeMountField(std::string_view field);
+    static bool isPseudoFilesystem(const std::string& fsType);
+
+    // Fill rate estimation
+    void updateFillRate(FilesystemInfo& info, std::chrono::steady_clock::time_point now);
+
+    // Thread management
+    std::thread monitoringThread_;
+    std::atomic<bool> running_;
+    std::atomic<bool> initialized_;
+    std::atomic<bool> fallbackMode_;
+
+    // Data storage
+    std::vector<FilesystemInfo> filesystems_;
+    mutable std::shared_mutex dataMutex_;
+
+    // Monitoring thread state
+    std::vector<MountEntry> mounts_;
+    std::map<std::string, UsageSample> previousSamples_;
+    int mountInfoFd_;
+
+    // Timing
+    std::chrono::milliseconds updateInterval_;
+    std::chrono::steady_clock::time_point lastUpdate_;
+
+    // Constants
+    static constexpr std::chrono::milliseconds DEFAULT_UPDATE_INTERVAL{10000};
+    static constexpr std::chrono::milliseconds POLL_SLICE{500};
+    static constexpr double FILL_RATE_SMOOTHING = 0.3;
+};
+
+} // namespace SysMon
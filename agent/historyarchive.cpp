@@ -0,0 +1,456 @@
+#include "historyarchive.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <chrono>
+
+#ifndef _WIN32
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace SysMon {
+
+constexpr char HistoryArchive::MAGIC[8];
+constexpr char HistoryArchive::SERIES_RECORD;
+constexpr char HistoryArchive::BATCH_RECORD;
+constexpr uint64_t HistoryArchive::MS_PER_DAY;
+constexpr size_t HistoryArchive::MAX_STRING_LENGTH;
+constexpr size_t HistoryArchive::READ_BUFFER_SIZE;
+
+// SeriesSelector implementation
+SeriesSelector::SeriesSelector()
+    : hasInstance(false) {
+}
+
+bool SeriesSelector::matches(const std::string& collectorName, const std::string& metricName,
+                             const std::string& instanceName) const {
+    return collectorName == collector && (metric.empty() || metricName == metric) &&
+           (!hasInstance || instanceName == instance);
+}
+
+bool SeriesSelector::parseList(const std::string& list, std::vector<SeriesSelector>& selectors,
+                               std::string& error) {
+    selectors.clear();
+
+    size_t start = 0;
+    while (start <= list.size()) {
+        size_t end = list.find(',', start);
+        if (end == std::string::npos) {
+            end = list.size();
+        }
+        std::string item = list.substr(start, end - start);
+        start = end + 1;
+
+        item.erase(0, item.find_first_not_of(" \t"));
+        item.erase(item.find_last_not_of(" \t") + 1);
+        if (item.empty()) {
+            continue;
+        }
+
+        // Instances (device serials, host:port) may contain dots and colons,
+        // so only the first of each separates
+        SeriesSelector selector;
+        size_t dot = item.find('.');
+        selector.collector = item.substr(0, dot);
+        if (dot != std::string::npos) {
+            std::string rest = item.substr(dot + 1);
+            size_t colon = rest.find(':');
+            selector.metric = rest.substr(0, colon);
+            if (colon != std::string::npos) {
+                selector.instance = rest.substr(colon + 1);
+                selector.hasInstance = true;
+            }
+            if (selector.metric.empty()) {
+                error = "Empty metric in series '" + item + "'";
+                return false;
+            }
+        }
+        if (selector.collector.empty()) {
+            error = "Empty collector in series '" + item + "'";
+            return false;
+        }
+        selectors.push_back(std::move(selector));
+    }
+
+    if (selectors.empty()) {
+        error = "No series selected (expected collector[.metric[:instance]],...)";
+        return false;
+    }
+    return true;
+}
+
+// HistoryArchive implementation
+HistoryArchive::HistoryArchive()
+    : initialized_(false)
+    , retentionDays_(31)
+    , file_(nullptr)
+    , segmentDay_(0)
+    , writeErrors_(0) {
+}
+
+HistoryArchive::~HistoryArchive() {
+    shutdown();
+}
+
+bool HistoryArchive::initialize(const std::string& directory, std::string& error) {
+    if (initialized_) {
+        return true;
+    }
+
+#ifdef _WIN32
+    (void)directory;
+    error = "History archive is not supported on this platform";
+    return false;
+#else
+    if (directory.empty()) {
+        error = "No archive directory";
+        return false;
+    }
+
+    if (mkdir(directory.c_str(), 0750) != 0 && errno != EEXIST) {
+        error = "Cannot create " + directory + ": " + std::strerror(errno);
+        return false;
+    }
+    if (access(directory.c_str(), W_OK | X_OK) != 0) {
+        error = "Cannot write to " + directory + ": " + std::strerror(errno);
+        return false;
+    }
+
+    directory_ = directory;
+    initialized_ = true;
+
+    uint64_t now = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+    std::lock_guard<std::mutex> lock(mutex_);
+    removeExpiredSegments(now);
+    return true;
+#endif
+}
+
+void HistoryArchive::shutdown() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closeSegment();
+    initialized_ = false;
+}
+
+void HistoryArchive::setRetentionDays(int days) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    retentionDays_ = std::max(1, days);
+}
+
+void HistoryArchive::append(const std::vector<MetricSample>& samples) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!initialized_ || samples.empty()) {
+        return;
+    }
+
+    uint64_t day = samples.front().timestampMs / MS_PER_DAY;
+    if (file_ && day != segmentDay_) {
+        closeSegment();
+        removeExpiredSegments(samples.front().timestampMs);
+    }
+    if (!file_ && !openSegment(samples.front().timestampMs)) {
+        writeErrors_++;
+        return;
+    }
+
+    // Series first, so a batch never refers to an undefined id
+    std::vector<uint32_t> ids;
+    ids.reserve(samples.size());
+    bool ok = true;
+    for (const auto& sample : samples) {
+        uint32_t id = seriesId(sample);
+        if (id == UINT32_MAX) {
+            ok = false;
+            break;
+        }
+        ids.push_back(id);
+    }
+
+    // One batch per run of equal timestamps (normally the whole call)
+    size_t begin = 0;
+    while (ok && begin < samples.size()) {
+        size_t end = begin + 1;
+        while (end < samples.size() && samples[end].timestampMs == samples[begin].timestampMs) {
+            ++end;
+        }
+
+        ok = writeValue(BATCH_RECORD) && writeValue(samples[begin].timestampMs) &&
+             writeValue(static_cast<uint32_t>(end - begin));
+        for (size_t i = begin; ok && i < end; ++i) {
+            ok = writeValue(ids[i]) && writeValue(samples[i].value);
+        }
+        begin = end;
+    }
+
+    if (!ok || std::fflush(file_) != 0) {
+        writeErrors_++;
+        closeSegment();
+    }
+}
+
+std::unique_ptr<HistoryArchive::Reader> HistoryArchive::openReader(const std::vector<SeriesSelector>& selectors,
+                                                                   uint64_t fromMs, uint64_t toMs) const {
+    std::string directory;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        directory = directory_;
+    }
+    return std::make_unique<Reader>(directory, selectors, fromMs, toMs);
+}
+
+std::string HistoryArchive::getDirectory() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return directory_;
+}
+
+uint64_t HistoryArchive::getWriteErrors() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return writeErrors_;
+}
+
+std::vector<std::pair<uint64_t, std::string>> HistoryArchive::listSegments(const std::string& directory) {
+    std::vector<std::pair<uint64_t, std::string>> segments;
+#ifndef _WIN32
+    DIR* dir = opendir(directory.c_str());
+    if (!dir) {
+        return segments;
+    }
+
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != nullptr) {
+        const char* name = entry->d_name;
+        unsigned long long start = 0;
+        int consumed = 0;
+        if (std::sscanf(name, "history-%llu.dat%n", &start, &consumed) == 1 &&
+            name[consumed] == '\0' && consumed > 0) {
+            segments.emplace_back(static_cast<uint64_t>(start), directory + "/" + name);
+        }
+    }
+    closedir(dir);
+#endif
+    std::sort(segments.begin(), segments.end());
+    return segments;
+}
+
+bool HistoryArchive::openSegment(uint64_t timestampMs) {
+    char name[64];
+    std::snprintf(name, sizeof(name), "history-%013llu.dat", static_cast<unsigned long long>(timestampMs));
+    std::string path = directory_ + "/" + name;
+
+    // "x": a segment is never appended to by a second writer
+    file_ = std::fopen(path.c_str(), "wbx");
+    if (!file_) {
+        return false;
+    }
+
+    if (std::fwrite(MAGIC, sizeof(MAGIC), 1, file_) != 1) {
+        closeSegment();
+        return false;
+    }
+
+    segmentDay_ = timestampMs / MS_PER_DAY;
+    seriesIds_.clear();
+    return true;
+}
+
+void HistoryArchive::closeSegment() {
+    if (file_) {
+        std::fclose(file_);
+        file_ = nullptr;
+    }
+    seriesIds_.clear();
+}
+
+void HistoryArchive::removeExpiredSegments(uint64_t nowMs) {
+    uint64_t retentionMs = static_cast<uint64_t>(retentionDays_) * MS_PER_DAY;
+    if (nowMs < retentionMs) {
+        return;
+    }
+    uint64_t cutoff = nowMs - retentionMs;
+
+    // A segment ends where the next one starts, so it is expired once its
+    // successor started before the cutoff; the newest one is always kept
+    auto segments = listSegments(directory_);
+    for (size_t i = 0; i + 1 < segments.size(); ++i) {
+        if (segments[i + 1].first < cutoff) {
+            std::remove(segments[i].second.c_str());
+        }
+    }
+}
+
+uint32_t HistoryArchive::seriesId(const MetricSample& sample) {
+    std::string key = seriesKey(sample);
+    auto it = seriesIds_.find(key);
+    if (it != seriesIds_.end()) {
+        return it->second;
+    }
+
+    uint32_t id = static_cast<uint32_t>(seriesIds_.size());
+    if (!writeValue(SERIES_RECORD) || !writeValue(id) || !writeString(sample.collector) ||
+        !writeString(sample.metric) || !writeString(sample.instance)) {
+        return UINT32_MAX;
+    }
+    seriesIds_.emplace(std::move(key), id);
+    return id;
+}
+
+bool HistoryArchive::writeString(const std::string& value) {
+    uint16_t length = static_cast<uint16_t>(std::min(value.size(), MAX_STRING_LENGTH));
+    return writeValue(length) && (length == 0 || std::fwrite(value.data(), length, 1, file_) == 1);
+}
+
+std::string HistoryArchive::seriesKey(const MetricSample& sample) {
+    std::string key;
+    key.reserve(sample.collector.size() + sample.metric.size() + sample.instance.size() + 2);
+    key += sample.collector;
+    key += '\0';
+    key += sample.metric;
+    key += '\0';
+    key += sample.instance;
+    return key;
+}
+
+// HistoryArchive::Reader implementation
+HistoryArchive::Reader::Reader(const std::string& directory, std::vector<SeriesSelector> selectors,
+                               uint64_t fromMs, uint64_t toMs)
+    : selectors_(std::move(selectors))
+    , fromMs_(fromMs)
+    , toMs_(toMs)
+    , nextSegment_(0)
+    , file_(nullptr)
+    , buffer_(READ_BUFFER_SIZE)
+    , batchTimestamp_(0)
+    , batchRemaining_(0) {
+    // A segment covers [its start, the next segment's start), so whole
+    // files outside the range are skipped without being opened
+    auto segments = listSegments(directory);
+    for (size_t i = 0; i < segments.size(); ++i) {
+        if (segments[i].first > toMs_) {
+            break;
+        }
+        if (i + 1 < segments.size() && segments[i + 1].first <= fromMs_) {
+            continue;
+        }
+        segments_.push_back(segments[i].second);
+    }
+}
+
+HistoryArchive::Reader::~Reader() {
+    closeSegment();
+}
+
+bool HistoryArchive::Reader::next(MetricSample& sample) {
+    while (true) {
+        if (!file_ && !openNextSegment()) {
+            return false;
+        }
+
+        if (batchRemaining_ == 0) {
+            if (!readRecord()) {
+                closeSegment();
+            }
+            continue;
+        }
+
+        uint32_t id;
+        double value;
+        batchRemaining_--;
+        if (!readValue(id) || !readValue(value) || id >= series_.size()) {
+            closeSegment();
+            continue;
+        }
+        if (!series_[id].selected) {
+            continue;
+        }
+
+        const Series& series = series_[id];
+        sample.collector = series.collector;
+        sample.metric = series.metric;
+        sample.instance = series.instance;
+        sample.value = value;
+        sample.timestampMs = batchTimestamp_;
+        return true;
+    }
+}
+
+bool HistoryArchive::Reader::openNextSegment() {
+    while (nextSegment_ < segments_.size()) {
+        const std::string& path = segments_[nextSegment_++];
+        file_ = std::fopen(path.c_str(), "rb");
+        if (!file_) {
+            continue;
+        }
+        std::setvbuf(file_, buffer_.data(), _IOFBF, buffer_.size());
+
+        char magic[sizeof(MAGIC)];
+        if (std::fread(magic, sizeof(magic), 1, file_) != 1 || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0) {
+            closeSegment();
+            continue;
+        }
+        return true;
+    }
+    return false;
+}
+
+void HistoryArchive::Reader::closeSegment() {
+    if (file_) {
+        std::fclose(file_);
+        file_ = nullptr;
+    }
+    series_.clear();
+    batchRemaining_ = 0;
+}
+
+bool HistoryArchive::Reader::readRecord() {
+    char type;
+    if (!readValue(type)) {
+        return false;
+    }
+
+    if (type == SERIES_RECORD) {
+        uint32_t id;
+        Series series;
+        if (!readValue(id) || !readString(series.collector) || !readString(series.metric) ||
+            !readString(series.instance) || id != series_.size()) {
+            return false;
+        }
+        series.selected = false;
+        for (const auto& selector : selectors_) {
+            if (selector.matches(series.collector, series.metric, series.instance)) {
+                series.selected = true;
+                break;
+            }
+        }
+        series_.push_back(std::move(series));
+        return true;
+    }
+
+    if (type == BATCH_RECORD) {
+        if (!readValue(batchTimestamp_) || !readValue(batchRemaining_)) {
+            return false;
+        }
+        // Batches outside the range are skipped without decoding
+        if (batchTimestamp_ < fromMs_ || batchTimestamp_ > toMs_) {
+            long skip = static_cast<long>(batchRemaining_) * static_cast<long>(sizeof(uint32_t) + sizeof(double));
+            batchRemaining_ = 0;
+            return std::fseek(file_, skip, SEEK_CUR) == 0;
+        }
+        return true;
+    }
+
+    return false;
+}
+
+bool HistoryArchive::Reader::readString(std::string& value) {
+    uint16_t length;
+    if (!readValue(length) || length > MAX_STRING_LENGTH) {
+        return false;
+    }
+    value.resize(length);
+    return length == 0 || std::fread(&value[0], length, 1, file_) == 1;
+}
+
+} // namespace SysMon
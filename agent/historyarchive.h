@@ -0,0 +1,144 @@
+#pragma once
+
+#include "../shared/systemtypes.h"
+#include <cstdio>
+#include <mutex>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace SysMon {
+
+// Series selector: "collector", "collector.metric" or "collector.metric:instance"
+struct SeriesSelector {
+    std::string collector;
+    std::string metric;         // empty = every metric
+    std::string instance;
+    bool hasInstance;
+
+    SeriesSelector();
+
+    bool matches(const std::string& collectorName, const std::string& metricName,
+                 const std::string& instanceName) const;
+
+    // Comma-separated list
+    static bool parseList(const std::string& list, std::vector<SeriesSelector>& selectors, std::string& error);
+};
+
+// History Archive - on-disk copy of every collector sample
+//
+// Samples are appended to segment files named history-<start ms>.dat; a new
+// segment starts with every agent run and every UTC day, and segments older
+// than the retention are deleted at day rollover. Each segment is
+// self-contained: series are defined once ('S' records, with an id local to
+// the segment) and every collector run is one 'B' record of (id, value)
+// pairs sharing a timestamp, so one second of a series costs 12 bytes.
+// Integers and doubles are stored in host byte order.
+//
+// A torn record at the end of a segment (crash, disk full) ends that segment
+// for readers; the next run starts a fresh one.
+class HistoryArchive {
+public:
+    // Streams the samples of [fromMs, toMs] that match the selectors, in
+    // file order (by time across series). Memory use is independent of the
+    // range: one read buffer plus the series table of the current segment.
+    class Reader {
+    public:
+        Reader(const std::string& directory, std::vector<SeriesSelector> selectors, uint64_t fromMs, uint64_t toMs);
+        ~Reader();
+
+        bool next(MetricSample& sample);
+
+    private:
+        struct Series {
+            std::string collector;
+            std::string metric;
+            std::string instance;
+            bool selected;
+        };
+
+        bool openNextSegment();
+        void closeSegment();
+        bool readRecord();
+        bool readString(std::string& value);
+
+        template<typename T>
+        bool readValue(T& value) {
+            return std::fread(&value, sizeof(value), 1, file_) == 1;
+        }
+
+        std::vector<SeriesSelector> selectors_;
+        uint64_t fromMs_;
+        uint64_t toMs_;
+
+        std::vector<std::string> segments_;     // full paths, oldest first
+        size_t nextSegment_;
+        std::FILE* file_;
+        std::vector<char> buffer_;
+        std::vector<Series> series_;            // by segment-local id
+
+        // Current batch record
+        uint64_t batchTimestamp_;
+        uint32_t batchRemaining_;
+    };
+
+    HistoryArchive();
+    ~HistoryArchive();
+
+    // Lifecycle; creates the directory if needed
+    bool initialize(const std::string& directory, std::string& error);
+    void shutdown();
+
+    // Configuration
+    void setRetentionDays(int days);
+
+    // Writer (collector scheduler thread); write errors close the segment
+    // and the next batch starts a new one
+    void append(const std::vector<MetricSample>& samples);
+
+    // Reading (any thread, independent of the writer)
+    std::unique_ptr<Reader> openReader(const std::vector<SeriesSelector>& selectors,
+                                       uint64_t fromMs, uint64_t toMs) const;
+
+    // Status
+    std::string getDirectory() const;
+    uint64_t getWriteErrors() const;
+
+    // Segment files of a directory as (start ms, path), oldest first
+    static std::vector<std::pair<uint64_t, std::string>> listSegments(const std::string& directory);
+
+private:
+    bool openSegment(uint64_t timestampMs);
+    void closeSegment();
+    void removeExpiredSegments(uint64_t nowMs);
+    uint32_t seriesId(const MetricSample& sample);
+    bool writeString(const std::string& value);
+
+    template<typename T>
+    bool writeValue(const T& value) {
+        return std::fwrite(&value, sizeof(value), 1, file_) == 1;
+    }
+
+    static std::string seriesKey(const MetricSample& sample);
+
+    std::string directory_;
+    bool initialized_;
+    int retentionDays_;
+
+    // Current segment
+    std::FILE* file_;
+    uint64_t segmentDay_;
+    std::unordered_map<std::string, uint32_t> seriesIds_;
+    uint64_t writeErrors_;
+    mutable std::mutex mutex_;
+
+    // Constants
+    static constexpr char MAGIC[8] = {'S', 'Y', 'S', 'H', 'I', 'S', 'T', '1'};
+    static constexpr char SERIES_RECORD = 'S';
+    static constexpr char BATCH_RECORD = 'B';
+    static constexpr uint64_t MS_PER_DAY = 24ULL * 60 * 60 * 1000;
+    static constexpr size_t MAX_STRING_LENGTH = 4096;
+    static constexpr size_t READ_BUFFER_SIZE = 256 * 1024;
+};
+
+} // namespace SysMon
@@ -0,0 +1,457 @@
+#include "historyexport.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace SysMon {
+
+constexpr size_t HistoryExport::CSV_CHUNK_SIZE;
+constexpr size_t HistoryExport::BATCH_ROWS;
+constexpr uint64_t HistoryExport::DEFAULT_RANGE_MS;
+
+namespace {
+
+// Arrow format constants (Schema.fbs, Message.fbs)
+constexpr uint16_t METADATA_V5 = 4;
+constexpr uint8_t HEADER_SCHEMA = 1;
+constexpr uint8_t HEADER_RECORD_BATCH = 3;
+constexpr uint8_t TYPE_FLOATING_POINT = 3;
+constexpr uint8_t TYPE_UTF8 = 5;
+constexpr uint8_t TYPE_TIMESTAMP = 10;
+constexpr uint16_t PRECISION_DOUBLE = 2;
+constexpr uint16_t TIME_UNIT_MILLISECOND = 1;
+constexpr uint32_t CONTINUATION = 0xFFFFFFFF;
+constexpr size_t COLUMN_COUNT = 5;
+constexpr size_t BUFFER_COUNT = 13;
+
+template<typename T>
+void appendRaw(std::string& out, const T& value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void padTo(std::string& out, size_t alignment, size_t base = 0) {
+    out.append((alignment - (out.size() - base) % alignment) % alignment, '\0');
+}
+
+// Minimal FlatBuffers writer for the Arrow metadata messages
+//
+// Objects are laid out parent first, so every offset points forward and is
+// filled in when its target is written: each object is given the position
+// of the slot that refers to it. Tables are preceded by their vtable and
+// start 4 bytes short of an 8-byte boundary, so 8-byte fields (stored
+// first) are aligned. Little-endian hosts only, like the rest of the
+// archive.
+class FlatWriter {
+public:
+    struct Field {
+        uint16_t id;
+        uint8_t size;       // 1, 2, 4 or 8 bytes
+        uint64_t value;     // ignored for offsets
+        bool isOffset;
+    };
+
+    static constexpr size_t ROOT = 0;
+
+    FlatWriter() {
+        put<uint32_t>(0);
+    }
+
+    // Returns the positions of the table's offset slots, in argument order
+    std::vector<size_t> table(size_t slot, const std::vector<Field>& fields) {
+        std::vector<const Field*> layout;
+        uint16_t fieldCount = 0;
+        for (const auto& field : fields) {
+            layout.push_back(&field);
+            fieldCount = std::max<uint16_t>(fieldCount, static_cast<uint16_t>(field.id + 1));
+        }
+        std::stable_sort(layout.begin(), layout.end(),
+                         [](const Field* a, const Field* b) { return a->size > b->size; });
+
+        std::vector<uint16_t> fieldOffsets(fieldCount, 0);
+        uint16_t inlineSize = 4;
+        for (const Field* field : layout) {
+            fieldOffsets[field->id] = inlineSize;
+            inlineSize = static_cast<uint16_t>(inlineSize + field->size);
+        }
+
+        uint16_t vtableSize = static_cast<uint16_t>(4 + 2 * fieldCount);
+        while ((buffer_.size() + vtableSize) % 8 != 4) {
+            buffer_ += '\0';
+        }
+        size_t vtable = buffer_.size();
+        put(vtableSize);
+        put(inlineSize);
+        for (uint16_t offset : fieldOffsets) {
+            put(offset);
+        }
+
+        size_t start = buffer_.size();
+        link(slot, start);
+        put(static_cast<int32_t>(start - vtable));
+
+        std::vector<size_t> slots(fields.size(), 0);
+        for (const Field* field : layout) {
+            if (field->isOffset) {
+                slots[static_cast<size_t>(field - fields.data())] = buffer_.size();
+            }
+            uint64_t value = field->isOffset ? 0 : field->value;
+            buffer_.append(reinterpret_cast<const char*>(&value), field->size);
+        }
+
+        std::vector<size_t> offsetSlots;
+        for (size_t i = 0; i < fields.size(); ++i) {
+            if (fields[i].isOffset) {
+                offsetSlots.push_back(slots[i]);
+            }
+        }
+        return offsetSlots;
+    }
+
+    void string(size_t slot, const std::string& value) {
+        padTo(buffer_, 4);
+        link(slot, buffer_.size());
+        put(static_cast<uint32_t>(value.size()));
+        buffer_ += value;
+        buffer_ += '\0';
+    }
+
+    // Vector of offsets to tables; returns the element slots
+    std::vector<size_t> offsetVector(size_t slot, size_t count) {
+        padTo(buffer_, 4);
+        link(slot, buffer_.size());
+        put(static_cast<uint32_t>(count));
+        std::vector<size_t> slots;
+        for (size_t i = 0; i < count; ++i) {
+            slots.push_back(buffer_.size());
+            put<uint32_t>(0);
+        }
+        return slots;
+    }
+
+    // Vector of structs made of int64 pairs (FieldNode, Buffer)
+    void pairVector(size_t slot, const std::vector<std::pair<int64_t, int64_t>>& values) {
+        while (buffer_.size() % 8 != 4) {
+            buffer_ += '\0';
+        }
+        link(slot, buffer_.size());
+        put(static_cast<uint32_t>(values.size()));
+        for (const auto& value : values) {
+            put(value.first);
+            put(value.second);
+        }
+    }
+
+    const std::string& data() const {
+        return buffer_;
+    }
+
+private:
+    template<typename T>
+    void put(T value) {
+        appendRaw(buffer_, value);
+    }
+
+    void link(size_t slot, size_t target) {
+        uint32_t offset = static_cast<uint32_t>(target - slot);
+        std::memcpy(&buffer_[slot], &offset, sizeof(offset));
+    }
+
+    std::string buffer_;
+};
+
+constexpr size_t FlatWriter::ROOT;
+
+// Encapsulated message: continuation marker, metadata length, metadata
+// padded to 8 bytes; the body follows
+void appendMessage(std::string& out, const std::string& metadata) {
+    size_t padded = (metadata.size() + 7) & ~static_cast<size_t>(7);
+    appendRaw(out, CONTINUATION);
+    appendRaw(out, static_cast<int32_t>(padded));
+    out += metadata;
+    out.append(padded - metadata.size(), '\0');
+}
+
+std::vector<FlatWriter::Field> messageFields(uint8_t headerType, int64_t bodyLength) {
+    return {
+        {0, 2, METADATA_V5, false},
+        {1, 1, headerType, false},
+        {2, 4, 0, true},
+        {3, 8, static_cast<uint64_t>(bodyLength), false}
+    };
+}
+
+bool parseMilliseconds(const std::string& text, uint64_t& value) {
+    if (text.empty() || text.find_first_not_of("0123456789") != std::string::npos || text.size() > 19) {
+        return false;
+    }
+    value = std::strtoull(text.c_str(), nullptr, 10);
+    return true;
+}
+
+} // namespace
+
+HistoryExport::HistoryExport(Source source, Format format)
+    : source_(std::move(source))
+    , format_(format)
+    , started_(false)
+    , finished_(false)
+    , rows_(0) {
+}
+
+bool HistoryExport::nextChunk(std::string& out) {
+    out.clear();
+    if (finished_) {
+        return false;
+    }
+
+    if (format_ == Format::CSV) {
+        writeCsvChunk(out);
+    } else {
+        writeArrowChunk(out);
+    }
+    return true;
+}
+
+HistoryExport::Format HistoryExport::getFormat() const {
+    return format_;
+}
+
+uint64_t HistoryExport::getRowCount() const {
+    return rows_;
+}
+
+bool HistoryExport::parseRequest(const std::map<std::string, std::string>& params, Request& request,
+                                 std::string& error) {
+    auto series = params.find("series");
+    if (series == params.end() || !SeriesSelector::parseList(series->second, request.selectors, error)) {
+        if (series == params.end()) {
+            error = "Missing series (expected collector[.metric[:instance]],...)";
+        }
+        return false;
+    }
+
+    request.format = Format::CSV;
+    auto format = params.find("format");
+    if (format != params.end() && !format->second.empty()) {
+        if (format->second == "csv") {
+            request.format = Format::CSV;
+        } else if (format->second == "arrow") {
+            request.format = Format::ARROW;
+        } else {
+            error = "Invalid format (expected csv or arrow)";
+            return false;
+        }
+    }
+
+    request.toMs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+    auto to = params.find("to");
+    if (to != params.end() && !parseMilliseconds(to->second, request.toMs)) {
+        error = "Invalid to (expected milliseconds since the epoch)";
+        return false;
+    }
+
+    request.fromMs = request.toMs > DEFAULT_RANGE_MS ? request.toMs - DEFAULT_RANGE_MS : 0;
+    auto from = params.find("from");
+    if (from != params.end() && !parseMilliseconds(from->second, request.fromMs)) {
+        error = "Invalid from (expected milliseconds since the epoch)";
+        return false;
+    }
+
+    if (request.fromMs > request.toMs) {
+        error = "from is after to";
+        return false;
+    }
+    return true;
+}
+
+const char* HistoryExport::contentType(Format format) {
+    return format == Format::ARROW ? "application/vnd.apache.arrow.stream" : "text/csv; charset=utf-8";
+}
+
+const char* HistoryExport::fileExtension(Format format) {
+    return format == Format::ARROW ? "arrows" : "csv";
+}
+
+void HistoryExport::writeCsvChunk(std::string& out) {
+    out.reserve(CSV_CHUNK_SIZE + 512);
+    if (!started_) {
+        out += "timestamp_ms,collector,metric,instance,value\n";
+        started_ = true;
+    }
+
+    MetricSample sample;
+    char number[32];
+    while (out.size() < CSV_CHUNK_SIZE) {
+        if (!source_(sample)) {
+            finished_ = true;
+            break;
+        }
+
+        std::snprintf(number, sizeof(number), "%llu,", static_cast<unsigned long long>(sample.timestampMs));
+        out += number;
+        appendCsvField(out, sample.collector);
+        out += ',';
+        appendCsvField(out, sample.metric);
+        out += ',';
+        appendCsvField(out, sample.instance);
+        // 17 significant digits read back as the same double
+        std::snprintf(number, sizeof(number), ",%.17g\n", sample.value);
+        out += number;
+        rows_++;
+    }
+}
+
+void HistoryExport::appendCsvField(std::string& out, const std::string& value) {
+    if (value.find_first_of(",\"\r\n") == std::string::npos) {
+        out += value;
+        return;
+    }
+
+    out += '"';
+    for (char c : value) {
+        if (c == '"') {
+            out += '"';
+        }
+        out += c;
+    }
+    out += '"';
+}
+
+void HistoryExport::writeArrowChunk(std::string& out) {
+    if (!started_) {
+        writeArrowSchema(out);
+        started_ = true;
+    }
+
+    timestamps_.clear();
+    values_.clear();
+    collectorOffsets_.assign(1, 0);
+    metricOffsets_.assign(1, 0);
+    instanceOffsets_.assign(1, 0);
+    collectorData_.clear();
+    metricData_.clear();
+    instanceData_.clear();
+
+    MetricSample sample;
+    while (timestamps_.size() < BATCH_ROWS) {
+        if (!source_(sample)) {
+            finished_ = true;
+            break;
+        }
+        timestamps_.push_back(static_cast<int64_t>(sample.timestampMs));
+        values_.push_back(sample.value);
+        collectorData_ += sample.collector;
+        collectorOffsets_.push_back(static_cast<int32_t>(collectorData_.size()));
+        metricData_ += sample.metric;
+        metricOffsets_.push_back(static_cast<int32_t>(metricData_.size()));
+        instanceData_ += sample.instance;
+        instanceOffsets_.push_back(static_cast<int32_t>(instanceData_.size()));
+    }
+    rows_ += timestamps_.size();
+
+    // An empty export is still a valid stream: schema, no batches
+    if (!timestamps_.empty()) {
+        writeArrowBatch(out);
+    }
+    if (finished_) {
+        appendRaw(out, CONTINUATION);
+        appendRaw(out, static_cast<int32_t>(0));
+    }
+}
+
+void HistoryExport::writeArrowSchema(std::string& out) const {
+    struct Column {
+        const char* name;
+        uint8_t type;
+    };
+    static const Column columns[COLUMN_COUNT] = {
+        {"timestamp", TYPE_TIMESTAMP},
+        {"collector", TYPE_UTF8},
+        {"metric", TYPE_UTF8},
+        {"instance", TYPE_UTF8},
+        {"value", TYPE_FLOATING_POINT}
+    };
+
+    FlatWriter writer;
+    auto message = writer.table(FlatWriter::ROOT, messageFields(HEADER_SCHEMA, 0));
+    auto schema = writer.table(message[0], {{1, 4, 0, true}});
+    auto fields = writer.offsetVector(schema[0], COLUMN_COUNT);
+
+    for (size_t i = 0; i < COLUMN_COUNT; ++i) {
+        // name, nullable, type_type, type, children
+        auto field = writer.table(fields[i], {
+            {0, 4, 0, true},
+            {1, 1, 0, false},
+            {2, 1, columns[i].type, false},
+            {3, 4, 0, true},
+            {5, 4, 0, true}
+        });
+        writer.string(field[0], columns[i].name);
+
+        if (columns[i].type == TYPE_TIMESTAMP) {
+            auto type = writer.table(field[1], {{0, 2, TIME_UNIT_MILLISECOND, false}, {1, 4, 0, true}});
+            writer.string(type[0], "UTC");
+        } else if (columns[i].type == TYPE_FLOATING_POINT) {
+            writer.table(field[1], {{0, 2, PRECISION_DOUBLE, false}});
+        } else {
+            writer.table(field[1], {});
+        }
+
+        writer.offsetVector(field[2], 0);
+    }
+
+    appendMessage(out, writer.data());
+}
+
+void HistoryExport::writeArrowBatch(std::string& out) const {
+    int64_t length = static_cast<int64_t>(timestamps_.size());
+
+    // Validity bitmaps are omitted (no nulls); every buffer starts 8-aligned
+    struct Region {
+        const void* data;
+        size_t size;
+    };
+    const Region regions[BUFFER_COUNT] = {
+        {nullptr, 0}, {timestamps_.data(), timestamps_.size() * sizeof(int64_t)},
+        {nullptr, 0}, {collectorOffsets_.data(), collectorOffsets_.size() * sizeof(int32_t)},
+        {collectorData_.data(), collectorData_.size()},
+        {nullptr, 0}, {metricOffsets_.data(), metricOffsets_.size() * sizeof(int32_t)},
+        {metricData_.data(), metricData_.size()},
+        {nullptr, 0}, {instanceOffsets_.data(), instanceOffsets_.size() * sizeof(int32_t)},
+        {instanceData_.data(), instanceData_.size()},
+        {nullptr, 0}, {values_.data(), values_.size() * sizeof(double)}
+    };
+
+    std::vector<std::pair<int64_t, int64_t>> buffers;
+    int64_t bodyLength = 0;
+    for (const auto& region : regions) {
+        buffers.emplace_back(bodyLength, static_cast<int64_t>(region.size));
+        bodyLength += static_cast<int64_t>((region.size + 7) & ~static_cast<size_t>(7));
+    }
+    std::vector<std::pair<int64_t, int64_t>> nodes(COLUMN_COUNT, {length, 0});
+
+    FlatWriter writer;
+    auto message = writer.table(FlatWriter::ROOT, messageFields(HEADER_RECORD_BATCH, bodyLength));
+    // length, nodes, buffers
+    auto batch = writer.table(message[0], {{0, 8, static_cast<uint64_t>(length), false},
+                                           {1, 4, 0, true},
+                                           {2, 4, 0, true}});
+    writer.pairVector(batch[0], nodes);
+    writer.pairVector(batch[1], buffers);
+
+    appendMessage(out, writer.data());
+
+    out.reserve(out.size() + static_cast<size_t>(bodyLength));
+    size_t body = out.size();
+    for (const auto& region : regions) {
+        if (region.size > 0) {
+            out.append(static_cast<const char*>(region.data), region.size);
+        }
+        padTo(out, 8, body);
+    }
+}
+
+} // namespace SysMon
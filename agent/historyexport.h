@@ -0,0 +1,80 @@
+#pragma once
+
+#include "historyarchive.h"
+#include <functional>
+#include <map>
+
+namespace SysMon {
+
+// History Export - turns a stream of samples into CSV or an Arrow IPC stream
+//
+// Output is produced one chunk at a time on demand, so the caller decides
+// the pace: an HTTP connection asks for the next chunk only once the socket
+// has drained, and memory use stays at one chunk whatever the time range.
+// Both formats are written by hand; the Arrow stream is one schema message,
+// one record batch per BATCH_ROWS samples and an end-of-stream marker, with
+// columns timestamp (ms, UTC), collector, metric, instance and value.
+class HistoryExport {
+public:
+    enum class Format {
+        CSV,
+        ARROW
+    };
+
+    // Fills the next sample; false at the end
+    using Source = std::function<bool(MetricSample& sample)>;
+
+    // Export parameters, parsed from HTTP query or command-line options:
+    // series (required), from and to (ms since the epoch; default the last
+    // 24 hours) and format (csv or arrow, default csv)
+    struct Request {
+        std::vector<SeriesSelector> selectors;
+        uint64_t fromMs;
+        uint64_t toMs;
+        Format format;
+    };
+
+    HistoryExport(Source source, Format format);
+
+    // Replaces out with the next piece of the stream (possibly empty); false
+    // once the stream has ended
+    bool nextChunk(std::string& out);
+
+    Format getFormat() const;
+    uint64_t getRowCount() const;
+
+    static bool parseRequest(const std::map<std::string, std::string>& params, Request& request,
+                             std::string& error);
+    static const char* contentType(Format format);
+    static const char* fileExtension(Format format);
+
+private:
+    void writeCsvChunk(std::string& out);
+    void writeArrowChunk(std::string& out);
+    void writeArrowSchema(std::string& out) const;
+    void writeArrowBatch(std::string& out) const;
+    static void appendCsvField(std::string& out, const std::string& value);
+
+    Source source_;
+    Format format_;
+    bool started_;
+    bool finished_;
+    uint64_t rows_;
+
+    // Column buffers of the batch being built, reused between batches
+    std::vector<int64_t> timestamps_;
+    std::vector<double> values_;
+    std::vector<int32_t> collectorOffsets_;
+    std::vector<int32_t> metricOffsets_;
+    std::vector<int32_t> instanceOffsets_;
+    std::string collectorData_;
+    std::string metricData_;
+    std::string instanceData_;
+
+    // Constants
+    static constexpr size_t CSV_CHUNK_SIZE = 64 * 1024;
+    static constexpr size_t BATCH_ROWS = 16384;
+    static constexpr uint64_t DEFAULT_RANGE_MS = 24ULL * 60 * 60 * 1000;
+};
+
+} // namespace SysMon
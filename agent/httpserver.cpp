@@ -0,0 +1,1211 @@
+#include "httpserver.h"
+#include "../shared/ipcprotocol.h"
+#include <algorithm>
+#include <sstream>
+#include <cctype>
+#include <cerrno>
+#include <cstdio>
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <cstring>
+#endif
+
+namespace SysMon {
+
+constexpr size_t HttpServer::MAX_CONNECTIONS;
+constexpr size_t HttpServer::MAX_REQUEST_SIZE;
+constexpr size_t HttpServer::MAX_PENDING_OUTPUT;
+constexpr size_t HttpServer::MAX_PENDING_EVENTS;
+constexpr size_t HttpServer::EXPORT_LOW_WATERMARK;
+constexpr size_t HttpServer::WORKER_THREADS;
+constexpr std::chrono::milliseconds HttpServer::SNAPSHOT_CACHE_TTL;
+constexpr std::chrono::seconds HttpServer::IDLE_TIMEOUT;
+constexpr std::chrono::seconds HttpServer::KEEPALIVE_INTERVAL;
+constexpr std::chrono::milliseconds HttpServer::DEFAULT_STREAM_INTERVAL;
+
+namespace {
+
+// Shared frames that never change
+const std::string SSE_KEEPALIVE = ": keepalive\n\n";
+
+std::string toLower(std::string value) {
+    std::transform(value.begin(), value.end(), value.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return value;
+}
+
+std::string toUpper(std::string value) {
+    std::transform(value.begin(), value.end(), value.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::toupper(c)); });
+    return value;
+}
+
+bool parseModule(const std::string& name, Module& module) {
+    std::string upper = toUpper(name);
+    module = stringToModule(upper);
+    return moduleToString(module) == upper;
+}
+
+} // anonymous namespace
+
+HttpServer::HttpServer()
+    : serverSocket_(-1)
+    , epollFd_(-1)
+    , wakeFd_(-1)
+    , running_(false)
+    , initialized_(false)
+    , nextSerial_(1)
+    , connectionCount_(0)
+    , streamClientCount_(0)
+    , streamInterval_(DEFAULT_STREAM_INTERVAL) {
+}
+
+HttpServer::~HttpServer() {
+    shutdown();
+}
+
+bool HttpServer::initialize(int port, const std::string& bindAddress) {
+    if (initialized_) {
+        return true;
+    }
+
+#ifdef _WIN32
+    (void)port;
+    (void)bindAddress;
+    return false;
+#else
+    serverSocket_ = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (serverSocket_ < 0) {
+        return false;
+    }
+
+    int reuse = 1;
+    setsockopt(serverSocket_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(static_cast<uint16_t>(port));
+    if (inet_pton(AF_INET, bindAddress.c_str(), &address.sin_addr) != 1 ||
+        bind(serverSocket_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 ||
+        listen(serverSocket_, SOMAXCONN) < 0) {
+        close(serverSocket_);
+        serverSocket_ = -1;
+        return false;
+    }
+
+    epollFd_ = epoll_create1(EPOLL_CLOEXEC);
+    wakeFd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (epollFd_ < 0 || wakeFd_ < 0) {
+        shutdown();
+        return false;
+    }
+
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.fd = serverSocket_;
+    epoll_ctl(epollFd_, EPOLL_CTL_ADD, serverSocket_, &event);
+    event.data.fd = wakeFd_;
+    epoll_ctl(epollFd_, EPOLL_CTL_ADD, wakeFd_, &event);
+
+    initialized_ = true;
+    return true;
+#endif
+}
+
+bool HttpServer::start() {
+    if (!initialized_ || running_) {
+        return false;
+    }
+
+    running_ = true;
+    for (size_t i = 0; i < WORKER_THREADS; ++i) {
+        workers_.emplace_back(&HttpServer::workerThread, this);
+    }
+    serverThread_ = std::thread(&HttpServer::serverThread, this);
+    return true;
+}
+
+void HttpServer::stop() {
+    if (!running_) {
+        return;
+    }
+
+    running_ = false;
+    wake();
+    if (serverThread_.joinable()) {
+        serverThread_.join();
+    }
+
+    // Queued jobs are dropped; running ones finish first
+    {
+        std::lock_guard<std::mutex> lock(jobMutex_);
+        jobs_.clear();
+    }
+    jobCondition_.notify_all();
+    for (auto& worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    workers_.clear();
+
+    std::lock_guard<std::mutex> lock(pendingMutex_);
+    completedSnapshots_.clear();
+    completedExports_.clear();
+}
+
+void HttpServer::shutdown() {
+    stop();
+
+#ifndef _WIN32
+    for (auto& entry : connections_) {
+        close(entry.first);
+    }
+    connections_.clear();
+    topics_.clear();
+    snapshotCache_.clear();
+    inFlight_.clear();
+    connectionCount_ = 0;
+    streamClientCount_ = 0;
+
+    if (serverSocket_ >= 0) {
+        close(serverSocket_);
+        serverSocket_ = -1;
+    }
+    if (wakeFd_ >= 0) {
+        close(wakeFd_);
+        wakeFd_ = -1;
+    }
+    if (epollFd_ >= 0) {
+        close(epollFd_);
+        epollFd_ = -1;
+    }
+#endif
+    initialized_ = false;
+}
+
+void HttpServer::setCommandHandler(CommandHandler handler) {
+    commandHandler_ = std::move(handler);
+}
+
+void HttpServer::setExportHandler(ExportHandler handler) {
+    exportHandler_ = std::move(handler);
+}
+
+void HttpServer::setAuthToken(const std::string& token) {
+    authToken_ = token;
+}
+
+void HttpServer::setStreamInterval(std::chrono::milliseconds interval) {
+    streamInterval_ = std::max(interval, std::chrono::milliseconds(100));
+}
+
+void HttpServer::publishEvent(const Event& event) {
+    if (!running_) {
+        return;
+    }
+    publishEvent(event, IpcProtocol::serializeEvent(event));
+}
+
+void HttpServer::publishEvent(const Event& event, const std::string& serializedEvent) {
+    if (!running_) {
+        return;
+    }
+
+    // Framed once here; every /events client gets the same buffer
+    std::string frame = "id: " + event.id + "\n";
+    Buffer buffer = makeBuffer(frame + *makeSseFrame(event.type, serializedEvent));
+
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        if (pendingEvents_.size() >= MAX_PENDING_EVENTS) {
+            pendingEvents_.erase(pendingEvents_.begin());
+        }
+        pendingEvents_.emplace_back(event.module, std::move(buffer));
+    }
+    wake();
+}
+
+bool HttpServer::isRunning() const {
+    return running_;
+}
+
+size_t HttpServer::getConnectionCount() const {
+    return connectionCount_;
+}
+
+size_t HttpServer::getStreamClientCount() const {
+    return streamClientCount_;
+}
+
+void HttpServer::serverThread() {
+#ifndef _WIN32
+    std::vector<epoll_event> events(256);
+    auto lastHousekeeping = std::chrono::steady_clock::now();
+
+    while (running_) {
+        try {
+            int count = epoll_wait(epollFd_, events.data(), static_cast<int>(events.size()), 100);
+            if (count < 0 && errno != EINTR) {
+                break;
+            }
+
+            for (int i = 0; i < count; ++i) {
+                int fd = events[i].data.fd;
+                uint32_t flags = events[i].events;
+
+                if (fd == serverSocket_) {
+                    acceptConnections();
+                    continue;
+                }
+                if (fd == wakeFd_) {
+                    uint64_t value;
+                    ssize_t received = read(wakeFd_, &value, sizeof(value));
+                    (void)received;
+                    drainPublishedEvents();
+                    completeSnapshots();
+                    completeExports();
+                    continue;
+                }
+
+                auto it = connections_.find(fd);
+                if (it == connections_.end()) {
+                    continue;
+                }
+
+                bool keep = !(flags & (EPOLLHUP | EPOLLERR));
+                if (keep && (flags & EPOLLIN)) {
+                    keep = handleReadable(it->second);
+                }
+                if (keep && (flags & EPOLLOUT)) {
+                    keep = handleWritable(it->second);
+                }
+                if (!keep) {
+                    closeConnection(fd);
+                }
+            }
+
+            publishTopics();
+
+            auto now = std::chrono::steady_clock::now();
+            if (now - lastHousekeeping >= std::chrono::seconds(1)) {
+                lastHousekeeping = now;
+                sendKeepAlives();
+                closeIdleConnections();
+            }
+        } catch (const std::exception& e) {
+            // Log error but continue
+            std::this_thread::sleep_for(std::chrono::seconds(1));
+        }
+    }
+#endif
+}
+
+void HttpServer::acceptConnections() {
+#ifndef _WIN32
+    while (true) {
+        int clientFd = accept4(serverSocket_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (clientFd < 0) {
+            return;
+        }
+
+        if (connections_.size() >= MAX_CONNECTIONS) {
+            close(clientFd);
+            continue;
+        }
+
+        int noDelay = 1;
+        setsockopt(clientFd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+
+        Connection connection;
+        connection.fd = clientFd;
+        connection.serial = nextSerial_++;
+        connection.outputOffset = 0;
+        connection.outputBytes = 0;
+        connection.isStream = false;
+        connection.closeAfterWrite = false;
+        connection.wantWrite = false;
+        connection.waiting = false;
+        connection.exporting = false;
+        connection.lastActivity = std::chrono::steady_clock::now();
+
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLRDHUP;
+        event.data.fd = clientFd;
+        if (epoll_ctl(epollFd_, EPOLL_CTL_ADD, clientFd, &event) < 0) {
+            close(clientFd);
+            continue;
+        }
+
+        connections_.emplace(clientFd, std::move(connection));
+        connectionCount_ = connections_.size();
+    }
+#endif
+}
+
+bool HttpServer::handleReadable(Connection& connection) {
+#ifdef _WIN32
+    (void)connection;
+    return false;
+#else
+    char buffer[4096];
+    while (true) {
+        ssize_t received = recv(connection.fd, buffer, sizeof(buffer), 0);
+        if (received == 0) {
+            return false;
+        }
+        if (received < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                break;
+            }
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        // Stream and export clients have nothing more to say
+        if (!connection.isStream && !connection.exporting) {
+            connection.input.append(buffer, static_cast<size_t>(received));
+        }
+    }
+    connection.lastActivity = std::chrono::steady_clock::now();
+
+    // Pipelining behind a slow command is fine, flooding it is not
+    if (connection.waiting && connection.input.size() > MAX_REQUEST_SIZE) {
+        return false;
+    }
+
+    processInput(connection);
+
+    if (connection.outputBytes > 0) {
+        return handleWritable(connection);
+    }
+    return !connection.closeAfterWrite;
+#endif
+}
+
+void HttpServer::processInput(Connection& connection) {
+    // Pipelined requests are answered in order, so parsing stops while one
+    // waits for a worker
+    while (!connection.isStream && !connection.exporting && !connection.waiting && !connection.closeAfterWrite) {
+        size_t headerEnd = connection.input.find("\r\n\r\n");
+        if (headerEnd == std::string::npos) {
+            if (connection.input.size() > MAX_REQUEST_SIZE) {
+                queueResponse(connection, 431, "text/plain", makeBuffer("Request header too large\n"), false);
+            }
+            break;
+        }
+
+        std::istringstream stream(connection.input.substr(0, headerEnd));
+        connection.input.erase(0, headerEnd + 4);
+
+        std::string requestLine;
+        std::getline(stream, requestLine);
+        if (!requestLine.empty() && requestLine.back() == '\r') {
+            requestLine.pop_back();
+        }
+
+        std::string method, target, version;
+        std::istringstream lineStream(requestLine);
+        lineStream >> method >> target >> version;
+        if (method.empty() || target.empty() || version.compare(0, 5, "HTTP/") != 0) {
+            queueResponse(connection, 400, "text/plain", makeBuffer("Bad request\n"), false);
+            break;
+        }
+
+        std::map<std::string, std::string> headers;
+        std::string line;
+        while (std::getline(stream, line)) {
+            if (!line.empty() && line.back() == '\r') {
+                line.pop_back();
+            }
+            size_t colon = line.find(':');
+            if (colon == std::string::npos) {
+                continue;
+            }
+            size_t valueStart = line.find_first_not_of(" \t", colon + 1);
+            headers[toLower(line.substr(0, colon))] =
+                valueStart == std::string::npos ? "" : line.substr(valueStart);
+        }
+
+        // HTTP/1.1 defaults to keep-alive, HTTP/1.0 to close
+        std::string connectionHeader = toLower(headers["connection"]);
+        bool keepAlive = version == "HTTP/1.1" ? connectionHeader != "close" : connectionHeader == "keep-alive";
+
+        // Only GET is served, so a request body means the client is confused
+        if (method != "GET" || (!headers["content-length"].empty() && headers["content-length"] != "0") ||
+            !headers["transfer-encoding"].empty()) {
+            queueResponse(connection, 405, "text/plain", makeBuffer("Only GET is supported\n"), false);
+            break;
+        }
+
+        handleRequest(connection, method, target, headers, keepAlive);
+    }
+}
+
+bool HttpServer::handleWritable(Connection& connection) {
+#ifdef _WIN32
+    (void)connection;
+    return false;
+#else
+    while (!connection.output.empty()) {
+        const std::string& front = *connection.output.front();
+        ssize_t sent = send(connection.fd, front.data() + connection.outputOffset,
+                            front.size() - connection.outputOffset, MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                break;
+            }
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+
+        connection.outputOffset += static_cast<size_t>(sent);
+        connection.outputBytes -= static_cast<size_t>(sent);
+        if (connection.outputOffset == front.size()) {
+            connection.output.pop_front();
+            connection.outputOffset = 0;
+        }
+    }
+
+    if (connection.output.empty() && connection.closeAfterWrite) {
+        return false;
+    }
+
+    pumpExport(connection);
+    updateInterest(connection);
+    return true;
+#endif
+}
+
+void HttpServer::closeConnection(int fd) {
+#ifndef _WIN32
+    auto it = connections_.find(fd);
+    if (it == connections_.end()) {
+        return;
+    }
+
+    if (it->second.isStream) {
+        streamClientCount_--;
+        auto topic = topics_.find(it->second.topic);
+        if (topic != topics_.end()) {
+            topic->second.subscribers.erase(fd);
+            if (topic->second.subscribers.empty()) {
+                topics_.erase(topic);
+            }
+        }
+    }
+
+    epoll_ctl(epollFd_, EPOLL_CTL_DEL, fd, nullptr);
+    close(fd);
+    connections_.erase(it);
+    connectionCount_ = connections_.size();
+#else
+    (void)fd;
+#endif
+}
+
+void HttpServer::drainPublishedEvents() {
+    std::vector<std::pair<Module, Buffer>> events;
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        events.swap(pendingEvents_);
+    }
+    if (events.empty() || streamClientCount_ == 0) {
+        return;
+    }
+
+    std::vector<int> closing;
+    for (auto& entry : connections_) {
+        Connection& connection = entry.second;
+        if (!connection.isStream || !connection.topic.empty()) {
+            continue;
+        }
+
+        bool keep = true;
+        for (const auto& event : events) {
+            if (!connection.modules.empty() && connection.modules.count(event.first) == 0) {
+                continue;
+            }
+            if (!queue(connection, event.second)) {
+                keep = false;
+                break;
+            }
+            connection.lastActivity = std::chrono::steady_clock::now();
+        }
+        if (keep && connection.outputBytes > 0) {
+            keep = handleWritable(connection);
+        }
+        if (!keep) {
+            closing.push_back(entry.first);
+        }
+    }
+
+    for (int fd : closing) {
+        closeConnection(fd);
+    }
+}
+
+void HttpServer::completeSnapshots() {
+    std::vector<SnapshotResult> results;
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        results.swap(completedSnapshots_);
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    std::vector<int> closing;
+    for (auto& result : results) {
+        snapshotCache_[result.cacheKey] = CachedBody{result.body, result.ok, result.headers, now + SNAPSHOT_CACHE_TTL};
+
+        std::vector<Waiter> waiters;
+        auto flight = inFlight_.find(result.cacheKey);
+        if (flight != inFlight_.end()) {
+            waiters.swap(flight->second);
+            inFlight_.erase(flight);
+        }
+
+        for (const auto& waiter : waiters) {
+            Connection* connection = findConnection(waiter.fd, waiter.serial);
+            if (!connection) {
+                continue;
+            }
+            connection->waiting = false;
+            connection->lastActivity = now;
+            queueResponse(*connection, result.ok ? 200 : 502, "application/json", result.body,
+                          waiter.keepAlive, result.headers);
+            processInput(*connection);
+            if (!handleWritable(*connection)) {
+                closing.push_back(waiter.fd);
+            }
+        }
+
+        auto topic = topics_.find(result.cacheKey);
+        if (topic != topics_.end() && topic->second.waiting) {
+            topic->second.waiting = false;
+            publishTopicFrame(topic->second, result.body, result.ok, closing);
+        }
+    }
+
+    for (int fd : closing) {
+        closeConnection(fd);
+    }
+}
+
+void HttpServer::completeExports() {
+    std::vector<ExportResult> results;
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        results.swap(completedExports_);
+    }
+
+    for (auto& result : results) {
+        // The client may have gone away while the worker was busy
+        Connection* connection = findConnection(result.fd, result.serial);
+        if (!connection) {
+            continue;
+        }
+        connection->waiting = false;
+        connection->lastActivity = std::chrono::steady_clock::now();
+
+        bool keep = true;
+        for (auto& frame : result.frames) {
+            keep = keep && queue(*connection, std::move(frame));
+        }
+        if (result.finished) {
+            connection->exporting = false;
+            connection->closeAfterWrite = true;
+            keep = keep && queue(*connection, makeBuffer("0\r\n\r\n"));
+        } else {
+            connection->exporter = std::move(result.exporter);
+        }
+
+        if (!keep || !handleWritable(*connection)) {
+            closeConnection(result.fd);
+        }
+    }
+}
+
+void HttpServer::publishTopics() {
+    auto now = std::chrono::steady_clock::now();
+    std::vector<int> closing;
+
+    for (auto& entry : topics_) {
+        Topic& topic = entry.second;
+        if (now < topic.nextPublish || topic.waiting) {
+            continue;
+        }
+        topic.nextPublish = now + streamInterval_;
+
+        // One execution and one frame per tick, whatever the subscriber count
+        const CachedBody* cached = freshSnapshot(entry.first);
+        if (cached) {
+            publishTopicFrame(topic, cached->body, cached->ok, closing);
+            continue;
+        }
+        topic.waiting = true;
+        requestSnapshot(entry.first, topic.command, nullptr);
+    }
+
+    for (int fd : closing) {
+        closeConnection(fd);
+    }
+}
+
+void HttpServer::publishTopicFrame(Topic& topic, const Buffer& body, bool ok, std::vector<int>& closing) {
+    auto now = std::chrono::steady_clock::now();
+    Buffer frame = makeSseFrame(ok ? "snapshot" : "error", *body);
+
+    for (int fd : topic.subscribers) {
+        auto it = connections_.find(fd);
+        if (it == connections_.end()) {
+            continue;
+        }
+        it->second.lastActivity = now;
+        if (!queue(it->second, frame) || !handleWritable(it->second)) {
+            closing.push_back(fd);
+        }
+    }
+}
+
+void HttpServer::sendKeepAlives() {
+    if (streamClientCount_ == 0) {
+        return;
+    }
+
+    // Comment frames keep proxies from timing out quiet event streams
+    static const Buffer keepAlive = makeBuffer(SSE_KEEPALIVE);
+    auto now = std::chrono::steady_clock::now();
+    std::vector<int> closing;
+
+    for (auto& entry : connections_) {
+        Connection& connection = entry.second;
+        if (!connection.isStream || now - connection.lastActivity < KEEPALIVE_INTERVAL) {
+            continue;
+        }
+        connection.lastActivity = now;
+        if (!queue(connection, keepAlive) || !handleWritable(connection)) {
+            closing.push_back(entry.first);
+        }
+    }
+
+    for (int fd : closing) {
+        closeConnection(fd);
+    }
+}
+
+void HttpServer::closeIdleConnections() {
+    auto now = std::chrono::steady_clock::now();
+    std::vector<int> closing;
+
+    for (const auto& entry : connections_) {
+        if (!entry.second.isStream && now - entry.second.lastActivity > IDLE_TIMEOUT) {
+            closing.push_back(entry.first);
+        }
+    }
+
+    for (int fd : closing) {
+        closeConnection(fd);
+    }
+
+    // Expired snapshots are only worth keeping while they are fresh
+    for (auto it = snapshotCache_.begin(); it != snapshotCache_.end();) {
+        if (now > it->second.expires) {
+            it = snapshotCache_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void HttpServer::handleRequest(Connection& connection, const std::string& method, const std::string& target,
+                               const std::map<std::string, std::string>& headers, bool keepAlive) {
+    (void)method;
+
+    size_t queryStart = target.find('?');
+    std::string path = urlDecode(target.substr(0, queryStart));
+    std::map<std::string, std::string> query =
+        queryStart == std::string::npos ? std::map<std::string, std::string>() : parseQuery(target.substr(queryStart + 1));
+
+    if (path == "/health") {
+        std::string body = "{\"status\":\"ok\",\"connections\":" + std::to_string(connections_.size()) +
+                           ",\"streams\":" + std::to_string(streamClientCount_.load()) + "}";
+        queueResponse(connection, 200, "application/json", makeBuffer(body), keepAlive);
+        return;
+    }
+
+    if (!isAuthorized(headers, query)) {
+        queueResponse(connection, 401, "text/plain", makeBuffer("Unauthorized\n"), keepAlive);
+        return;
+    }
+    query.erase("token");
+
+    if (path == "/events") {
+        startEventStream(connection, query);
+        return;
+    }
+
+    if (path == "/export") {
+        startExport(connection, query, keepAlive);
+        return;
+    }
+
+    std::string route;
+    if (path.compare(0, 5, "/api/") == 0) {
+        route = path.substr(4);
+    } else if (path.compare(0, 8, "/stream/") == 0) {
+        route = path.substr(7);
+    } else {
+        queueResponse(connection, 404, "text/plain", makeBuffer("Not found\n"), keepAlive);
+        return;
+    }
+
+    Command command;
+    std::string error;
+    if (!buildCommand(route, query, command, error)) {
+        queueResponse(connection, 404, "text/plain", makeBuffer(error + "\n"), keepAlive);
+        return;
+    }
+
+    // Query parameters come out of std::map sorted, so equal requests share a key
+    std::string cacheKey = moduleToString(command.module) + "/" + commandTypeToString(command.type);
+    for (const auto& param : command.parameters) {
+        cacheKey += "&" + param.first + "=" + param.second;
+    }
+
+    if (path.compare(0, 8, "/stream/") == 0) {
+        startTopicStream(connection, cacheKey, command);
+        return;
+    }
+
+    const CachedBody* cached = freshSnapshot(cacheKey);
+    if (cached) {
+        queueResponse(connection, cached->ok ? 200 : 502, "application/json", cached->body, keepAlive,
+                      cached->headers);
+        return;
+    }
+
+    // Answered from completeSnapshots() once a worker has run the command
+    Waiter waiter{connection.fd, connection.serial, keepAlive};
+    connection.waiting = true;
+    requestSnapshot(cacheKey, command, &waiter);
+}
+
+bool HttpServer::isAuthorized(const std::map<std::string, std::string>& headers,
+                              const std::map<std::string, std::string>& query) const {
+    if (authToken_.empty()) {
+        return true;
+    }
+
+    auto header = headers.find("authorization");
+    if (header != headers.end() && header->second == "Bearer " + authToken_) {
+        return true;
+    }
+
+    // EventSource cannot set headers, so browsers pass the token in the URL
+    auto param = query.find("token");
+    return param != query.end() && param->second == authToken_;
+}
+
+bool HttpServer::buildCommand(const std::string& path, const std::map<std::string, std::string>& query,
+                              Command& command, std::string& error) const {
+    // path is "/<module>/<COMMAND>"
+    size_t separator = path.find('/', 1);
+    if (path.size() < 2 || separator == std::string::npos) {
+        error = "Expected /<module>/<command>";
+        return false;
+    }
+
+    Module module;
+    if (!parseModule(path.substr(1, separator - 1), module)) {
+        error = "Unknown module";
+        return false;
+    }
+
+    // Only read-only commands are reachable over HTTP
+    std::string name = toUpper(path.substr(separator + 1));
+    CommandType type = stringToCommandType(name);
+    if (name.compare(0, 4, "GET_") != 0 || commandTypeToString(type) != name) {
+        error = "Unknown or non-GET command";
+        return false;
+    }
+
+    command = createCommand(type, module, query);
+    return true;
+}
+
+const HttpServer::CachedBody* HttpServer::freshSnapshot(const std::string& cacheKey) const {
+    auto cached = snapshotCache_.find(cacheKey);
+    if (cached == snapshotCache_.end() || std::chrono::steady_clock::now() > cached->second.expires) {
+        return nullptr;
+    }
+    return &cached->second;
+}
+
+void HttpServer::requestSnapshot(const std::string& cacheKey, const Command& command, const Waiter* waiter) {
+    // Requests for a key already being produced wait for the same result
+    auto flight = inFlight_.find(cacheKey);
+    if (flight == inFlight_.end()) {
+        flight = inFlight_.emplace(cacheKey, std::vector<Waiter>()).first;
+        submit([this, cacheKey, command]() {
+            SnapshotResult result;
+            result.cacheKey = cacheKey;
+            try {
+                result.body = executeCommand(command, result.ok, result.headers);
+            } catch (const std::exception& e) {
+                // Waiters still need an answer
+                result.ok = false;
+                result.body = makeBuffer("{\"error\":\"Command failed\"}");
+            }
+            {
+                std::lock_guard<std::mutex> lock(pendingMutex_);
+                completedSnapshots_.push_back(std::move(result));
+            }
+            wake();
+        });
+    }
+    if (waiter) {
+        flight->second.push_back(*waiter);
+    }
+}
+
+HttpServer::Buffer HttpServer::executeCommand(const Command& command, bool& ok, std::string& headers) const {
+    if (!commandHandler_) {
+        ok = false;
+        return makeBuffer("{\"error\":\"No command handler\"}");
+    }
+
+    Command fresh = command;
+    fresh.id = std::to_string(std::chrono::system_clock::now().time_since_epoch().count());
+    fresh.timestamp = std::chrono::system_clock::now();
+    Response response = commandHandler_(fresh);
+
+    // List commands carry a ready-made JSON document; anything else gets the
+    // regular IPC response envelope
+    ok = response.status == CommandStatus::SUCCESS;
+    auto data = response.data.find("data");
+    Buffer body = makeBuffer(ok && data != response.data.end() ? data->second
+                                                              : IpcProtocol::serializeResponse(response));
+
+    // The bare document loses the envelope, so freshness travels in headers
+    headers.clear();
+    auto stale = response.data.find("stale");
+    auto age = response.data.find("data_age_ms");
+    if (stale != response.data.end() && age != response.data.end()) {
+        headers = "X-SysMon-Stale: " + std::string(stale->second == "1" ? "true" : "false") + "\r\n";
+        headers += "X-SysMon-Data-Age-Ms: " + age->second + "\r\n";
+    }
+    return body;
+}
+
+void HttpServer::startEventStream(Connection& connection, const std::map<std::string, std::string>& query) {
+    auto modules = query.find("modules");
+    if (modules != query.end()) {
+        std::istringstream stream(modules->second);
+        std::string name;
+        while (std::getline(stream, name, ',')) {
+            Module module;
+            if (parseModule(name, module)) {
+                connection.modules.insert(module);
+            }
+        }
+    }
+
+    connection.isStream = true;
+    connection.input.clear();
+    streamClientCount_++;
+    queueResponse(connection, 200, "text/event-stream", makeBuffer(": connected\n\n"), true);
+}
+
+void HttpServer::startTopicStream(Connection& connection, const std::string& target, const Command& command) {
+    auto it = topics_.find(target);
+    if (it == topics_.end()) {
+        Topic topic;
+        topic.command = command;
+        topic.nextPublish = std::chrono::steady_clock::now();
+        topic.waiting = false;
+        it = topics_.emplace(target, std::move(topic)).first;
+    }
+    it->second.subscribers.insert(connection.fd);
+
+    connection.isStream = true;
+    connection.topic = target;
+    connection.input.clear();
+    streamClientCount_++;
+    queueResponse(connection, 200, "text/event-stream", makeBuffer(": connected\n\n"), true);
+
+    // New subscribers see the latest snapshot without waiting for a tick
+    auto cached = snapshotCache_.find(target);
+    if (cached != snapshotCache_.end() && cached->second.ok) {
+        queue(connection, makeSseFrame("snapshot", *cached->second.body));
+    }
+}
+
+void HttpServer::startExport(Connection& connection, const std::map<std::string, std::string>& query,
+                             bool keepAlive) {
+    if (!exportHandler_) {
+        queueResponse(connection, 404, "text/plain", makeBuffer("Export not available\n"), keepAlive);
+        return;
+    }
+
+    std::string error;
+    std::unique_ptr<HistoryExport> exporter = exportHandler_(query, error);
+    if (!exporter) {
+        queueResponse(connection, 400, "text/plain", makeBuffer(error + "\n"), keepAlive);
+        return;
+    }
+
+    // The length is unknown up front, so the body is sent chunked and the
+    // connection closes after the last chunk
+    HistoryExport::Format exportFormat = exporter->getFormat();
+    std::string header = "HTTP/1.1 200 OK\r\n";
+    header += "Content-Type: " + std::string(HistoryExport::contentType(exportFormat)) + "\r\n";
+    header += "Content-Disposition: attachment; filename=\"sysmon-history." +
+              std::string(HistoryExport::fileExtension(exportFormat)) + "\"\r\n";
+    header += "Cache-Control: no-cache\r\n";
+    header += "Transfer-Encoding: chunked\r\n";
+    header += "Connection: close\r\n\r\n";
+    queue(connection, makeBuffer(std::move(header)));
+
+    connection.exporter = std::move(exporter);
+    connection.exporting = true;
+    connection.input.clear();
+}
+
+void HttpServer::pumpExport(Connection& connection) {
+    // Only refill once the client has taken most of what is queued, so a
+    // slow reader holds back the archive instead of growing the queue. A
+    // sparse selection can scan many segments per chunk, so chunks are
+    // produced on a worker, which holds the exporter meanwhile.
+    if (!connection.exporter || connection.waiting || connection.outputBytes >= EXPORT_LOW_WATERMARK) {
+        return;
+    }
+
+    std::shared_ptr<HistoryExport> exporter = std::move(connection.exporter);
+    size_t budget = EXPORT_LOW_WATERMARK - connection.outputBytes;
+    int fd = connection.fd;
+    uint64_t serial = connection.serial;
+    connection.waiting = true;
+
+    submit([this, fd, serial, exporter, budget]() {
+        ExportResult result{fd, serial, exporter, {}, false};
+        size_t produced = 0;
+        std::string chunk;
+        while (produced < budget && running_) {
+            bool more = false;
+            try {
+                more = exporter->nextChunk(chunk);
+            } catch (const std::exception& e) {
+                // Ends the body early; the client sees a short export
+            }
+            if (!more) {
+                result.finished = true;
+                break;
+            }
+            if (chunk.empty()) {
+                continue;
+            }
+
+            char size[20];
+            std::snprintf(size, sizeof(size), "%zx\r\n", chunk.size());
+            std::string frame;
+            frame.reserve(chunk.size() + 24);
+            frame += size;
+            frame += chunk;
+            frame += "\r\n";
+            produced += frame.size();
+            result.frames.push_back(makeBuffer(std::move(frame)));
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(pendingMutex_);
+            completedExports_.push_back(std::move(result));
+        }
+        wake();
+    });
+}
+
+HttpServer::Connection* HttpServer::findConnection(int fd, uint64_t serial) {
+    auto it = connections_.find(fd);
+    return it != connections_.end() && it->second.serial == serial ? &it->second : nullptr;
+}
+
+void HttpServer::workerThread() {
+    while (true) {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(jobMutex_);
+            jobCondition_.wait(lock, [this] { return !running_ || !jobs_.empty(); });
+            if (!running_) {
+                break;
+            }
+            job = std::move(jobs_.front());
+            jobs_.pop_front();
+        }
+
+        try {
+            job();
+        } catch (const std::exception& e) {
+            // Jobs report their own failures; nothing is left to tell anyone
+        }
+    }
+}
+
+void HttpServer::submit(std::function<void()> job) {
+    {
+        std::lock_guard<std::mutex> lock(jobMutex_);
+        jobs_.push_back(std::move(job));
+    }
+    jobCondition_.notify_one();
+}
+
+void HttpServer::wake() {
+#ifndef _WIN32
+    uint64_t one = 1;
+    ssize_t written = write(wakeFd_, &one, sizeof(one));
+    (void)written;
+#endif
+}
+
+bool HttpServer::queue(Connection& connection, Buffer buffer) {
+    // A stream client that cannot keep up is dropped rather than buffered forever
+    if (connection.outputBytes + buffer->size() > MAX_PENDING_OUTPUT) {
+        return false;
+    }
+
+    connection.outputBytes += buffer->size();
+    connection.output.push_back(std::move(buffer));
+    return true;
+}
+
+void HttpServer::queueResponse(Connection& connection, int status, const std::string& contentType,
+                               Buffer body, bool keepAlive, const std::string& extraHeaders) {
+    std::string header = "HTTP/1.1 " + std::to_string(status) + " " + statusText(status) + "\r\n";
+    header += "Content-Type: " + contentType + "\r\n";
+    header += "Cache-Control: no-cache\r\n";
+    header += extraHeaders;
+
+    if (contentType == "text/event-stream") {
+        // Streams have no length and end when either side closes
+        header += "Connection: keep-alive\r\n";
+        header += "X-Accel-Buffering: no\r\n";
+    } else {
+        header += "Content-Length: " + std::to_string(body->size()) + "\r\n";
+        header += keepAlive ? "Connection: keep-alive\r\n" : "Connection: close\r\n";
+    }
+    header += "\r\n";
+
+    // Header and body are separate buffers so the body stays shared
+    queue(connection, makeBuffer(std::move(header)));
+    queue(connection, std::move(body));
+    if (!keepAlive) {
+        connection.closeAfterWrite = true;
+    }
+}
+
+void HttpServer::updateInterest(Connection& connection) {
+#ifndef _WIN32
+    // A running export is refilled from handleWritable() as the socket drains
+    // and from completeExports() when a worker hands chunks back
+    bool wantWrite = !connection.output.empty();
+    if (wantWrite == connection.wantWrite) {
+        return;
+    }
+
+    epoll_event event{};
+    event.events = EPOLLIN | EPOLLRDHUP | (wantWrite ? static_cast<uint32_t>(EPOLLOUT) : 0u);
+    event.data.fd = connection.fd;
+    epoll_ctl(epollFd_, EPOLL_CTL_MOD, connection.fd, &event);
+    connection.wantWrite = wantWrite;
+#else
+    (void)connection;
+#endif
+}
+
+HttpServer::Buffer HttpServer::makeBuffer(std::string data) {
+    return std::make_shared<const std::string>(std::move(data));
+}
+
+HttpServer::Buffer HttpServer::makeSseFrame(const std::string& eventName, const std::string& data) {
+    std::string frame;
+    frame.reserve(data.size() + eventName.size() + 16);
+    frame += "event: " + eventName + "\n";
+
+    // Each payload line needs its own data: prefix
+    size_t start = 0;
+    while (start <= data.size()) {
+        size_t end = data.find('\n', start);
+        if (end == std::string::npos) {
+            end = data.size();
+        }
+        frame += "data: ";
+        frame.append(data, start, end - start);
+        frame += "\n";
+        start = end + 1;
+    }
+    frame += "\n";
+    return makeBuffer(std::move(frame));
+}
+
+std::string HttpServer::statusText(int status) {
+    switch (status) {
+        case 200: return "OK";
+        case 400: return "Bad Request";
+        case 401: return "Unauthorized";
+        case 404: return "Not Found";
+        case 405: return "Method Not Allowed";
+        case 431: return "Request Header Fields Too Large";
+        case 502: return "Bad Gateway";
+        default: return "Error";
+    }
+}
+
+std::string HttpServer::urlDecode(const std::string& value) {
+    std::string result;
+    result.reserve(value.size());
+
+    for (size_t i = 0; i < value.size(); ++i) {
+        if (value[i] == '%' && i + 2 < value.size() &&
+            std::isxdigit(static_cast<unsigned char>(value[i + 1])) &&
+            std::isxdigit(static_cast<unsigned char>(value[i + 2]))) {
+            result += static_cast<char>(std::stoi(value.substr(i + 1, 2), nullptr, 16));
+            i += 2;
+        } else if (value[i] == '+') {
+            result += ' ';
+        } else {
+            result += value[i];
+        }
+    }
+    return result;
+}
+
+std::map<std::string, std::string> HttpServer::parseQuery(const std::string& query) {
+    std::map<std::string, std::string> params;
+    std::istringstream stream(query);
+    std::string pair;
+
+    while (std::getline(stream, pair, '&')) {
+        if (pair.empty()) {
+            continue;
+        }
+        size_t equals = pair.find('=');
+        if (equals == std::string::npos) {
+            params[urlDecode(pair)] = "";
+        } else {
+            params[urlDecode(pair.substr(0, equals))] = urlDecode(pair.substr(equals + 1));
+        }
+    }
+    return params;
+}
+
+} // namespace SysMon
@@ -0,0 +1,222 @@
+#pragma once
+
+#include "../shared/commands.h"
+#include "historyexport.h"
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <vector>
+#include <deque>
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <chrono>
+
+namespace SysMon {
+
+// HTTP Server - optional read-only HTTP/1.1 endpoint for dashboards and scripts
+//
+// One thread multiplexes every connection with epoll, so idle keep-alive and
+// SSE clients only cost a socket and a small state record. Commands and
+// export chunks run on a few worker threads and their results are posted
+// back to the loop, so a slow command (adb waiting out its timeout) only
+// holds back the clients that asked for it. Payloads are shared, immutable
+// buffers: a snapshot or event is serialized once and the same buffer is
+// queued on every connection that wants it.
+//
+//   GET /api/<module>/<GET_COMMAND>?param=value   JSON snapshot
+//   GET /stream/<module>/<GET_COMMAND>?...         SSE, snapshot every interval
+//   GET /events?modules=device,system              SSE, agent events
+//   GET /export?series=...&from=&to=&format=csv    chunked CSV or Arrow download
+//   GET /health                                    liveness and client counts
+class HttpServer {
+public:
+    using CommandHandler = std::function<Response(const Command&)>;
+    using ExportHandler = std::function<std::unique_ptr<HistoryExport>(
+        const std::map<std::string, std::string>& query, std::string& error)>;
+
+    HttpServer();
+    ~HttpServer();
+
+    // Lifecycle
+    bool initialize(int port, const std::string& bindAddress);
+    bool start();
+    void stop();
+    void shutdown();
+
+    // Configuration
+    void setCommandHandler(CommandHandler handler);
+    void setExportHandler(ExportHandler handler);
+    void setAuthToken(const std::string& token);
+    void setStreamInterval(std::chrono::milliseconds interval);
+
+    // Event publishing (any thread); the serialized form lets callers share
+    // one serialization with the IPC broadcast
+    void publishEvent(const Event& event);
+    void publishEvent(const Event& event, const std::string& serializedEvent);
+
+    // Status
+    bool isRunning() const;
+    size_t getConnectionCount() const;
+    size_t getStreamClientCount() const;
+
+private:
+    using Buffer = std::shared_ptr<const std::string>;
+
+    // Per-connection state
+    struct Connection {
+        int fd;
+        uint64_t serial;            // tells a reused fd from the connection a result was for
+        std::string input;
+        std::deque<Buffer> output;
+        size_t outputOffset;
+        size_t outputBytes;
+        bool isStream;
+        bool closeAfterWrite;
+        bool wantWrite;
+        bool waiting;               // a snapshot or export chunk is being produced on a worker
+        bool exporting;             // /export in progress
+        std::set<Module> modules;   // /events filter, empty = all
+        std::string topic;          // /stream topic key
+        std::shared_ptr<HistoryExport> exporter;    // null while a worker holds it
+        std::chrono::steady_clock::time_point lastActivity;
+    };
+
+    // Snapshot stream shared by all subscribers of the same target
+    struct Topic {
+        Command command;
+        std::set<int> subscribers;
+        std::chrono::steady_clock::time_point nextPublish;
+        bool waiting;               // this tick's snapshot is being produced
+    };
+
+    // Cached snapshot body
+    struct CachedBody {
+        Buffer body;
+        bool ok;
+        std::string headers;        // freshness headers for plain GETs
+        std::chrono::steady_clock::time_point expires;
+    };
+
+    // A plain GET waiting for a snapshot
+    struct Waiter {
+        int fd;
+        uint64_t serial;
+        bool keepAlive;
+    };
+
+    // Worker results, handed back to the loop
+    struct SnapshotResult {
+        std::string cacheKey;
+        Buffer body;
+        bool ok;
+        std::string headers;
+    };
+
+    struct ExportResult {
+        int fd;
+        uint64_t serial;
+        std::shared_ptr<HistoryExport> exporter;
+        std::vector<Buffer> frames;
+        bool finished;
+    };
+
+    // Event loop
+    void serverThread();
+    void acceptConnections();
+    bool handleReadable(Connection& connection);
+    bool handleWritable(Connection& connection);
+    void closeConnection(int fd);
+    void drainPublishedEvents();
+    void completeSnapshots();
+    void completeExports();
+    void publishTopics();
+    void publishTopicFrame(Topic& topic, const Buffer& body, bool ok, std::vector<int>& closing);
+    void sendKeepAlives();
+    void closeIdleConnections();
+
+    // Request handling
+    void processInput(Connection& connection);
+    void handleRequest(Connection& connection, const std::string& method, const std::string& target,
+                       const std::map<std::string, std::string>& headers, bool keepAlive);
+    bool isAuthorized(const std::map<std::string, std::string>& headers,
+                      const std::map<std::string, std::string>& query) const;
+    bool buildCommand(const std::string& path, const std::map<std::string, std::string>& query,
+                      Command& command, std::string& error) const;
+    const CachedBody* freshSnapshot(const std::string& cacheKey) const;
+    void requestSnapshot(const std::string& cacheKey, const Command& command, const Waiter* waiter);
+    Buffer executeCommand(const Command& command, bool& ok, std::string& headers) const;
+    void startEventStream(Connection& connection, const std::map<std::string, std::string>& query);
+    void startTopicStream(Connection& connection, const std::string& target, const Command& command);
+    void startExport(Connection& connection, const std::map<std::string, std::string>& query, bool keepAlive);
+    void pumpExport(Connection& connection);
+    Connection* findConnection(int fd, uint64_t serial);
+
+    // Workers
+    void workerThread();
+    void submit(std::function<void()> job);
+    void wake();
+
+    // Output helpers
+    bool queue(Connection& connection, Buffer buffer);
+    void queueResponse(Connection& connection, int status, const std::string& contentType,
+                       Buffer body, bool keepAlive, const std::string& extraHeaders = "");
+    void updateInterest(Connection& connection);
+    static Buffer makeBuffer(std::string data);
+    static Buffer makeSseFrame(const std::string& eventName, const std::string& data);
+    static std::string statusText(int status);
+    static std::string urlDecode(const std::string& value);
+    static std::map<std::string, std::string> parseQuery(const std::string& query);
+
+    // Server state
+    int serverSocket_;
+    int epollFd_;
+    int wakeFd_;
+    std::atomic<bool> running_;
+    std::atomic<bool> initialized_;
+    std::thread serverThread_;
+
+    // Loop-owned state
+    std::unordered_map<int, Connection> connections_;
+    std::map<std::string, Topic> topics_;
+    std::map<std::string, CachedBody> snapshotCache_;
+    std::map<std::string, std::vector<Waiter>> inFlight_;      // one execution per cache key
+    uint64_t nextSerial_;
+    std::atomic<size_t> connectionCount_;
+    std::atomic<size_t> streamClientCount_;
+
+    // Events handed over from other threads
+    std::vector<std::pair<Module, Buffer>> pendingEvents_;
+    std::vector<SnapshotResult> completedSnapshots_;
+    std::vector<ExportResult> completedExports_;
+    std::mutex pendingMutex_;
+
+    // Worker pool
+    std::vector<std::thread> workers_;
+    std::deque<std::function<void()>> jobs_;
+    std::mutex jobMutex_;
+    std::condition_variable jobCondition_;
+
+    // Configuration
+    CommandHandler commandHandler_;
+    ExportHandler exportHandler_;
+    std::string authToken_;
+    std::chrono::milliseconds streamInterval_;
+
+    // Constants
+    static constexpr size_t MAX_CONNECTIONS = 4096;
+    static constexpr size_t MAX_REQUEST_SIZE = 16 * 1024;
+    static constexpr size_t MAX_PENDING_OUTPUT = 4 * 1024 * 1024;
+    static constexpr size_t MAX_PENDING_EVENTS = 1024;
+    static constexpr size_t EXPORT_LOW_WATERMARK = 256 * 1024;  // refill exports below this
+    static constexpr size_t WORKER_THREADS = 4;
+    static constexpr std::chrono::milliseconds SNAPSHOT_CACHE_TTL{250};
+    static constexpr std::chrono::seconds IDLE_TIMEOUT{60};
+    static constexpr std::chrono::seconds KEEPALIVE_INTERVAL{15};
+    static constexpr std::chrono::milliseconds DEFAULT_STREAM_INTERVAL{1000};
+};
+
+} // namespace SysMon
@@ -14,6 +14,8 @@
 #include <ws2tcpip.h>
 #else
 #include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
 #include <unistd.h>
@@ -25,6 +27,7 @@ namespace SysMon {
 
 IpcServer::IpcServer() 
     : serverSocket_(-1)
+    , unixSocket_(-1)
     , port_(Constants::DEFAULT_IPC_PORT)
     , running_(false)
     , initialized_(false)
@@ -45,12 +48,13 @@ IpcServer::~IpcServer() {
 #endif
 }
 
-bool IpcServer::initialize(int port) {
+bool IpcServer::initialize(int port, const std::string& socketPath) {
     if (initialized_) {
         return true;
     }
     
     port_ = port;
+    socketPath_ = socketPath;
     
     // Configure security manager
     securityManager_->setMaxMessageSize(Constants::MAX_MESSAGE_SIZE);
@@ -60,6 +64,13 @@ bool IpcServer::initialize(int port) {
         return false;
     }
     
+    // Local clients (e.g. sysmon_top over SSH) are optional; TCP keeps working without them
+    if (!socketPath_.empty() && !createUnixSocket(socketPath_)) {
+        if (logger_) {
+            logger_->warning("Unix socket " + socketPath_ + " unavailable, continuing with TCP only");
+        }
+    }
+    
     initialized_ = true;
     return true;
 }
@@ -209,13 +220,23 @@ void IpcServer::setEventHandler(EventHandler handler) {
     eventHandler_ = handler;
 }
 
+void IpcServer::setSubscriptionHandler(SubscriptionHandler handler) {
+    subscriptionHandler_ = handler;
+}
+
+void IpcServer::setDisconnectHandler(DisconnectHandler handler) {
+    disconnectHandler_ = handler;
+}
+
 void IpcServer::setLogger(Logger* logger) {
     logger_ = logger;
 }
 
 void IpcServer::broadcastEvent(const Event& event) {
-    std::string eventData = IpcProtocol::serializeEvent(event);
-    
+    broadcastSerializedEvent(IpcProtocol::serializeEvent(event));
+}
+
+void IpcServer::broadcastSerializedEvent(const std::string& eventData) {
     std::lock_guard<std::mutex> lock(clientsMutex_);
     for (const auto& client : clientSockets_) {
         sendMessage(client.second, eventData);
@@ -264,11 +285,20 @@ void IpcServer::serverThread() {
 }
 
 void IpcServer::acceptConnections() {
-    if (serverSocket_ == -1 || shuttingDown_) {
+    if (shuttingDown_) {
+        return;
+    }
+    
+    acceptConnection(serverSocket_);
+    acceptConnection(unixSocket_);
+}
+
+void IpcServer::acceptConnection(int listenSocket) {
+    if (listenSocket == -1 || shuttingDown_) {
         return;
     }
     
-    sockaddr_in clientAddr;
+    sockaddr_storage clientAddr;
 #ifdef _WIN32
     int clientAddrLen = sizeof(clientAddr);
 #else
@@ -276,9 +306,9 @@ void IpcServer::acceptConnections() {
 #endif
     
 #ifdef _WIN32
-    SOCKET clientSocket = accept(serverSocket_, (sockaddr*)&clientAddr, &clientAddrLen);
+    SOCKET clientSocket = accept(listenSocket, (sockaddr*)&clientAddr, &clientAddrLen);
 #else
-    int clientSocket = accept(serverSocket_, (sockaddr*)&clientAddr, &clientAddrLen);
+    int clientSocket = accept(listenSocket, (sockaddr*)&clientAddr, &clientAddrLen);
 #endif
     
     if (clientSocket == INVALID_SOCKET) {
@@ -293,13 +323,18 @@ void IpcServer::acceptConnections() {
         return;
     }
     
+    std::string clientAddress = "unix:" + socketPath_;
+    if (clientAddr.ss_family == AF_INET) {
+        clientAddress = inet_ntoa(reinterpret_cast<sockaddr_in*>(&clientAddr)->sin_addr);
+    }
+    
     // Log new connection
     if (logger_) {
-        logger_->info("New client connected from: " + std::string(inet_ntoa(clientAddr.sin_addr)) + 
+        logger_->info("New client connected from: " + clientAddress + 
                      " on socket " + std::to_string(clientSocket));
     }
     
-    std::cout << "New client connected from " << inet_ntoa(clientAddr.sin_addr) 
+    std::cout << "New client connected from " << clientAddress 
               << " on socket " << clientSocket << std::endl;
     
     // Check client limit
@@ -328,7 +363,6 @@ void IpcServer::acceptConnections() {
 #endif
     
     // Add client
-    std::string clientAddress = inet_ntoa(clientAddr.sin_addr);
     addClient(clientSocket, clientAddress);
     
     // Start client handler thread
@@ -341,23 +375,49 @@ void IpcServer::handleClient(const std::string& clientId, int socket) {
         logger_->info("Client handler started for ID: " + clientId);
     }
     
+    std::deque<QueuedMessage> queue;
+    
     try {
         while (running_ && !shuttingDown_) {
-            std::string message = receiveMessage(socket);
-            if (message.empty()) {
-                if (shuttingDown_) {
-                    if (logger_) {
-                        logger_->info("Client handler " + clientId + " exiting due to shutdown");
-                    }
-                } else {
-                    if (logger_) {
-                        logger_->info("Client " + clientId + " disconnected");
+            // Block only while idle; with work queued just check for new frames
+            int ready = 0;
+            if (queue.size() < MAX_QUEUED_MESSAGES) {
+                ready = waitForData(socket, queue.empty() ? IDLE_WAIT_MS : 0);
+            }
+            if (ready < 0) {
+                if (logger_) {
+                    logger_->error("Select failed on socket " + std::to_string(socket));
+                }
+                break;
+            }
+            
+            if (ready > 0) {
+                std::string message = receiveMessage(socket);
+                if (message.empty()) {
+                    if (shuttingDown_) {
+                        if (logger_) {
+                            logger_->info("Client handler " + clientId + " exiting due to shutdown");
+                        }
+                    } else {
+                        if (logger_) {
+                            logger_->info("Client " + clientId + " disconnected");
+                        }
                     }
+                    break; // Client disconnected or shutting down
                 }
-                break; // Client disconnected or shutting down
+                
+                // Read everything that has arrived before running the next command
+                enqueueMessage(clientId, message, queue);
+                continue;
             }
             
-            processClientMessage(clientId, message);
+            if (queue.empty()) {
+                continue; // Idle timeout, the client is still connected
+            }
+            
+            QueuedMessage next = std::move(queue.front());
+            queue.pop_front();
+            processClientMessage(clientId, next.message);
         }
     } catch (const std::exception& e) {
         if (logger_) {
@@ -382,6 +442,56 @@ void IpcServer::handleClient(const std::string& clientId, int socket) {
     }
 }
 
+void IpcServer::enqueueMessage(const std::string& clientId, const std::string& message,
+                               std::deque<QueuedMessage>& queue) {
+    QueuedMessage queued;
+    queued.message = message;
+    
+    // Anything unauthenticated or malformed is queued as-is and rejected
+    // by processClientMessage in order
+    if (isClientAuthenticated(clientId) && securityManager_->validateCommand(message)) {
+        try {
+            if (IpcProtocol::getMessageType(message) == IpcProtocol::MessageType::COMMAND) {
+                Command command = IpcProtocol::deserializeCommand(message);
+                if (command.type == CommandType::CANCEL_COMMAND) {
+                    cancelQueuedCommand(clientId, command, queue);
+                    return;
+                }
+                queued.commandId = command.id;
+            }
+        } catch (const std::exception&) {
+            // Leave commandId empty, processClientMessage reports the error
+        }
+    }
+    
+    queue.push_back(std::move(queued));
+}
+
+void IpcServer::cancelQueuedCommand(const std::string& clientId, const Command& cancel,
+                                    std::deque<QueuedMessage>& queue) {
+    auto targetIt = cancel.parameters.find("command_id");
+    if (targetIt == cancel.parameters.end() || targetIt->second.empty()) {
+        sendResponseToClient(clientId, createResponse(cancel.id, CommandStatus::FAILED,
+            "Missing command_id parameter"));
+        return;
+    }
+    
+    auto it = std::find_if(queue.begin(), queue.end(), [&](const QueuedMessage& queued) {
+        return queued.commandId == targetIt->second;
+    });
+    if (it == queue.end()) {
+        // Already running or answered; the client drops the late response
+        sendResponseToClient(clientId, createResponse(cancel.id, CommandStatus::SUCCESS,
+            "Command is not queued", {{"cancelled", "0"}}));
+        return;
+    }
+    
+    queue.erase(it);
+    sendResponseToClient(clientId, createResponse(targetIt->second, CommandStatus::FAILED, "Cancelled"));
+    sendResponseToClient(clientId, createResponse(cancel.id, CommandStatus::SUCCESS,
+        "Command cancelled", {{"cancelled", "1"}}));
+}
+
 void IpcServer::processClientMessage(const std::string& clientId, const std::string& message) {
     try {
         // Update client activity
@@ -426,7 +536,12 @@ void IpcServer::processClientMessage(const std::string& clientId, const std::str
         switch (messageType) {
             case IpcProtocol::MessageType::COMMAND: {
                 Command command = IpcProtocol::deserializeCommand(message);
-                if (commandHandler_) {
+                bool subscription = command.type == CommandType::SUBSCRIBE ||
+                                    command.type == CommandType::UNSUBSCRIBE;
+                if (subscription && subscriptionHandler_) {
+                    // Subscriptions belong to the connection, so they need its id
+                    sendResponseToClient(clientId, subscriptionHandler_(clientId, command));
+                } else if (commandHandler_) {
                     Response response = commandHandler_(command);
                     sendResponseToClient(clientId, response);
                 } else {
@@ -587,18 +702,25 @@ void IpcServer::addClient(int socket, const std::string& address) {
 }
 
 void IpcServer::removeClient(const std::string& clientId) {
-    std::lock_guard<std::mutex> lock(clientsMutex_);
-    
-    auto it = clients_.find(clientId);
-    if (it != clients_.end() && logger_) {
-        logger_->info("Client disconnected: " + clientId + " from " + it->second.address);
+    {
+        std::lock_guard<std::mutex> lock(clientsMutex_);
+        
+        auto it = clients_.find(clientId);
+        if (it != clients_.end() && logger_) {
+            logger_->info("Client disconnected: " + clientId + " from " + it->second.address);
+        }
+        
+        clients_.erase(clientId);
+        clientSockets_.erase(clientId);
+        
+        // Remove from security manager
+        securityManager_->removeClient(clientId);
     }
     
-    clients_.erase(clientId);
-    clientSockets_.erase(clientId);
-    
-    // Remove from security manager
-    securityManager_->removeClient(clientId);
+    // Outside the lock: handlers may send to other clients
+    if (disconnectHandler_) {
+        disconnectHandler_(clientId);
+    }
 }
 
 bool IpcServer::createServerSocket(int port) {
@@ -686,6 +808,68 @@ void IpcServer::closeServerSocket() {
             logger_->info("Server socket closed");
         }
     }
+    
+#ifndef _WIN32
+    if (unixSocket_ >= 0) {
+        close(unixSocket_);
+        unixSocket_ = -1;
+        unlink(socketPath_.c_str());
+        
+        if (logger_) {
+            logger_->info("Unix socket " + socketPath_ + " closed");
+        }
+    }
+#endif
+}
+
+bool IpcServer::createUnixSocket(const std::string& path) {
+#ifdef _WIN32
+    (void)path;
+    return false;
+#else
+    sockaddr_un serverAddr;
+    std::memset(&serverAddr, 0, sizeof(serverAddr));
+    if (path.size() >= sizeof(serverAddr.sun_path)) {
+        if (logger_) {
+            logger_->error("Unix socket path too long: " + path);
+        }
+        return false;
+    }
+    serverAddr.sun_family = AF_UNIX;
+    std::strncpy(serverAddr.sun_path, path.c_str(), sizeof(serverAddr.sun_path) - 1);
+    
+    unixSocket_ = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (unixSocket_ < 0) {
+        if (logger_) {
+            logger_->error("Failed to create Unix socket");
+        }
+        return false;
+    }
+    
+    int flags = fcntl(unixSocket_, F_GETFL, 0);
+    fcntl(unixSocket_, F_SETFL, flags | O_NONBLOCK);
+    
+    // A previous agent that did not shut down cleanly leaves the path behind
+    unlink(path.c_str());
+    
+    if (bind(unixSocket_, (struct sockaddr*)&serverAddr, sizeof(serverAddr)) < 0 ||
+        listen(unixSocket_, SOMAXCONN) < 0) {
+        if (logger_) {
+            logger_->error("Failed to listen on Unix socket " + path + " (error code: " + std::to_string(errno) + ")");
+        }
+        close(unixSocket_);
+        unixSocket_ = -1;
+        return false;
+    }
+    
+    // Owner and group only; clients still authenticate like TCP clients
+    chmod(path.c_str(), 0660);
+    
+    if (logger_) {
+        logger_->info("Unix socket listening on " + path);
+    }
+    return true;
+#endif
 }
 
 bool IpcServer::sendMessage(int socket, const std::string& message) {
@@ -731,6 +915,30 @@ bool IpcServer::sendMessage(int socket, const std::string& message) {
     
     return true;
 }
+int IpcServer::waitForData(int socket, int timeoutMs) {
+    if (socket < 0) {
+        return -1;
+    }
+    if (shuttingDown_) {
+        return 0; // The caller's loop condition ends the handler
+    }
+    
+    fd_set read_fds;
+    FD_ZERO(&read_fds);
+    FD_SET(socket, &read_fds);
+    
+    struct timeval timeout;
+    timeout.tv_sec = timeoutMs / 1000;
+    timeout.tv_usec = (timeoutMs % 1000) * 1000;
+    
+    // Returns >0 when a frame can be read, 0 on timeout, <0 on error
+    int result = select(socket + 1, &read_fds, nullptr, nullptr, &timeout);
+    if (result < 0 && errno == EINTR) {
+        return 0;
+    }
+    return result;
+}
+
 std::string IpcServer::receiveMessage(int socket) {
     if (socket < 0) {
         if (logger_) {
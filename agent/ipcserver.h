@@ -13,6 +13,7 @@
 #include <functional>
 #include <vector>
 #include <map>
+#include <deque>
 
 #ifdef _WIN32
 #include <winsock2.h>
@@ -51,13 +52,15 @@ class IpcServer {
 public:
     using CommandHandler = std::function<Response(const Command&)>;
     using EventHandler = std::function<void(const Event&)>;
+    using SubscriptionHandler = std::function<Response(const std::string& clientId, const Command&)>;
+    using DisconnectHandler = std::function<void(const std::string& clientId)>;
     
     // Server lifecycle
     IpcServer();
     ~IpcServer();
     
-    // Server lifecycle
-    bool initialize(int port = 8081);
+    // Server lifecycle; a non-empty socketPath also listens on a Unix socket
+    bool initialize(int port = 8081, const std::string& socketPath = "");
     bool start();
     void stop();
     void shutdown();
@@ -65,6 +68,8 @@ public:
     // Command handling
     void setCommandHandler(CommandHandler handler);
     void setEventHandler(EventHandler handler);
+    void setSubscriptionHandler(SubscriptionHandler handler);   // SUBSCRIBE and UNSUBSCRIBE
+    void setDisconnectHandler(DisconnectHandler handler);
     void setLogger(Logger* logger);
     
     // Status
@@ -74,6 +79,7 @@ public:
     
     // Event broadcasting
     void broadcastEvent(const Event& event);
+    void broadcastSerializedEvent(const std::string& eventData);
     void sendEventToClient(const std::string& clientId, const Event& event);
     void sendResponseToClient(const std::string& clientId, const Response& response);
 
@@ -81,8 +87,20 @@ private:
     // Server implementation
     void serverThread();
     void acceptConnections();
+    void acceptConnection(int listenSocket);
     void handleClient(const std::string& clientId, int socket);
     
+    // Pipelining: frames are read as soon as they arrive and run in order,
+    // so a CANCEL_COMMAND can drop work still queued behind a slow command
+    struct QueuedMessage {
+        std::string commandId;
+        std::string message;
+    };
+    void enqueueMessage(const std::string& clientId, const std::string& message,
+                        std::deque<QueuedMessage>& queue);
+    void cancelQueuedCommand(const std::string& clientId, const Command& cancel,
+                             std::deque<QueuedMessage>& queue);
+    
     // Client management
     void addClient(int socket, const std::string& address);
     void removeClient(const std::string& clientId);
@@ -97,13 +115,17 @@ private:
     
     // Network helpers
     bool createServerSocket(int port);
+    bool createUnixSocket(const std::string& path);
     void closeServerSocket();
     bool sendMessage(int socket, const std::string& message);
     std::string receiveMessage(int socket);
+    int waitForData(int socket, int timeoutMs);
     
     // Server state
     int serverSocket_;
+    int unixSocket_;
     int port_;
+    std::string socketPath_;
     std::atomic<bool> running_;
     std::atomic<bool> initialized_;
     std::atomic<bool> shuttingDown_;
@@ -120,11 +142,15 @@ private:
     // Handlers
     CommandHandler commandHandler_;
     EventHandler eventHandler_;
+    SubscriptionHandler subscriptionHandler_;
+    DisconnectHandler disconnectHandler_;
     Logger* logger_;
     Security::SecurityManager* securityManager_;
     
     // Constants
     static constexpr int BUFFER_SIZE = 4096;
+    static constexpr int IDLE_WAIT_MS = 1000;
+    static constexpr size_t MAX_QUEUED_MESSAGES = 64; // per client; reading pauses when full
     static constexpr std::chrono::milliseconds SHUTDOWN_TIMEOUT{5000}; // 5 seconds shutdown timeout
 };
 
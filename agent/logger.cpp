@@ -1,4 +1,5 @@
 #include "logger.h"
+#include "../shared/logger.h"
 #include <iostream>
 #include <iomanip>
 #include <filesystem>
@@ -98,6 +99,11 @@ void Logger::log(LogLevel level, const std::string& message) {
     entry.timestamp = std::chrono::system_clock::now();
     entry.threadId = std::this_thread::get_id();
     
+    // Live tails read the shared ring, not the file
+    Logging::LogLevel ringLevel = level == LogLevel::ERROR ? Logging::LogLevel::ERROR :
+                                  level == LogLevel::WARNING ? Logging::LogLevel::WARNING : Logging::LogLevel::INFO;
+    Logging::LogManager::getInstance().getRing().push(ringLevel, "Agent", message);
+    
     std::lock_guard<std::mutex> lock(queueMutex_);
     
     if (logQueue_.size() >= MAX_QUEUE_SIZE) {
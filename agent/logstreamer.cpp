@@ -0,0 +1,257 @@
+#include "logstreamer.h"
+#include "../shared/serializer.h"
+#include <algorithm>
+#include <sstream>
+
+namespace SysMon {
+
+constexpr size_t LogStreamer::MAX_SUBSCRIBERS;
+constexpr size_t LogStreamer::MAX_BACKLOG;
+constexpr size_t LogStreamer::MAX_BATCH;
+
+LogStreamer::LogStreamer()
+    : running_(false)
+    , initialized_(false)
+    , nextGeneration_(1)
+    , wakeup_(false)
+    , pollInterval_(250) {
+}
+
+LogStreamer::~LogStreamer() {
+    shutdown();
+}
+
+bool LogStreamer::initialize() {
+    if (initialized_) {
+        return true;
+    }
+
+    initialized_ = true;
+    return true;
+}
+
+bool LogStreamer::start() {
+    if (!initialized_) {
+        return false;
+    }
+
+    if (running_) {
+        return true;
+    }
+
+    running_ = true;
+    streamThread_ = std::thread(&LogStreamer::streamThread, this);
+    return true;
+}
+
+void LogStreamer::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_ = false;
+    }
+    condition_.notify_all();
+
+    if (streamThread_.joinable()) {
+        streamThread_.join();
+    }
+}
+
+void LogStreamer::shutdown() {
+    if (!initialized_) {
+        return;
+    }
+
+    stop();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    subscribers_.clear();
+    initialized_ = false;
+}
+
+void LogStreamer::setEventSender(EventSender sender) {
+    sender_ = std::move(sender);
+}
+
+void LogStreamer::setPollInterval(std::chrono::milliseconds interval) {
+    pollInterval_ = std::max(interval, std::chrono::milliseconds(50));
+}
+
+bool LogStreamer::subscribe(const std::string& clientId, const std::string& minLevel, const std::string& categories,
+                            size_t backlog, std::string& error) {
+    Subscriber subscriber;
+    subscriber.minLevel = Logging::LogLevel::INFO;
+    if (!minLevel.empty() && !Logging::parseLevel(minLevel, subscriber.minLevel)) {
+        error = "Invalid min_level (expected TRACE, DEBUG, INFO, WARNING, ERROR or CRITICAL)";
+        return false;
+    }
+
+    std::istringstream stream(categories);
+    std::string category;
+    while (std::getline(stream, category, ',')) {
+        category.erase(0, category.find_first_not_of(" \t"));
+        category.erase(category.find_last_not_of(" \t") + 1);
+        if (!category.empty()) {
+            subscriber.categories.push_back(toLower(category));
+        }
+    }
+
+    // Start far enough back to replay the backlog
+    uint64_t head = Logging::LogManager::getInstance().getRing().nextSequence();
+    subscriber.nextSequence = head - std::min<uint64_t>(head, std::min(backlog, MAX_BACKLOG));
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (subscribers_.find(clientId) == subscribers_.end() && subscribers_.size() >= MAX_SUBSCRIBERS) {
+            error = "Too many log subscribers";
+            return false;
+        }
+        subscriber.generation = nextGeneration_++;
+        subscribers_[clientId] = std::move(subscriber);
+        wakeup_ = true;
+    }
+    condition_.notify_all();
+    return true;
+}
+
+bool LogStreamer::unsubscribe(const std::string& clientId) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return subscribers_.erase(clientId) > 0;
+}
+
+size_t LogStreamer::getSubscriberCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return subscribers_.size();
+}
+
+bool LogStreamer::isRunning() const {
+    return running_;
+}
+
+void LogStreamer::streamThread() {
+    while (running_) {
+        {
+            // Idle until someone subscribes, then poll
+            std::unique_lock<std::mutex> lock(mutex_);
+            condition_.wait(lock, [this] { return !running_ || !subscribers_.empty(); });
+            condition_.wait_for(lock, pollInterval_, [this] { return !running_ || wakeup_; });
+            wakeup_ = false;
+        }
+
+        while (running_ && deliver()) {
+            // More than one batch was pending
+        }
+    }
+}
+
+bool LogStreamer::deliver() {
+    std::map<std::string, Subscriber> subscribers;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        subscribers = subscribers_;
+    }
+    if (subscribers.empty() || !sender_) {
+        return false;
+    }
+
+    uint64_t from = UINT64_MAX;
+    for (const auto& subscriber : subscribers) {
+        from = std::min(from, subscriber.second.nextSequence);
+    }
+
+    std::vector<Logging::LogRecord> records;
+    records.reserve(MAX_BATCH);
+    uint64_t next = Logging::LogManager::getInstance().getRing().read(from, records, MAX_BATCH);
+
+    // Formatted on first use, once for all subscribers
+    std::vector<std::string> formatted(records.size());
+
+    for (auto& entry : subscribers) {
+        Subscriber& subscriber = entry.second;
+        if (next <= subscriber.nextSequence) {
+            continue;
+        }
+
+        std::string entries = "[";
+        size_t count = 0;
+        uint64_t available = 0;
+        for (size_t i = 0; i < records.size(); ++i) {
+            if (records[i].sequence < subscriber.nextSequence) {
+                continue;
+            }
+            ++available;
+            if (!matches(subscriber, records[i])) {
+                continue;
+            }
+            if (formatted[i].empty()) {
+                formatted[i] = formatRecord(records[i]);
+            }
+            if (count++ > 0) {
+                entries += ",";
+            }
+            entries += formatted[i];
+        }
+        entries += "]";
+
+        // Entries overwritten before we read them
+        uint64_t dropped = (next - subscriber.nextSequence) - available;
+        subscriber.nextSequence = next;
+
+        if (count > 0 || dropped > 0) {
+            sender_(entry.first, createEvent(Module::SYSTEM, "LOG_ENTRIES", {
+                {"entries", entries},
+                {"count", std::to_string(count)},
+                {"dropped", std::to_string(dropped)}
+            }));
+        }
+    }
+
+    {
+        // Skip clients that unsubscribed or re-subscribed meanwhile
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& entry : subscribers) {
+            auto it = subscribers_.find(entry.first);
+            if (it != subscribers_.end() && it->second.generation == entry.second.generation) {
+                it->second.nextSequence = std::max(it->second.nextSequence, entry.second.nextSequence);
+            }
+        }
+    }
+
+    return records.size() == MAX_BATCH;
+}
+
+bool LogStreamer::matches(const Subscriber& subscriber, const Logging::LogRecord& record) {
+    if (record.level < subscriber.minLevel) {
+        return false;
+    }
+    if (subscriber.categories.empty()) {
+        return true;
+    }
+    std::string category = toLower(record.category);
+    return std::find(subscriber.categories.begin(), subscriber.categories.end(), category) !=
+           subscriber.categories.end();
+}
+
+std::string LogStreamer::formatRecord(const Logging::LogRecord& record) {
+    uint64_t timestampMs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        record.timestamp.time_since_epoch()).count());
+
+    Serialization::StringBuilder builder(256);
+    builder.append("{");
+    builder.append("\"seq\":").append(record.sequence).append(",");
+    builder.append("\"timestamp\":").append(timestampMs).append(",");
+    builder.append("\"level\":\"").append(Logging::levelName(record.level)).append("\",");
+    builder.append("\"category\":\"").escapeAndAppend(record.category).append("\",");
+    builder.append("\"thread\":").append(static_cast<uint64_t>(record.threadId)).append(",");
+    builder.append("\"message\":\"").escapeAndAppend(record.message).append("\"");
+    builder.append("}");
+    return builder.toString();
+}
+
+std::string LogStreamer::toLower(const std::string& str) {
+    std::string result = str;
+    std::transform(result.begin(), result.end(), result.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return result;
+}
+
+} // namespace SysMon
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "../shared/commands.h"
+#include "../shared/logger.h"
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <map>
+
+namespace SysMon {
+
+// Log Streamer - live tail of the agent log for subscribed IPC clients
+//
+// Reads the shared LogRing on its own thread, so the logging path never
+// knows who is watching. Each subscriber has its own level and category
+// filter and read position; an entry is formatted once, and only if at
+// least one subscriber wants it. New entries are sent as one LOG_ENTRIES
+// event per subscriber and poll interval.
+class LogStreamer {
+public:
+    using EventSender = std::function<void(const std::string& clientId, const Event& event)>;
+
+    LogStreamer();
+    ~LogStreamer();
+
+    // Lifecycle
+    bool initialize();
+    bool start();
+    void stop();
+    void shutdown();
+
+    // Configuration (before start)
+    void setEventSender(EventSender sender);
+    void setPollInterval(std::chrono::milliseconds interval);
+
+    // Subscriptions; categories is a comma-separated list (empty for all)
+    // and backlog is how many entries already in the ring to send first
+    bool subscribe(const std::string& clientId, const std::string& minLevel, const std::string& categories,
+                   size_t backlog, std::string& error);
+    bool unsubscribe(const std::string& clientId);
+    size_t getSubscriberCount() const;
+
+    // Status
+    bool isRunning() const;
+
+private:
+    struct Subscriber {
+        Logging::LogLevel minLevel;
+        std::vector<std::string> categories;    // lower case
+        uint64_t nextSequence;
+        uint64_t generation;                    // changes on every subscribe
+    };
+
+    // Streaming thread
+    void streamThread();
+    bool deliver();
+
+    static bool matches(const Subscriber& subscriber, const Logging::LogRecord& record);
+    static std::string formatRecord(const Logging::LogRecord& record);
+    static std::string toLower(const std::string& str);
+
+    // Thread management
+    std::thread streamThread_;
+    std::atomic<bool> running_;
+    std::atomic<bool> initialized_;
+
+    // Subscribers by client id
+    std::map<std::string, Subscriber> subscribers_;
+    uint64_t nextGeneration_;
+    bool wakeup_;
+    mutable std::mutex mutex_;
+    std::condition_variable condition_;
+
+    // Configuration
+    EventSender sender_;
+    std::chrono::milliseconds pollInterval_;
+
+    // Constants
+    static constexpr size_t MAX_SUBSCRIBERS = 32;
+    static constexpr size_t MAX_BACKLOG = 1000;
+    static constexpr size_t MAX_BATCH = 256;    // entries read per pass
+};
+
+} // namespace SysMon
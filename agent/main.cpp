@@ -1,5 +1,10 @@
 #include "agentcore.h"
+#include "configmanager.h"
+#include "historyexport.h"
 #include <iostream>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
 #include <signal.h>
 #include <memory>
 #include <mutex>
@@ -28,6 +33,62 @@ namespace {
             g_agent->shutdown();
         }
     }
+    
+    // sysmon_agent --export --series <list> [--from <ms>] [--to <ms>]
+    //              [--format csv|arrow] [--archive-dir <dir>] [--config <file>]
+    // Streams archived history to stdout without starting the agent
+    int runExport(int argc, char* argv[]) {
+        std::map<std::string, std::string> options;
+        for (int i = 2; i < argc; ++i) {
+            std::string name = argv[i];
+            if (name.compare(0, 2, "--") != 0 || i + 1 >= argc) {
+                std::cerr << "Invalid export option: " << name << std::endl;
+                return 2;
+            }
+            options[name.substr(2)] = argv[++i];
+        }
+        
+        std::string archiveDir = options["archive-dir"];
+        if (archiveDir.empty()) {
+            ConfigManager config;
+            config.initialize(options.count("config") ? options["config"] : "sysmon_agent.conf");
+            config.load();
+            archiveDir = config.getString("collectors.archive_dir", "");
+        }
+        if (archiveDir.empty()) {
+            std::cerr << "No history archive (set collectors.archive_dir or pass --archive-dir)" << std::endl;
+            return 1;
+        }
+        
+        HistoryExport::Request request;
+        std::string error;
+        if (!HistoryExport::parseRequest(options, request, error)) {
+            std::cerr << error << std::endl;
+            return 2;
+        }
+        
+        auto reader = std::make_shared<HistoryArchive::Reader>(archiveDir, request.selectors,
+                                                               request.fromMs, request.toMs);
+        HistoryExport exporter([reader](MetricSample& sample) {
+            return reader->next(sample);
+        }, request.format);
+        
+        // stdout's own buffering is enough; one chunk is in memory at a time
+        std::string chunk;
+        while (exporter.nextChunk(chunk)) {
+            if (!chunk.empty() && std::fwrite(chunk.data(), 1, chunk.size(), stdout) != chunk.size()) {
+                std::cerr << "Write failed: " << std::strerror(errno) << std::endl;
+                return 1;
+            }
+        }
+        if (std::fflush(stdout) != 0) {
+            std::cerr << "Write failed: " << std::strerror(errno) << std::endl;
+            return 1;
+        }
+        
+        std::cerr << "Exported " << exporter.getRowCount() << " samples" << std::endl;
+        return 0;
+    }
 }
 
 // Signal handler for graceful shutdown
@@ -38,8 +99,13 @@ void signalHandler(int signal) {
 }
 
 int main(int argc, char* argv[]) {
-    (void)argc;
-    (void)argv;
+    if (argc > 1 && std::strcmp(argv[1], "--export") == 0) {
+#ifndef _WIN32
+        signal(SIGPIPE, SIG_IGN);
+#endif
+        return runExport(argc, argv);
+    }
+    
     std::cout << "SysMon3 Agent starting..." << std::endl;
     
     // Set up signal handlers
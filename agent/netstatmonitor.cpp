@@ -0,0 +1,306 @@
+#include "netstatmonitor.h"
+#include "watchdog.h"
+#include "../shared/procparsers.h"
+#include <thread>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <fcntl.h>
+#endif
+
+namespace SysMon {
+
+constexpr std::chrono::milliseconds NetStatMonitor::DEFAULT_UPDATE_INTERVAL;
+
+const std::array<NetStatMonitor::CounterDefinition, 32> NetStatMonitor::COUNTERS = {{
+    // /proc/net/snmp
+    {"Ip", "InDiscards", false},
+    {"Ip", "OutDiscards", false},
+    {"Ip", "ReasmFails", false},
+    {"Icmp", "InErrors", false},
+    {"Icmp", "OutErrors", false},
+    {"Tcp", "ActiveOpens", false},
+    {"Tcp", "PassiveOpens", false},
+    {"Tcp", "AttemptFails", false},
+    {"Tcp", "EstabResets", false},
+    {"Tcp", "CurrEstab", true},
+    {"Tcp", "InSegs", false},
+    {"Tcp", "OutSegs", false},
+    {"Tcp", "RetransSegs", false},
+    {"Tcp", "InErrs", false},
+    {"Tcp", "OutRsts", false},
+    {"Udp", "InDatagrams", false},
+    {"Udp", "NoPorts", false},
+    {"Udp", "InErrors", false},
+    {"Udp", "OutDatagrams", false},
+    {"Udp", "RcvbufErrors", false},
+    {"Udp", "SndbufErrors", false},
+    // /proc/net/netstat
+    {"TcpExt", "SyncookiesSent", false},
+    {"TcpExt", "SyncookiesRecv", false},
+    {"TcpExt", "SyncookiesFailed", false},
+    {"TcpExt", "ListenOverflows", false},
+    {"TcpExt", "ListenDrops", false},
+    {"TcpExt", "TCPTimeouts", false},
+    {"TcpExt", "TCPLostRetransmit", false},
+    {"TcpExt", "TCPBacklogDrop", false},
+    {"TcpExt", "TCPAbortOnMemory", false},
+    {"TcpExt", "PruneCalled", false},
+    {"TcpExt", "TCPRcvQDrop", false},
+}};
+
+NetStatMonitor::NetStatMonitor()
+    : running_(false)
+    , initialized_(false)
+    , fallbackMode_(false)
+    , snmpFd_(-1)
+    , netstatFd_(-1)
+    , previousValues_(COUNTERS.size(), 0)
+    , previousPresent_(COUNTERS.size(), false)
+    , updateInterval_(DEFAULT_UPDATE_INTERVAL) {
+}
+
+NetStatMonitor::~NetStatMonitor() {
+    shutdown();
+}
+
+bool NetStatMonitor::initialize() {
+    if (initialized_) {
+        return true;
+    }
+
+#ifdef _WIN32
+    // No equivalent counter files on Windows
+    return false;
+#else
+    // Files stay open; each tick re-reads them from offset 0
+    snmpFd_ = open("/proc/net/snmp", O_RDONLY | O_CLOEXEC);
+    netstatFd_ = open("/proc/net/netstat", O_RDONLY | O_CLOEXEC);
+    if (snmpFd_ < 0) {
+        if (netstatFd_ >= 0) {
+            close(netstatFd_);
+            netstatFd_ = -1;
+        }
+        return false;
+    }
+
+    updateCounters();
+
+    initialized_ = true;
+    return true;
+#endif
+}
+
+void NetStatMonitor::shutdown() {
+    if (!initialized_) {
+        return;
+    }
+
+    running_ = false;
+
+    if (monitoringThread_.joinable()) {
+        monitoringThread_.join();
+    }
+
+#ifndef _WIN32
+    if (snmpFd_ >= 0) {
+        close(snmpFd_);
+        snmpFd_ = -1;
+    }
+    if (netstatFd_ >= 0) {
+        close(netstatFd_);
+        netstatFd_ = -1;
+    }
+#endif
+
+    initialized_ = false;
+}
+
+bool NetStatMonitor::start() {
+    if (!initialized_) {
+        return false;
+    }
+
+    if (running_ || fallbackMode_) {
+        return true;
+    }
+
+    Watchdog::getInstance().registerJob("netstat", updateInterval_);
+
+    running_ = true;
+    monitoringThread_ = std::thread(&NetStatMonitor::monitoringThread, this);
+
+    return true;
+}
+
+void NetStatMonitor::stop() {
+    running_ = false;
+
+    if (monitoringThread_.joinable()) {
+        monitoringThread_.join();
+    }
+
+    Watchdog::getInstance().unregisterJob("netstat");
+}
+
+void NetStatMonitor::monitoringThread() {
+    while (running_) {
+        try {
+            std::this_thread::sleep_for(updateInterval_);
+
+            Watchdog::RunGuard guard("netstat");
+            updateCounters();
+
+        } catch (const std::exception& e) {
+            // Log error but continue
+            std::this_thread::sleep_for(std::chrono::seconds(1));
+        }
+    }
+}
+
+void NetStatMonitor::updateCounters() {
+    std::vector<uint64_t> values(COUNTERS.size(), 0);
+    std::vector<bool> present(COUNTERS.size(), false);
+
+    if (ProcParsers::readFile(snmpFd_, readBuffer_)) {
+        parseCounterFile(readBuffer_, snmpLayouts_, values, present);
+    }
+    if (ProcParsers::readFile(netstatFd_, readBuffer_)) {
+        parseCounterFile(readBuffer_, netstatLayouts_, values, present);
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    double elapsed = std::chrono::duration<double>(now - previousSample_).count();
+
+    std::vector<NetworkStatCounter> counters;
+    counters.reserve(COUNTERS.size());
+    for (size_t i = 0; i < COUNTERS.size(); ++i) {
+        if (!present[i]) {
+            continue;
+        }
+
+        NetworkStatCounter counter;
+        counter.name = std::string(COUNTERS[i].section) + "." + COUNTERS[i].name;
+        counter.value = values[i];
+        counter.isGauge = COUNTERS[i].isGauge;
+
+        // Counters only reset on namespace teardown; treat a drop as zero rate
+        if (!counter.isGauge && previousPresent_[i] && elapsed > 0.0 && values[i] >= previousValues_[i]) {
+            counter.rate = static_cast<double>(values[i] - previousValues_[i]) / elapsed;
+        }
+
+        counters.push_back(counter);
+    }
+
+    previousValues_.swap(values);
+    previousPresent_.swap(present);
+    previousSample_ = now;
+
+    std::unique_lock<std::shared_mutex> lock(dataMutex_);
+    counters_ = std::move(counters);
+}
+
+void NetStatMonitor::parseCounterFile(std::string_view content, std::vector<SectionLayout>& layouts,
+                                      std::vector<uint64_t>& values, std::vector<bool>& present) {
+    // Lines come in pairs: "Tcp: RtoAlgorithm RtoMin ..." then "Tcp: 1 200 ..."
+    std::string_view header, valueLine;
+    size_t pairIndex = 0;
+    while (ProcParsers::nextHeaderValuePair(content, header, valueLine)) {
+        if (layouts.size() <= pairIndex) {
+            layouts.emplace_back();
+        }
+        SectionLayout& layout = layouts[pairIndex];
+        if (header != layout.header) {
+            buildLayout(header, layout);
+        }
+
+        // Skip the "Section:" prefix, then walk the value columns
+        std::string_view section, fields;
+        if (ProcParsers::splitSection(valueLine, section, fields)) {
+            for (size_t column = 0; column < layout.columns.size(); ++column) {
+                int64_t value = 0;
+                if (!ProcParsers::parseSigned(fields, value)) {
+                    break;
+                }
+
+                int index = layout.columns[column];
+                if (index >= 0) {
+                    values[index] = value < 0 ? 0 : static_cast<uint64_t>(value);
+                    present[index] = true;
+                }
+            }
+        }
+
+        ++pairIndex;
+    }
+}
+
+void NetStatMonitor::buildLayout(std::string_view header, SectionLayout& layout) {
+    layout.header.assign(header.data(), header.size());
+    layout.columns.clear();
+
+    std::string_view section, names;
+    if (!ProcParsers::splitSection(header, section, names)) {
+        return;
+    }
+
+    std::string_view name;
+    while (ProcParsers::nextField(names, name)) {
+        layout.columns.push_back(findCounter(section, name));
+    }
+}
+
+int NetStatMonitor::findCounter(std::string_view section, std::string_view name) {
+    for (size_t i = 0; i < COUNTERS.size(); ++i) {
+        if (section == COUNTERS[i].section && name == COUNTERS[i].name) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+std::vector<NetworkStatCounter> NetStatMonitor::getCounters() const {
+    std::shared_lock<std::shared_mutex> lock(dataMutex_);
+    return counters_;
+}
+
+bool NetStatMonitor::getCounter(const std::string& name, NetworkStatCounter& counter) const {
+    std::shared_lock<std::shared_mutex> lock(dataMutex_);
+    for (const auto& current : counters_) {
+        if (current.name == name) {
+            counter = current;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool NetStatMonitor::isRunning() const {
+    return running_;
+}
+
+std::chrono::milliseconds NetStatMonitor::getUpdateInterval() const {
+    return updateInterval_;
+}
+
+void NetStatMonitor::setUpdateInterval(std::chrono::milliseconds interval) {
+    updateInterval_ = interval;
+}
+
+// Fallback mode support
+void NetStatMonitor::enableFallbackMode() {
+    fallbackMode_ = true;
+    initialized_ = true;
+
+    std::unique_lock<std::shared_mutex> lock(dataMutex_);
+    counters_.clear();
+}
+
+bool NetStatMonitor::isFallbackMode() const {
+    return fallbackMode_;
+}
+
+} // namespace SysMon
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "../shared/systemtypes.h"
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <shared_mutex>
+#include <array>
+#include <string_view>
+
+namespace SysMon {
+
+// Network Statistics Monitor - TCP/IP stack counters from /proc/net/snmp
+// and /proc/net/netstat, kept in a fixed table indexed by counter
+class NetStatMonitor {
+public:
+    NetStatMonitor();
+    ~NetStatMonitor();
+
+    // Lifecycle
+    bool initialize();
+    bool start();
+    void stop();
+    void shutdown();
+
+    // Fallback mode support
+    void enableFallbackMode();
+    bool isFallbackMode() const;
+
+    // Data access
+    std::vector<NetworkStatCounter> getCounters() const;
+    bool getCounter(const std::string& name, NetworkStatCounter& counter) const;
+
+    // Status
+    bool isRunning() const;
+    std::chrono::milliseconds getUpdateInterval() const;
+    void setUpdateInterval(std::chrono::milliseconds interval);
+
+private:
+    // Tracked counter definition
+    struct CounterDefinition {
+        const char* section;    // "Tcp", "TcpExt", "Udp", ...
+        const char* name;       // column name in the header line
+        bool isGauge;           // current value rather than a running total
+    };
+
+    // Column layout of one header/value line pair; rebuilt only when the
+    // header line changes (i.e. never, short of a kernel upgrade)
+    struct SectionLayout {
+        std::string header;
+        std::vector<int> columns;   // column -> counter index, -1 = untracked
+    };
+
+    // Monitoring thread
+    void monitoringThread();
+    void updateCounters();
+
+    // Parsing
+    void parseCounterFile(std::string_view content, std::vector<SectionLayout>& layouts,
+                          std::vector<uint64_t>& values, std::vector<bool>& present);
+    static void buildLayout(std::string_view header, SectionLayout& layout);
+    static int findCounter(std::string_view section, std::string_view name);
+
+    // Thread management
+    std::thread monitoringThread_;
+    std::atomic<bool> running_;
+    std::atomic<bool> initialized_;
+    std::atomic<bool> fallbackMode_;
+
+    // Data storage
+    std::vector<NetworkStatCounter> counters_;
+    mutable std::shared_mutex dataMutex_;
+
+    // Monitoring thread state
+    int snmpFd_;
+    int netstatFd_;
+    std::string readBuffer_;
+    std::vector<SectionLayout> snmpLayouts_;
+    std::vector<SectionLayout> netstatLayouts_;
+    std::vector<uint64_t> previousValues_;
+    std::vector<bool> previousPresent_;
+    std::chrono::steady_clock::time_point previousSample_;
+
+    // Timing
+    std::chrono::milliseconds updateInterval_;
+
+    // Constants
+    static const std::array<CounterDefinition, 32> COUNTERS;
+    static constexpr std::chrono::milliseconds DEFAULT_UPDATE_INTERVAL{1000};
+};
+
+} // namespace SysMon
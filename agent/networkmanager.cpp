@@ -1,4 +1,7 @@
 #include "networkmanager.h"
+#include "processrunner.h"
+#include "watchdog.h"
+#include "../shared/procparsers.h"
 #include <thread>
 #include <chrono>
 #include <fstream>
@@ -113,6 +116,8 @@ bool NetworkManager::start() {
         return true;
     }
     
+    Watchdog::getInstance().registerJob("network", statsUpdateInterval_);
+    
     running_ = true;
     monitoringThread_ = std::thread(&NetworkManager::networkMonitoringThread, this);
     
@@ -129,6 +134,8 @@ void NetworkManager::stop() {
     if (monitoringThread_.joinable()) {
         monitoringThread_.join();
     }
+
+    Watchdog::getInstance().unregisterJob("network");
 }
 
 void NetworkManager::shutdown() {
@@ -239,7 +246,10 @@ bool NetworkManager::setDhcpIp(const std::string& interfaceName) {
 void NetworkManager::networkMonitoringThread() {
     while (running_) {
         try {
-            updateNetworkStats();
+            {
+                Watchdog::RunGuard guard("network");
+                updateNetworkStats();
+            }
             std::this_thread::sleep_for(statsUpdateInterval_);
             
         } catch (const std::exception& e) {
@@ -267,82 +277,49 @@ void NetworkManager::updateNetworkStats() {
 }
 
 uint64_t NetworkManager::getInterfaceRxBytes(const std::string& interfaceName) {
-#ifdef _WIN32
-    // Temporary simplified implementation for Windows
-    (void)interfaceName;
-    return 0;
-#else
-    // Linux implementation using /proc/net/dev
-    std::ifstream file("/proc/net/dev");
-    if (!file.is_open()) {
-        return 0;
-    }
-    
-    std::string line;
-    // Skip header lines
-    std::getline(file, line);
-    std::getline(file, line);
-    
-    while (std::getline(file, line)) {
-        size_t colonPos = line.find(':');
-        if (colonPos != std::string::npos) {
-            std::string iface = line.substr(0, colonPos);
-            // Remove leading spaces
-            iface.erase(0, iface.find_first_not_of(" \t"));
-            
-            if (iface == interfaceName) {
-                std::istringstream iss(line.substr(colonPos + 1));
-                uint64_t rxBytes, rxPackets, rxErrs, rxDrop, rxFifo, rxFrames, rxCompressed, rxMulticast;
-                uint64_t txBytes, txPackets, txErrs, txDrop, txFifo, txFrames, txCompressed, txMulticast;
-                
-                if (iss >> rxBytes >> rxPackets >> rxErrs >> rxDrop >> rxFifo >> rxFrames >> rxCompressed >> rxMulticast >>
-                           txBytes >> txPackets >> txErrs >> txDrop >> txFifo >> txFrames >> txCompressed >> txMulticast) {
-                    return rxBytes;
-                }
-            }
-        }
-    }
-#endif
-    return 0;
+    uint64_t rxBytes = 0;
+    uint64_t txBytes = 0;
+    return readInterfaceCounters(interfaceName, rxBytes, txBytes) ? rxBytes : 0;
 }
 
 uint64_t NetworkManager::getInterfaceTxBytes(const std::string& interfaceName) {
+    uint64_t rxBytes = 0;
+    uint64_t txBytes = 0;
+    return readInterfaceCounters(interfaceName, rxBytes, txBytes) ? txBytes : 0;
+}
+
+bool NetworkManager::readInterfaceCounters(const std::string& interfaceName, uint64_t& rxBytes, uint64_t& txBytes) {
 #ifdef _WIN32
     // Temporary simplified implementation for Windows
     (void)interfaceName;
-    return 0;
+    (void)rxBytes;
+    (void)txBytes;
+    return false;
 #else
-    // Linux implementation using /proc/net/dev
-    std::ifstream file("/proc/net/dev");
-    if (!file.is_open()) {
-        return 0;
+    // Linux implementation using /proc/net/dev:
+    // "  eth0: rxBytes rxPackets ... (8 rx fields) txBytes ..."
+    std::string buffer;
+    if (!ProcParsers::readFile("/proc/net/dev", buffer)) {
+        return false;
     }
     
-    std::string line;
+    std::string_view text = buffer;
+    std::string_view line;
     // Skip header lines
-    std::getline(file, line);
-    std::getline(file, line);
-    
-    while (std::getline(file, line)) {
-        size_t colonPos = line.find(':');
-        if (colonPos != std::string::npos) {
-            std::string iface = line.substr(0, colonPos);
-            iface.erase(0, iface.find_first_not_of(" \t"));
-            
-            if (iface == interfaceName) {
-                std::istringstream iss(line.substr(colonPos + 1));
-                uint64_t rxBytes, rxPackets, rxErrs, rxDrop, rxFifo, rxFrames, rxCompressed, rxMulticast;
-                uint64_t txBytes, txPackets, txErrs, txDrop, txFifo, txFrames, txCompressed, txMulticast;
-                
-                if (iss >> rxBytes >> rxPackets >> rxErrs >> rxDrop >> rxFifo >> rxFrames >> rxCompressed >> rxMulticast >>
-                           txBytes >> txPackets >> txErrs >> txDrop >> txFifo >> txFrames >> txCompressed >> txMulticast) {
-                    return txBytes;
-                }
-            }
+    ProcParsers::nextLine(text, line);
+    ProcParsers::nextLine(text, line);
+    
+    std::string_view name, fields;
+    while (ProcParsers::nextLine(text, line)) {
+        if (!ProcParsers::splitSection(line, name, fields) || ProcParsers::trim(name) != interfaceName) {
+            continue;
         }
+        return ProcParsers::parseUnsigned(fields, rxBytes) &&
+               ProcParsers::skipFields(fields, 7) &&
+               ProcParsers::parseUnsigned(fields, txBytes);
     }
+    return false;
 #endif
-    return 0;
 }
 
 std::vector<SysMon::NetworkInterface> NetworkManager::getNetworkInterfacesLinux() {
@@ -382,10 +359,8 @@ std::vector<SysMon::NetworkInterface> NetworkManager::getNetworkInterfacesWindow
 }
 
 bool NetworkManager::enableInterfaceLinux(const std::string& interfaceName) {
-    // Use system command to enable interface
-    std::string command = "ip link set " + interfaceName + " up";
-    int result = system(command.c_str());
-    return result == 0;
+    // Run ip(8) directly, without a shell
+    return ProcessRunner::run({"ip", "link", "set", interfaceName, "up"}).succeeded();
 }
 
 bool NetworkManager::enableInterfaceWindows(const std::string& interfaceName) {
@@ -400,10 +375,8 @@ bool NetworkManager::enableInterfaceWindows(const std::string& interfaceName) {
 }
 
 bool NetworkManager::disableInterfaceLinux(const std::string& interfaceName) {
-    // Use system command to disable interface
-    std::string command = "ip link set " + interfaceName + " down";
-    int result = system(command.c_str());
-    return result == 0;
+    // Run ip(8) directly, without a shell
+    return ProcessRunner::run({"ip", "link", "set", interfaceName, "down"}).succeeded();
 }
 
 bool NetworkManager::disableInterfaceWindows(const std::string& interfaceName) {
@@ -419,22 +392,17 @@ bool NetworkManager::disableInterfaceWindows(const std::string& interfaceName) {
 
 bool NetworkManager::setStaticIpLinux(const std::string& interfaceName, const std::string& ip, 
                                       const std::string& netmask, const std::string& gateway) {
-    // Configure static IP using system commands
-    std::string cmd1 = "ip addr flush dev " + interfaceName;
-    std::string cmd2 = "ip addr add " + ip + "/" + netmask + " dev " + interfaceName;
-    std::string cmd3 = "ip link set " + interfaceName + " up";
-    
-    if (!gateway.empty()) {
-        std::string cmd4 = "ip route add default via " + gateway + " dev " + interfaceName;
-        return (system(cmd1.c_str()) == 0) && 
-               (system(cmd2.c_str()) == 0) && 
-               (system(cmd3.c_str()) == 0) && 
-               (system(cmd4.c_str()) == 0);
+    // Configure static IP with ip(8), each step run without a shell
+    bool success = ProcessRunner::run({"ip", "addr", "flush", "dev", interfaceName}).succeeded() &&
+                   ProcessRunner::run({"ip", "addr", "add", ip + "/" + netmask, "dev", interfaceName}).succeeded() &&
+                   ProcessRunner::run({"ip", "link", "set", interfaceName, "up"}).succeeded();
+    
+    if (success && !gateway.empty()) {
+        success = ProcessRunner::run({"ip", "route", "add", "default", "via", gateway,
+                                      "dev", interfaceName}).succeeded();
     }
     
-    return (system(cmd1.c_str()) == 0) && 
-           (system(cmd2.c_str()) == 0) && 
-           (system(cmd3.c_str()) == 0);
+    return success;
 }
 
 bool NetworkManager::setStaticIpWindows(const std::string& interfaceName, const std::string& ip, 
@@ -464,14 +432,10 @@ bool NetworkManager::setStaticIpWindows(const std::string& interfaceName, const
 }
 
 bool NetworkManager::setDhcpIpLinux(const std::string& interfaceName) {
-    // Configure DHCP using system commands
-    std::string cmd1 = "ip addr flush dev " + interfaceName;
-    std::string cmd2 = "dhclient " + interfaceName + " -r";  // Release
-    std::string cmd3 = "dhclient " + interfaceName;           // Renew
-    
-    return (system(cmd1.c_str()) == 0) && 
-           (system(cmd2.c_str()) == 0) && 
-           (system(cmd3.c_str()) == 0);
+    // Configure DHCP; dhclient can take a while to obtain a lease
+    return ProcessRunner::run({"ip", "addr", "flush", "dev", interfaceName}).succeeded() &&
+           ProcessRunner::run({"dhclient", "-r", interfaceName}, DHCP_TIMEOUT).succeeded() &&   // Release
+           ProcessRunner::run({"dhclient", interfaceName}, DHCP_TIMEOUT).succeeded();           // Renew
 }
 
 bool NetworkManager::setDhcpIpWindows(const std::string& interfaceName) {
@@ -78,6 +78,7 @@ private:
     // Network statistics
     uint64_t getInterfaceRxBytes(const std::string& interfaceName);
     uint64_t getInterfaceTxBytes(const std::string& interfaceName);
+    static bool readInterfaceCounters(const std::string& interfaceName, uint64_t& rxBytes, uint64_t& txBytes);
     
     // Thread management
     std::thread monitoringThread_;
@@ -93,6 +94,9 @@ private:
     std::chrono::steady_clock::time_point lastStatsUpdate_;
     std::chrono::milliseconds statsUpdateInterval_;
     
+    // Constants
+    static constexpr std::chrono::milliseconds DHCP_TIMEOUT{30000};
+    
     // Platform-specific data
 #ifdef _WIN32
     // Windows IP Helper API
@@ -0,0 +1,423 @@
+#include "powermonitor.h"
+#include "watchdog.h"
+#include "../shared/procparsers.h"
+#include <thread>
+#include <chrono>
+#include <cstring>
+#include <cstdlib>
+#include <algorithm>
+#include <mutex>
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <fcntl.h>
+#include <dirent.h>
+#endif
+
+namespace SysMon {
+
+constexpr std::chrono::milliseconds PowerMonitor::DEFAULT_UPDATE_INTERVAL;
+constexpr size_t PowerMonitor::MAX_PROCESS_ENTRIES;
+
+PowerMonitor::PowerMonitor()
+    : running_(false)
+    , initialized_(false)
+    , fallbackMode_(false)
+    , totalPackageWatts_(0.0)
+    , sysfsRoot_("/sys/class/powercap")
+    , procRoot_("/proc")
+    , previousBusyTicks_(0)
+    , updateInterval_(DEFAULT_UPDATE_INTERVAL) {
+}
+
+PowerMonitor::~PowerMonitor() {
+    shutdown();
+}
+
+bool PowerMonitor::initialize() {
+    if (initialized_) {
+        return true;
+    }
+
+#ifdef _WIN32
+    // RAPL counters are not exposed to user space on Windows
+    return false;
+#else
+    if (!discoverZonesLinux()) {
+        return false;
+    }
+
+    // First sample only establishes the baseline
+    updatePower();
+
+    initialized_ = true;
+    return true;
+#endif
+}
+
+void PowerMonitor::shutdown() {
+    if (!initialized_) {
+        return;
+    }
+
+    running_ = false;
+
+    if (monitoringThread_.joinable()) {
+        monitoringThread_.join();
+    }
+
+    closeZones();
+
+    initialized_ = false;
+}
+
+bool PowerMonitor::start() {
+    if (!initialized_) {
+        return false;
+    }
+
+    if (running_ || fallbackMode_) {
+        return true;
+    }
+
+    Watchdog::getInstance().registerJob("power", updateInterval_);
+
+    running_ = true;
+    monitoringThread_ = std::thread(&PowerMonitor::monitoringThread, this);
+
+    return true;
+}
+
+void PowerMonitor::stop() {
+    running_ = false;
+
+    if (monitoringThread_.joinable()) {
+        monitoringThread_.join();
+    }
+
+    Watchdog::getInstance().unregisterJob("power");
+}
+
+void PowerMonitor::monitoringThread() {
+    while (running_) {
+        try {
+            std::this_thread::sleep_for(updateInterval_);
+
+            Watchdog::RunGuard guard("power");
+            updatePower();
+
+        } catch (const std::exception& e) {
+            // Log error but continue
+            std::this_thread::sleep_for(std::chrono::seconds(1));
+        }
+    }
+}
+
+#ifndef _WIN32
+
+bool PowerMonitor::discoverZonesLinux() {
+    DIR* dir = opendir(sysfsRoot_.c_str());
+    if (!dir) {
+        return false;
+    }
+
+    std::vector<std::string> zoneNames;
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != nullptr) {
+        // "intel-rapl:0" is package 0, "intel-rapl:0:1" a subzone of it; the
+        // MMIO interface duplicates the package counters and is skipped
+        std::string zone = entry->d_name;
+        if (zone.compare(0, 11, "intel-rapl:") == 0) {
+            zoneNames.push_back(zone);
+        }
+    }
+    closedir(dir);
+    std::sort(zoneNames.begin(), zoneNames.end());
+
+    for (const auto& zoneName : zoneNames) {
+        std::string base = sysfsRoot_ + "/" + zoneName + "/";
+
+        EnergyZone zone;
+        zone.zone = zoneName;
+        zone.socket = static_cast<uint32_t>(std::strtoul(zoneName.c_str() + 11, nullptr, 10));
+        zone.isPackage = zoneName.find(':', 11) == std::string::npos;
+        zone.maxEnergyRangeUj = 0;
+        zone.lastEnergyUj = 0;
+        zone.accumulatedUj = 0;
+        zone.hasLastEnergy = false;
+
+        if (!ProcParsers::readAttribute(base + "name", zone.name) || zone.name.empty()) {
+            zone.name = zoneName;
+        }
+        // psys covers the whole platform, not a socket
+        if (zone.name == "psys") {
+            zone.isPackage = false;
+        }
+
+        std::string range;
+        if (ProcParsers::readAttribute(base + "max_energy_range_uj", range)) {
+            std::string_view digits = range;
+            ProcParsers::parseUnsigned(digits, zone.maxEnergyRangeUj);
+        }
+
+        // energy_uj is root-only on kernels with the RAPL side-channel fix
+        zone.energyFd = open((base + "energy_uj").c_str(), O_RDONLY | O_CLOEXEC);
+        if (zone.energyFd < 0) {
+            continue;
+        }
+
+        zones_.push_back(zone);
+    }
+
+    return !zones_.empty();
+}
+
+void PowerMonitor::closeZones() {
+    for (auto& zone : zones_) {
+        if (zone.energyFd >= 0) {
+            close(zone.energyFd);
+            zone.energyFd = -1;
+        }
+    }
+    zones_.clear();
+}
+
+bool PowerMonitor::readEnergy(const EnergyZone& zone, uint64_t& energyUj) const {
+    char buffer[32];
+    ssize_t bytesRead = pread(zone.energyFd, buffer, sizeof(buffer), 0);
+    if (bytesRead <= 0) {
+        return false;
+    }
+
+    std::string_view digits(buffer, static_cast<size_t>(bytesRead));
+    return ProcParsers::parseUnsigned(digits, energyUj);
+}
+
+bool PowerMonitor::readBusyTicks(uint64_t& busyTicks) {
+    ProcParsers::CpuTimes times;
+    if (!ProcParsers::readFile(procRoot_ + "/stat", readBuffer_) ||
+        !ProcParsers::parseCpuStat(readBuffer_, times)) {
+        return false;
+    }
+
+    // Everything but idle and iowait (guest time is part of user)
+    busyTicks = times.total() - times.idleTotal();
+    return true;
+}
+
+std::vector<ProcessPowerInfo> PowerMonitor::attributeProcesses(double packageWatts, uint64_t busyDelta) {
+    std::vector<ProcessPowerInfo> processes;
+    std::map<uint32_t, CpuSample> currentCpu;
+
+    DIR* dir = opendir(procRoot_.c_str());
+    if (!dir) {
+        previousCpu_.clear();
+        return processes;
+    }
+
+    std::string path = procRoot_ + "/";
+    const size_t procPrefix = path.size();
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != nullptr) {
+        if (entry->d_name[0] < '0' || entry->d_name[0] > '9') {
+            continue;
+        }
+
+        path.resize(procPrefix);
+        path += entry->d_name;
+        path += "/stat";
+        ProcParsers::ProcessStat stat;
+        if (!ProcParsers::readFile(path, readBuffer_) || !ProcParsers::parseProcessStat(readBuffer_, stat)) {
+            continue; // Exited while scanning
+        }
+
+        uint32_t pid = stat.pid;
+        uint64_t startTime = stat.startTime;
+        CpuSample sample{stat.utime + stat.stime, startTime};
+        currentCpu[pid] = sample;
+
+        auto previous = previousCpu_.find(pid);
+        if (busyDelta == 0 || previous == previousCpu_.end() ||
+            previous->second.startTime != startTime || sample.ticks <= previous->second.ticks) {
+            continue;
+        }
+
+        double share = static_cast<double>(sample.ticks - previous->second.ticks) / static_cast<double>(busyDelta);
+        ProcessPowerInfo info;
+        info.pid = pid;
+        info.name = std::string(stat.name);
+        info.cpuShare = share * 100.0;
+        info.watts = packageWatts * std::min(1.0, share);
+        info.sanitize();
+        processes.push_back(info);
+    }
+    closedir(dir);
+
+    previousCpu_.swap(currentCpu);
+
+    size_t count = std::min(MAX_PROCESS_ENTRIES, processes.size());
+    std::partial_sort(processes.begin(), processes.begin() + count, processes.end(),
+                      [](const ProcessPowerInfo& a, const ProcessPowerInfo& b) { return a.watts > b.watts; });
+    processes.resize(count);
+    return processes;
+}
+
+#else
+
+bool PowerMonitor::discoverZonesLinux() {
+    return false;
+}
+
+void PowerMonitor::closeZones() {
+    zones_.clear();
+}
+
+bool PowerMonitor::readEnergy(const EnergyZone& zone, uint64_t& energyUj) const {
+    (void)zone;
+    (void)energyUj;
+    return false;
+}
+
+bool PowerMonitor::readBusyTicks(uint64_t& busyTicks) {
+    (void)busyTicks;
+    return false;
+}
+
+std::vector<ProcessPowerInfo> PowerMonitor::attributeProcesses(double packageWatts, uint64_t busyDelta) {
+    (void)packageWatts;
+    (void)busyDelta;
+    return {};
+}
+
+#endif
+
+void PowerMonitor::updatePower() {
+    auto now = std::chrono::steady_clock::now();
+    double elapsed = std::chrono::duration<double>(now - previousSample_).count();
+    bool hasPrevious = previousSample_.time_since_epoch().count() != 0 && elapsed > 0.0;
+
+    std::vector<PowerDomainInfo> domains;
+    double packageWatts = 0.0;
+    for (auto& zone : zones_) {
+        uint64_t energy = 0;
+        if (!readEnergy(zone, energy)) {
+            continue;
+        }
+
+        PowerDomainInfo domain;
+        domain.name = zone.name;
+        domain.zone = zone.zone;
+        domain.socket = zone.socket;
+
+        if (zone.hasLastEnergy) {
+            uint64_t delta = energyDelta(zone.lastEnergyUj, energy, zone.maxEnergyRangeUj);
+            zone.accumulatedUj += delta;
+            if (hasPrevious) {
+                domain.watts = static_cast<double>(delta) / 1e6 / elapsed;
+            }
+        }
+        zone.lastEnergyUj = energy;
+        zone.hasLastEnergy = true;
+        domain.energyUj = zone.accumulatedUj;
+
+        if (zone.isPackage) {
+            packageWatts += domain.watts;
+        }
+
+        domain.sanitize();
+        domains.push_back(domain);
+    }
+
+    // Split package power by each process' share of busy CPU time
+    uint64_t busyTicks = 0;
+    uint64_t busyDelta = 0;
+    if (readBusyTicks(busyTicks)) {
+        if (hasPrevious && busyTicks > previousBusyTicks_) {
+            busyDelta = busyTicks - previousBusyTicks_;
+        }
+        previousBusyTicks_ = busyTicks;
+    }
+    std::vector<ProcessPowerInfo> processes = attributeProcesses(packageWatts, busyDelta);
+
+    previousSample_ = now;
+
+    std::unique_lock<std::shared_mutex> lock(dataMutex_);
+    domains_ = std::move(domains);
+    processPower_ = std::move(processes);
+    totalPackageWatts_ = packageWatts;
+}
+
+uint64_t PowerMonitor::energyDelta(uint64_t previous, uint64_t current, uint64_t maxRange) {
+    if (current >= previous) {
+        return current - previous;
+    }
+    // The counter wrapped at max_energy_range_uj; without a known range the
+    // sample is dropped rather than reported as a huge spike
+    if (maxRange == 0 || previous > maxRange) {
+        return 0;
+    }
+    return (maxRange - previous) + current;
+}
+
+void PowerMonitor::setSysfsRoot(const std::string& path) {
+    sysfsRoot_ = path;
+}
+
+void PowerMonitor::setProcRoot(const std::string& path) {
+    procRoot_ = path;
+}
+
+std::vector<PowerDomainInfo> PowerMonitor::getDomains() const {
+    std::shared_lock<std::shared_mutex> lock(dataMutex_);
+    return domains_;
+}
+
+std::vector<ProcessPowerInfo> PowerMonitor::getProcessPower() const {
+    std::shared_lock<std::shared_mutex> lock(dataMutex_);
+    return processPower_;
+}
+
+bool PowerMonitor::getDomain(const std::string& name, PowerDomainInfo& domain) const {
+    std::shared_lock<std::shared_mutex> lock(dataMutex_);
+    for (const auto& current : domains_) {
+        if (current.name == name || current.zone == name) {
+            domain = current;
+            return true;
+        }
+    }
+    return false;
+}
+
+double PowerMonitor::getTotalPackageWatts() const {
+    std::shared_lock<std::shared_mutex> lock(dataMutex_);
+    return totalPackageWatts_;
+}
+
+bool PowerMonitor::isRunning() const {
+    return running_;
+}
+
+std::chrono::milliseconds PowerMonitor::getUpdateInterval() const {
+    return updateInterval_;
+}
+
+void PowerMonitor::setUpdateInterval(std::chrono::milliseconds interval) {
+    updateInterval_ = interval;
+}
+
+// Fallback mode support
+void PowerMonitor::enableFallbackMode() {
+    fallbackMode_ = true;
+    initialized_ = true;
+
+    std::unique_lock<std::shared_mutex> lock(dataMutex_);
+    domains_.clear();
+    processPower_.clear();
+    totalPackageWatts_ = 0.0;
+}
+
+bool PowerMonitor::isFallbackMode() const {
+    return fallbackMode_;
+}
+
+} // namespace SysMon
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "../shared/systemtypes.h"
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <shared_mutex>
+#include <map>
+
+namespace SysMon {
+
+// Power Monitor - package, core and DRAM power from the powercap (RAPL)
+// energy counters, with an approximate per-process split by CPU time
+//
+// The sysfs and procfs roots are configurable so the collector can be pointed
+// at a captured directory tree instead of the live system.
+class PowerMonitor {
+public:
+    PowerMonitor();
+    ~PowerMonitor();
+
+    // Lifecycle
+    bool initialize();
+    bool start();
+    void stop();
+    void shutdown();
+
+    // Fallback mode support
+    void enableFallbackMode();
+    bool isFallbackMode() const;
+
+    // Configuration (before initialize)
+    void setSysfsRoot(const std::string& path);
+    void setProcRoot(const std::string& path);
+
+    // Data access
+    std::vector<PowerDomainInfo> getDomains() const;
+    std::vector<ProcessPowerInfo> getProcessPower() const;
+    bool getDomain(const std::string& name, PowerDomainInfo& domain) const;
+    double getTotalPackageWatts() const;
+
+    // Status
+    bool isRunning() const;
+    std::chrono::milliseconds getUpdateInterval() const;
+    void setUpdateInterval(std::chrono::milliseconds interval);
+
+    // Sampling (called by the monitoring thread; public for one-shot use)
+    void updatePower();
+
+private:
+    // One powercap zone with an energy counter
+    struct EnergyZone {
+        std::string zone;           // directory name, e.g. "intel-rapl:0:1"
+        std::string name;           // contents of the name file
+        uint32_t socket;
+        bool isPackage;
+        int energyFd;
+        uint64_t maxEnergyRangeUj;
+        uint64_t lastEnergyUj;
+        uint64_t accumulatedUj;
+        bool hasLastEnergy;
+    };
+
+    // CPU time of one process at the previous sample
+    struct CpuSample {
+        uint64_t ticks;             // utime + stime
+        uint64_t startTime;         // detects pid reuse
+    };
+
+    // Monitoring thread
+    void monitoringThread();
+
+    // Platform-specific implementations
+    bool discoverZonesLinux();
+    bool readEnergy(const EnergyZone& zone, uint64_t& energyUj) const;
+    bool readBusyTicks(uint64_t& busyTicks);
+    std::vector<ProcessPowerInfo> attributeProcesses(double packageWatts, uint64_t busyDelta);
+    void closeZones();
+
+    // Helpers
+    static uint64_t energyDelta(uint64_t previous, uint64_t current, uint64_t maxRange);
+
+    // Thread management
+    std::thread monitoringThread_;
+    std::atomic<bool> running_;
+    std::atomic<bool> initialized_;
+    std::atomic<bool> fallbackMode_;
+
+    // Data storage
+    std::vector<PowerDomainInfo> domains_;
+    std::vector<ProcessPowerInfo> processPower_;
+    double totalPackageWatts_;
+    mutable std::shared_mutex dataMutex_;
+
+    // Monitoring thread state
+    std::string sysfsRoot_;
+    std::string procRoot_;
+    std::vector<EnergyZone> zones_;
+    std::map<uint32_t, CpuSample> previousCpu_;
+    uint64_t previousBusyTicks_;
+    std::string readBuffer_;        // reused for /proc/stat and every /proc/<pid>/stat
+    std::chrono::steady_clock::time_point previousSample_;
+
+    // Timing
+    std::chrono::milliseconds updateInterval_;
+
+    // Constants
+    static constexpr std::chrono::milliseconds DEFAULT_UPDATE_INTERVAL{5000};
+    static constexpr size_t MAX_PROCESS_ENTRIES = 20;
+};
+
+} // namespace SysMon
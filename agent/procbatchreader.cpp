@@ -0,0 +1,410 @@
+#include "procbatchreader.h"
+#include "../shared/procparsers.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#endif
+#endif
+
+// Direct descriptors (open into the registered file table) arrived with the
+// same uapi header as IORING_FILE_INDEX_ALLOC
+#ifdef IORING_FILE_INDEX_ALLOC
+#define SYSMON_HAVE_IO_URING
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+namespace SysMon {
+
+constexpr size_t ProcBatchReader::BATCH_PROCESSES;
+constexpr size_t ProcBatchReader::SLOT_SIZE;
+
+namespace {
+
+// user_data of a request: slot << 2 | operation
+constexpr uint64_t OP_OPEN = 0;
+constexpr uint64_t OP_READ = 1;
+constexpr uint64_t OP_CLOSE = 2;
+
+#ifdef SYSMON_HAVE_IO_URING
+const unsigned SETUP_FLAGS[] = {
+#ifdef IORING_SETUP_DEFER_TASKRUN
+    IORING_SETUP_SINGLE_ISSUER | IORING_SETUP_DEFER_TASKRUN,
+#endif
+    IORING_SETUP_COOP_TASKRUN,
+    0,
+};
+#endif
+
+} // anonymous namespace
+
+ProcBatchReader::ProcBatchReader(const std::string& procRoot, const std::vector<std::string>& fileNames)
+    : procRoot_(procRoot)
+    , fileNames_(fileNames)
+    , pathStride_(0)
+    , fileBuffers_(fileNames.size())
+    , contents_(fileNames.size())
+    , ringFd_(-1)
+    , sqRing_(nullptr)
+    , cqRing_(nullptr)
+    , sqRingSize_(0)
+    , cqRingSize_(0)
+    , sqes_(nullptr)
+    , sqesSize_(0)
+    , sqHead_(nullptr)
+    , sqTail_(nullptr)
+    , sqMask_(nullptr)
+    , sqArray_(nullptr)
+    , cqHead_(nullptr)
+    , cqTail_(nullptr)
+    , cqMask_(nullptr)
+    , cqes_(nullptr)
+    , queued_(0) {
+    // "<root>/<pid>/<name>\0"
+    size_t longestName = 0;
+    for (const auto& name : fileNames_) {
+        longestName = std::max(longestName, name.size());
+    }
+    pathStride_ = procRoot_.size() + 1 + 10 + 1 + longestName + 1;
+    pathBuffer_.resize(pathStride_);
+}
+
+ProcBatchReader::~ProcBatchReader() {
+    shutdown();
+}
+
+bool ProcBatchReader::initialize(std::string& error) {
+    if (ringFd_ >= 0) {
+        return true;
+    }
+
+#ifndef SYSMON_HAVE_IO_URING
+    error = "built without io_uring support";
+    return false;
+#else
+    if (fileNames_.empty()) {
+        error = "no files to read";
+        return false;
+    }
+    if (!setupRing(error)) {
+        closeRing();
+        return false;
+    }
+
+    // Opening into a direct descriptor and reading it in the same chain
+    // needs 5.15 or later; older kernels fail the chain instead
+    std::fill(lengths_.begin(), lengths_.end(), -1);
+    queueChain(0, "/proc/self/stat");
+    if (!submitAndWait(queued_, 3) || lengths_[0] <= 0) {
+        error = "io_uring cannot open and read direct descriptors on this kernel";
+        closeRing();
+        return false;
+    }
+    return true;
+#endif
+}
+
+void ProcBatchReader::shutdown() {
+    closeRing();
+}
+
+bool ProcBatchReader::isBatched() const {
+    return ringFd_ >= 0;
+}
+
+void ProcBatchReader::read(const std::vector<uint32_t>& pids, const Handler& handler) {
+    size_t done = 0;
+    while (done < pids.size() && ringFd_ >= 0) {
+        size_t count = std::min(BATCH_PROCESSES, pids.size() - done);
+        if (!readBatch(pids.data() + done, count, handler)) {
+            // The ring is unusable; the rest of this and later scans are synchronous
+            closeRing();
+            break;
+        }
+        done += count;
+    }
+
+    for (; done < pids.size(); ++done) {
+        readSynchronous(pids[done], handler);
+    }
+}
+
+void ProcBatchReader::readSynchronous(uint32_t pid, const Handler& handler) {
+    for (size_t file = 0; file < fileNames_.size(); ++file) {
+        const char* path = formatPath(pid, file, &pathBuffer_[0]);
+        contents_[file] = ProcParsers::readFile(path, fileBuffers_[file]) ? std::string_view(fileBuffers_[file])
+                                                                          : std::string_view();
+    }
+    handler(pid, contents_.data());
+}
+
+const char* ProcBatchReader::formatPath(uint32_t pid, size_t file, char* out) const {
+    std::snprintf(out, pathStride_, "%s/%u/%s", procRoot_.c_str(), pid, fileNames_[file].c_str());
+    return out;
+}
+
+#ifdef SYSMON_HAVE_IO_URING
+
+bool ProcBatchReader::readBatch(const uint32_t* pids, size_t count, const Handler& handler) {
+    const size_t files = fileNames_.size();
+    const size_t slots = count * files;
+    std::fill(lengths_.begin(), lengths_.begin() + slots, -1);
+
+    for (size_t process = 0; process < count; ++process) {
+        for (size_t file = 0; file < files; ++file) {
+            size_t slot = process * files + file;
+            queueChain(slot, formatPath(pids[process], file, &paths_[slot * pathStride_]));
+        }
+    }
+    if (!submitAndWait(queued_, static_cast<unsigned>(slots * 3))) {
+        return false;
+    }
+
+    for (size_t process = 0; process < count; ++process) {
+        for (size_t file = 0; file < files; ++file) {
+            size_t slot = process * files + file;
+            int32_t length = lengths_[slot];
+            if (length < 0) {
+                contents_[file] = std::string_view();
+            } else if (static_cast<size_t>(length) < SLOT_SIZE) {
+                contents_[file] = std::string_view(&buffer_[slot * SLOT_SIZE], static_cast<size_t>(length));
+            } else {
+                // Filled the slot, so possibly truncated
+                const char* path = &paths_[slot * pathStride_];
+                contents_[file] = ProcParsers::readFile(path, fileBuffers_[file])
+                                      ? std::string_view(fileBuffers_[file]) : std::string_view();
+            }
+        }
+        handler(pids[process], contents_.data());
+    }
+    return true;
+}
+
+bool ProcBatchReader::setupRing(std::string& error) {
+    const size_t slots = BATCH_PROCESSES * fileNames_.size();
+    const unsigned requests = static_cast<unsigned>(slots * 3);
+
+    // Completion work runs only when the scanner waits for it (6.1+), else
+    // without interrupting the scanner (5.19+), else the default
+    io_uring_params params;
+    for (unsigned flags : SETUP_FLAGS) {
+        std::memset(&params, 0, sizeof(params));
+        params.flags = flags;
+        ringFd_ = static_cast<int>(syscall(__NR_io_uring_setup, requests, &params));
+        if (ringFd_ >= 0 || errno != EINVAL) {
+            break;
+        }
+    }
+    if (ringFd_ < 0) {
+        error = std::string("io_uring_setup: ") + std::strerror(errno);
+        return false;
+    }
+    if (params.sq_entries < requests || params.cq_entries < requests) {
+        error = "io_uring queues too small";
+        return false;
+    }
+
+    // Map the queues; with IORING_FEAT_SINGLE_MMAP both rings share one mapping
+    sqRingSize_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cqRingSize_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    bool singleMmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (singleMmap) {
+        sqRingSize_ = cqRingSize_ = std::max(sqRingSize_, cqRingSize_);
+    }
+
+    void* sqRing = mmap(nullptr, sqRingSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                        ringFd_, IORING_OFF_SQ_RING);
+    if (sqRing == MAP_FAILED) {
+        error = std::string("io_uring mmap: ") + std::strerror(errno);
+        return false;
+    }
+    sqRing_ = sqRing;
+
+    if (singleMmap) {
+        cqRing_ = sqRing_;
+    } else {
+        void* cqRing = mmap(nullptr, cqRingSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                            ringFd_, IORING_OFF_CQ_RING);
+        if (cqRing == MAP_FAILED) {
+            error = std::string("io_uring mmap: ") + std::strerror(errno);
+            return false;
+        }
+        cqRing_ = cqRing;
+    }
+
+    sqesSize_ = params.sq_entries * sizeof(io_uring_sqe);
+    void* sqes = mmap(nullptr, sqesSize_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                      ringFd_, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED) {
+        error = std::string("io_uring mmap: ") + std::strerror(errno);
+        return false;
+    }
+    sqes_ = static_cast<io_uring_sqe*>(sqes);
+
+    char* sq = static_cast<char*>(sqRing_);
+    char* cq = static_cast<char*>(cqRing_);
+    sqHead_ = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+    sqTail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+    sqMask_ = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+    sqArray_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+    cqHead_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+    cqTail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+    cqMask_ = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+    cqes_ = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+    // One registered buffer cut into slots, and an empty file table that
+    // the opens fill and the closes empty again
+    buffer_.resize(slots * SLOT_SIZE);
+    paths_.resize(slots * pathStride_);
+    lengths_.resize(slots);
+
+    iovec bufferVector;
+    bufferVector.iov_base = buffer_.data();
+    bufferVector.iov_len = buffer_.size();
+    if (syscall(__NR_io_uring_register, ringFd_, IORING_REGISTER_BUFFERS, &bufferVector, 1) < 0) {
+        error = std::string("io_uring buffer registration: ") + std::strerror(errno);
+        return false;
+    }
+
+    std::vector<int> files(slots, -1);
+    if (syscall(__NR_io_uring_register, ringFd_, IORING_REGISTER_FILES, files.data(),
+                static_cast<unsigned>(files.size())) < 0) {
+        error = std::string("io_uring file registration: ") + std::strerror(errno);
+        return false;
+    }
+    return true;
+}
+
+void ProcBatchReader::closeRing() {
+    if (sqes_) {
+        munmap(sqes_, sqesSize_);
+        sqes_ = nullptr;
+    }
+    if (cqRing_ && cqRing_ != sqRing_) {
+        munmap(cqRing_, cqRingSize_);
+    }
+    cqRing_ = nullptr;
+    if (sqRing_) {
+        munmap(sqRing_, sqRingSize_);
+        sqRing_ = nullptr;
+    }
+    // Closing the ring also drops the registered buffer and file table
+    if (ringFd_ >= 0) {
+        close(ringFd_);
+        ringFd_ = -1;
+    }
+    queued_ = 0;
+}
+
+void ProcBatchReader::queueChain(size_t slot, const char* path) {
+    const unsigned mask = *sqMask_;
+    const unsigned tail = *sqTail_ + queued_;
+    io_uring_sqe* chain[3];
+    for (unsigned i = 0; i < 3; ++i) {
+        unsigned index = (tail + i) & mask;
+        sqArray_[index] = index;
+        chain[i] = &sqes_[index];
+        std::memset(chain[i], 0, sizeof(io_uring_sqe));
+    }
+
+    // Open into table slot `slot`; a failed open cancels the rest
+    io_uring_sqe* opening = chain[0];
+    opening->opcode = IORING_OP_OPENAT;
+    opening->fd = AT_FDCWD;
+    opening->addr = reinterpret_cast<uint64_t>(path);
+    opening->open_flags = O_RDONLY;
+    opening->file_index = static_cast<uint32_t>(slot + 1);
+    opening->flags = IOSQE_IO_LINK;
+    opening->user_data = slot << 2 | OP_OPEN;
+
+    // Short reads (the normal case) would sever a plain link, so the
+    // close hangs off a hard link
+    io_uring_sqe* reading = chain[1];
+    reading->opcode = IORING_OP_READ_FIXED;
+    reading->fd = static_cast<int32_t>(slot);
+    reading->addr = reinterpret_cast<uint64_t>(&buffer_[slot * SLOT_SIZE]);
+    reading->len = static_cast<uint32_t>(SLOT_SIZE);
+    reading->off = 0;
+    reading->buf_index = 0;
+    reading->flags = IOSQE_FIXED_FILE | IOSQE_IO_HARDLINK;
+    reading->user_data = slot << 2 | OP_READ;
+
+    io_uring_sqe* closing = chain[2];
+    closing->opcode = IORING_OP_CLOSE;
+    closing->file_index = static_cast<uint32_t>(slot + 1);
+    closing->user_data = slot << 2 | OP_CLOSE;
+
+    queued_ += 3;
+}
+
+bool ProcBatchReader::submitAndWait(unsigned submissions, unsigned completions) {
+    __atomic_store_n(sqTail_, *sqTail_ + queued_, __ATOMIC_RELEASE);
+    queued_ = 0;
+
+    unsigned reaped = 0;
+    while (submissions > 0 || reaped < completions) {
+        long result = syscall(__NR_io_uring_enter, ringFd_, submissions, completions - reaped,
+                              IORING_ENTER_GETEVENTS, nullptr, 0);
+        if (result < 0) {
+            if (errno == EINTR || errno == EAGAIN || errno == EBUSY) {
+                // EBUSY: completions must be reaped before more submissions
+            } else {
+                return false;
+            }
+        } else {
+            submissions -= std::min(submissions, static_cast<unsigned>(result));
+        }
+
+        unsigned head = *cqHead_;
+        unsigned tail = __atomic_load_n(cqTail_, __ATOMIC_ACQUIRE);
+        for (; head != tail; ++head, ++reaped) {
+            const io_uring_cqe& completion = cqes_[head & *cqMask_];
+            size_t slot = static_cast<size_t>(completion.user_data >> 2);
+            if ((completion.user_data & 3) == OP_READ && slot < lengths_.size()) {
+                lengths_[slot] = completion.res >= 0 ? completion.res : -1;
+            }
+        }
+        __atomic_store_n(cqHead_, head, __ATOMIC_RELEASE);
+    }
+    return true;
+}
+
+#else
+
+bool ProcBatchReader::readBatch(const uint32_t* pids, size_t count, const Handler& handler) {
+    (void)pids;
+    (void)count;
+    (void)handler;
+    return false;
+}
+
+bool ProcBatchReader::setupRing(std::string& error) {
+    error = "built without io_uring support";
+    return false;
+}
+
+void ProcBatchReader::closeRing() {
+}
+
+void ProcBatchReader::queueChain(size_t slot, const char* path) {
+    (void)slot;
+    (void)path;
+}
+
+bool ProcBatchReader::submitAndWait(unsigned submissions, unsigned completions) {
+    (void)submissions;
+    (void)completions;
+    return false;
+}
+
+#endif
+
+} // namespace SysMon
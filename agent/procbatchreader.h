@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+namespace SysMon {
+
+// Proc Batch Reader - reads the same few small files (stat, status, ...) of
+// many /proc/<pid> directories for the process scanner
+//
+// With io_uring, every file is a linked open -> read -> close chain on a
+// direct descriptor, reading into one registered buffer, and a batch of
+// BATCH_PROCESSES processes goes to the kernel in one io_uring_enter instead
+// of three system calls per file. The ring is driven through the raw system
+// calls, so there is no liburing dependency; kernels before 5.15 (no direct
+// descriptors), seccomp profiles and kernel.io_uring_disabled make
+// initialize() fail and reads stay synchronous. A file larger than its
+// buffer slot is re-read synchronously, so the handler always sees whole
+// files either way.
+class ProcBatchReader {
+public:
+    // contents[i] holds the file named fileNames[i]; empty when the file
+    // could not be read (process exited, permission denied). The views are
+    // valid only during the call.
+    using Handler = std::function<void(uint32_t pid, const std::string_view* contents)>;
+
+    ProcBatchReader(const std::string& procRoot, const std::vector<std::string>& fileNames);
+    ~ProcBatchReader();
+
+    ProcBatchReader(const ProcBatchReader&) = delete;
+    ProcBatchReader& operator=(const ProcBatchReader&) = delete;
+
+    // Sets up the ring and checks it against the running kernel; without
+    // it (or after a failure) read() is synchronous
+    bool initialize(std::string& error);
+    void shutdown();
+
+    // Calls handler once per pid, in pid list order
+    void read(const std::vector<uint32_t>& pids, const Handler& handler);
+
+    bool isBatched() const;
+
+    // Constants
+    static constexpr size_t BATCH_PROCESSES = 128;
+    static constexpr size_t SLOT_SIZE = 4096;
+
+private:
+    void readSynchronous(uint32_t pid, const Handler& handler);
+    bool readBatch(const uint32_t* pids, size_t count, const Handler& handler);
+    const char* formatPath(uint32_t pid, size_t file, char* out) const;
+
+    // Ring plumbing
+    bool setupRing(std::string& error);
+    void closeRing();
+    void queueChain(size_t slot, const char* path);
+    bool submitAndWait(unsigned submissions, unsigned completions);
+
+    std::string procRoot_;
+    std::vector<std::string> fileNames_;
+    size_t pathStride_;
+
+    // Synchronous reads (fallback and oversized files)
+    std::vector<std::string> fileBuffers_;
+    std::string pathBuffer_;
+    std::vector<std::string_view> contents_;
+
+    // Batch state: one slot per (process, file) of the batch
+    std::vector<char> buffer_;          // registered, SLOT_SIZE per slot
+    std::vector<char> paths_;           // pathStride_ per slot
+    std::vector<int32_t> lengths_;      // read result per slot, -1 = failed
+
+    // Ring
+    int ringFd_;
+    void* sqRing_;
+    void* cqRing_;
+    size_t sqRingSize_;
+    size_t cqRingSize_;
+    io_uring_sqe* sqes_;
+    size_t sqesSize_;
+    unsigned* sqHead_;
+    unsigned* sqTail_;
+    unsigned* sqMask_;
+    unsigned* sqArray_;
+    unsigned* cqHead_;
+    unsigned* cqTail_;
+    unsigned* cqMask_;
+    io_uring_cqe* cqes_;
+    unsigned queued_;
+};
+
+} // namespace SysMon
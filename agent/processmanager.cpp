@@ -1,8 +1,8 @@
 #include "processmanager.h"
+#include "watchdog.h"
+#include "../shared/procparsers.h"
 #include <thread>
 #include <chrono>
-#include <fstream>
-#include <sstream>
 #include <iostream>
 #include <algorithm>
 #include <cstring>
@@ -21,6 +21,7 @@
 #include <sys/types.h>
 #include <fcntl.h>
 #include <sys/stat.h>
+#include <pwd.h>
 #endif
 
 namespace SysMon {
@@ -29,6 +30,8 @@ ProcessManager::ProcessManager()
     : running_(false)
     , initialized_(false)
     , fallbackMode_(false)
+    , batchedReads_(true)
+    , procReader_("/proc", {"stat", "status", "cgroup"})
     , updateInterval_(2000) {
 }
 
@@ -55,6 +58,7 @@ void ProcessManager::shutdown() {
     if (processMonitoringThread_.joinable()) {
         processMonitoringThread_.join();
     }
+    executableIdentities_.stop();
     
     initialized_ = false;
 }
@@ -68,6 +72,9 @@ bool ProcessManager::start() {
         return true;
     }
     
+    Watchdog::getInstance().registerJob("process", updateInterval_);
+    executableIdentities_.start();
+    
     running_ = true;
     processMonitoringThread_ = std::thread(&ProcessManager::processMonitoringThread, this);
     
@@ -80,12 +87,26 @@ void ProcessManager::stop() {
     if (processMonitoringThread_.joinable()) {
         processMonitoringThread_.join();
     }
+    executableIdentities_.stop();
+
+    Watchdog::getInstance().unregisterJob("process");
 }
 
 void ProcessManager::processMonitoringThread() {
+#ifndef _WIN32
+    // The ring belongs to the thread that submits to it
+    std::string error;
+    if (batchedReads_) {
+        procReader_.initialize(error);
+    }
+#endif
+    
     while (running_) {
         try {
-            updateProcessList();
+            {
+                Watchdog::RunGuard guard("process");
+                updateProcessList();
+            }
             
             std::this_thread::sleep_for(updateInterval_);
             
@@ -94,30 +115,56 @@ void ProcessManager::processMonitoringThread() {
             std::this_thread::sleep_for(std::chrono::seconds(1));
         }
     }
+    
+#ifndef _WIN32
+    procReader_.shutdown();
+#endif
 }
 
 void ProcessManager::updateProcessList() {
-    // Temporary simplified implementation
-    std::vector<ProcessInfo> processes;
+    auto table = std::make_shared<ProcessTable>();
     
-    ProcessInfo proc;
-    proc.pid = GetCurrentProcessId();
-    proc.name = "sysmon_agent";
-    proc.cpuUsage = 0.1;
-    proc.memoryUsage = 1024 * 1024; // 1MB
-    proc.status = "R";
-    proc.parentPid = 0;
-    proc.user = "system";
-    processes.push_back(proc);
+#ifdef _WIN32
+    for (const auto& process : getProcessListWindows()) {
+        table->addRow(process.pid, process.parentPid, 'R', process.cpuUsage, process.memoryUsage,
+                      process.name, process.user, "", "", 0);
+    }
+#else
+    scanProcessesLinux(*table);
+#endif
+    
+    // lastUpdate_ is only written here, so the scanning thread reads it unlocked
+    auto now = std::chrono::steady_clock::now();
+    double intervalSeconds = lastUpdate_.time_since_epoch().count() == 0 ? 0.0 :
+        std::chrono::duration<double>(now - lastUpdate_).count();
+    topConsumers_.record(*table, intervalSeconds, static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count()));
     
     std::unique_lock<std::shared_mutex> lock(processMutex_);
-    currentProcessList_ = processes;
-    lastUpdate_ = std::chrono::steady_clock::now();
+    processTable_ = std::move(table);
+    lastUpdate_ = now;
 }
 
 std::vector<ProcessInfo> ProcessManager::getProcessList() {
+    auto table = getProcessTable();
+    return table ? table->toProcessList() : std::vector<ProcessInfo>();
+}
+
+std::shared_ptr<const ProcessTable> ProcessManager::getProcessTable() const {
     std::shared_lock<std::shared_mutex> lock(processMutex_);
-    return currentProcessList_;
+    return processTable_;
+}
+
+std::vector<ExecutableIdentity> ProcessManager::getExecutableIdentities() const {
+    return executableIdentities_.getIdentities();
+}
+
+std::vector<TopConsumerInfo> ProcessManager::getTopConsumers(TopConsumerTracker::Metric metric, uint64_t windowSeconds,
+                                                             size_t limit, uint64_t& coveredSeconds) const {
+    uint64_t nowMs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+    return topConsumers_.query(metric, windowSeconds, limit, nowMs, coveredSeconds);
 }
 
 bool ProcessManager::terminateProcess(uint32_t pid) {
@@ -183,48 +230,97 @@ std::vector<ProcessInfo> ProcessManager::getProcessListWindows() {
 }
 
 #ifndef _WIN32
-std::vector<ProcessInfo> ProcessManager::getProcessListLinux() {
-    std::vector<ProcessInfo> processes;
-    
+void ProcessManager::scanProcessesLinux(ProcessTable& table) {
     DIR* proc_dir = opendir("/proc");
     if (!proc_dir) {
-        return processes;
+        return;
     }
     
+    auto now = std::chrono::steady_clock::now();
+    double elapsedTicks = previousScan_.time_since_epoch().count() == 0 ? 0.0 :
+        std::chrono::duration<double>(now - previousScan_).count() * static_cast<double>(sysconf(_SC_CLK_TCK));
+    static const uint64_t pageSize = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+    
+    scanPids_.clear();
     struct dirent* entry;
     while ((entry = readdir(proc_dir)) != nullptr) {
-        if (!isdigit(entry->d_name[0])) {
-            continue;
+        if (isdigit(static_cast<unsigned char>(entry->d_name[0]))) {
+            scanPids_.push_back(static_cast<uint32_t>(std::strtoul(entry->d_name, nullptr, 10)));
+        }
+    }
+    closedir(proc_dir);
+    
+    std::unordered_map<uint32_t, CpuSample> currentCpu;
+    currentCpu.reserve(scanPids_.size());
+    table.reserve(scanPids_.size());
+    executableIdentities_.beginScan();
+    
+    // contents: stat, status, cgroup (see procReader_)
+    procReader_.read(scanPids_, [&](uint32_t pid, const std::string_view* contents) {
+        ProcParsers::ProcessStat stat;
+        if (!ProcParsers::parseProcessStat(contents[0], stat)) {
+            return; // Exited while scanning
         }
         
-        uint32_t pid = std::stoul(entry->d_name);
+        // CPU since the previous scan; a reused pid has a different start time
+        CpuSample sample{stat.utime + stat.stime, stat.startTime};
+        currentCpu[pid] = sample;
+        double cpu = 0.0;
+        auto previous = previousCpu_.find(pid);
+        if (elapsedTicks > 0.0 && previous != previousCpu_.end() &&
+            previous->second.startTime == stat.startTime && sample.ticks >= previous->second.ticks) {
+            cpu = static_cast<double>(sample.ticks - previous->second.ticks) / elapsedTicks * 100.0;
+        }
         
-        // Read process name from /proc/[pid]/comm
-        std::string comm_path = "/proc/" + std::string(entry->d_name) + "/comm";
-        std::ifstream comm_file(comm_path);
-        std::string name;
-        if (comm_file.is_open()) {
-            std::getline(comm_file, name);
-            // Remove trailing newline
-            if (!name.empty() && name.back() == '\n') {
-                name.pop_back();
+        // Owner from the real uid in status
+        std::string_view text = contents[1];
+        std::string_view line, key, value;
+        uint32_t uid = 0;
+        while (ProcParsers::nextLine(text, line)) {
+            uint64_t realUid = 0;
+            if (ProcParsers::splitKeyValue(line, key, value) && key == "Uid") {
+                if (ProcParsers::parseUnsigned(value, realUid)) {
+                    uid = static_cast<uint32_t>(realUid);
+                }
+                break;
             }
-        } else {
-            name = "Unknown";
         }
         
-        ProcessInfo info;
-        info.pid = pid;
-        info.name = name.empty() ? "Unknown" : name;
-        info.cpuUsage = 0.0; // Would need /proc/stat for real CPU usage
-        info.memoryUsage = 0; // Would need /proc/[pid]/statm for real memory
-        info.status = "Running";
+        // cgroup v2 path ("0::/system.slice/nginx.service"), else the first hierarchy
+        std::string cgroup;
+        text = contents[2];
+        while (ProcParsers::nextLine(text, line)) {
+            std::string_view hierarchy = line;
+            size_t separator = ProcParsers::findByte(hierarchy, ':');
+            if (separator == std::string_view::npos) {
+                continue;
+            }
+            hierarchy.remove_prefix(separator + 1);
+            separator = ProcParsers::findByte(hierarchy, ':');
+            if (separator == std::string_view::npos) {
+                continue;
+            }
+            bool unified = ProcParsers::consumePrefix(line, "0::");
+            if (cgroup.empty() || unified) {
+                cgroup.assign(hierarchy.substr(separator + 1));
+            }
+            if (unified) {
+                break;
+            }
+        }
         
-        processes.push_back(info);
-    }
+        // Executable path and identity, looked up once per process
+        std::string name(stat.name);
+        std::string executable;
+        uint32_t executableId = executableIdentities_.resolve(pid, stat.startTime, name, executable);
+        
+        table.addRow(pid, stat.parentPid, stat.state, cpu, stat.rssPages * pageSize,
+                     name, getUserName(uid), cgroup, executable, executableId);
+    });
     
-    closedir(proc_dir);
-    return processes;
+    executableIdentities_.endScan();
+    previousCpu_.swap(currentCpu);
+    previousScan_ = now;
 }
 #endif
 
@@ -318,12 +414,7 @@ ProcessInfo ProcessManager::getProcessInfoLinux(uint32_t pid) {
     
     // Read process name from /proc/[pid]/comm
     std::string comm_path = "/proc/" + std::to_string(pid) + "/comm";
-    std::ifstream comm_file(comm_path);
-    if (comm_file.is_open()) {
-        std::getline(comm_file, info.name);
-        if (!info.name.empty() && info.name.back() == '\n') {
-            info.name.pop_back();
-        }
+    if (ProcParsers::readAttribute(comm_path, info.name)) {
         info.status = "Running";
     } else {
         info.name = "Unknown";
@@ -341,6 +432,25 @@ std::string ProcessManager::getProcessUser(uint32_t pid) {
     return "system";
 }
 
+std::string ProcessManager::getUserName(uint32_t uid) {
+    auto it = userNames_.find(uid);
+    if (it != userNames_.end()) {
+        return it->second;
+    }
+    
+    std::string name = std::to_string(uid);
+#ifndef _WIN32
+    struct passwd entry;
+    struct passwd* result = nullptr;
+    char buffer[1024];
+    if (getpwuid_r(uid, &entry, buffer, sizeof(buffer), &result) == 0 && result) {
+        name = result->pw_name;
+    }
+#endif
+    userNames_[uid] = name;
+    return name;
+}
+
 // Fallback mode support
 void ProcessManager::enableFallbackMode() {
     fallbackMode_ = true;
@@ -348,7 +458,7 @@ void ProcessManager::enableFallbackMode() {
     
     // Clear process list in fallback mode
     std::lock_guard<std::shared_mutex> lock(processMutex_);
-    currentProcessList_.clear();
+    processTable_.reset();
     criticalProcesses_.clear();
 }
 
@@ -356,4 +466,12 @@ bool ProcessManager::isFallbackMode() const {
     return fallbackMode_;
 }
 
+void ProcessManager::setExecutableHashing(bool enabled) {
+    executableIdentities_.setHashingEnabled(enabled);
+}
+
+void ProcessManager::setBatchedReads(bool enabled) {
+    batchedReads_ = enabled;
+}
+
 } // namespace SysMon
@@ -1,10 +1,16 @@
 #pragma once
 
 #include "../shared/systemtypes.h"
+#include "processtable.h"
+#include "exeidentitycache.h"
+#include "procbatchreader.h"
+#include "topconsumers.h"
 #include <memory>
 #include <thread>
 #include <atomic>
 #include <shared_mutex>
+#include <unordered_map>
+#include <map>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -35,8 +41,16 @@ public:
     void enableFallbackMode();
     bool isFallbackMode() const;
     
+    // Configuration (before start)
+    void setExecutableHashing(bool enabled);
+    void setBatchedReads(bool enabled);     // io_uring reads of /proc (Linux)
+    
     // Process operations
     std::vector<ProcessInfo> getProcessList();
+    std::shared_ptr<const ProcessTable> getProcessTable() const;
+    std::vector<ExecutableIdentity> getExecutableIdentities() const;
+    std::vector<TopConsumerInfo> getTopConsumers(TopConsumerTracker::Metric metric, uint64_t windowSeconds,
+                                                 size_t limit, uint64_t& coveredSeconds) const;
     bool terminateProcess(uint32_t pid);
     bool killProcess(uint32_t pid);
     bool isCriticalProcess(uint32_t pid) const;
@@ -50,7 +64,7 @@ private:
     void updateProcessList();
     
     // Platform-specific implementations
-    std::vector<ProcessInfo> getProcessListLinux();
+    void scanProcessesLinux(ProcessTable& table);
     std::vector<ProcessInfo> getProcessListWindows();
     bool terminateProcessLinux(uint32_t pid);
     bool terminateProcessWindows(uint32_t pid);
@@ -69,6 +83,7 @@ private:
     uint64_t getProcessMemoryUsage(uint32_t pid);
     std::string getProcessStatus(uint32_t pid);
     std::string getProcessUser(uint32_t pid);
+    std::string getUserName(uint32_t uid);
     uint32_t getParentPid(uint32_t pid);
     
     // Thread management
@@ -77,11 +92,25 @@ private:
     std::atomic<bool> initialized_;
     std::atomic<bool> fallbackMode_;
     
-    // Process storage
-    std::vector<ProcessInfo> currentProcessList_;
+    // Process storage; each scan publishes a new immutable table
+    std::shared_ptr<const ProcessTable> processTable_;
     std::vector<uint32_t> criticalProcesses_;
     mutable std::shared_mutex processMutex_;
     
+    // CPU accounting between scans (scanning thread only)
+    struct CpuSample {
+        uint64_t ticks;
+        uint64_t startTime;
+    };
+    std::unordered_map<uint32_t, CpuSample> previousCpu_;
+    std::chrono::steady_clock::time_point previousScan_;
+    std::map<uint32_t, std::string> userNames_;
+    ExecutableIdentityCache executableIdentities_;
+    bool batchedReads_;
+    ProcBatchReader procReader_;        // stat, status and cgroup of every process
+    std::vector<uint32_t> scanPids_;
+    TopConsumerTracker topConsumers_;   // fed by every scan
+    
     // Timing
     std::chrono::steady_clock::time_point lastUpdate_;
     std::chrono::milliseconds updateInterval_;
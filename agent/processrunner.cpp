@@ -0,0 +1,454 @@
+#include "processrunner.h"
+#include <sstream>
+#include <thread>
+#include <algorithm>
+#include <cerrno>
+
+#ifndef _WIN32
+#include <spawn.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+extern char** environ;
+#endif
+
+namespace SysMon {
+
+constexpr std::chrono::milliseconds ProcessRunner::DEFAULT_TIMEOUT;
+constexpr size_t ProcessRunner::MAX_OUTPUT_SIZE;
+constexpr size_t ProcessRunner::READ_CHUNK_SIZE;
+
+#ifndef _WIN32
+
+namespace {
+
+// Per-child bookkeeping for the capture loop
+struct ChildProcess {
+    pid_t pid = -1;
+    int outFd = -1;
+    int errFd = -1;
+    bool reaped = false;
+};
+
+void closeFd(int& fd) {
+    if (fd >= 0) {
+        close(fd);
+        fd = -1;
+    }
+}
+
+bool setNonBlocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+// New process group so a timeout can kill the whole tree; the agent
+// ignores SIGPIPE, which must not leak into the tools it runs
+void initSpawnAttributes(posix_spawnattr_t& attributes) {
+    posix_spawnattr_init(&attributes);
+    sigset_t defaultSignals;
+    sigemptyset(&defaultSignals);
+    sigaddset(&defaultSignals, SIGPIPE);
+    sigaddset(&defaultSignals, SIGINT);
+    sigaddset(&defaultSignals, SIGTERM);
+    sigset_t emptyMask;
+    sigemptyset(&emptyMask);
+    posix_spawnattr_setsigdefault(&attributes, &defaultSignals);
+    posix_spawnattr_setsigmask(&attributes, &emptyMask);
+    posix_spawnattr_setpgroup(&attributes, 0);
+    posix_spawnattr_setflags(&attributes, POSIX_SPAWN_SETPGROUP | POSIX_SPAWN_SETSIGDEF |
+                                          POSIX_SPAWN_SETSIGMASK);
+}
+
+bool spawnChild(const std::vector<std::string>& argv, ChildProcess& child) {
+    if (argv.empty() || argv[0].empty()) {
+        return false;
+    }
+
+    int outPipe[2] = {-1, -1};
+    int errPipe[2] = {-1, -1};
+    if (pipe2(outPipe, O_CLOEXEC) != 0) {
+        return false;
+    }
+    if (pipe2(errPipe, O_CLOEXEC) != 0) {
+        closeFd(outPipe[0]);
+        closeFd(outPipe[1]);
+        return false;
+    }
+
+    // stdin from /dev/null, stdout/stderr into the pipes; the original pipe
+    // ends are close-on-exec so concurrent children never inherit each other's
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_addopen(&actions, STDIN_FILENO, "/dev/null", O_RDONLY, 0);
+    posix_spawn_file_actions_adddup2(&actions, outPipe[1], STDOUT_FILENO);
+    posix_spawn_file_actions_adddup2(&actions, errPipe[1], STDERR_FILENO);
+
+    posix_spawnattr_t attributes;
+    initSpawnAttributes(attributes);
+
+    std::vector<char*> args;
+    args.reserve(argv.size() + 1);
+    for (const auto& arg : argv) {
+        args.push_back(const_cast<char*>(arg.c_str()));
+    }
+    args.push_back(nullptr);
+
+    int spawnResult = posix_spawnp(&child.pid, args[0], &actions, &attributes, args.data(), environ);
+
+    posix_spawn_file_actions_destroy(&actions);
+    posix_spawnattr_destroy(&attributes);
+    closeFd(outPipe[1]);
+    closeFd(errPipe[1]);
+
+    if (spawnResult != 0) {
+        child.pid = -1;
+        closeFd(outPipe[0]);
+        closeFd(errPipe[0]);
+        return false;
+    }
+
+    child.outFd = outPipe[0];
+    child.errFd = errPipe[0];
+    setNonBlocking(child.outFd);
+    setNonBlocking(child.errFd);
+    return true;
+}
+
+// Drain everything currently readable; closes the fd on EOF or error
+void drainPipe(int& fd, std::string& buffer) {
+    char chunk[ProcessRunner::READ_CHUNK_SIZE];
+    while (fd >= 0) {
+        ssize_t bytesRead = read(fd, chunk, sizeof(chunk));
+        if (bytesRead > 0) {
+            size_t room = ProcessRunner::MAX_OUTPUT_SIZE - std::min(buffer.size(), ProcessRunner::MAX_OUTPUT_SIZE);
+            buffer.append(chunk, std::min(static_cast<size_t>(bytesRead), room));
+        } else if (bytesRead == 0) {
+            closeFd(fd);
+        } else if (errno == EINTR) {
+            continue;
+        } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            return;
+        } else {
+            closeFd(fd);
+        }
+    }
+}
+
+void recordExit(ChildProcess& child, ProcessResult& result, int status) {
+    child.reaped = true;
+    result.exitCode = WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+} // anonymous namespace
+
+std::vector<ProcessResult> ProcessRunner::runAll(const std::vector<std::vector<std::string>>& commands,
+                                                 std::chrono::milliseconds timeout) {
+    std::vector<ProcessResult> results(commands.size());
+    std::vector<ChildProcess> children(commands.size());
+
+    for (size_t i = 0; i < commands.size(); ++i) {
+        results[i].started = spawnChild(commands[i], children[i]);
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    bool expired = false;
+
+    // Capture loop - the remaining time is recomputed from the absolute
+    // deadline on every pass
+    std::vector<pollfd> pollFds;
+    std::vector<std::pair<size_t, bool>> owners; // child index, true = stdout
+    while (true) {
+        pollFds.clear();
+        owners.clear();
+        for (size_t i = 0; i < children.size(); ++i) {
+            if (children[i].outFd >= 0) {
+                pollFds.push_back({children[i].outFd, POLLIN, 0});
+                owners.emplace_back(i, true);
+            }
+            if (children[i].errFd >= 0) {
+                pollFds.push_back({children[i].errFd, POLLIN, 0});
+                owners.emplace_back(i, false);
+            }
+        }
+        if (pollFds.empty()) {
+            break;
+        }
+
+        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now());
+        if (remaining.count() <= 0) {
+            expired = true;
+            break;
+        }
+
+        int ready = poll(pollFds.data(), pollFds.size(), static_cast<int>(remaining.count()));
+        if (ready < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            expired = true;
+            break;
+        }
+
+        for (size_t p = 0; p < pollFds.size(); ++p) {
+            if (pollFds[p].revents == 0) {
+                continue;
+            }
+            ChildProcess& child = children[owners[p].first];
+            ProcessResult& result = results[owners[p].first];
+            if (owners[p].second) {
+                drainPipe(child.outFd, result.output);
+            } else {
+                drainPipe(child.errFd, result.errorOutput);
+            }
+        }
+    }
+
+    // Reap children; anything still alive past the deadline loses its group
+    for (size_t i = 0; i < children.size(); ++i) {
+        ChildProcess& child = children[i];
+        if (child.pid <= 0) {
+            continue;
+        }
+
+        int status = 0;
+        while (!child.reaped) {
+            pid_t waited = waitpid(child.pid, &status, WNOHANG);
+            if (waited == child.pid) {
+                recordExit(child, results[i], status);
+            } else if (waited < 0 && errno != EINTR) {
+                child.reaped = true;
+            } else if (expired || std::chrono::steady_clock::now() >= deadline) {
+                break;
+            } else {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+
+        if (!child.reaped) {
+            killpg(child.pid, SIGKILL);
+            while (waitpid(child.pid, &status, 0) < 0 && errno == EINTR) {
+            }
+            results[i].timedOut = true;
+            results[i].exitCode = -1;
+            child.reaped = true;
+        } else if (expired && (child.outFd >= 0 || child.errFd >= 0)) {
+            // Leader exited but a background descendant still holds the pipes
+            killpg(child.pid, SIGKILL);
+            results[i].timedOut = true;
+        }
+
+        closeFd(child.outFd);
+        closeFd(child.errFd);
+    }
+
+    return results;
+}
+
+#else
+
+std::vector<ProcessResult> ProcessRunner::runAll(const std::vector<std::vector<std::string>>& commands,
+                                                 std::chrono::milliseconds timeout) {
+    // Windows callers keep their CreateProcess paths
+    (void)timeout;
+    return std::vector<ProcessResult>(commands.size());
+}
+
+#endif
+
+ProcessResult ProcessRunner::run(const std::vector<std::string>& argv, std::chrono::milliseconds timeout) {
+    return runAll({argv}, timeout).front();
+}
+
+std::vector<std::string> ProcessRunner::splitArguments(const std::string& commandLine) {
+    std::vector<std::string> args;
+    std::istringstream iss(commandLine);
+    std::string arg;
+    while (iss >> arg) {
+        args.push_back(arg);
+    }
+    return args;
+}
+
+// ShellSession implementation
+ShellSession::ShellSession()
+    : pid_(-1)
+    , inFd_(-1)
+    , outFd_(-1) {
+}
+
+ShellSession::~ShellSession() {
+    stop();
+}
+
+bool ShellSession::start(const std::vector<std::string>& argv) {
+#ifdef _WIN32
+    (void)argv;
+    return false;
+#else
+    stop();
+    if (argv.empty() || argv[0].empty()) {
+        return false;
+    }
+
+    int inPipe[2] = {-1, -1};
+    int outPipe[2] = {-1, -1};
+    if (pipe2(inPipe, O_CLOEXEC) != 0) {
+        return false;
+    }
+    if (pipe2(outPipe, O_CLOEXEC) != 0) {
+        closeFd(inPipe[0]);
+        closeFd(inPipe[1]);
+        return false;
+    }
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, inPipe[0], STDIN_FILENO);
+    posix_spawn_file_actions_adddup2(&actions, outPipe[1], STDOUT_FILENO);
+    posix_spawn_file_actions_addopen(&actions, STDERR_FILENO, "/dev/null", O_WRONLY, 0);
+
+    posix_spawnattr_t attributes;
+    initSpawnAttributes(attributes);
+
+    std::vector<char*> args;
+    args.reserve(argv.size() + 1);
+    for (const auto& arg : argv) {
+        args.push_back(const_cast<char*>(arg.c_str()));
+    }
+    args.push_back(nullptr);
+
+    pid_t pid = -1;
+    int spawnResult = posix_spawnp(&pid, args[0], &actions, &attributes, args.data(), environ);
+
+    posix_spawn_file_actions_destroy(&actions);
+    posix_spawnattr_destroy(&attributes);
+    closeFd(inPipe[0]);
+    closeFd(outPipe[1]);
+
+    if (spawnResult != 0) {
+        closeFd(inPipe[1]);
+        closeFd(outPipe[0]);
+        return false;
+    }
+
+    pid_ = pid;
+    inFd_ = inPipe[1];
+    outFd_ = outPipe[0];
+    setNonBlocking(outFd_);
+    buffer_.clear();
+    return true;
+#endif
+}
+
+void ShellSession::stop() {
+#ifndef _WIN32
+    closeFd(inFd_);
+    closeFd(outFd_);
+    if (pid_ > 0) {
+        // The shell may be blocked on the device side, so do not wait for EOF
+        killpg(pid_, SIGKILL);
+        int status = 0;
+        while (waitpid(pid_, &status, 0) < 0 && errno == EINTR) {
+        }
+    }
+#endif
+    pid_ = -1;
+    buffer_.clear();
+}
+
+bool ShellSession::isRunning() const {
+    return pid_ > 0 && inFd_ >= 0 && outFd_ >= 0;
+}
+
+bool ShellSession::execute(const std::string& script, const std::string& endMarker, std::string& output,
+                           std::chrono::milliseconds timeout) {
+    output.clear();
+    return send(script) && receive(endMarker, output, timeout);
+}
+
+bool ShellSession::send(const std::string& script) {
+#ifdef _WIN32
+    (void)script;
+    return false;
+#else
+    if (!isRunning()) {
+        return false;
+    }
+
+    // Scripts are a few hundred bytes, well under the pipe buffer
+    size_t written = 0;
+    while (written < script.size()) {
+        ssize_t result = write(inFd_, script.data() + written, script.size() - written);
+        if (result < 0 && errno == EINTR) {
+            continue;
+        }
+        if (result <= 0) {
+            stop();
+            return false;
+        }
+        written += static_cast<size_t>(result);
+    }
+    return true;
+#endif
+}
+
+bool ShellSession::receive(const std::string& endMarker, std::string& output,
+                           std::chrono::milliseconds timeout) {
+#ifdef _WIN32
+    (void)endMarker;
+    (void)output;
+    (void)timeout;
+    return false;
+#else
+    output.clear();
+    if (!isRunning() || endMarker.empty()) {
+        return false;
+    }
+
+    const std::string markerLine = endMarker + "\n";
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    size_t searchFrom = 0;
+    while (true) {
+        // The marker must start a line, so echoed text cannot end the read early
+        size_t position = buffer_.find(markerLine, searchFrom);
+        while (position != std::string::npos && position > 0 && buffer_[position - 1] != '\n') {
+            position = buffer_.find(markerLine, position + 1);
+        }
+        if (position != std::string::npos) {
+            output.assign(buffer_, 0, position);
+            buffer_.erase(0, position + markerLine.size());
+            return true;
+        }
+        searchFrom = buffer_.size() > markerLine.size() ? buffer_.size() - markerLine.size() : 0;
+        if (outFd_ < 0) {
+            stop(); // The shell exited (device unplugged)
+            return false;
+        }
+
+        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now());
+        if (remaining.count() <= 0 || buffer_.size() >= ProcessRunner::MAX_OUTPUT_SIZE) {
+            stop();
+            return false;
+        }
+
+        pollfd pollFd{outFd_, POLLIN, 0};
+        int ready = poll(&pollFd, 1, static_cast<int>(remaining.count()));
+        if (ready < 0 && errno != EINTR) {
+            stop();
+            return false;
+        }
+        if (ready > 0) {
+            drainPipe(outFd_, buffer_);
+        }
+    }
+#endif
+}
+
+} // namespace SysMon
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <chrono>
+
+namespace SysMon {
+
+// Result of a single child process run
+struct ProcessResult {
+    bool started;
+    bool timedOut;
+    int exitCode;           // -1 if the child did not exit normally
+    std::string output;     // captured stdout
+    std::string errorOutput; // captured stderr
+
+    ProcessResult() : started(false), timedOut(false), exitCode(-1) {}
+
+    bool succeeded() const { return started && !timedOut && exitCode == 0; }
+};
+
+// Process Runner - spawns external tools without a shell
+//
+// Children are started with posix_spawnp() in their own process group, so a
+// timeout kills the whole tree (e.g. adb plus its helpers). stdout and stderr
+// are drained through non-blocking pipes with poll(), and the deadline is
+// absolute, so partial reads never extend it. All state is local to a call,
+// so any number of threads may run children concurrently.
+class ProcessRunner {
+public:
+    // Run one command and wait for it (argv[0] is looked up in PATH)
+    static ProcessResult run(const std::vector<std::string>& argv,
+                             std::chrono::milliseconds timeout = DEFAULT_TIMEOUT);
+
+    // Run several commands concurrently under one shared deadline
+    static std::vector<ProcessResult> runAll(const std::vector<std::vector<std::string>>& commands,
+                                             std::chrono::milliseconds timeout = DEFAULT_TIMEOUT);
+
+    // Split a command line on whitespace (no quoting, no shell semantics)
+    static std::vector<std::string> splitArguments(const std::string& commandLine);
+
+    // Constants
+    static constexpr std::chrono::milliseconds DEFAULT_TIMEOUT{5000};
+    static constexpr size_t MAX_OUTPUT_SIZE = 16 * 1024 * 1024;
+    static constexpr size_t READ_CHUNK_SIZE = 4096;
+};
+
+// Shell Session - one long-lived child that is fed scripts on stdin
+//
+// For tools that are queried every few seconds (adb shell): a round trip
+// costs one write and one read instead of spawning a process per query.
+// A script must print a marker line last; receive() returns stdout up to
+// it, and stderr is discarded. send() and receive() are separate so several
+// sessions can work in parallel. A session that times out is killed, since
+// its output can no longer be framed, and must be started again.
+// Not thread-safe.
+class ShellSession {
+public:
+    ShellSession();
+    ~ShellSession();
+
+    ShellSession(const ShellSession&) = delete;
+    ShellSession& operator=(const ShellSession&) = delete;
+
+    bool start(const std::vector<std::string>& argv);
+    void stop();
+    bool isRunning() const;
+
+    bool send(const std::string& script);
+    bool receive(const std::string& endMarker, std::string& output,
+                 std::chrono::milliseconds timeout = ProcessRunner::DEFAULT_TIMEOUT);
+    bool execute(const std::string& script, const std::string& endMarker, std::string& output,
+                 std::chrono::milliseconds timeout = ProcessRunner::DEFAULT_TIMEOUT);
+
+private:
+    int pid_;
+    int inFd_;
+    int outFd_;
+    std::string buffer_;    // bytes read past the previous marker
+};
+
+} // namespace SysMon
@@ -0,0 +1,147 @@
+#include "processtable.h"
+#include <algorithm>
+
+namespace SysMon {
+
+// StringColumn implementation
+uint32_t ProcessTable::StringColumn::intern(const std::string& value) {
+    auto it = index_.find(value);
+    uint32_t code;
+    if (it != index_.end()) {
+        code = it->second;
+    } else {
+        code = static_cast<uint32_t>(values_.size());
+        values_.push_back(value);
+        index_.emplace(value, code);
+    }
+    codes.push_back(code);
+    return code;
+}
+
+const std::string& ProcessTable::StringColumn::value(uint32_t code) const {
+    return values_[code];
+}
+
+size_t ProcessTable::StringColumn::distinctCount() const {
+    return values_.size();
+}
+
+void ProcessTable::StringColumn::clear() {
+    codes.clear();
+    values_.clear();
+    index_.clear();
+}
+
+// ProcessTable implementation
+void ProcessTable::clear() {
+    pids.clear();
+    parentPids.clear();
+    states.clear();
+    cpuUsage.clear();
+    rssBytes.clear();
+    names.clear();
+    users.clear();
+    cgroups.clear();
+    executables.clear();
+    executableIds.clear();
+}
+
+void ProcessTable::reserve(size_t rows) {
+    pids.reserve(rows);
+    parentPids.reserve(rows);
+    states.reserve(rows);
+    cpuUsage.reserve(rows);
+    rssBytes.reserve(rows);
+    names.codes.reserve(rows);
+    users.codes.reserve(rows);
+    cgroups.codes.reserve(rows);
+    executables.codes.reserve(rows);
+    executableIds.reserve(rows);
+}
+
+void ProcessTable::addRow(uint32_t pid, uint32_t parentPid, char state, double cpu, uint64_t rss,
+                          const std::string& name, const std::string& user,
+                          const std::string& cgroup, const std::string& executable, uint32_t executableId) {
+    pids.push_back(pid);
+    parentPids.push_back(parentPid);
+    states.push_back(state);
+    cpuUsage.push_back(cpu);
+    rssBytes.push_back(rss);
+    names.intern(name);
+    users.intern(user);
+    cgroups.intern(cgroup);
+    executables.intern(executable);
+    executableIds.push_back(executableId);
+}
+
+size_t ProcessTable::size() const {
+    return pids.size();
+}
+
+std::vector<ProcessInfo> ProcessTable::toProcessList() const {
+    std::vector<ProcessInfo> processes;
+    processes.reserve(size());
+
+    for (size_t row = 0; row < size(); ++row) {
+        ProcessInfo info;
+        info.pid = pids[row];
+        info.parentPid = parentPids[row];
+        info.name = names.value(names.codes[row]);
+        info.user = users.value(users.codes[row]);
+        info.status = std::string(1, states[row]);
+        info.cpuUsage = cpuUsage[row];
+        info.memoryUsage = rssBytes[row];
+        info.executableId = executableIds[row];
+        processes.push_back(info);
+    }
+    return processes;
+}
+
+std::vector<ProcessAggregate> ProcessTable::aggregate(GroupKey key) const {
+    const StringColumn& keys = column(key);
+
+    // Codes are dense, so the code is the group's slot
+    std::vector<ProcessAggregate> groups(keys.distinctCount());
+    for (size_t row = 0; row < keys.codes.size(); ++row) {
+        ProcessAggregate& group = groups[keys.codes[row]];
+        group.count++;
+        group.cpuTotal += cpuUsage[row];
+        group.cpuMax = std::max(group.cpuMax, cpuUsage[row]);
+        group.rssTotal += rssBytes[row];
+    }
+
+    for (uint32_t code = 0; code < groups.size(); ++code) {
+        groups[code].key = keys.value(code);
+    }
+    return groups;
+}
+
+bool ProcessTable::parseGroupKey(const std::string& str, GroupKey& key) {
+    if (str == "name") key = GroupKey::NAME;
+    else if (str == "user") key = GroupKey::USER;
+    else if (str == "cgroup") key = GroupKey::CGROUP;
+    else if (str == "exe" || str == "executable") key = GroupKey::EXECUTABLE;
+    else return false;
+    return true;
+}
+
+std::string ProcessTable::groupKeyToString(GroupKey key) {
+    switch (key) {
+        case GroupKey::NAME: return "name";
+        case GroupKey::USER: return "user";
+        case GroupKey::CGROUP: return "cgroup";
+        case GroupKey::EXECUTABLE: return "exe";
+        default: return "unknown";
+    }
+}
+
+const ProcessTable::StringColumn& ProcessTable::column(GroupKey key) const {
+    switch (key) {
+        case GroupKey::USER: return users;
+        case GroupKey::CGROUP: return cgroups;
+        case GroupKey::EXECUTABLE: return executables;
+        default: return names;
+    }
+}
+
+} // namespace SysMon
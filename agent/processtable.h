@@ -0,0 +1,75 @@
+#pragma once
+
+#include "../shared/systemtypes.h"
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace SysMon {
+
+// Process Table - columnar snapshot of every process
+//
+// One row per process, stored column by column. String columns are
+// dictionary-encoded: each distinct name, user, cgroup or executable is
+// stored once and rows hold its integer code. Interning hashes every string
+// once when the row is added; grouping then works on the dense codes, so an
+// aggregation is a single pass over two or three flat arrays.
+class ProcessTable {
+public:
+    enum class GroupKey {
+        NAME,
+        USER,
+        CGROUP,
+        EXECUTABLE
+    };
+
+    // Dictionary-encoded string column
+    class StringColumn {
+    public:
+        uint32_t intern(const std::string& value);
+        const std::string& value(uint32_t code) const;
+        size_t distinctCount() const;
+        void clear();
+
+        std::vector<uint32_t> codes;
+
+    private:
+        std::vector<std::string> values_;
+        std::unordered_map<std::string, uint32_t> index_;
+    };
+
+    ProcessTable() = default;
+
+    void clear();
+    void reserve(size_t rows);
+    void addRow(uint32_t pid, uint32_t parentPid, char state, double cpuUsage, uint64_t rssBytes,
+                const std::string& name, const std::string& user,
+                const std::string& cgroup, const std::string& executable, uint32_t executableId);
+    size_t size() const;
+
+    // Row-oriented view for GET_PROCESS_LIST
+    std::vector<ProcessInfo> toProcessList() const;
+
+    // Count, CPU sum/max and RSS sum per distinct key, in code order
+    std::vector<ProcessAggregate> aggregate(GroupKey key) const;
+
+    static bool parseGroupKey(const std::string& str, GroupKey& key);
+    static std::string groupKeyToString(GroupKey key);
+
+    // Columns
+    std::vector<uint32_t> pids;
+    std::vector<uint32_t> parentPids;
+    std::vector<char> states;
+    std::vector<double> cpuUsage;       // percent of one CPU since the previous scan
+    std::vector<uint64_t> rssBytes;
+    StringColumn names;
+    StringColumn users;
+    StringColumn cgroups;
+    StringColumn executables;
+    std::vector<uint32_t> executableIds; // ExecutableIdentityCache ids, 0 when unknown
+
+private:
+    const StringColumn& column(GroupKey key) const;
+};
+
+} // namespace SysMon
@@ -1,4 +1,5 @@
 #include "systemmonitor.h"
+#include "watchdog.h"
 #include <thread>
 #include <chrono>
 #include <fstream>
@@ -80,6 +81,8 @@ bool SystemMonitor::start() {
         return true;
     }
     
+    Watchdog::getInstance().registerJob("system", updateInterval_);
+    
     running_ = true;
     monitoringThread_ = std::thread(&SystemMonitor::monitoringThread, this);
     
@@ -92,13 +95,18 @@ void SystemMonitor::stop() {
     if (monitoringThread_.joinable()) {
         monitoringThread_.join();
     }
+
+    Watchdog::getInstance().unregisterJob("system");
 }
 
 void SystemMonitor::monitoringThread() {
     while (running_) {
         try {
-            updateSystemInfo();
-            updateProcessList();
+            {
+                Watchdog::RunGuard guard("system");
+                updateSystemInfo();
+                updateProcessList();
+            }
             
             std::this_thread::sleep_for(updateInterval_);
             
@@ -174,63 +182,41 @@ SystemInfo SystemMonitor::collectSystemInfoLinux() {
     SystemInfo info;
     
     // Get CPU usage from /proc/stat
-    std::ifstream statFile("/proc/stat");
-    if (statFile.is_open()) {
-        std::string line;
-        if (std::getline(statFile, line)) {
-            std::istringstream iss(line);
-            std::string cpu;
-            unsigned long long user, nice, system, idle, iowait, irq, softirq;
-            if (iss >> cpu >> user >> nice >> system >> idle >> iowait >> irq >> softirq) {
-                static unsigned long long lastIdle = 0, lastTotal = 0;
-                
-                unsigned long long total = user + nice + system + idle + iowait + irq + softirq;
-                unsigned long long idleDiff = idle - lastIdle;
-                unsigned long long totalDiff = total - lastTotal;
-                
-                if (totalDiff > 0) {
-                    info.cpuUsageTotal = 100.0 * (1.0 - (double)idleDiff / totalDiff);
-                }
-                
-                lastIdle = idle;
-                lastTotal = total;
-            }
+    std::string& buffer = readBuffer_;
+    ProcParsers::CpuTimes total;
+    std::vector<ProcParsers::CpuTimes> cores;
+    if (ProcParsers::readFile("/proc/stat", buffer) && ProcParsers::parseCpuStat(buffer, total, &cores)) {
+        info.cpuUsageTotal = ProcParsers::cpuUsagePercent(previousCpuTotal_, total);
+        info.cpuCoresUsage.resize(cores.size());
+        for (size_t i = 0; i < cores.size(); ++i) {
+            info.cpuCoresUsage[i] = i < previousCpuCores_.size() ?
+                ProcParsers::cpuUsagePercent(previousCpuCores_[i], cores[i]) : 0.0;
         }
+        
+        previousCpuTotal_ = total;
+        previousCpuCores_.swap(cores);
     }
     
     // Get memory info from /proc/meminfo
-    std::ifstream memFile("/proc/meminfo");
-    if (memFile.is_open()) {
-        std::string line;
-        while (std::getline(memFile, line)) {
-            if (line.find("MemTotal:") == 0) {
-                std::istringstream iss(line);
-                std::string label;
-                unsigned long long value;
-                std::string unit;
-                iss >> label >> value >> unit;
-                info.memoryTotal = value * 1024; // Convert KB to bytes
-            } else if (line.find("MemAvailable:") == 0) {
-                std::istringstream iss(line);
-                std::string label;
-                unsigned long long value;
-                std::string unit;
-                iss >> label >> value >> unit;
-                info.memoryFree = value * 1024; // Convert KB to bytes
-            }
-        }
-        info.memoryUsed = info.memoryTotal - info.memoryFree;
+    ProcParsers::MemInfo memInfo;
+    if (ProcParsers::readFile("/proc/meminfo", buffer) && ProcParsers::parseMemInfo(buffer, memInfo)) {
+        info.memoryTotal = memInfo.totalBytes;
+        info.memoryFree = memInfo.availableBytes;
+        info.memoryUsed = memInfo.totalBytes - std::min(memInfo.totalBytes, memInfo.availableBytes);
     }
     
     // Get CPU cores
-    info.cpuCoresUsage.resize(std::thread::hardware_concurrency(), info.cpuUsageTotal / std::thread::hardware_concurrency());
+    if (info.cpuCoresUsage.empty()) {
+        info.cpuCoresUsage.resize(std::thread::hardware_concurrency(), info.cpuUsageTotal);
+    }
     
-    // Get uptime from /proc/uptime
-    std::ifstream uptimeFile("/proc/uptime");
-    if (uptimeFile.is_open()) {
-        double uptimeSeconds;
-        uptimeFile >> uptimeSeconds;
-        info.uptime = std::chrono::seconds(static_cast<long long>(uptimeSeconds));
+    // Get uptime from /proc/uptime ("12345.67 54321.00")
+    if (ProcParsers::readFile("/proc/uptime", buffer)) {
+        std::string_view uptime = buffer;
+        double uptimeSeconds = 0.0;
+        if (ProcParsers::parseDecimal(uptime, uptimeSeconds)) {
+            info.uptime = std::chrono::seconds(static_cast<long long>(uptimeSeconds));
+        }
     }
     
     return info;
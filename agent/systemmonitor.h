@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../shared/systemtypes.h"
+#include "../shared/procparsers.h"
 #include <memory>
 #include <thread>
 #include <atomic>
@@ -72,7 +73,7 @@ private:
     uint64_t getContextSwitches();
     std::chrono::seconds getSystemUptime();
     
-    // Linux-specific helper
+    // Linux-specific helpers
     ProcessInfo getProcessInfoLinux(pid_t pid);
     
     // Thread management
@@ -107,6 +108,9 @@ private:
         unsigned long long work;
     };
     std::vector<CpuTime> prevCpuTimes_;
+    ProcParsers::CpuTimes previousCpuTotal_;
+    std::vector<ProcParsers::CpuTimes> previousCpuCores_;
+    std::string readBuffer_;    // reused by every sample
 #endif
 };
 
@@ -0,0 +1,759 @@
+#include "taskstatsmonitor.h"
+#include "watchdog.h"
+#include "../shared/procparsers.h"
+#include <thread>
+#include <chrono>
+#include <cstring>
+#include <algorithm>
+#include <set>
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <linux/netlink.h>
+#include <linux/genetlink.h>
+#include <linux/taskstats.h>
+#endif
+
+namespace SysMon {
+
+constexpr std::chrono::milliseconds TaskStatsMonitor::DEFAULT_UPDATE_INTERVAL;
+constexpr std::chrono::milliseconds TaskStatsMonitor::BATCH_TIMEOUT;
+constexpr size_t TaskStatsMonitor::MAX_CANDIDATES;
+constexpr size_t TaskStatsMonitor::MAX_EXITED_TASKS;
+constexpr size_t TaskStatsMonitor::RECEIVE_BUFFER_SIZE;
+
+#ifndef _WIN32
+
+namespace {
+
+// Generic netlink request with room for one small attribute
+struct GenlRequest {
+    nlmsghdr header;
+    genlmsghdr genl;
+    char attributes[256];
+};
+
+bool addAttribute(GenlRequest& request, uint16_t type, const void* data, size_t length) {
+    size_t attributeLength = NLA_HDRLEN + length;
+    size_t offset = NLMSG_ALIGN(request.header.nlmsg_len);
+    if (offset + NLA_ALIGN(attributeLength) > sizeof(request)) {
+        return false;
+    }
+
+    nlattr* attribute = reinterpret_cast<nlattr*>(reinterpret_cast<char*>(&request) + offset);
+    attribute->nla_type = type;
+    attribute->nla_len = static_cast<uint16_t>(attributeLength);
+    memcpy(reinterpret_cast<char*>(attribute) + NLA_HDRLEN, data, length);
+    request.header.nlmsg_len = static_cast<uint32_t>(offset + NLA_ALIGN(attributeLength));
+    return true;
+}
+
+// Storage I/O of the whole process from /proc/[pid]/io, which sums every
+// thread, exited ones included; taskstats PID replies cover one thread only
+bool readProcessIo(uint32_t pid, std::string& buffer, uint64_t& readBytes, uint64_t& writeBytes) {
+    if (!ProcParsers::readFile("/proc/" + std::to_string(pid) + "/io", buffer)) {
+        return false;
+    }
+
+    bool hasRead = false;
+    bool hasWrite = false;
+    std::string_view text(buffer);
+    std::string_view line;
+    while (ProcParsers::nextLine(text, line)) {
+        std::string_view key;
+        std::string_view value;
+        if (!ProcParsers::splitKeyValue(line, key, value)) {
+            continue;
+        }
+        if (key == "read_bytes") {
+            hasRead = ProcParsers::parseUnsigned(value, readBytes);
+        } else if (key == "write_bytes") {
+            hasWrite = ProcParsers::parseUnsigned(value, writeBytes);
+        }
+    }
+    return hasRead && hasWrite;
+}
+
+bool sendRequest(int socketFd, uint16_t family, uint8_t command, uint16_t flags, uint32_t sequence,
+                 uint16_t attributeType, const void* data, size_t length) {
+    GenlRequest request;
+    memset(&request, 0, sizeof(request));
+    request.header.nlmsg_len = NLMSG_LENGTH(GENL_HDRLEN);
+    request.header.nlmsg_type = family;
+    request.header.nlmsg_flags = NLM_F_REQUEST | flags;
+    request.header.nlmsg_seq = sequence;
+    request.genl.cmd = command;
+    request.genl.version = 1;
+
+    if (!addAttribute(request, attributeType, data, length)) {
+        return false;
+    }
+
+    sockaddr_nl kernel;
+    memset(&kernel, 0, sizeof(kernel));
+    kernel.nl_family = AF_NETLINK;
+
+    ssize_t sent = sendto(socketFd, &request, request.header.nlmsg_len, 0,
+                          reinterpret_cast<sockaddr*>(&kernel), sizeof(kernel));
+    return sent == static_cast<ssize_t>(request.header.nlmsg_len);
+}
+
+int openGenericSocket() {
+    int socketFd = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_GENERIC);
+    if (socketFd < 0) {
+        return -1;
+    }
+
+    sockaddr_nl local;
+    memset(&local, 0, sizeof(local));
+    local.nl_family = AF_NETLINK;
+    if (bind(socketFd, reinterpret_cast<sockaddr*>(&local), sizeof(local)) < 0) {
+        close(socketFd);
+        return -1;
+    }
+    return socketFd;
+}
+
+// Wait up to timeout for one datagram
+ssize_t receiveWithTimeout(int socketFd, char* buffer, size_t size, std::chrono::milliseconds timeout) {
+    pollfd pfd;
+    pfd.fd = socketFd;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    if (poll(&pfd, 1, static_cast<int>(std::max<long long>(0, timeout.count()))) <= 0) {
+        return -1;
+    }
+    return recv(socketFd, buffer, size, MSG_DONTWAIT);
+}
+
+const nlattr* firstAttribute(const nlmsghdr* header, int& remaining) {
+    remaining = static_cast<int>(header->nlmsg_len) - static_cast<int>(NLMSG_LENGTH(GENL_HDRLEN));
+    return reinterpret_cast<const nlattr*>(reinterpret_cast<const char*>(NLMSG_DATA(header)) + GENL_HDRLEN);
+}
+
+bool attributeOk(const nlattr* attribute, int remaining) {
+    return remaining >= static_cast<int>(sizeof(nlattr)) &&
+           attribute->nla_len >= sizeof(nlattr) &&
+           static_cast<int>(attribute->nla_len) <= remaining;
+}
+
+const nlattr* nextAttribute(const nlattr* attribute, int& remaining) {
+    int length = NLA_ALIGN(attribute->nla_len);
+    remaining -= length;
+    return reinterpret_cast<const nlattr*>(reinterpret_cast<const char*>(attribute) + length);
+}
+
+const void* attributeData(const nlattr* attribute) {
+    return reinterpret_cast<const char*>(attribute) + NLA_HDRLEN;
+}
+
+} // anonymous namespace
+
+#endif
+
+TaskStatsMonitor::TaskStatsMonitor()
+    : running_(false)
+    , initialized_(false)
+    , fallbackMode_(false)
+    , querySocket_(-1)
+    , exitSocket_(-1)
+    , familyId_(0)
+    , sequence_(1)
+    , updateInterval_(DEFAULT_UPDATE_INTERVAL) {
+}
+
+TaskStatsMonitor::~TaskStatsMonitor() {
+    shutdown();
+}
+
+bool TaskStatsMonitor::initialize() {
+    if (initialized_) {
+        return true;
+    }
+
+#ifdef _WIN32
+    return false;
+#else
+    querySocket_ = openGenericSocket();
+    if (querySocket_ < 0) {
+        return false;
+    }
+
+    if (!resolveFamilyId()) {
+        close(querySocket_);
+        querySocket_ = -1;
+        return false;
+    }
+
+    // Exit notifications need CAP_NET_ADMIN; live queries still work without them
+    if (!registerExitListener() && exitSocket_ >= 0) {
+        close(exitSocket_);
+        exitSocket_ = -1;
+    }
+
+    initialized_ = true;
+    return true;
+#endif
+}
+
+void TaskStatsMonitor::shutdown() {
+    if (!initialized_) {
+        return;
+    }
+
+    running_ = false;
+
+    if (monitoringThread_.joinable()) {
+        monitoringThread_.join();
+    }
+
+#ifndef _WIN32
+    if (exitSocket_ >= 0) {
+        close(exitSocket_);
+        exitSocket_ = -1;
+    }
+    if (querySocket_ >= 0) {
+        close(querySocket_);
+        querySocket_ = -1;
+    }
+#endif
+
+    initialized_ = false;
+}
+
+bool TaskStatsMonitor::start() {
+    if (!initialized_) {
+        return false;
+    }
+
+    if (running_ || fallbackMode_) {
+        return true;
+    }
+
+    Watchdog::getInstance().registerJob("taskstats", updateInterval_);
+
+    running_ = true;
+    monitoringThread_ = std::thread(&TaskStatsMonitor::monitoringThread, this);
+
+    return true;
+}
+
+void TaskStatsMonitor::stop() {
+    running_ = false;
+
+    if (monitoringThread_.joinable()) {
+        monitoringThread_.join();
+    }
+
+    Watchdog::getInstance().unregisterJob("taskstats");
+}
+
+void TaskStatsMonitor::monitoringThread() {
+    auto nextUpdate = std::chrono::steady_clock::now();
+
+    while (running_) {
+        try {
+            auto now = std::chrono::steady_clock::now();
+            if (now >= nextUpdate) {
+                Watchdog::RunGuard guard("taskstats");
+                updateCandidates();
+                nextUpdate = now + updateInterval_;
+            }
+
+            // Sleep until the next batch, handling exit notifications meanwhile
+            auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                nextUpdate - std::chrono::steady_clock::now());
+            remaining = std::max(std::chrono::milliseconds(1), std::min(remaining, std::chrono::milliseconds(500)));
+#ifdef _WIN32
+            std::this_thread::sleep_for(remaining);
+#else
+            if (exitSocket_ < 0) {
+                std::this_thread::sleep_for(remaining);
+                continue;
+            }
+
+            pollfd pfd;
+            pfd.fd = exitSocket_;
+            pfd.events = POLLIN;
+            pfd.revents = 0;
+            if (poll(&pfd, 1, static_cast<int>(remaining.count())) > 0) {
+                drainExitNotifications();
+            }
+#endif
+
+        } catch (const std::exception& e) {
+            // Log error but continue
+            std::this_thread::sleep_for(std::chrono::seconds(1));
+        }
+    }
+}
+
+void TaskStatsMonitor::updateCandidates() {
+    std::vector<uint32_t> provided;
+    if (candidateProvider_) {
+        provided = candidateProvider_();
+    }
+    size_t budget = std::min(provided.size(), MAX_CANDIDATES);
+
+    // Up to half the budget goes to the biggest waiters of the last round:
+    // a process stalled on I/O between scans need not be in D state when
+    // the process list is taken
+    std::vector<uint32_t> candidates;
+    candidates.reserve(budget);
+    {
+        std::shared_lock<std::shared_mutex> lock(dataMutex_);
+        for (const auto& info : taskDelays_) {
+            if (candidates.size() >= budget / 2 ||
+                info.cpuDelayPercent + info.blkioDelayPercent + info.swapinDelayPercent <= 0.0) {
+                break;
+            }
+            candidates.push_back(info.pid);
+        }
+    }
+    for (uint32_t pid : provided) {
+        if (candidates.size() >= budget) {
+            break;
+        }
+        if (std::find(candidates.begin(), candidates.end(), pid) == candidates.end()) {
+            candidates.push_back(pid);
+        }
+    }
+
+    std::vector<TaskSample> samples = queryBatch(candidates);
+
+    std::vector<TaskDelayInfo> delays;
+    std::map<uint32_t, TaskSample> currentSamples;
+    delays.reserve(samples.size());
+    for (const auto& sample : samples) {
+        auto previous = previousSamples_.find(sample.pid);
+        delays.push_back(toDelayInfo(sample, previous != previousSamples_.end() ? &previous->second : nullptr));
+        currentSamples[sample.pid] = sample;
+    }
+    previousSamples_.swap(currentSamples);
+
+    // Biggest waiters first
+    std::sort(delays.begin(), delays.end(), [](const TaskDelayInfo& a, const TaskDelayInfo& b) {
+        return a.cpuDelayPercent + a.blkioDelayPercent + a.swapinDelayPercent >
+               b.cpuDelayPercent + b.blkioDelayPercent + b.swapinDelayPercent;
+    });
+
+    std::unique_lock<std::shared_mutex> lock(dataMutex_);
+    taskDelays_ = std::move(delays);
+}
+
+std::vector<TaskDelayInfo> TaskStatsMonitor::queryTasks(const std::vector<uint32_t>& pids) {
+    std::vector<TaskDelayInfo> delays;
+    for (const auto& sample : queryBatch(pids)) {
+        delays.push_back(toDelayInfo(sample, nullptr));
+    }
+    return delays;
+}
+
+TaskDelayInfo TaskStatsMonitor::toDelayInfo(const TaskSample& sample, const TaskSample* previous) const {
+    TaskDelayInfo info;
+    info.pid = sample.pid;
+    info.name = sample.name;
+    info.cpuDelayMs = sample.cpuDelayNs / 1000000;
+    info.blkioDelayMs = sample.blkioDelayNs / 1000000;
+    info.swapinDelayMs = sample.swapinDelayNs / 1000000;
+    info.readBytes = sample.readBytes;
+    info.writeBytes = sample.writeBytes;
+
+    // Percentages over the last interval, or over the process lifetime for
+    // the first sample and for exited processes
+    double windowNs;
+    uint64_t cpuDelay = sample.cpuDelayNs;
+    uint64_t blkioDelay = sample.blkioDelayNs;
+    uint64_t swapinDelay = sample.swapinDelayNs;
+    uint64_t readBytes = sample.readBytes;
+    uint64_t writeBytes = sample.writeBytes;
+
+    if (previous && sample.timestamp > previous->timestamp && sample.cpuDelayNs >= previous->cpuDelayNs) {
+        windowNs = std::chrono::duration<double, std::nano>(sample.timestamp - previous->timestamp).count();
+        cpuDelay -= previous->cpuDelayNs;
+        blkioDelay -= std::min(blkioDelay, previous->blkioDelayNs);
+        swapinDelay -= std::min(swapinDelay, previous->swapinDelayNs);
+        readBytes -= std::min(readBytes, previous->readBytes);
+        writeBytes -= std::min(writeBytes, previous->writeBytes);
+    } else {
+        windowNs = static_cast<double>(sample.lifetimeUs) * 1000.0;
+    }
+
+    if (windowNs > 0.0) {
+        info.cpuDelayPercent = 100.0 * static_cast<double>(cpuDelay) / windowNs;
+        info.blkioDelayPercent = 100.0 * static_cast<double>(blkioDelay) / windowNs;
+        info.swapinDelayPercent = 100.0 * static_cast<double>(swapinDelay) / windowNs;
+        info.readRate = static_cast<double>(readBytes) * 1e9 / windowNs;
+        info.writeRate = static_cast<double>(writeBytes) * 1e9 / windowNs;
+    }
+
+    info.sanitize();
+    return info;
+}
+
+#ifndef _WIN32
+
+bool TaskStatsMonitor::resolveFamilyId() {
+    uint32_t sequence = sequence_++;
+    if (!sendRequest(querySocket_, GENL_ID_CTRL, CTRL_CMD_GETFAMILY, 0, sequence,
+                     CTRL_ATTR_FAMILY_NAME, TASKSTATS_GENL_NAME, strlen(TASKSTATS_GENL_NAME) + 1)) {
+        return false;
+    }
+
+    std::vector<char> buffer(RECEIVE_BUFFER_SIZE);
+    ssize_t length = receiveWithTimeout(querySocket_, buffer.data(), buffer.size(), BATCH_TIMEOUT);
+    if (length <= 0) {
+        return false;
+    }
+
+    int messageLength = static_cast<int>(length);
+    for (const nlmsghdr* header = reinterpret_cast<const nlmsghdr*>(buffer.data());
+         NLMSG_OK(header, messageLength); header = NLMSG_NEXT(header, messageLength)) {
+        if (header->nlmsg_type == NLMSG_ERROR || header->nlmsg_seq != sequence) {
+            continue;
+        }
+
+        int remaining;
+        for (const nlattr* attribute = firstAttribute(header, remaining); attributeOk(attribute, remaining);
+             attribute = nextAttribute(attribute, remaining)) {
+            if (attribute->nla_type == CTRL_ATTR_FAMILY_ID) {
+                familyId_ = *static_cast<const uint16_t*>(attributeData(attribute));
+                return familyId_ != 0;
+            }
+        }
+    }
+
+    return false;
+}
+
+bool TaskStatsMonitor::registerExitListener() {
+    exitSocket_ = openGenericSocket();
+    if (exitSocket_ < 0) {
+        return false;
+    }
+
+    // Room for exit storms; overflow only loses notifications (ENOBUFS)
+    int bufferSize = 1024 * 1024;
+    setsockopt(exitSocket_, SOL_SOCKET, SO_RCVBUF, &bufferSize, sizeof(bufferSize));
+
+    long cpuCount = sysconf(_SC_NPROCESSORS_CONF);
+    std::string cpuMask = "0-" + std::to_string(std::max(1L, cpuCount) - 1);
+    uint32_t sequence = sequence_++;
+    if (!sendRequest(exitSocket_, familyId_, TASKSTATS_CMD_GET, NLM_F_ACK, sequence,
+                     TASKSTATS_CMD_ATTR_REGISTER_CPUMASK, cpuMask.c_str(), cpuMask.size() + 1)) {
+        return false;
+    }
+
+    // The acknowledgement carries the registration result
+    std::vector<char> buffer(4096);
+    ssize_t length = receiveWithTimeout(exitSocket_, buffer.data(), buffer.size(), BATCH_TIMEOUT);
+    if (length <= 0) {
+        return false;
+    }
+
+    const nlmsghdr* header = reinterpret_cast<const nlmsghdr*>(buffer.data());
+    if (!NLMSG_OK(header, static_cast<int>(length)) || header->nlmsg_type != NLMSG_ERROR) {
+        return false;
+    }
+    const nlmsgerr* error = static_cast<const nlmsgerr*>(NLMSG_DATA(header));
+    return error->error == 0;
+}
+
+std::vector<TaskStatsMonitor::TaskSample> TaskStatsMonitor::queryBatch(const std::vector<uint32_t>& pids) {
+    std::vector<TaskSample> samples;
+    if (pids.empty() || querySocket_ < 0) {
+        return samples;
+    }
+
+    std::lock_guard<std::mutex> lock(queryMutex_);
+
+    // Send the whole batch first, then collect the replies. TGID replies only
+    // carry the delay totals, so each candidate is paired with a PID query for
+    // its leader thread (name, lifetime and I/O); even offsets are TGID queries.
+    uint32_t firstSequence = sequence_;
+    size_t outstanding = 0;
+    for (uint32_t pid : pids) {
+        if (sendRequest(querySocket_, familyId_, TASKSTATS_CMD_GET, 0, sequence_++,
+                        TASKSTATS_CMD_ATTR_TGID, &pid, sizeof(pid))) {
+            ++outstanding;
+        }
+        if (sendRequest(querySocket_, familyId_, TASKSTATS_CMD_GET, 0, sequence_++,
+                        TASKSTATS_CMD_ATTR_PID, &pid, sizeof(pid))) {
+            ++outstanding;
+        }
+    }
+    uint32_t endSequence = sequence_;
+    std::map<uint32_t, TaskSample> merged;
+
+    std::vector<char> buffer(RECEIVE_BUFFER_SIZE);
+    const auto deadline = std::chrono::steady_clock::now() + BATCH_TIMEOUT;
+    while (outstanding > 0) {
+        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now());
+        if (remaining.count() <= 0) {
+            break;
+        }
+
+        ssize_t length = receiveWithTimeout(querySocket_, buffer.data(), buffer.size(), remaining);
+        if (length <= 0) {
+            break;
+        }
+
+        int messageLength = static_cast<int>(length);
+        for (const nlmsghdr* header = reinterpret_cast<const nlmsghdr*>(buffer.data());
+             NLMSG_OK(header, messageLength); header = NLMSG_NEXT(header, messageLength)) {
+            if (header->nlmsg_seq < firstSequence || header->nlmsg_seq >= endSequence) {
+                continue; // Stale reply from an earlier, timed-out batch
+            }
+            --outstanding;
+
+            // Processes that exited meanwhile answer with ESRCH
+            if (header->nlmsg_type == NLMSG_ERROR) {
+                continue;
+            }
+
+            TaskSample sample;
+            ExitKind exitKind = ExitKind::THREAD;
+            if (!parseTaskStatsMessage(header, header->nlmsg_len, sample, exitKind)) {
+                continue;
+            }
+
+            auto inserted = merged.emplace(sample.pid, sample);
+            TaskSample& entry = inserted.first->second;
+            if (inserted.second) {
+                continue;
+            }
+            if ((header->nlmsg_seq - firstSequence) % 2 == 0) {
+                entry.cpuDelayNs = sample.cpuDelayNs;
+                entry.blkioDelayNs = sample.blkioDelayNs;
+                entry.swapinDelayNs = sample.swapinDelayNs;
+            } else {
+                entry.name = sample.name;
+                entry.readBytes = sample.readBytes;
+                entry.writeBytes = sample.writeBytes;
+                entry.lifetimeUs = sample.lifetimeUs;
+            }
+        }
+    }
+
+    samples.reserve(merged.size());
+    std::string ioBuffer;
+    for (auto& entry : merged) {
+        // Leader-thread bytes only when /proc/[pid]/io is not readable
+        uint64_t readBytes = 0;
+        uint64_t writeBytes = 0;
+        if (readProcessIo(entry.first, ioBuffer, readBytes, writeBytes)) {
+            entry.second.readBytes = readBytes;
+            entry.second.writeBytes = writeBytes;
+        }
+        samples.push_back(std::move(entry.second));
+    }
+    return samples;
+}
+
+void TaskStatsMonitor::drainExitNotifications() {
+    std::vector<char> buffer(RECEIVE_BUFFER_SIZE);
+    std::vector<TaskDelayInfo> exited;
+
+    while (true) {
+        ssize_t length = recv(exitSocket_, buffer.data(), buffer.size(), MSG_DONTWAIT);
+        if (length < 0) {
+            if (errno == ENOBUFS) {
+                continue; // Notifications were dropped; keep reading what is left
+            }
+            break;
+        }
+        if (length == 0) {
+            break;
+        }
+
+        int messageLength = static_cast<int>(length);
+        for (const nlmsghdr* header = reinterpret_cast<const nlmsghdr*>(buffer.data());
+             NLMSG_OK(header, messageLength); header = NLMSG_NEXT(header, messageLength)) {
+            if (header->nlmsg_type != familyId_) {
+                continue;
+            }
+
+            // A PID-only record is trusted only for a process being tracked;
+            // every thread exit of an untracked group would otherwise look
+            // like a process exit and push real ones out of exitedTasks_
+            TaskSample sample;
+            ExitKind exitKind = ExitKind::THREAD;
+            if (!parseTaskStatsMessage(header, header->nlmsg_len, sample, exitKind)) {
+                continue;
+            }
+            if (exitKind == ExitKind::GROUP ||
+                (exitKind == ExitKind::TASK && previousSamples_.count(sample.pid) > 0)) {
+                TaskDelayInfo info = toDelayInfo(sample, nullptr);
+                info.hasExited = true;
+                exited.push_back(info);
+                previousSamples_.erase(sample.pid);
+            }
+        }
+    }
+
+    if (exited.empty()) {
+        return;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(dataMutex_);
+    for (auto& info : exited) {
+        exitedTasks_.push_front(std::move(info));
+    }
+    while (exitedTasks_.size() > MAX_EXITED_TASKS) {
+        exitedTasks_.pop_back();
+    }
+}
+
+bool TaskStatsMonitor::parseTaskStatsMessage(const void* message, size_t length, TaskSample& sample,
+                                             ExitKind& exitKind) const {
+    const nlmsghdr* header = static_cast<const nlmsghdr*>(message);
+    if (length < NLMSG_LENGTH(GENL_HDRLEN)) {
+        return false;
+    }
+
+    // TGID records hold the summed delays only; PID records hold the full
+    // accounting (name, lifetime, I/O) of a single thread. Exit notifications
+    // carry AGGR_PID for the exiting thread plus AGGR_TGID when a
+    // multi-threaded group dies.
+    struct taskstats pidStats;
+    struct taskstats tgidStats;
+    bool hasPidStats = false;
+    bool hasTgidStats = false;
+    uint32_t pid = 0;
+    uint32_t tgid = 0;
+
+    int remaining;
+    for (const nlattr* attribute = firstAttribute(header, remaining); attributeOk(attribute, remaining);
+         attribute = nextAttribute(attribute, remaining)) {
+        bool isTgid = attribute->nla_type == TASKSTATS_TYPE_AGGR_TGID;
+        if (!isTgid && attribute->nla_type != TASKSTATS_TYPE_AGGR_PID) {
+            continue;
+        }
+
+        int nestedRemaining = static_cast<int>(attribute->nla_len) - NLA_HDRLEN;
+        for (const nlattr* nested = static_cast<const nlattr*>(attributeData(attribute));
+             attributeOk(nested, nestedRemaining); nested = nextAttribute(nested, nestedRemaining)) {
+            size_t payloadLength = nested->nla_len - NLA_HDRLEN;
+            if (nested->nla_type == TASKSTATS_TYPE_PID && payloadLength >= sizeof(uint32_t)) {
+                memcpy(&pid, attributeData(nested), sizeof(pid));
+            } else if (nested->nla_type == TASKSTATS_TYPE_TGID && payloadLength >= sizeof(uint32_t)) {
+                memcpy(&tgid, attributeData(nested), sizeof(tgid));
+            } else if (nested->nla_type == TASKSTATS_TYPE_STATS) {
+                // Older kernels send a shorter structure; missing fields stay zero
+                struct taskstats& stats = isTgid ? tgidStats : pidStats;
+                memset(&stats, 0, sizeof(stats));
+                memcpy(&stats, attributeData(nested), std::min(payloadLength, sizeof(stats)));
+                (isTgid ? hasTgidStats : hasPidStats) = true;
+            }
+        }
+    }
+
+    if (!hasPidStats && !hasTgidStats) {
+        return false;
+    }
+
+    // Without AGGR_TGID the record is a single-threaded process or one
+    // thread of a group; v13+ names the group, so other threads are told
+    // apart. A leader leaving before its threads still looks like TASK.
+    exitKind = hasTgidStats ? ExitKind::GROUP : ExitKind::TASK;
+#if TASKSTATS_VERSION >= 13
+    if (!hasTgidStats && pidStats.version >= 13 && pidStats.ac_tgid != pidStats.ac_pid) {
+        exitKind = ExitKind::THREAD;
+    }
+#endif
+
+    const struct taskstats& delays = hasTgidStats ? tgidStats : pidStats;
+    sample.pid = tgid != 0 ? tgid : pid;
+    sample.cpuDelayNs = delays.cpu_delay_total;
+    sample.blkioDelayNs = delays.blkio_delay_total;
+    sample.swapinDelayNs = delays.swapin_delay_total;
+    sample.readBytes = 0;
+    sample.writeBytes = 0;
+    sample.lifetimeUs = 0;
+    if (hasPidStats) {
+        sample.name.assign(pidStats.ac_comm, strnlen(pidStats.ac_comm, sizeof(pidStats.ac_comm)));
+        sample.readBytes = pidStats.read_bytes;
+        sample.writeBytes = pidStats.write_bytes;
+        sample.lifetimeUs = pidStats.ac_etime;
+    }
+    sample.timestamp = std::chrono::steady_clock::now();
+    return sample.pid != 0;
+}
+
+#else
+
+bool TaskStatsMonitor::resolveFamilyId() {
+    return false;
+}
+
+bool TaskStatsMonitor::registerExitListener() {
+    return false;
+}
+
+std::vector<TaskStatsMonitor::TaskSample> TaskStatsMonitor::queryBatch(const std::vector<uint32_t>& pids) {
+    (void)pids;
+    return {};
+}
+
+void TaskStatsMonitor::drainExitNotifications() {
+}
+
+bool TaskStatsMonitor::parseTaskStatsMessage(const void* message, size_t length, TaskSample& sample,
+                                             ExitKind& exitKind) const {
+    (void)message;
+    (void)length;
+    (void)sample;
+    (void)exitKind;
+    return false;
+}
+
+#endif
+
+void TaskStatsMonitor::setCandidateProvider(CandidateProvider provider) {
+    candidateProvider_ = std::move(provider);
+}
+
+void TaskStatsMonitor::setUpdateInterval(std::chrono::milliseconds interval) {
+    updateInterval_ = interval;
+}
+
+std::chrono::milliseconds TaskStatsMonitor::getUpdateInterval() const {
+    return updateInterval_;
+}
+
+std::vector<TaskDelayInfo> TaskStatsMonitor::getTaskDelays() const {
+    std::shared_lock<std::shared_mutex> lock(dataMutex_);
+    return taskDelays_;
+}
+
+std::vector<TaskDelayInfo> TaskStatsMonitor::getExitedTasks() const {
+    std::shared_lock<std::shared_mutex> lock(dataMutex_);
+    return std::vector<TaskDelayInfo>(exitedTasks_.begin(), exitedTasks_.end());
+}
+
+bool TaskStatsMonitor::isRunning() const {
+    return running_;
+}
+
+bool TaskStatsMonitor::hasExitNotifications() const {
+    return exitSocket_ >= 0;
+}
+
+// Fallback mode support
+void TaskStatsMonitor::enableFallbackMode() {
+    fallbackMode_ = true;
+    initialized_ = true;
+
+    std::unique_lock<std::shared_mutex> lock(dataMutex_);
+    taskDelays_.clear();
+    exitedTasks_.clear();
+}
+
+bool TaskStatsMonitor::isFallbackMode() const {
+    return fallbackMode_;
+}
+
+} // namespace SysMon
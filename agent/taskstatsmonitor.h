@@ -0,0 +1,123 @@
+#pragma once
+
+#include "../shared/systemtypes.h"
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <shared_mutex>
+#include <mutex>
+#include <functional>
+#include <deque>
+#include <map>
+
+namespace SysMon {
+
+// Taskstats Monitor - per-process delay accounting and I/O over the
+// NETLINK_GENERIC taskstats family (Linux only, optional)
+//
+// Live processes are queried in one batch per tick for a bounded set of
+// candidates (e.g. blocked and runnable processes), topped up with the
+// biggest waiters of the previous batch; exit notifications capture the
+// final totals of sampled processes and of multi-threaded ones, even those
+// too short-lived to be sampled.
+class TaskStatsMonitor {
+public:
+    using CandidateProvider = std::function<std::vector<uint32_t>()>;
+
+    TaskStatsMonitor();
+    ~TaskStatsMonitor();
+
+    // Lifecycle
+    bool initialize();
+    bool start();
+    void stop();
+    void shutdown();
+
+    // Fallback mode support
+    void enableFallbackMode();
+    bool isFallbackMode() const;
+
+    // Configuration
+    void setCandidateProvider(CandidateProvider provider);
+    void setUpdateInterval(std::chrono::milliseconds interval);
+    std::chrono::milliseconds getUpdateInterval() const;
+
+    // Data access
+    std::vector<TaskDelayInfo> getTaskDelays() const;
+    std::vector<TaskDelayInfo> getExitedTasks() const;
+    std::vector<TaskDelayInfo> queryTasks(const std::vector<uint32_t>& pids);
+
+    // Status
+    bool isRunning() const;
+    bool hasExitNotifications() const;
+
+    // Most pids in one batch, sampled or queried on demand
+    static constexpr size_t MAX_CANDIDATES = 64;
+
+private:
+    // Raw totals from one taskstats record
+    struct TaskSample {
+        uint32_t pid;
+        std::string name;
+        uint64_t cpuDelayNs;
+        uint64_t blkioDelayNs;
+        uint64_t swapinDelayNs;
+        uint64_t readBytes;
+        uint64_t writeBytes;
+        uint64_t lifetimeUs;        // ac_etime, elapsed time since fork
+        std::chrono::steady_clock::time_point timestamp;
+    };
+
+    // What an exit notification says about the process it belongs to
+    enum class ExitKind {
+        THREAD,     // a thread of a group that lives on
+        TASK,       // AGGR_PID alone: a single-threaded process, or a thread
+                    // the record cannot place; an exit only if the pid is tracked
+        GROUP       // AGGR_TGID: the last thread of a group is gone
+    };
+
+    // Monitoring thread
+    void monitoringThread();
+    void updateCandidates();
+    void drainExitNotifications();
+
+    // Netlink helpers
+    bool resolveFamilyId();
+    bool registerExitListener();
+    std::vector<TaskSample> queryBatch(const std::vector<uint32_t>& pids);
+    bool parseTaskStatsMessage(const void* message, size_t length, TaskSample& sample, ExitKind& exitKind) const;
+    TaskDelayInfo toDelayInfo(const TaskSample& sample, const TaskSample* previous) const;
+
+    // Thread management
+    std::thread monitoringThread_;
+    std::atomic<bool> running_;
+    std::atomic<bool> initialized_;
+    std::atomic<bool> fallbackMode_;
+
+    // Data storage
+    std::vector<TaskDelayInfo> taskDelays_;
+    std::deque<TaskDelayInfo> exitedTasks_;
+    mutable std::shared_mutex dataMutex_;
+
+    // Netlink state
+    int querySocket_;
+    int exitSocket_;
+    uint16_t familyId_;
+    uint32_t sequence_;
+    std::mutex queryMutex_;
+
+    // Monitoring thread state
+    CandidateProvider candidateProvider_;
+    std::map<uint32_t, TaskSample> previousSamples_;
+
+    // Timing
+    std::chrono::milliseconds updateInterval_;
+
+    // Constants
+    static constexpr std::chrono::milliseconds DEFAULT_UPDATE_INTERVAL{2000};
+    static constexpr std::chrono::milliseconds BATCH_TIMEOUT{200};
+    static constexpr size_t MAX_EXITED_TASKS = 256;
+    static constexpr size_t RECEIVE_BUFFER_SIZE = 64 * 1024;
+};
+
+} // namespace SysMon
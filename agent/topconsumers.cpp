@@ -0,0 +1,311 @@
+#include "topconsumers.h"
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
+#include <unordered_set>
+
+namespace SysMon {
+
+constexpr size_t TopConsumerTracker::CAPACITY;
+constexpr size_t TopConsumerTracker::MINUTE_BUCKETS;
+constexpr size_t TopConsumerTracker::HOUR_BUCKETS;
+constexpr uint64_t TopConsumerTracker::MAX_WINDOW_SECONDS;
+constexpr uint64_t TopConsumerTracker::MINUTE_MS;
+constexpr uint64_t TopConsumerTracker::HOUR_MS;
+constexpr uint64_t TopConsumerTracker::PRUNE_INTERVAL;
+
+namespace {
+
+// Dictionary codes of one identity in a ProcessTable
+struct IdentityKey {
+    uint32_t name;
+    uint32_t executable;
+    uint32_t cgroup;
+
+    bool operator==(const IdentityKey& other) const {
+        return name == other.name && executable == other.executable && cgroup == other.cgroup;
+    }
+};
+
+struct IdentityKeyHash {
+    size_t operator()(const IdentityKey& key) const {
+        uint64_t hash = key.name * 0x9e3779b97f4a7c15ULL;
+        hash ^= key.executable + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+        hash ^= key.cgroup + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+        return static_cast<size_t>(hash);
+    }
+};
+
+struct IdentityTotals {
+    double cpuSeconds = 0.0;
+    double memoryByteSeconds = 0.0;
+};
+
+} // anonymous namespace
+
+void TopConsumerTracker::Summary::add(uint32_t identity, double value) {
+    for (auto& counter : counters) {
+        if (counter.identity == identity) {
+            counter.value += value;
+            return;
+        }
+    }
+
+    if (counters.size() < CAPACITY) {
+        counters.push_back({identity, value, 0.0});
+        return;
+    }
+
+    // Full: the newcomer takes over the smallest counter
+    auto smallest = std::min_element(counters.begin(), counters.end(),
+                                     [](const Counter& a, const Counter& b) { return a.value < b.value; });
+    smallest->identity = identity;
+    smallest->error = smallest->value;
+    smallest->value += value;
+}
+
+double TopConsumerTracker::Summary::minimum() const {
+    if (counters.size() < CAPACITY) {
+        return 0.0;
+    }
+    double smallest = counters.front().value;
+    for (const auto& counter : counters) {
+        smallest = std::min(smallest, counter.value);
+    }
+    return smallest;
+}
+
+void TopConsumerTracker::Summary::clear() {
+    counters.clear();
+}
+
+TopConsumerTracker::Bucket& TopConsumerTracker::Tier::current(uint64_t nowMs) {
+    uint64_t startMs = nowMs / widthMs * widthMs;
+    Bucket& bucket = buckets[(startMs / widthMs) % buckets.size()];
+
+    // A slot last used one ring length ago; a clock stepped back keeps
+    // adding to the newer bucket already there
+    if (startMs > bucket.startMs) {
+        bucket.startMs = startMs;
+        bucket.cpu.clear();
+        bucket.memory.clear();
+    }
+    return bucket;
+}
+
+TopConsumerTracker::TopConsumerTracker()
+    : firstRecordMs_(0)
+    , nextIdentity_(1)
+    , records_(0) {
+    // One extra bucket each, so a full window still fits next to the
+    // partly filled current bucket
+    minutes_.widthMs = MINUTE_MS;
+    minutes_.buckets.resize(MINUTE_BUCKETS + 1, Bucket{0, {}, {}});
+    hours_.widthMs = HOUR_MS;
+    hours_.buckets.resize(HOUR_BUCKETS + 1, Bucket{0, {}, {}});
+}
+
+void TopConsumerTracker::record(const ProcessTable& table, double intervalSeconds, uint64_t nowMs) {
+    if (intervalSeconds <= 0.0 || table.size() == 0) {
+        return;
+    }
+
+    // Sum per identity first; worker pools are many rows but one update
+    std::unordered_map<IdentityKey, IdentityTotals, IdentityKeyHash> groups;
+    for (size_t row = 0; row < table.size(); ++row) {
+        double cpuSeconds = table.cpuUsage[row] / 100.0 * intervalSeconds;
+        double memoryByteSeconds = static_cast<double>(table.rssBytes[row]) * intervalSeconds;
+        if (cpuSeconds <= 0.0 && memoryByteSeconds <= 0.0) {
+            continue;
+        }
+
+        IdentityKey key{table.names.codes[row], table.executables.codes[row], table.cgroups.codes[row]};
+        IdentityTotals& totals = groups[key];
+        totals.cpuSeconds += cpuSeconds;
+        totals.memoryByteSeconds += memoryByteSeconds;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (firstRecordMs_ == 0) {
+        firstRecordMs_ = nowMs;
+    }
+
+    Bucket& minute = minutes_.current(nowMs);
+    Bucket& hour = hours_.current(nowMs);
+    for (const auto& group : groups) {
+        uint32_t identity = internIdentity(table.names.value(group.first.name),
+                                           table.executables.value(group.first.executable),
+                                           table.cgroups.value(group.first.cgroup));
+        if (group.second.cpuSeconds > 0.0) {
+            minute.cpu.add(identity, group.second.cpuSeconds);
+            hour.cpu.add(identity, group.second.cpuSeconds);
+        }
+        if (group.second.memoryByteSeconds > 0.0) {
+            minute.memory.add(identity, group.second.memoryByteSeconds);
+            hour.memory.add(identity, group.second.memoryByteSeconds);
+        }
+    }
+
+    if (++records_ % PRUNE_INTERVAL == 0) {
+        pruneIdentities();
+    }
+}
+
+std::vector<TopConsumerInfo> TopConsumerTracker::query(Metric metric, uint64_t windowSeconds, size_t limit,
+                                                       uint64_t nowMs, uint64_t& coveredSeconds) const {
+    coveredSeconds = 0;
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // Minute buckets up to an hour, hour buckets beyond; the window is
+    // rounded out to whole buckets
+    const Tier& tier = windowSeconds <= MINUTE_BUCKETS * MINUTE_MS / 1000 ? minutes_ : hours_;
+    uint64_t windowMs = std::min(windowSeconds, MAX_WINDOW_SECONDS) * 1000;
+    uint64_t windowStartMs = nowMs > windowMs ? nowMs - windowMs : 0;
+    uint64_t currentStartMs = nowMs / tier.widthMs * tier.widthMs;
+
+    // An identity missing from a full bucket may still have had up to that
+    // bucket's minimum there
+    struct Merged {
+        double value = 0.0;
+        double error = 0.0;
+        double presentMinimum = 0.0;
+    };
+    std::unordered_map<uint32_t, Merged> merged;
+    double totalMinimum = 0.0;
+    uint64_t oldestStartMs = std::numeric_limits<uint64_t>::max();
+
+    for (const auto& bucket : tier.buckets) {
+        if (bucket.startMs == 0 || bucket.startMs + tier.widthMs <= windowStartMs || bucket.startMs > currentStartMs) {
+            continue;
+        }
+        const Summary& summary = metric == Metric::CPU ? bucket.cpu : bucket.memory;
+        double minimum = summary.minimum();
+        totalMinimum += minimum;
+        oldestStartMs = std::min(oldestStartMs, bucket.startMs);
+
+        for (const auto& counter : summary.counters) {
+            Merged& entry = merged[counter.identity];
+            entry.value += counter.value;
+            entry.error += counter.error;
+            entry.presentMinimum += minimum;
+        }
+    }
+
+    if (oldestStartMs == std::numeric_limits<uint64_t>::max()) {
+        return {};
+    }
+    uint64_t coveredFromMs = std::max(oldestStartMs, firstRecordMs_);
+    coveredSeconds = nowMs > coveredFromMs ? (nowMs - coveredFromMs) / 1000 : 0;
+
+    std::vector<TopConsumerInfo> consumers;
+    consumers.reserve(merged.size());
+    for (const auto& entry : merged) {
+        auto identity = identities_.find(entry.first);
+        if (identity == identities_.end()) {
+            continue;
+        }
+
+        double absent = totalMinimum - entry.second.presentMinimum;
+        TopConsumerInfo info;
+        info.name = identity->second.name;
+        info.executable = identity->second.executable;
+        info.cgroup = identity->second.cgroup;
+        info.value = entry.second.value + absent;
+        info.error = entry.second.error + absent;
+        if (coveredSeconds > 0) {
+            // CPU: percent of one CPU; memory: bytes resident
+            info.average = info.value / static_cast<double>(coveredSeconds) * (metric == Metric::CPU ? 100.0 : 1.0);
+        }
+        info.sanitize();
+        consumers.push_back(std::move(info));
+    }
+
+    size_t shown = std::min(limit, consumers.size());
+    std::partial_sort(consumers.begin(), consumers.begin() + static_cast<std::ptrdiff_t>(shown), consumers.end(),
+                      [](const TopConsumerInfo& a, const TopConsumerInfo& b) { return a.value > b.value; });
+    consumers.resize(shown);
+    return consumers;
+}
+
+bool TopConsumerTracker::parseMetric(const std::string& str, Metric& metric) {
+    if (str == "cpu") {
+        metric = Metric::CPU;
+        return true;
+    }
+    if (str == "memory") {
+        metric = Metric::MEMORY;
+        return true;
+    }
+    return false;
+}
+
+bool TopConsumerTracker::parseWindow(const std::string& str, uint64_t& seconds) {
+    if (str.empty() || str[0] < '0' || str[0] > '9') {
+        return false;
+    }
+
+    char* end = nullptr;
+    unsigned long long value = std::strtoull(str.c_str(), &end, 10);
+    std::string unit(end);
+    uint64_t multiplier = 0;
+    if (unit.empty() || unit == "s") {
+        multiplier = 1;
+    } else if (unit == "m") {
+        multiplier = 60;
+    } else if (unit == "h") {
+        multiplier = 3600;
+    } else if (unit == "d") {
+        multiplier = 86400;
+    } else {
+        return false;
+    }
+
+    if (value == 0 || value > MAX_WINDOW_SECONDS / multiplier) {
+        return false;
+    }
+    seconds = value * multiplier;
+    return true;
+}
+
+uint32_t TopConsumerTracker::internIdentity(const std::string& name, const std::string& executable,
+                                            const std::string& cgroup) {
+    std::string key;
+    key.reserve(name.size() + executable.size() + cgroup.size() + 2);
+    key.append(name).append(1, '\0').append(executable).append(1, '\0').append(cgroup);
+
+    auto existing = identityIds_.find(key);
+    if (existing != identityIds_.end()) {
+        return existing->second;
+    }
+
+    uint32_t id = nextIdentity_++;
+    identityIds_.emplace(std::move(key), id);
+    identities_.emplace(id, Identity{name, executable, cgroup});
+    return id;
+}
+
+void TopConsumerTracker::pruneIdentities() {
+    std::unordered_set<uint32_t> referenced;
+    referenced.reserve(identities_.size());
+    for (const Tier* tier : {&minutes_, &hours_}) {
+        for (const auto& bucket : tier->buckets) {
+            for (const auto& counter : bucket.cpu.counters) {
+                referenced.insert(counter.identity);
+            }
+            for (const auto& counter : bucket.memory.counters) {
+                referenced.insert(counter.identity);
+            }
+        }
+    }
+
+    for (auto it = identityIds_.begin(); it != identityIds_.end();) {
+        if (referenced.count(it->second) == 0) {
+            identities_.erase(it->second);
+            it = identityIds_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+} // namespace SysMon
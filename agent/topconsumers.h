@@ -0,0 +1,112 @@
+#pragma once
+
+#include "../shared/systemtypes.h"
+#include "processtable.h"
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace SysMon {
+
+// Top Consumer Tracker - heaviest CPU and memory users over long windows,
+// in fixed memory
+//
+// Processes are grouped by identity (name, executable, cgroup), so restarts
+// and worker pools add up. Every process scan adds the CPU seconds and
+// memory byte-seconds of each identity to the current time bucket: one per
+// minute for the last hour and one per hour for the last week. A bucket is
+// a weighted Space-Saving summary of at most CAPACITY identities: an
+// identity arriving at a full summary takes over the smallest counter and
+// inherits its value as error. Reported values are therefore upper bounds,
+// at most `error` above the truth, and any identity with more than
+// 1/CAPACITY of a bucket is always present. Queries merge the buckets of
+// the window the same way.
+//
+// record() belongs to the scanning thread; query() may be called from any
+// thread.
+class TopConsumerTracker {
+public:
+    enum class Metric {
+        CPU,
+        MEMORY
+    };
+
+    TopConsumerTracker();
+
+    // One call per process scan; intervalSeconds since the previous scan
+    void record(const ProcessTable& table, double intervalSeconds, uint64_t nowMs);
+
+    // Heaviest identities of the last windowSeconds, largest first;
+    // coveredSeconds is the part of the window with data
+    std::vector<TopConsumerInfo> query(Metric metric, uint64_t windowSeconds, size_t limit, uint64_t nowMs,
+                                       uint64_t& coveredSeconds) const;
+
+    static bool parseMetric(const std::string& str, Metric& metric);
+    // "3600", "90m", "24h" or "7d"
+    static bool parseWindow(const std::string& str, uint64_t& seconds);
+
+    // Constants
+    static constexpr size_t CAPACITY = 128;
+    static constexpr size_t MINUTE_BUCKETS = 60;
+    static constexpr size_t HOUR_BUCKETS = 168;
+    static constexpr uint64_t MAX_WINDOW_SECONDS = HOUR_BUCKETS * 3600;
+
+private:
+    struct Counter {
+        uint32_t identity;
+        double value;
+        double error;
+    };
+
+    // Weighted Space-Saving summary; a linear scan over CAPACITY counters
+    // beats any index at this size
+    struct Summary {
+        std::vector<Counter> counters;
+
+        void add(uint32_t identity, double value);
+        double minimum() const;     // 0 while not full
+        void clear();
+    };
+
+    struct Bucket {
+        uint64_t startMs;
+        Summary cpu;
+        Summary memory;
+    };
+
+    struct Tier {
+        uint64_t widthMs;
+        std::vector<Bucket> buckets;    // ring indexed by start / width
+
+        Bucket& current(uint64_t nowMs);
+    };
+
+    struct Identity {
+        std::string name;
+        std::string executable;
+        std::string cgroup;
+    };
+
+    uint32_t internIdentity(const std::string& name, const std::string& executable, const std::string& cgroup);
+    void pruneIdentities();
+
+    Tier minutes_;
+    Tier hours_;
+    uint64_t firstRecordMs_;
+
+    // Identities referenced by the summaries; unreferenced ones are pruned
+    // every PRUNE_INTERVAL records
+    std::unordered_map<std::string, uint32_t> identityIds_;
+    std::unordered_map<uint32_t, Identity> identities_;
+    uint32_t nextIdentity_;
+    uint64_t records_;
+
+    mutable std::mutex mutex_;
+
+    static constexpr uint64_t MINUTE_MS = 60 * 1000;
+    static constexpr uint64_t HOUR_MS = 60 * MINUTE_MS;
+    static constexpr uint64_t PRUNE_INTERVAL = 30;
+};
+
+} // namespace SysMon
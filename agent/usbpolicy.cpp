@@ -0,0 +1,169 @@
+#include "usbpolicy.h"
+#include <algorithm>
+#include <mutex>
+
+namespace SysMon {
+
+UsbPolicyEngine::UsbPolicyEngine()
+    : defaultAllow_(true) {
+}
+
+bool UsbPolicyEngine::addRule(const UsbPolicyRule& rule) {
+    UsbPolicyRule sanitized = rule;
+    sanitized.sanitize();
+    if (!sanitized.isValid()) {
+        return false;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(rulesMutex_);
+
+    // Replacing a rule may move it to another index
+    auto existing = rules_.find(sanitized.id);
+    if (existing != rules_.end()) {
+        unindexRule(existing->second);
+    }
+
+    std::string key;
+    indexFor(sanitized, key)[key].push_back(sanitized.id);
+    rules_[sanitized.id] = sanitized;
+    return true;
+}
+
+bool UsbPolicyEngine::removeRule(const std::string& ruleId) {
+    std::unique_lock<std::shared_mutex> lock(rulesMutex_);
+
+    auto it = rules_.find(ruleId);
+    if (it == rules_.end()) {
+        return false;
+    }
+
+    unindexRule(it->second);
+    rules_.erase(it);
+    return true;
+}
+
+std::vector<UsbPolicyRule> UsbPolicyEngine::getRules() const {
+    std::shared_lock<std::shared_mutex> lock(rulesMutex_);
+
+    std::vector<UsbPolicyRule> rules;
+    rules.reserve(rules_.size());
+    for (const auto& entry : rules_) {
+        rules.push_back(entry.second);
+    }
+    return rules;
+}
+
+void UsbPolicyEngine::setDefaultAllow(bool allow) {
+    std::unique_lock<std::shared_mutex> lock(rulesMutex_);
+    defaultAllow_ = allow;
+}
+
+bool UsbPolicyEngine::isDefaultAllow() const {
+    std::shared_lock<std::shared_mutex> lock(rulesMutex_);
+    return defaultAllow_;
+}
+
+UsbPolicyDecision UsbPolicyEngine::evaluate(const UsbPolicyDevice& device) const {
+    std::shared_lock<std::shared_mutex> lock(rulesMutex_);
+
+    UsbPolicyDecision decision;
+    decision.allow = defaultAllow_;
+
+    if (!device.serialNumber.empty() && evaluateLevel(bySerial_, device.serialNumber, device, decision)) {
+        return decision;
+    }
+    if (evaluateLevel(byVidPid_, device.vid + ":" + device.pid, device, decision)) {
+        return decision;
+    }
+    if (evaluateLevel(byVendor_, device.vid, device, decision)) {
+        return decision;
+    }
+
+    // A class rule hits if any device or interface class matches
+    bool matched = false;
+    UsbPolicyDecision classDecision;
+    for (const auto& deviceClass : device.classes) {
+        UsbPolicyDecision candidate;
+        if (evaluateLevel(byClass_, deviceClass, device, candidate) && (!matched || !candidate.allow)) {
+            classDecision = candidate;
+            matched = true;
+        }
+    }
+    if (matched) {
+        return classDecision;
+    }
+
+    return decision;
+}
+
+bool UsbPolicyEngine::evaluateLevel(const Index& index, const std::string& key, const UsbPolicyDevice& device,
+                                    UsbPolicyDecision& decision) const {
+    auto it = index.find(key);
+    if (it == index.end()) {
+        return false;
+    }
+
+    bool matched = false;
+    for (const auto& ruleId : it->second) {
+        const UsbPolicyRule& rule = rules_.at(ruleId);
+        if (!matches(rule, device)) {
+            continue;
+        }
+        if (!matched || !rule.allow) {
+            decision.allow = rule.allow;
+            decision.ruleId = rule.id;
+        }
+        matched = true;
+        if (!rule.allow) {
+            break;
+        }
+    }
+    return matched;
+}
+
+UsbPolicyEngine::Index& UsbPolicyEngine::indexFor(const UsbPolicyRule& rule, std::string& key) {
+    // Each rule lives under its most specific selector; the others are
+    // checked by matches()
+    if (!rule.serialNumber.empty()) {
+        key = rule.serialNumber;
+        return bySerial_;
+    }
+    if (!rule.pid.empty()) {
+        key = rule.vid + ":" + rule.pid;
+        return byVidPid_;
+    }
+    if (!rule.vid.empty()) {
+        key = rule.vid;
+        return byVendor_;
+    }
+    key = rule.deviceClass;
+    return byClass_;
+}
+
+void UsbPolicyEngine::unindexRule(const UsbPolicyRule& rule) {
+    std::string key;
+    Index& index = indexFor(rule, key);
+    auto it = index.find(key);
+    if (it == index.end()) {
+        return;
+    }
+
+    auto& ids = it->second;
+    ids.erase(std::remove(ids.begin(), ids.end(), rule.id), ids.end());
+    if (ids.empty()) {
+        index.erase(it);
+    }
+}
+
+bool UsbPolicyEngine::matches(const UsbPolicyRule& rule, const UsbPolicyDevice& device) {
+    if (!rule.vid.empty() && rule.vid != device.vid) return false;
+    if (!rule.pid.empty() && rule.pid != device.pid) return false;
+    if (!rule.serialNumber.empty() && rule.serialNumber != device.serialNumber) return false;
+    if (!rule.deviceClass.empty() &&
+        std::find(device.classes.begin(), device.classes.end(), rule.deviceClass) == device.classes.end()) {
+        return false;
+    }
+    return true;
+}
+
+} // namespace SysMon
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "../shared/systemtypes.h"
+#include <map>
+#include <unordered_map>
+#include <shared_mutex>
+
+namespace SysMon {
+
+// Identity of a USB device as seen at plug-in time
+struct UsbPolicyDevice {
+    std::string vid;
+    std::string pid;
+    std::string serialNumber;
+    std::vector<std::string> classes;   // device class plus interface classes
+};
+
+// Outcome of evaluating one device
+struct UsbPolicyDecision {
+    bool allow;
+    std::string ruleId;         // empty when the default action applied
+};
+
+// Policy decision applied to a plugged-in device
+struct UsbPolicyEvent {
+    std::string devicePath;     // sysfs path of the USB device
+    UsbPolicyDevice device;
+    UsbPolicyDecision decision;
+    bool applied;               // authorized flag written successfully
+};
+
+// USB Policy Engine - allow/deny rules indexed by serial, VID:PID and class
+//
+// The most specific level with a matching rule decides: serial, then VID:PID,
+// then vendor-wide VID, then class. Deny wins within a level. Devices no rule
+// matches get the default action.
+class UsbPolicyEngine {
+public:
+    UsbPolicyEngine();
+
+    // Rule management
+    bool addRule(const UsbPolicyRule& rule);
+    bool removeRule(const std::string& ruleId);
+    std::vector<UsbPolicyRule> getRules() const;
+    void setDefaultAllow(bool allow);
+    bool isDefaultAllow() const;
+
+    // Evaluation
+    UsbPolicyDecision evaluate(const UsbPolicyDevice& device) const;
+
+private:
+    using Index = std::unordered_map<std::string, std::vector<std::string>>;
+
+    Index& indexFor(const UsbPolicyRule& rule, std::string& key);
+    void unindexRule(const UsbPolicyRule& rule);
+    static bool matches(const UsbPolicyRule& rule, const UsbPolicyDevice& device);
+    bool evaluateLevel(const Index& index, const std::string& key, const UsbPolicyDevice& device,
+                       UsbPolicyDecision& decision) const;
+
+    std::map<std::string, UsbPolicyRule> rules_;
+    Index bySerial_;
+    Index byVidPid_;
+    Index byVendor_;
+    Index byClass_;
+    bool defaultAllow_;
+    mutable std::shared_mutex rulesMutex_;
+};
+
+} // namespace SysMon
@@ -0,0 +1,230 @@
+#include "watchdog.h"
+#include <algorithm>
+#include <exception>
+
+namespace SysMon {
+
+constexpr std::chrono::milliseconds Watchdog::CHECK_INTERVAL;
+constexpr std::chrono::milliseconds Watchdog::MIN_DEADLINE;
+
+Watchdog& Watchdog::getInstance() {
+    static Watchdog instance;
+    return instance;
+}
+
+Watchdog::Watchdog()
+    : running_(false) {
+}
+
+Watchdog::~Watchdog() {
+    stop();
+}
+
+bool Watchdog::start() {
+    if (running_) {
+        return true;
+    }
+
+    running_ = true;
+    watchdogThread_ = std::thread(&Watchdog::watchdogThread, this);
+    return true;
+}
+
+void Watchdog::stop() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex_);
+        running_ = false;
+    }
+    wakeCondition_.notify_all();
+
+    if (watchdogThread_.joinable()) {
+        watchdogThread_.join();
+    }
+}
+
+std::chrono::milliseconds Watchdog::registerJob(const std::string& name, std::chrono::milliseconds interval) {
+    std::lock_guard<std::mutex> lock(jobsMutex_);
+
+    // Default deadline: two intervals, so one slow run is tolerated
+    std::chrono::milliseconds deadline = std::max(interval * 2, MIN_DEADLINE);
+    if (deadlineProvider_) {
+        std::chrono::milliseconds configured = deadlineProvider_(name);
+        if (configured.count() > 0) {
+            deadline = configured;
+        }
+    }
+
+    Job job;
+    job.interval = interval;
+    job.deadline = deadline;
+    job.lastSuccess = std::chrono::steady_clock::now();
+    job.runStarted = job.lastSuccess;
+    job.lastDurationMs = 0.0;
+    job.overruns = 0;
+    job.isRunning = false;
+    job.isQuarantined = false;
+    job.overrunCounted = false;
+    job.reportedStale = false;
+    jobs_[name] = job;
+
+    return deadline;
+}
+
+void Watchdog::unregisterJob(const std::string& name) {
+    std::lock_guard<std::mutex> lock(jobsMutex_);
+    jobs_.erase(name);
+}
+
+void Watchdog::beginRun(const std::string& name) {
+    std::lock_guard<std::mutex> lock(jobsMutex_);
+
+    auto it = jobs_.find(name);
+    if (it == jobs_.end()) {
+        return;
+    }
+    it->second.isRunning = true;
+    it->second.overrunCounted = false;
+    it->second.runStarted = std::chrono::steady_clock::now();
+}
+
+void Watchdog::endRun(const std::string& name, bool success) {
+    std::lock_guard<std::mutex> lock(jobsMutex_);
+
+    auto it = jobs_.find(name);
+    if (it == jobs_.end() || !it->second.isRunning) {
+        return;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    Job& job = it->second;
+    job.isRunning = false;
+    job.lastDurationMs = std::chrono::duration<double, std::milli>(now - job.runStarted).count();
+    if (success) {
+        job.lastSuccess = now;
+    }
+}
+
+void Watchdog::setQuarantined(const std::string& name, bool quarantined) {
+    std::lock_guard<std::mutex> lock(jobsMutex_);
+
+    auto it = jobs_.find(name);
+    if (it != jobs_.end()) {
+        it->second.isQuarantined = quarantined;
+    }
+}
+
+void Watchdog::setHealthCallback(HealthCallback callback) {
+    std::lock_guard<std::mutex> lock(jobsMutex_);
+    healthCallback_ = std::move(callback);
+}
+
+void Watchdog::setDeadlineProvider(DeadlineProvider provider) {
+    std::lock_guard<std::mutex> lock(jobsMutex_);
+    deadlineProvider_ = std::move(provider);
+}
+
+std::vector<JobHealthInfo> Watchdog::getJobHealth() const {
+    std::lock_guard<std::mutex> lock(jobsMutex_);
+
+    auto now = std::chrono::steady_clock::now();
+    std::vector<JobHealthInfo> health;
+    health.reserve(jobs_.size());
+    for (const auto& entry : jobs_) {
+        health.push_back(makeHealth(entry.first, entry.second, now));
+    }
+    return health;
+}
+
+bool Watchdog::getJobHealth(const std::string& name, JobHealthInfo& health) const {
+    std::lock_guard<std::mutex> lock(jobsMutex_);
+
+    auto it = jobs_.find(name);
+    if (it == jobs_.end()) {
+        return false;
+    }
+    health = makeHealth(it->first, it->second, std::chrono::steady_clock::now());
+    return true;
+}
+
+void Watchdog::watchdogThread() {
+    while (running_) {
+        try {
+            std::vector<JobHealthInfo> transitions;
+            HealthCallback callback;
+            {
+                std::lock_guard<std::mutex> lock(jobsMutex_);
+                auto now = std::chrono::steady_clock::now();
+
+                for (auto& entry : jobs_) {
+                    Job& job = entry.second;
+                    JobHealthInfo health = makeHealth(entry.first, job, now);
+
+                    if (job.isRunning && now - job.runStarted > job.deadline && !job.overrunCounted) {
+                        job.overruns++;
+                        job.overrunCounted = true;
+                        health.overruns = job.overruns;
+                    }
+                    if (health.isStale != job.reportedStale) {
+                        job.reportedStale = health.isStale;
+                        transitions.push_back(health);
+                    }
+                }
+                callback = healthCallback_;
+            }
+
+            // Callbacks run unlocked; they typically broadcast an event
+            if (callback) {
+                for (const auto& health : transitions) {
+                    callback(health);
+                }
+            }
+
+            std::unique_lock<std::mutex> lock(wakeMutex_);
+            wakeCondition_.wait_for(lock, CHECK_INTERVAL, [this]() { return !running_; });
+
+        } catch (const std::exception& e) {
+            // Log error but continue
+            std::this_thread::sleep_for(std::chrono::seconds(1));
+        }
+    }
+}
+
+JobHealthInfo Watchdog::makeHealth(const std::string& name, const Job& job,
+                                   std::chrono::steady_clock::time_point now) const {
+    JobHealthInfo health;
+    health.name = name;
+    health.intervalMs = static_cast<uint32_t>(job.interval.count());
+    health.deadlineMs = static_cast<uint32_t>(job.deadline.count());
+    health.ageMs = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(now - job.lastSuccess).count());
+    health.runningMs = job.isRunning ? static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(now - job.runStarted).count()) : 0;
+    health.lastDurationMs = job.lastDurationMs;
+    health.overruns = job.overruns;
+    health.isRunning = job.isRunning;
+    health.isQuarantined = job.isQuarantined;
+
+    bool overrunning = job.isRunning && now - job.runStarted > job.deadline;
+    bool expired = now - job.lastSuccess > job.interval + job.deadline;
+    health.isStale = overrunning || expired || job.isQuarantined;
+    return health;
+}
+
+// RunGuard implementation
+Watchdog::RunGuard::RunGuard(const std::string& name)
+    : name_(name)
+    , uncaughtExceptions_(std::uncaught_exceptions())
+    , failed_(false) {
+    Watchdog::getInstance().beginRun(name_);
+}
+
+Watchdog::RunGuard::~RunGuard() {
+    bool unwinding = std::uncaught_exceptions() > uncaughtExceptions_;
+    Watchdog::getInstance().endRun(name_, !failed_ && !unwinding);
+}
+
+void Watchdog::RunGuard::fail() {
+    failed_ = true;
+}
+
+} // namespace SysMon
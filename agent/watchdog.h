@@ -0,0 +1,103 @@
+#pragma once
+
+#include "../shared/systemtypes.h"
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <chrono>
+#include <map>
+
+namespace SysMon {
+
+// Watchdog - per-job deadlines for monitor loops and collectors
+//
+// Jobs bracket each run with beginRun()/endRun() (or a RunGuard). A job is
+// stale while a run exceeds its deadline, while it is quarantined, or when
+// no run has succeeded within interval + deadline. The watchdog thread
+// reports stale/fresh transitions through the health callback.
+class Watchdog {
+public:
+    using HealthCallback = std::function<void(const JobHealthInfo& health)>;
+    using DeadlineProvider = std::function<std::chrono::milliseconds(const std::string& jobName)>;
+
+    static Watchdog& getInstance();
+
+    // Lifecycle
+    bool start();
+    void stop();
+
+    // Job registration; returns the effective deadline
+    std::chrono::milliseconds registerJob(const std::string& name, std::chrono::milliseconds interval);
+    void unregisterJob(const std::string& name);
+
+    // Run tracking (any thread)
+    void beginRun(const std::string& name);
+    void endRun(const std::string& name, bool success);
+    void setQuarantined(const std::string& name, bool quarantined);
+
+    // Configuration
+    void setHealthCallback(HealthCallback callback);
+    void setDeadlineProvider(DeadlineProvider provider);
+
+    // Status
+    std::vector<JobHealthInfo> getJobHealth() const;
+    bool getJobHealth(const std::string& name, JobHealthInfo& health) const;
+
+    // Marks one run of a job; a run left by an exception counts as failed
+    class RunGuard {
+    public:
+        explicit RunGuard(const std::string& name);
+        ~RunGuard();
+        RunGuard(const RunGuard&) = delete;
+        RunGuard& operator=(const RunGuard&) = delete;
+
+        void fail();
+
+    private:
+        std::string name_;
+        int uncaughtExceptions_;
+        bool failed_;
+    };
+
+private:
+    Watchdog();
+    ~Watchdog();
+    Watchdog(const Watchdog&) = delete;
+    Watchdog& operator=(const Watchdog&) = delete;
+
+    struct Job {
+        std::chrono::milliseconds interval;
+        std::chrono::milliseconds deadline;
+        std::chrono::steady_clock::time_point lastSuccess;
+        std::chrono::steady_clock::time_point runStarted;
+        double lastDurationMs;
+        uint64_t overruns;
+        bool isRunning;
+        bool isQuarantined;
+        bool overrunCounted;
+        bool reportedStale;
+    };
+
+    void watchdogThread();
+    JobHealthInfo makeHealth(const std::string& name, const Job& job,
+                             std::chrono::steady_clock::time_point now) const;
+
+    std::map<std::string, Job> jobs_;
+    mutable std::mutex jobsMutex_;
+
+    std::atomic<bool> running_;
+    std::thread watchdogThread_;
+    std::mutex wakeMutex_;
+    std::condition_variable wakeCondition_;
+
+    HealthCallback healthCallback_;
+    DeadlineProvider deadlineProvider_;
+
+    // Constants
+    static constexpr std::chrono::milliseconds CHECK_INTERVAL{250};
+    static constexpr std::chrono::milliseconds MIN_DEADLINE{1000};
+};
+
+} // namespace SysMon
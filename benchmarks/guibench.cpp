@@ -0,0 +1,293 @@
+// GUI rendering benchmark
+//
+// Runs the real SystemMonitorTab, ProcessManagerTab and NetworkManagerTab on
+// Qt's offscreen platform, connected through the real IpcClient to a
+// SyntheticAgent on a worker thread. Reports per-update frame times (the
+// GUI-thread work to take in a response plus the repaint that follows it)
+// and the share of wall time the GUI thread was busy.
+
+#include "syntheticagent.h"
+#include "../gui/ipcclient.h"
+#include "../gui/systemmonitortab.h"
+#include "../gui/processmanagertab.h"
+#include "../gui/networkmanagertab.h"
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QEvent>
+#include <QHBoxLayout>
+#include <QLoggingCategory>
+#include <QMetaObject>
+#include <QThread>
+#include <QTimer>
+#include <QWidget>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace SysMon;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Times every top-level event delivered on the GUI thread
+class BenchApplication : public QApplication {
+public:
+    using EventObserver = std::function<void(QEvent::Type type, double elapsedMs)>;
+
+    BenchApplication(int& argc, char** argv)
+        : QApplication(argc, argv)
+        , depth_(0)
+        , busyMs_(0.0) {
+    }
+
+    bool notify(QObject* receiver, QEvent* event) override {
+        // Nested deliveries are part of the outer event's time; other
+        // threads (the synthetic agent) are not measured
+        if (depth_ > 0 || QThread::currentThread() != thread()) {
+            return QApplication::notify(receiver, event);
+        }
+
+        QEvent::Type type = event->type();
+        auto started = Clock::now();
+        depth_++;
+        bool result = QApplication::notify(receiver, event);
+        depth_--;
+        double elapsedMs = std::chrono::duration<double, std::milli>(Clock::now() - started).count();
+
+        busyMs_ += elapsedMs;
+        if (observer_) {
+            observer_(type, elapsedMs);
+        }
+        return result;
+    }
+
+    void setObserver(EventObserver observer) { observer_ = std::move(observer); }
+    double busyMs() const { return busyMs_; }
+    void resetBusy() { busyMs_ = 0.0; }
+
+private:
+    int depth_;
+    double busyMs_;
+    EventObserver observer_;
+};
+
+// Pairs each response with the repaint that follows it
+class FrameRecorder {
+public:
+    FrameRecorder()
+        : pendingMs_(0.0)
+        , recording_(false) {
+    }
+
+    // Called from IpcClient::responseReceived, inside a top-level event
+    void onResponse(const Response& response) {
+        auto data = response.data.find("data");
+        if (data != response.data.end() && data->second.find("\"processes\":") != std::string::npos) {
+            currentKinds_.insert("process_list");
+        } else if (response.message.find("\"cpu_total\":") != std::string::npos) {
+            currentKinds_.insert("system_info");
+        } else if (response.data.count("interfaces")) {
+            currentKinds_.insert("network_interfaces");
+        }
+    }
+
+    void onEvent(QEvent::Type type, double elapsedMs) {
+        if (!currentKinds_.empty()) {
+            // The event that delivered one or more responses
+            pendingKinds_.insert(currentKinds_.begin(), currentKinds_.end());
+            pendingMs_ += elapsedMs;
+            currentKinds_.clear();
+            return;
+        }
+
+        if (type == QEvent::UpdateRequest && !pendingKinds_.empty()) {
+            if (recording_) {
+                for (const auto& kind : pendingKinds_) {
+                    frames_[kind].push_back(pendingMs_ + elapsedMs);
+                }
+            }
+            pendingKinds_.clear();
+            pendingMs_ = 0.0;
+        }
+    }
+
+    void setRecording(bool recording) { recording_ = recording; }
+    const std::map<std::string, std::vector<double>>& frames() const { return frames_; }
+
+private:
+    std::set<std::string> currentKinds_;
+    std::set<std::string> pendingKinds_;
+    double pendingMs_;
+    bool recording_;
+    std::map<std::string, std::vector<double>> frames_;
+};
+
+double percentile(std::vector<double> values, double p) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    std::sort(values.begin(), values.end());
+    size_t rank = static_cast<size_t>(p / 100.0 * (values.size() - 1) + 0.5);
+    return values[std::min(rank, values.size() - 1)];
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    BenchApplication app(argc, argv);
+    QApplication::setApplicationName("sysmon_gui_bench");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Offscreen GUI rendering benchmark with a synthetic agent");
+    parser.addHelpOption();
+    QCommandLineOption durationOption("duration", "Measured seconds (default 10).", "seconds", "10");
+    QCommandLineOption warmupOption("warmup", "Unmeasured seconds first (default 2).", "seconds", "2");
+    QCommandLineOption intervalOption("interval", "Poll interval per tab in ms (default 250).", "ms", "250");
+    QCommandLineOption processesOption("processes", "Processes per list (default 50000).", "count", "50000");
+    QCommandLineOption coresOption("cores", "CPU cores per update (default 256).", "count", "256");
+    QCommandLineOption interfacesOption("interfaces", "Network interfaces (default 64).", "count", "64");
+    QCommandLineOption eventsOption("event-rate", "Events per second (default 2000).", "count", "2000");
+    QCommandLineOption jsonOption("json", "Print one JSON object instead of a table.");
+    parser.addOptions({durationOption, warmupOption, intervalOption, processesOption, coresOption,
+                       interfacesOption, eventsOption, jsonOption});
+    parser.process(app);
+
+    // IpcClient logs every command at debug level
+    QLoggingCategory::setFilterRules("default.debug=false");
+
+    SyntheticAgent::Config config;
+    config.processCount = parser.value(processesOption).toInt();
+    config.coreCount = parser.value(coresOption).toInt();
+    config.interfaceCount = parser.value(interfacesOption).toInt();
+    config.eventsPerSecond = parser.value(eventsOption).toInt();
+    int durationMs = static_cast<int>(parser.value(durationOption).toDouble() * 1000);
+    int warmupMs = static_cast<int>(parser.value(warmupOption).toDouble() * 1000);
+    int intervalMs = std::max(1, parser.value(intervalOption).toInt());
+
+    // Synthetic agent on its own thread
+    QThread agentThread;
+    auto* agent = new SyntheticAgent(config);
+    agent->moveToThread(&agentThread);
+    QObject::connect(&agentThread, &QThread::finished, agent, &QObject::deleteLater);
+    agentThread.start();
+
+    int port = 0;
+    QMetaObject::invokeMethod(agent, [agent, &port]() { port = agent->start(); }, Qt::BlockingQueuedConnection);
+    if (port == 0) {
+        std::fprintf(stderr, "Failed to start synthetic agent\n");
+        agentThread.quit();
+        agentThread.wait();
+        return 1;
+    }
+
+    // The real client and tabs, side by side so all of them stay active
+    IpcClient client;
+    if (!client.connectToAgent("127.0.0.1", port)) {
+        std::fprintf(stderr, "Failed to connect: %s\n", client.getLastError().c_str());
+        agentThread.quit();
+        agentThread.wait();
+        return 1;
+    }
+
+    QWidget window;
+    auto* layout = new QHBoxLayout(&window);
+    auto* systemTab = new SystemMonitorTab(&client, &window);
+    auto* processTab = new ProcessManagerTab(&client, &window);
+    auto* networkTab = new NetworkManagerTab(&client, &window);
+    layout->addWidget(systemTab);
+    layout->addWidget(processTab);
+    layout->addWidget(networkTab);
+    window.resize(1920, 1080);
+
+    FrameRecorder recorder;
+    uint64_t eventsReceived = 0;
+    QObject::connect(&client, &IpcClient::responseReceived, [&recorder](const Response& response) {
+        recorder.onResponse(response);
+    });
+    QObject::connect(&client, &IpcClient::eventReceived, [&eventsReceived](const Event&) {
+        eventsReceived++;
+    });
+    app.setObserver([&recorder](QEvent::Type type, double elapsedMs) {
+        recorder.onEvent(type, elapsedMs);
+    });
+
+    // Poll faster than the tabs' own timers, through their real slots
+    QTimer pollTimer;
+    QObject::connect(&pollTimer, &QTimer::timeout, [systemTab, processTab, networkTab]() {
+        QMetaObject::invokeMethod(systemTab, "updateSystemInfo");
+        QMetaObject::invokeMethod(systemTab, "updateProcessList");
+        QMetaObject::invokeMethod(processTab, "refreshProcesses");
+        QMetaObject::invokeMethod(networkTab, "refreshInterfaces");
+    });
+
+    window.show();
+    pollTimer.start(intervalMs);
+
+    QElapsedTimer wallClock;
+    uint64_t eventsAtStart = 0;
+    QTimer::singleShot(warmupMs, [&]() {
+        recorder.setRecording(true);
+        app.resetBusy();
+        eventsAtStart = eventsReceived;
+        wallClock.start();
+        QTimer::singleShot(durationMs, &app, &QApplication::quit);
+    });
+
+    app.exec();
+    app.setObserver(nullptr);
+
+    double wallMs = static_cast<double>(wallClock.elapsed());
+    double occupancy = wallMs > 0 ? app.busyMs() / wallMs * 100.0 : 0.0;
+    uint64_t events = eventsReceived - eventsAtStart;
+
+    pollTimer.stop();
+    client.disconnectFromAgent();
+    QMetaObject::invokeMethod(agent, [agent]() { agent->stop(); }, Qt::BlockingQueuedConnection);
+    uint64_t commandsServed = agent->commandsServed();
+    agentThread.quit();
+    agentThread.wait();
+
+    const auto& frames = recorder.frames();
+    if (parser.isSet(jsonOption)) {
+        std::printf("{\"processes\":%d,\"cores\":%d,\"interfaces\":%d,\"event_rate\":%d,\"duration_ms\":%.0f,",
+                    config.processCount, config.coreCount, config.interfaceCount, config.eventsPerSecond, wallMs);
+        std::printf("\"ui_thread_occupancy\":%.4f,\"events_received\":%llu,\"updates\":{",
+                    occupancy / 100.0, static_cast<unsigned long long>(events));
+        bool first = true;
+        for (const auto& entry : frames) {
+            std::printf("%s\"%s\":{\"frames\":%zu,\"p50_ms\":%.3f,\"p90_ms\":%.3f,\"p99_ms\":%.3f,\"max_ms\":%.3f}",
+                        first ? "" : ",", entry.first.c_str(), entry.second.size(),
+                        percentile(entry.second, 50), percentile(entry.second, 90),
+                        percentile(entry.second, 99), percentile(entry.second, 100));
+            first = false;
+        }
+        std::printf("}}\n");
+        return 0;
+    }
+
+    std::printf("SysMon GUI benchmark: %d processes, %d cores, %d interfaces, %d events/s, %.1f s\n\n",
+                config.processCount, config.coreCount, config.interfaceCount, config.eventsPerSecond,
+                wallMs / 1000.0);
+    std::printf("%-20s %8s %9s %9s %9s %9s\n", "update", "frames", "p50 ms", "p90 ms", "p99 ms", "max ms");
+    for (const auto& entry : frames) {
+        std::printf("%-20s %8zu %9.2f %9.2f %9.2f %9.2f\n", entry.first.c_str(), entry.second.size(),
+                    percentile(entry.second, 50), percentile(entry.second, 90),
+                    percentile(entry.second, 99), percentile(entry.second, 100));
+    }
+    std::printf("\nUI thread occupancy: %.1f%%\n", occupancy);
+    std::printf("Events received:     %llu (%.0f/s)\n", static_cast<unsigned long long>(events),
+                wallMs > 0 ? events * 1000.0 / wallMs : 0.0);
+    std::printf("Commands served:     %llu\n", static_cast<unsigned long long>(commandsServed));
+    return 0;
+}
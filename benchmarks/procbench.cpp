@@ -0,0 +1,342 @@
+// Process scan read benchmark
+//
+// Reads stat, status and cgroup of every process the way the process
+// scanner does, with three readers: plain (synchronous, one thread),
+// parallel (synchronous, one reader per thread over a slice of the pids)
+// and io_uring (ProcBatchReader's batched mode). Runs against a generated
+// fixture tree of --processes fake /proc/<pid> directories, or against a
+// live tree with --proc-root /proc. Every reader must see the same bytes;
+// the benchmark fails otherwise.
+
+#include "../agent/procbatchreader.h"
+#include "../shared/procparsers.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <dirent.h>
+#include <ftw.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace SysMon;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const std::vector<std::string> FILE_NAMES = {"stat", "status", "cgroup"};
+
+struct Options {
+    int processes = 50000;
+    int iterations = 10;
+    int threads = 0;
+    std::string procRoot;
+    bool json = false;
+};
+
+struct Result {
+    std::string reader;
+    bool available = true;
+    std::string error;
+    std::vector<double> scanMs;
+    uint64_t bytes = 0;
+    uint64_t processesSeen = 0;
+};
+
+// Scan-time work per process: the stat parse the scanner does
+struct ScanTotals {
+    uint64_t bytes = 0;
+    uint64_t processes = 0;
+
+    void add(const std::string_view* contents) {
+        ProcParsers::ProcessStat stat;
+        if (ProcParsers::parseProcessStat(contents[0], stat)) {
+            processes++;
+        }
+        for (size_t i = 0; i < FILE_NAMES.size(); ++i) {
+            bytes += contents[i].size();
+        }
+    }
+};
+
+bool writeFile(const std::string& path, const std::string& content) {
+    FILE* file = std::fopen(path.c_str(), "w");
+    if (!file) {
+        return false;
+    }
+    bool ok = std::fwrite(content.data(), 1, content.size(), file) == content.size();
+    return std::fclose(file) == 0 && ok;
+}
+
+// Fake /proc with the agent's own files as templates, pid swapped in
+bool createFixture(const std::string& root, int processes) {
+    std::string stat, status, cgroup;
+    if (!ProcParsers::readFile("/proc/self/stat", stat)) {
+        stat = "1 (bench) S 0 1 1 0 -1 4194560 100 0 0 0 10 5 0 0 20 0 1 0 100 10000000 500 "
+               "18446744073709551615 1 1 0 0 0 0 0 0 0 0 0 0 17 0 0 0 0 0 0\n";
+    }
+    if (!ProcParsers::readFile("/proc/self/status", status)) {
+        status = "Name:\tbench\nState:\tS (sleeping)\nUid:\t1000\t1000\t1000\t1000\n";
+    }
+    if (!ProcParsers::readFile("/proc/self/cgroup", cgroup)) {
+        cgroup = "0::/user.slice/bench.scope\n";
+    }
+    std::string statTail = stat.substr(stat.find(' '));
+
+    for (int pid = 1; pid <= processes; ++pid) {
+        std::string directory = root + "/" + std::to_string(pid);
+        if (mkdir(directory.c_str(), 0755) != 0 ||
+            !writeFile(directory + "/stat", std::to_string(pid) + statTail) ||
+            !writeFile(directory + "/status", status) ||
+            !writeFile(directory + "/cgroup", cgroup)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int removeEntry(const char* path, const struct stat*, int, struct FTW*) {
+    return ::remove(path);
+}
+
+std::vector<uint32_t> listPids(const std::string& root) {
+    std::vector<uint32_t> pids;
+    DIR* dir = opendir(root.c_str());
+    if (!dir) {
+        return pids;
+    }
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != nullptr) {
+        if (entry->d_name[0] >= '1' && entry->d_name[0] <= '9') {
+            pids.push_back(static_cast<uint32_t>(std::strtoul(entry->d_name, nullptr, 10)));
+        }
+    }
+    closedir(dir);
+    std::sort(pids.begin(), pids.end());
+    return pids;
+}
+
+double elapsedMs(Clock::time_point started) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - started).count();
+}
+
+Result runPlain(const std::string& root, const std::vector<uint32_t>& pids, int iterations) {
+    Result result;
+    result.reader = "plain";
+    ProcBatchReader reader(root, FILE_NAMES);
+    for (int i = 0; i < iterations; ++i) {
+        ScanTotals totals;
+        auto started = Clock::now();
+        reader.read(pids, [&](uint32_t, const std::string_view* contents) { totals.add(contents); });
+        result.scanMs.push_back(elapsedMs(started));
+        result.bytes = totals.bytes;
+        result.processesSeen = totals.processes;
+    }
+    return result;
+}
+
+Result runParallel(const std::string& root, const std::vector<uint32_t>& pids, int iterations, int threads) {
+    Result result;
+    result.reader = "parallel x" + std::to_string(threads);
+
+    std::vector<std::vector<uint32_t>> slices(static_cast<size_t>(threads));
+    for (size_t i = 0; i < pids.size(); ++i) {
+        slices[i * slices.size() / pids.size()].push_back(pids[i]);
+    }
+    std::vector<std::unique_ptr<ProcBatchReader>> readers;
+    for (int t = 0; t < threads; ++t) {
+        readers.push_back(std::make_unique<ProcBatchReader>(root, FILE_NAMES));
+    }
+
+    for (int i = 0; i < iterations; ++i) {
+        std::vector<ScanTotals> totals(static_cast<size_t>(threads));
+        std::vector<std::thread> workers;
+        auto started = Clock::now();
+        for (size_t t = 0; t < slices.size(); ++t) {
+            workers.emplace_back([&, t]() {
+                readers[t]->read(slices[t], [&](uint32_t, const std::string_view* contents) {
+                    totals[t].add(contents);
+                });
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        result.scanMs.push_back(elapsedMs(started));
+
+        result.bytes = 0;
+        result.processesSeen = 0;
+        for (const auto& slice : totals) {
+            result.bytes += slice.bytes;
+            result.processesSeen += slice.processes;
+        }
+    }
+    return result;
+}
+
+Result runBatched(const std::string& root, const std::vector<uint32_t>& pids, int iterations) {
+    Result result;
+    result.reader = "io_uring";
+    ProcBatchReader reader(root, FILE_NAMES);
+    if (!reader.initialize(result.error)) {
+        result.available = false;
+        return result;
+    }
+    for (int i = 0; i < iterations; ++i) {
+        ScanTotals totals;
+        auto started = Clock::now();
+        reader.read(pids, [&](uint32_t, const std::string_view* contents) { totals.add(contents); });
+        result.scanMs.push_back(elapsedMs(started));
+        result.bytes = totals.bytes;
+        result.processesSeen = totals.processes;
+    }
+    if (!reader.isBatched()) {
+        result.available = false;
+        result.error = "ring failed during the run";
+    }
+    return result;
+}
+
+double percentile(std::vector<double> values, double p) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    std::sort(values.begin(), values.end());
+    size_t rank = static_cast<size_t>(p / 100.0 * (values.size() - 1) + 0.5);
+    return values[std::min(rank, values.size() - 1)];
+}
+
+void printUsage() {
+    std::printf("Usage: sysmon_proc_bench [--processes N] [--iterations N] [--threads N]\n"
+                "                         [--proc-root DIR] [--json]\n\n"
+                "  --processes N   fixture processes (default 50000)\n"
+                "  --iterations N  measured scans per reader (default 10)\n"
+                "  --threads N     threads of the parallel reader (default: hardware threads)\n"
+                "  --proc-root DIR read a live tree (e.g. /proc) instead of a fixture\n"
+                "  --json          print one JSON object instead of a table\n");
+}
+
+bool parseOptions(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--processes" && hasValue) {
+            options.processes = std::atoi(argv[++i]);
+        } else if (arg == "--iterations" && hasValue) {
+            options.iterations = std::atoi(argv[++i]);
+        } else if (arg == "--threads" && hasValue) {
+            options.threads = std::atoi(argv[++i]);
+        } else if (arg == "--proc-root" && hasValue) {
+            options.procRoot = argv[++i];
+        } else if (arg == "--json") {
+            options.json = true;
+        } else {
+            return false;
+        }
+    }
+    return options.processes > 0 && options.iterations > 0 && options.threads >= 0;
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return 1;
+    }
+    if (options.threads == 0) {
+        options.threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+
+    // Fixture on tmpfs where there is one, so the disk is not measured
+    std::string root = options.procRoot;
+    std::string fixture;
+    if (root.empty()) {
+        std::string base = access("/dev/shm", W_OK) == 0 ? "/dev/shm" : "/tmp";
+        std::string pattern = base + "/sysmon-procbench-XXXXXX";
+        if (!mkdtemp(&pattern[0])) {
+            std::fprintf(stderr, "Cannot create fixture directory: %s\n", std::strerror(errno));
+            return 1;
+        }
+        fixture = root = pattern;
+        if (!createFixture(fixture, options.processes)) {
+            std::fprintf(stderr, "Cannot create fixture tree in %s\n", fixture.c_str());
+            nftw(fixture.c_str(), removeEntry, 16, FTW_DEPTH | FTW_PHYS);
+            return 1;
+        }
+    }
+
+    std::vector<uint32_t> pids = listPids(root);
+    if (pids.empty()) {
+        std::fprintf(stderr, "No processes under %s\n", root.c_str());
+        return 1;
+    }
+
+    // One unmeasured scan warms the dentry cache for everyone
+    runPlain(root, pids, 1);
+
+    std::vector<Result> results;
+    results.push_back(runPlain(root, pids, options.iterations));
+    results.push_back(runParallel(root, pids, options.iterations, options.threads));
+    results.push_back(runBatched(root, pids, options.iterations));
+
+    if (!fixture.empty()) {
+        nftw(fixture.c_str(), removeEntry, 16, FTW_DEPTH | FTW_PHYS);
+    }
+
+    // A fixture does not change between scans, so every reader must agree
+    bool consistent = true;
+    for (const auto& result : results) {
+        if (result.available && !fixture.empty() &&
+            (result.bytes != results[0].bytes || result.processesSeen != results[0].processesSeen)) {
+            consistent = false;
+        }
+    }
+
+    if (options.json) {
+        std::printf("{\"processes\":%zu,\"fixture\":%s,\"consistent\":%s,\"readers\":{",
+                    pids.size(), fixture.empty() ? "false" : "true", consistent ? "true" : "false");
+        bool first = true;
+        for (const auto& result : results) {
+            std::printf("%s\"%s\":", first ? "" : ",", result.reader.c_str());
+            if (!result.available) {
+                std::printf("{\"available\":false,\"error\":\"%s\"}", result.error.c_str());
+            } else {
+                std::printf("{\"available\":true,\"p50_ms\":%.3f,\"min_ms\":%.3f,\"max_ms\":%.3f,"
+                            "\"us_per_process\":%.3f,\"bytes\":%llu}",
+                            percentile(result.scanMs, 50), percentile(result.scanMs, 0),
+                            percentile(result.scanMs, 100), percentile(result.scanMs, 50) * 1000.0 / pids.size(),
+                            static_cast<unsigned long long>(result.bytes));
+            }
+            first = false;
+        }
+        std::printf("}}\n");
+        return consistent ? 0 : 2;
+    }
+
+    std::printf("SysMon process scan reads: %zu processes (%s), 3 files each, %d scans\n\n",
+                pids.size(), fixture.empty() ? root.c_str() : "fixture", options.iterations);
+    std::printf("%-14s %10s %10s %10s %12s %12s\n", "reader", "p50 ms", "min ms", "max ms", "us/process", "bytes");
+    for (const auto& result : results) {
+        if (!result.available) {
+            std::printf("%-14s unavailable: %s\n", result.reader.c_str(), result.error.c_str());
+            continue;
+        }
+        std::printf("%-14s %10.2f %10.2f %10.2f %12.2f %12llu\n", result.reader.c_str(),
+                    percentile(result.scanMs, 50), percentile(result.scanMs, 0), percentile(result.scanMs, 100),
+                    percentile(result.scanMs, 50) * 1000.0 / pids.size(),
+                    static_cast<unsigned long long>(result.bytes));
+    }
+    if (!consistent) {
+        std::printf("\nReaders disagree on the fixture contents\n");
+        return 2;
+    }
+    return 0;
+}
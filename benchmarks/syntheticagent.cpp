@@ -0,0 +1,296 @@
+#include "syntheticagent.h"
+#include "../shared/ipcprotocol.h"
+#include "../shared/serializer.h"
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QHostAddress>
+#include <QTimer>
+#include <cstdio>
+
+namespace SysMon {
+
+SyntheticAgent::Config::Config()
+    : processCount(50000)
+    , coreCount(256)
+    , interfaceCount(64)
+    , eventsPerSecond(2000) {
+}
+
+SyntheticAgent::SyntheticAgent(const Config& config, QObject* parent)
+    : QObject(parent)
+    , config_(config)
+    , server_(nullptr)
+    , eventTimer_(nullptr)
+    , seed_(12345)
+    , eventBudget_(0.0)
+    , commandsServed_(0)
+    , eventsSent_(0)
+    , bytesSent_(0) {
+
+    // A few hundred distinct names, like a real host with many workers
+    static const char* const BASE_NAMES[] = {
+        "chrome", "postgres", "nginx", "java", "python3", "node", "kworker", "systemd",
+        "containerd-shim", "sshd", "bash", "redis-server", "dockerd", "rsyslogd",
+    };
+    for (const char* base : BASE_NAMES) {
+        for (int i = 0; i < 32; ++i) {
+            processNames_.push_back(std::string(base) + "-" + std::to_string(i));
+        }
+    }
+}
+
+SyntheticAgent::~SyntheticAgent() {
+    stop();
+}
+
+int SyntheticAgent::start() {
+    server_ = new QTcpServer(this);
+    connect(server_, &QTcpServer::newConnection, this, &SyntheticAgent::onNewConnection);
+    if (!server_->listen(QHostAddress::LocalHost, 0)) {
+        return 0;
+    }
+
+    eventTimer_ = new QTimer(this);
+    connect(eventTimer_, &QTimer::timeout, this, &SyntheticAgent::publishEvents);
+    eventTimer_->start(EVENT_TICK_MS);
+
+    return server_->serverPort();
+}
+
+void SyntheticAgent::stop() {
+    if (eventTimer_) {
+        eventTimer_->stop();
+    }
+    for (auto& client : clients_) {
+        client.first->abort();
+    }
+    clients_.clear();
+    if (server_) {
+        server_->close();
+    }
+}
+
+uint64_t SyntheticAgent::commandsServed() const {
+    return commandsServed_;
+}
+
+uint64_t SyntheticAgent::eventsSent() const {
+    return eventsSent_;
+}
+
+uint64_t SyntheticAgent::bytesSent() const {
+    return bytesSent_;
+}
+
+void SyntheticAgent::onNewConnection() {
+    while (QTcpSocket* socket = server_->nextPendingConnection()) {
+        clients_[socket] = QByteArray();
+        connect(socket, &QTcpSocket::readyRead, this, &SyntheticAgent::onReadyRead);
+        connect(socket, &QTcpSocket::disconnected, this, [this, socket]() {
+            clients_.erase(socket);
+            socket->deleteLater();
+        });
+    }
+}
+
+void SyntheticAgent::onReadyRead() {
+    auto* socket = qobject_cast<QTcpSocket*>(sender());
+    auto it = clients_.find(socket);
+    if (it == clients_.end()) {
+        return;
+    }
+
+    QByteArray& buffer = it->second;
+    buffer.append(socket->readAll());
+
+    // Same framing as IpcClient: native-endian uint32 length, then JSON
+    while (buffer.size() >= static_cast<qsizetype>(sizeof(uint32_t))) {
+        uint32_t length = *reinterpret_cast<const uint32_t*>(buffer.constData());
+        if (buffer.size() < static_cast<qsizetype>(sizeof(uint32_t) + length)) {
+            break;
+        }
+
+        std::string json(buffer.constData() + sizeof(uint32_t), length);
+        buffer.remove(0, sizeof(uint32_t) + length);
+
+        Command command = IpcProtocol::deserializeCommand(json);
+        send(socket, IpcProtocol::serializeResponse(handleCommand(command)));
+        commandsServed_++;
+    }
+}
+
+void SyntheticAgent::publishEvents() {
+    if (clients_.empty() || config_.eventsPerSecond <= 0) {
+        return;
+    }
+
+    // Carry the fractional part so low rates still publish
+    eventBudget_ += config_.eventsPerSecond * EVENT_TICK_MS / 1000.0;
+    int count = static_cast<int>(eventBudget_);
+    eventBudget_ -= count;
+
+    for (int i = 0; i < count; ++i) {
+        char value[32];
+        std::snprintf(value, sizeof(value), "%.2f", nextLoad() / 25.0);
+        Event event = createEvent(Module::SYSTEM, "COLLECTOR_SAMPLES",
+            {{"collector", "loadavg"},
+             {"samples", std::string("{\"sample_count\":1,\"samples\":[{\"collector\":\"loadavg\","
+                                     "\"metric\":\"load1\",\"instance\":\"\",\"value\":") + value + "}]}"}});
+        std::string message = IpcProtocol::serializeEvent(event);
+
+        for (auto& client : clients_) {
+            send(client.first, message);
+        }
+        eventsSent_++;
+    }
+}
+
+Response SyntheticAgent::handleCommand(const Command& command) {
+    switch (command.type) {
+        case CommandType::PING:
+            // Also answers the GUI's authentication request
+            return createResponse(command.id, CommandStatus::SUCCESS, "PONG");
+
+        case CommandType::GET_SYSTEM_INFO: {
+            // Same payload as the agent: the serializer's document as the message
+            SystemInfo info;
+            info.cpuUsageTotal = nextLoad();
+            info.cpuCoresUsage = makeCoreUsage();
+            info.memoryTotal = 549755813888ULL;
+            info.memoryUsed = 274877906944ULL + static_cast<uint64_t>(nextLoad()) * 1048576ULL;
+            info.memoryFree = 137438953472ULL;
+            info.processCount = static_cast<uint32_t>(config_.processCount);
+            info.threadCount = static_cast<uint32_t>(config_.processCount) * 4;
+            info.sanitize();
+
+            auto fieldsIt = command.parameters.find("fields");
+            Serialization::FieldMask mask(fieldsIt != command.parameters.end() ? fieldsIt->second : "");
+            return createResponse(command.id, CommandStatus::SUCCESS,
+                                  Serialization::Serializer::getInstance().serializeSystemInfo(info, mask));
+        }
+
+        case CommandType::GET_PROCESS_LIST:
+            return createResponse(command.id, CommandStatus::SUCCESS, "Process list retrieved",
+                                  {{"data", makeProcessList(command)}});
+
+        case CommandType::GET_NETWORK_INTERFACES:
+            return createResponse(command.id, CommandStatus::SUCCESS, "Network interfaces retrieved",
+                                  {{"interfaces", makeInterfaces()}});
+
+        default:
+            return createResponse(command.id, CommandStatus::FAILED, "Not simulated");
+    }
+}
+
+std::string SyntheticAgent::makeProcessList(const Command& command) {
+    // Same document as Serializer::serializeProcessList, projected by the
+    // "fields" parameter, but with every configured process instead of the
+    // agent's first 100
+    static const char* const USERS[] = {"root", "postgres", "www-data", "user"};
+
+    auto fieldsIt = command.parameters.find("fields");
+    Serialization::FieldMask mask(fieldsIt != command.parameters.end() ? fieldsIt->second : "");
+    const bool pidField = mask.includes("pid");
+    const bool nameField = mask.includes("name");
+    const bool cpuField = mask.includes("cpu_usage");
+    const bool memoryField = mask.includes("memory_usage");
+    const bool statusField = mask.includes("status");
+    const bool parentField = mask.includes("parent_pid");
+    const bool userField = mask.includes("user");
+    const bool exeField = mask.includes("exe_id");
+
+    std::string list;
+    list.reserve(static_cast<size_t>(config_.processCount) * 140 + 48);
+    list += "{\"process_count\":" + std::to_string(config_.processCount) + ",\"processes\":[";
+    char value[32];
+    for (int i = 0; i < config_.processCount; ++i) {
+        uint32_t pid = static_cast<uint32_t>(i + 1);
+        double cpu = nextLoad() / 10.0;
+        bool first = true;
+        auto field = [&list, &first](const char* name) {
+            list += first ? "\"" : ",\"";
+            list += name;
+            list += "\":";
+            first = false;
+        };
+
+        list += i > 0 ? ",{" : "{";
+        if (pidField) {
+            field("pid");
+            list += std::to_string(pid);
+        }
+        if (nameField) {
+            field("name");
+            list += "\"" + processNames_[i % processNames_.size()] + "\"";
+        }
+        if (cpuField) {
+            field("cpu_usage");
+            std::snprintf(value, sizeof(value), "%.1f", cpu);
+            list += value;
+        }
+        if (memoryField) {
+            field("memory_usage");
+            list += std::to_string(4096ULL * (1 + (pid * 2654435761U) % 65536));
+        }
+        if (statusField) {
+            field("status");
+            list += cpu > 5.0 ? "\"R\"" : "\"S\"";
+        }
+        if (parentField) {
+            field("parent_pid");
+            list += std::to_string(pid > 1 ? 1 + pid / 64 : 0);
+        }
+        if (userField) {
+            field("user");
+            list += std::string("\"") + USERS[i % 4] + "\"";
+        }
+        if (exeField) {
+            field("exe_id");
+            list += std::to_string(1 + i % processNames_.size());
+        }
+        list += "}";
+    }
+    list += "]}";
+    return list;
+}
+
+std::vector<double> SyntheticAgent::makeCoreUsage() {
+    std::vector<double> cores;
+    cores.reserve(static_cast<size_t>(config_.coreCount));
+    for (int i = 0; i < config_.coreCount; ++i) {
+        cores.push_back(nextLoad());
+    }
+    return cores;
+}
+
+std::string SyntheticAgent::makeInterfaces() {
+    // "name,ipv4,ipv6,status,rx,tx;..." as parsed by NetworkManagerTab
+    std::string list;
+    char entry[128];
+    for (int i = 0; i < config_.interfaceCount; ++i) {
+        uint64_t traffic = static_cast<uint64_t>(nextLoad() * 1e7);
+        int length = std::snprintf(entry, sizeof(entry), "veth%d,10.%d.%d.1,fe80::%x,%d,%llu,%llu;",
+                                   i, i / 256, i % 256, i + 1, i % 8 != 7 ? 1 : 0,
+                                   static_cast<unsigned long long>(traffic),
+                                   static_cast<unsigned long long>(traffic / 2));
+        list.append(entry, static_cast<size_t>(length));
+    }
+    return list;
+}
+
+void SyntheticAgent::send(QTcpSocket* socket, const std::string& message) {
+    uint32_t length = static_cast<uint32_t>(message.size());
+    socket->write(reinterpret_cast<const char*>(&length), sizeof(length));
+    socket->write(message.data(), static_cast<qint64>(message.size()));
+    bytesSent_ += sizeof(length) + message.size();
+}
+
+double SyntheticAgent::nextLoad() {
+    // xorshift32: reproducible load values in [0, 100)
+    seed_ ^= seed_ << 13;
+    seed_ ^= seed_ >> 17;
+    seed_ ^= seed_ << 5;
+    return (seed_ % 10000) / 100.0;
+}
+
+} // namespace SysMon
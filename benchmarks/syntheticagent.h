@@ -0,0 +1,79 @@
+#pragma once
+
+#include "../shared/commands.h"
+#include <QObject>
+#include <QByteArray>
+#include <atomic>
+#include <map>
+#include <string>
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+class QTcpServer;
+class QTcpSocket;
+class QTimer;
+QT_END_NAMESPACE
+
+namespace SysMon {
+
+// Synthetic Agent - in-process stand-in for sysmon_agent in benchmarks
+//
+// Speaks the length-prefixed IPC protocol on a loopback port and answers
+// the GUI's polling commands with generated data of configurable size,
+// while pushing events at a fixed rate. It is meant to live on its own
+// thread so generating the feed is not charged to the GUI thread.
+class SyntheticAgent : public QObject {
+    Q_OBJECT
+
+public:
+    struct Config {
+        int processCount;
+        int coreCount;
+        int interfaceCount;
+        int eventsPerSecond;
+
+        Config();
+    };
+
+    explicit SyntheticAgent(const Config& config, QObject* parent = nullptr);
+    ~SyntheticAgent();
+
+    // Lifecycle (call on the agent's thread); start() returns the port, 0 on failure
+    int start();
+    void stop();
+
+    // Counters (any thread)
+    uint64_t commandsServed() const;
+    uint64_t eventsSent() const;
+    uint64_t bytesSent() const;
+
+private slots:
+    void onNewConnection();
+    void onReadyRead();
+    void publishEvents();
+
+private:
+    Response handleCommand(const Command& command);
+    std::string makeProcessList(const Command& command);
+    std::vector<double> makeCoreUsage();
+    std::string makeInterfaces();
+    void send(QTcpSocket* socket, const std::string& message);
+    double nextLoad();
+
+    Config config_;
+    QTcpServer* server_;
+    QTimer* eventTimer_;
+    std::map<QTcpSocket*, QByteArray> clients_;
+    std::vector<std::string> processNames_;
+    uint32_t seed_;
+    double eventBudget_;
+
+    std::atomic<uint64_t> commandsServed_;
+    std::atomic<uint64_t> eventsSent_;
+    std::atomic<uint64_t> bytesSent_;
+
+    // Constants
+    static constexpr int EVENT_TICK_MS = 10;
+};
+
+} // namespace SysMon
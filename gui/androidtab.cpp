@@ -21,6 +21,9 @@
 #include <QShowEvent>
 #include <QHideEvent>
 #include <QMessageBox>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
 #include <sstream>
 #include <algorithm>
 #include <QDebug>
@@ -191,10 +194,17 @@ void AndroidTab::refreshApps() {
     }
     
     AndroidDeviceInfo device = getSelectedDevice();
-    
-    // Create command to get installed apps
-    Command command = createCommand(CommandType::ANDROID_GET_FOREGROUND_APP, Module::ANDROID);
-    command.parameters["serial"] = device.serialNumber;
+    pendingApps_.clear();
+    requestAppPage(device.serialNumber, 0);
+}
+
+void AndroidTab::requestAppPage(const std::string& serialNumber, size_t offset) {
+    // Installed apps are served from the agent's cache, a page at a time
+    Command command = createCommand(CommandType::ANDROID_GET_INSTALLED_APPS, Module::ANDROID);
+    command.parameters["device_serial"] = serialNumber;
+    command.parameters["offset"] = std::to_string(offset);
+    command.parameters["limit"] = std::to_string(APP_PAGE_SIZE);
+    command.parameters["fields"] = "package";
     command.id = "apps_" + command.id;
     
     // Send command
@@ -422,31 +432,40 @@ void AndroidTab::onAppListResponse(const Response& response) {
         return;
     }
     
-    // Parse app list from response data
-    std::vector<std::string> apps;
+    auto it = response.data.find("data");
+    QJsonDocument document = it != response.data.end() ?
+        QJsonDocument::fromJson(QByteArray::fromStdString(it->second)) : QJsonDocument();
+    if (!document.isObject()) {
+        onError("Failed to parse app list");
+        return;
+    }
     
-    try {
-        std::string appData = response.data.count("apps") ? response.data.at("apps") : "";
-        
-        if (!appData.empty()) {
-            std::stringstream ss(appData);
-            std::string app;
-            
-            while (std::getline(ss, app, ';')) {
-                // Remove whitespace
-                app.erase(0, app.find_first_not_of(" \t\n\r"));
-                app.erase(app.find_last_not_of(" \t\n\r") + 1);
-                
-                if (!app.empty()) {
-                    apps.push_back(app);
-                }
-            }
+    // {"total":..,"matched":..,"offset":..,"apps":[{"package":..}]}
+    QJsonObject root = document.object();
+    size_t offset = static_cast<size_t>(root.value("offset").toDouble());
+    size_t matched = static_cast<size_t>(root.value("matched").toDouble());
+    QJsonArray page = root.value("apps").toArray();
+    if (offset == 0) {
+        pendingApps_.clear();
+    }
+    for (const QJsonValue& value : page) {
+        std::string packageName = value.toObject().value("package").toString().toStdString();
+        if (!packageName.empty()) {
+            pendingApps_.push_back(packageName);
         }
-    } catch (const std::exception& e) {
-        onError(QString("Failed to parse app list: %1").arg(e.what()));
+    }
+    
+    // Keep paging until every matching app is in
+    if (!page.isEmpty() && offset + static_cast<size_t>(page.size()) < matched && hasValidDeviceSelection()) {
+        requestAppPage(getSelectedDevice().serialNumber, offset + static_cast<size_t>(page.size()));
+        statusLabel_->setText(QString("Loading apps: %1 of %2").arg(pendingApps_.size()).arg(matched));
         return;
     }
     
+    std::vector<std::string> apps = std::move(pendingApps_);
+    pendingApps_.clear();
+    statusLabel_->setText(QString("%1 apps").arg(apps.size()));
+    
     // If no apps, show appropriate message
     if (apps.empty()) {
         // Show no apps message in app table
@@ -96,6 +96,7 @@ private:
     void updateDeviceList(const std::vector<AndroidDeviceInfo>& devices);
     void updateDeviceInfo(const AndroidDeviceInfo& device);
     void updateAppList(const std::vector<std::string>& apps);
+    void requestAppPage(const std::string& serialNumber, size_t offset);
     AndroidDeviceInfo getSelectedDevice() const;
     bool hasValidDeviceSelection() const;
     
@@ -187,6 +188,7 @@ private:
     // Data
     std::vector<AndroidDeviceInfo> currentDevices_;
     std::vector<std::string> currentApps_;
+    std::vector<std::string> pendingApps_;      // pages received so far
     AndroidDeviceInfo currentDeviceInfo_;
     
     // Status
@@ -202,6 +204,7 @@ private:
     static constexpr int DEVICE_REFRESH_INTERVAL = 5000; // 5 seconds
     static constexpr int INFO_REFRESH_INTERVAL = 2000; // 2 seconds
     static constexpr int MAX_LOGCAT_LINES = 100;
+    static constexpr int APP_PAGE_SIZE = 500; // agent caps a page at 1000
 };
 
 } // namespace SysMon
@@ -0,0 +1,137 @@
+#include "commandfuture.h"
+
+namespace SysMon {
+
+CommandFuture::CommandFuture() {
+}
+
+CommandFuture::CommandFuture(std::shared_ptr<State> state)
+    : state_(std::move(state)) {
+}
+
+CommandFuture CommandFuture::create(const std::string& commandId, Canceller canceller) {
+    auto state = std::make_shared<State>();
+    state->commandId = commandId;
+    state->canceller = std::move(canceller);
+    return CommandFuture(state);
+}
+
+bool CommandFuture::isValid() const {
+    return state_ != nullptr;
+}
+
+bool CommandFuture::isReady() const {
+    return state_ && state_->ready;
+}
+
+bool CommandFuture::isCancelled() const {
+    return state_ && state_->cancelled;
+}
+
+bool CommandFuture::succeeded() const {
+    return isReady() && state_->response.status == CommandStatus::SUCCESS;
+}
+
+const std::string& CommandFuture::getCommandId() const {
+    static const std::string empty;
+    return state_ ? state_->commandId : empty;
+}
+
+const Response& CommandFuture::getResponse() const {
+    static const Response empty = createResponse("", CommandStatus::PENDING);
+    return state_ ? state_->response : empty;
+}
+
+CommandFuture& CommandFuture::then(Continuation continuation) {
+    if (!state_ || !continuation) {
+        return *this;
+    }
+
+    if (state_->ready) {
+        continuation(state_->response);
+    } else {
+        state_->continuations.push_back(std::move(continuation));
+    }
+    return *this;
+}
+
+void CommandFuture::cancel() {
+    if (!state_ || state_->ready) {
+        return;
+    }
+
+    // Mark first so the canceller's own resolve() is reported as cancelled;
+    // taking the canceller out stops it from re-entering cancel()
+    state_->cancelled = true;
+    Canceller canceller;
+    canceller.swap(state_->canceller);
+    if (canceller) {
+        canceller(state_->commandId);
+    }
+    resolve(createResponse(state_->commandId, CommandStatus::FAILED, "Cancelled"));
+}
+
+bool CommandFuture::resolve(const Response& response) {
+    if (!state_ || state_->ready) {
+        return false;
+    }
+
+    state_->ready = true;
+    state_->response = response;
+
+    // Continuations may add more continuations or cancel other futures,
+    // so they run from a local list; clearing also breaks whenAll() cycles
+    std::vector<Continuation> continuations;
+    continuations.swap(state_->continuations);
+    state_->canceller = nullptr;
+
+    std::shared_ptr<State> keepAlive = state_;
+    for (const auto& continuation : continuations) {
+        continuation(keepAlive->response);
+    }
+    return true;
+}
+
+CommandFuture CommandFuture::whenAll(const std::vector<CommandFuture>& futures) {
+    CommandFuture all = create("all", [futures](const std::string&) {
+        for (auto future : futures) {
+            future.cancel();
+        }
+    });
+
+    if (futures.empty()) {
+        all.resolve(createResponse("all", CommandStatus::SUCCESS, "No commands"));
+        return all;
+    }
+
+    // An invalid future never resolves, so it counts as already failed
+    auto remaining = std::make_shared<size_t>(futures.size());
+    auto failures = std::make_shared<size_t>(0);
+    std::shared_ptr<State> state = all.state_;
+    auto settle = [state, remaining, failures](bool success) {
+        if (!success) {
+            (*failures)++;
+        }
+        if (--(*remaining) > 0) {
+            return;
+        }
+        CommandFuture aggregate(state);
+        aggregate.resolve(*failures == 0
+            ? createResponse("all", CommandStatus::SUCCESS, "All commands succeeded")
+            : createResponse("all", CommandStatus::FAILED,
+                             std::to_string(*failures) + " command(s) failed"));
+    };
+
+    for (auto future : futures) {
+        if (!future.isValid()) {
+            settle(false);
+            continue;
+        }
+        future.then([settle](const Response& response) {
+            settle(response.status == CommandStatus::SUCCESS);
+        });
+    }
+    return all;
+}
+
+} // namespace SysMon
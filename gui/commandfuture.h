@@ -0,0 +1,64 @@
+#pragma once
+
+#include "../shared/commands.h"
+#include <memory>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace SysMon {
+
+// Command Future - the pending result of IpcClient::request()
+//
+// A cheap, copyable handle to shared state. Continuations added with then()
+// run on the GUI thread when the response arrives, the command times out or
+// it is cancelled; one added after that runs immediately. A future resolves
+// exactly once, so a late response to a cancelled command is dropped.
+// Not thread-safe: use it from the thread that owns the IpcClient.
+class CommandFuture {
+public:
+    using Continuation = std::function<void(const Response&)>;
+    using Canceller = std::function<void(const std::string&)>;
+
+    CommandFuture();
+
+    // State
+    bool isValid() const;
+    bool isReady() const;
+    bool isCancelled() const;
+    bool succeeded() const;
+    const std::string& getCommandId() const;
+    const Response& getResponse() const;     // PENDING until isReady()
+
+    // Composition
+    CommandFuture& then(Continuation continuation);
+    void cancel();
+
+    // Ready once every future is; SUCCESS only if all of them succeeded
+    // (an invalid future counts as failed).
+    // Cancelling it cancels every future that is still pending.
+    static CommandFuture whenAll(const std::vector<CommandFuture>& futures);
+
+private:
+    friend class IpcClient;
+
+    struct State {
+        std::string commandId;
+        bool ready;
+        bool cancelled;
+        Response response;
+        std::vector<Continuation> continuations;
+        Canceller canceller;
+
+        State() : ready(false), cancelled(false), response(createResponse("", CommandStatus::PENDING)) {}
+    };
+
+    explicit CommandFuture(std::shared_ptr<State> state);
+
+    static CommandFuture create(const std::string& commandId, Canceller canceller);
+    bool resolve(const Response& response);
+
+    std::shared_ptr<State> state_;
+};
+
+} // namespace SysMon
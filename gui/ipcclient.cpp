@@ -6,6 +6,9 @@
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
+#include <QEventLoop>
+#include <QPointer>
+#include <algorithm>
 
 namespace SysMon {
 
@@ -18,7 +21,8 @@ IpcClient::IpcClient(QObject* parent)
     , connected_(false)
     , commandCounter_(0)
     , authTimer_(nullptr)
-    , heartbeatTimer_(nullptr) {
+    , heartbeatTimer_(nullptr)
+    , deadlineTimer_(nullptr) {
     
     socket_ = std::make_unique<QTcpSocket>(this);
     
@@ -41,6 +45,12 @@ IpcClient::IpcClient(QObject* parent)
     heartbeatTimer_ = new QTimer(this);
     connect(heartbeatTimer_, &QTimer::timeout,
             this, &IpcClient::onHeartbeatTimer);
+    
+    // Single timer armed for the earliest command deadline
+    deadlineTimer_ = new QTimer(this);
+    deadlineTimer_->setSingleShot(true);
+    connect(deadlineTimer_, &QTimer::timeout,
+            this, &IpcClient::onDeadlineTimer);
 }
 
 IpcClient::~IpcClient() {
@@ -130,31 +140,182 @@ bool IpcClient::isConnected() const {
 }
 
 std::string IpcClient::sendCommand(const Command& command, ResponseHandler handler) {
+    // No deadline: callers of this API may run long ADB operations and
+    // expect responseReceived for every reply
+    CommandFuture future = request(command, 0);
+    future.then([this, handler](const Response& response) {
+        if (handler) {
+            handler(response);
+        } else if (defaultResponseHandler_) {
+            defaultResponseHandler_(response);
+        }
+    });
+    return future.getCommandId();
+}
+
+CommandFuture IpcClient::request(const Command& command, int timeoutMs) {
     std::string commandId = generateCommandId();
     
     // Create a copy of the command with the new ID
     Command cmdWithId = command;
     cmdWithId.id = commandId;
     
-    // Store pending command
+    // The future may outlive the client
+    QPointer<IpcClient> self(this);
+    CommandFuture future = CommandFuture::create(commandId, [self](const std::string& id) {
+        if (self) {
+            self->cancelCommand(id);
+        }
+    });
+    
     PendingCommand pending;
     pending.id = commandId;
     pending.command = cmdWithId;
-    pending.handler = handler;
+    pending.future = future;
     pending.timestamp = std::chrono::system_clock::now();
+    pending.sent = connected_;
     
     {
         std::lock_guard<std::mutex> lock(commandsMutex_);
-        pendingCommands_.push(pending);
         activeCommands_[commandId] = pending;
+        if (!pending.sent) {
+            pendingCommands_.push_back(commandId);
+        }
+        if (timeoutMs > 0) {
+            deadlines_.push({std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs), commandId});
+        }
     }
     
-    // Send command if connected
-    if (connected_) {
+    // Commands are pipelined: send now, the agent answers in order
+    if (pending.sent) {
         sendCommandToSocket(cmdWithId);
     }
+    armDeadlineTimer();
+    
+    return future;
+}
+
+void IpcClient::cancelCommand(const std::string& commandId) {
+    // Resolves the future as cancelled; no-op if it already finished
+    abandonCommand(commandId).cancel();
+}
+
+size_t IpcClient::getActiveCommandCount() const {
+    std::lock_guard<std::mutex> lock(commandsMutex_);
+    return activeCommands_.size();
+}
+
+Response IpcClient::wait(CommandFuture future) {
+    if (!future.isValid()) {
+        return createResponse("", CommandStatus::FAILED, "Invalid command future");
+    }
+    
+    if (!future.isReady()) {
+        QEventLoop loop;
+        future.then([&loop](const Response&) {
+            loop.quit();
+        });
+        loop.exec();
+    }
+    return future.getResponse();
+}
+
+CommandFuture IpcClient::abandonCommand(const std::string& commandId) {
+    CommandFuture future;
+    bool sent = false;
+    
+    {
+        std::lock_guard<std::mutex> lock(commandsMutex_);
+        auto it = activeCommands_.find(commandId);
+        if (it == activeCommands_.end()) {
+            return future;
+        }
+        future = it->second.future;
+        sent = it->second.sent;
+        activeCommands_.erase(it);
+        
+        if (sent) {
+            if (abandonedCommands_.size() >= MAX_ABANDONED_COMMANDS) {
+                abandonedCommands_.clear();
+            }
+            abandonedCommands_.insert(commandId);
+        } else {
+            pendingCommands_.erase(std::remove(pendingCommands_.begin(), pendingCommands_.end(), commandId),
+                                   pendingCommands_.end());
+        }
+    }
     
-    return commandId;
+    // Let the agent drop it if it is still queued behind other work
+    if (sent && connected_) {
+        sendCancelFrame(commandId);
+    }
+    return future;
+}
+
+void IpcClient::sendCancelFrame(const std::string& commandId) {
+    Command cancelCmd = createCommand(CommandType::CANCEL_COMMAND, Module::SYSTEM, {{"command_id", commandId}});
+    cancelCmd.id = generateCommandId();
+    
+    {
+        std::lock_guard<std::mutex> lock(commandsMutex_);
+        abandonedCommands_.insert(cancelCmd.id);
+    }
+    sendCommandToSocket(cancelCmd);
+}
+
+void IpcClient::failSentCommands(const std::string& reason) {
+    std::vector<CommandFuture> failed;
+    
+    {
+        std::lock_guard<std::mutex> lock(commandsMutex_);
+        for (auto it = activeCommands_.begin(); it != activeCommands_.end();) {
+            if (it->second.sent) {
+                failed.push_back(it->second.future);
+                it = activeCommands_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        abandonedCommands_.clear();
+    }
+    
+    // Unsent commands stay queued for the next connection
+    for (auto& future : failed) {
+        future.resolve(createResponse(future.getCommandId(), CommandStatus::FAILED, reason));
+    }
+}
+
+void IpcClient::armDeadlineTimer() {
+    std::lock_guard<std::mutex> lock(commandsMutex_);
+    if (deadlines_.empty()) {
+        deadlineTimer_->stop();
+        return;
+    }
+    
+    auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(
+        deadlines_.top().when - std::chrono::steady_clock::now());
+    deadlineTimer_->start(static_cast<int>(std::max<long long>(0, wait.count())));
+}
+
+void IpcClient::onDeadlineTimer() {
+    auto now = std::chrono::steady_clock::now();
+    std::vector<std::string> expired;
+    
+    {
+        std::lock_guard<std::mutex> lock(commandsMutex_);
+        while (!deadlines_.empty() && deadlines_.top().when <= now) {
+            if (activeCommands_.count(deadlines_.top().commandId)) {
+                expired.push_back(deadlines_.top().commandId);
+            }
+            deadlines_.pop();
+        }
+    }
+    
+    for (const auto& commandId : expired) {
+        abandonCommand(commandId).resolve(createResponse(commandId, CommandStatus::FAILED, "Command timed out"));
+    }
+    
+    armDeadlineTimer();
 }
 
 std::string IpcClient::sendCommandAsync(const Command& command, ResponseHandler handler) {
@@ -217,6 +378,9 @@ void IpcClient::onSocketDisconnected() {
         qDebug() << "Heartbeat timer stopped";
     }
     
+    // Replies to commands already sent will never arrive
+    failSentCommands("Connection lost");
+    
     emit disconnected();
     
     if (connectionHandler_) {
@@ -393,18 +557,26 @@ void IpcClient::sendCommandToSocket(const Command& command) {
 }
 
 void IpcClient::handlePendingCommands() {
-    std::lock_guard<std::mutex> lock(commandsMutex_);
-    
     // Only send commands if authenticated
     if (!connected_) {
         return; // Commands will be sent after successful authentication
     }
     
-    while (!pendingCommands_.empty()) {
-        PendingCommand pending = pendingCommands_.front();
-        pendingCommands_.pop();
-        
-        sendCommandToSocket(pending.command);
+    std::vector<Command> commands;
+    {
+        std::lock_guard<std::mutex> lock(commandsMutex_);
+        while (!pendingCommands_.empty()) {
+            auto it = activeCommands_.find(pendingCommands_.front());
+            pendingCommands_.pop_front();
+            if (it != activeCommands_.end()) {
+                it->second.sent = true;
+                commands.push_back(it->second.command);
+            }
+        }
+    }
+    
+    for (const auto& command : commands) {
+        sendCommandToSocket(command);
     }
 }
 
@@ -418,20 +590,22 @@ void IpcClient::handleResponse(const Response& response) {
     }
     
     // Find and remove from active commands
-    std::lock_guard<std::mutex> lock(commandsMutex_);
-    auto it = activeCommands_.find(commandId);
-    if (it != activeCommands_.end()) {
-        PendingCommand pending = it->second;
-        activeCommands_.erase(it);
-        
-        // Call handler if available
-        if (pending.handler) {
-            pending.handler(response);
-        } else if (defaultResponseHandler_) {
-            defaultResponseHandler_(response);
+    CommandFuture future;
+    {
+        std::lock_guard<std::mutex> lock(commandsMutex_);
+        auto it = activeCommands_.find(commandId);
+        if (it != activeCommands_.end()) {
+            future = it->second.future;
+            activeCommands_.erase(it);
+        } else if (abandonedCommands_.erase(commandId) > 0) {
+            // Late reply to a cancelled or timed-out command, or to a cancel frame
+            return;
         }
     }
     
+    // Continuations run outside the lock so they can send further commands
+    future.resolve(response);
+    
     emit responseReceived(response);
 }
 
@@ -3,6 +3,7 @@
 #include "../shared/commands.h"
 #include "../shared/ipcprotocol.h"
 #include "../shared/security.h"
+#include "commandfuture.h"
 #include <QObject>
 #include <QTcpSocket>
 #include <QTimer>
@@ -10,6 +11,12 @@
 #include <memory>
 #include <functional>
 #include <queue>
+#include <deque>
+#include <set>
+#include <map>
+#include <vector>
+#include <chrono>
+#include <atomic>
 #include <mutex>
 
 QT_BEGIN_NAMESPACE
@@ -43,6 +50,18 @@ public:
     std::string sendCommand(const Command& command, ResponseHandler handler = nullptr);
     std::string sendCommandAsync(const Command& command, ResponseHandler handler = nullptr);
     
+    // Futures API: any number of commands can be in flight at once. Each
+    // future resolves on its response, on timeout (timeoutMs, 0 for none)
+    // or on cancel; timed-out and cancelled commands are also cancelled on
+    // the agent if they are still queued there.
+    CommandFuture request(const Command& command, int timeoutMs = COMMAND_TIMEOUT);
+    void cancelCommand(const std::string& commandId);
+    size_t getActiveCommandCount() const;
+    
+    // Runs a local event loop until the future is ready. For dialogs and
+    // scripts; tabs should use then() instead.
+    Response wait(CommandFuture future);
+    
     // Handler registration
     void setDefaultResponseHandler(ResponseHandler handler);
     void setEventHandler(EventHandler handler);
@@ -71,6 +90,7 @@ private slots:
     void onConnectionTimer();
     void onAuthenticationTimeout();
     void onHeartbeatTimer();
+    void onDeadlineTimer();
     
     // Connection management
     void startReconnection();
@@ -83,6 +103,10 @@ private:
     // Command management
     void sendCommandToSocket(const Command& command);
     void handlePendingCommands();
+    CommandFuture abandonCommand(const std::string& commandId);
+    void sendCancelFrame(const std::string& commandId);
+    void failSentCommands(const std::string& reason);
+    void armDeadlineTimer();
     
     // Authentication
     void sendAuthenticationRequest();
@@ -96,12 +120,24 @@ private:
     struct PendingCommand {
         std::string id;
         Command command;
-        ResponseHandler handler;
+        CommandFuture future;
         std::chrono::system_clock::time_point timestamp;
+        bool sent;
+    };
+    
+    // Timeouts are kept in a min-heap and removed lazily: an entry whose
+    // command has already finished is skipped when it reaches the top
+    struct Deadline {
+        std::chrono::steady_clock::time_point when;
+        std::string commandId;
+        
+        bool operator>(const Deadline& other) const { return when > other.when; }
     };
     
-    std::queue<PendingCommand> pendingCommands_;
+    std::deque<std::string> pendingCommands_;       // not sent yet (before authentication)
     std::map<std::string, PendingCommand> activeCommands_;
+    std::priority_queue<Deadline, std::vector<Deadline>, std::greater<Deadline>> deadlines_;
+    std::set<std::string> abandonedCommands_;       // late replies to drop
     mutable std::mutex commandsMutex_;
     
     // Network components
@@ -118,6 +154,7 @@ private:
     QTimer* connectionTimer_;
     QTimer* authTimer_;
     QTimer* heartbeatTimer_;
+    QTimer* deadlineTimer_;
     
     // Connection management
     bool reconnecting_;
@@ -148,6 +185,7 @@ private:
     static constexpr int RECONNECT_DELAY = 2000; // 2 seconds
     static constexpr int HEARTBEAT_INTERVAL = 60000; // 60 seconds (from Constants::HEARTBEAT_INTERVAL)
     static constexpr int AUTH_TIMEOUT = 10000; // 10 seconds
+    static constexpr size_t MAX_ABANDONED_COMMANDS = 1024;
 };
 
 } // namespace SysMon
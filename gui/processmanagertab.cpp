@@ -13,7 +13,11 @@
 #include <QInputDialog>
 #include <QShowEvent>
 #include <QHideEvent>
-#include <sstream>
+#include <QMenu>
+#include <QComboBox>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
 #include <algorithm>
 #include <QDebug>
 
@@ -74,8 +78,20 @@ void ProcessManagerTab::refreshProcesses() {
         return;
     }
     
-    // Create command to get process list
-    Command command = createCommand(CommandType::GET_PROCESS_LIST, Module::PROCESS);
+    // Grouped view asks the agent for per-group totals instead of every process
+    if (isGrouped()) {
+        Command command = createCommand(CommandType::GET_PROCESS_AGGREGATES, Module::SYSTEM,
+                                        {{"group_by", groupByCombo_->currentData().toString().toStdString()},
+                                         {"limit", std::to_string(MAX_PROCESSES_DISPLAY)}});
+        ipcClient_->sendCommand(command, [this](const Response& response) {
+            onProcessAggregatesResponse(response);
+        });
+        return;
+    }
+    
+    // Create command to get process list, limited to the visible columns
+    Command command = createCommand(CommandType::GET_PROCESS_LIST, Module::SYSTEM,
+                                    {{"fields", visibleFields()}});
     
     // Send command with response handler
     ipcClient_->sendCommand(command, [this](const Response& response) {
@@ -128,49 +144,103 @@ void ProcessManagerTab::onSearchTextChanged() {
     filterProcesses();
 }
 
+void ProcessManagerTab::showColumnMenu(const QPoint& position) {
+    QMenu menu(this);
+    
+    // PID stays visible, selection and process control depend on it
+    for (int column = COLUMN_NAME; column < COLUMN_COUNT; ++column) {
+        QAction* action = menu.addAction(processTable_->horizontalHeaderItem(column)->text());
+        action->setCheckable(true);
+        action->setChecked(!processTable_->isColumnHidden(column));
+        connect(action, &QAction::toggled, this, [this, column](bool visible) {
+            processTable_->setColumnHidden(column, !visible);
+            refreshProcesses();
+        });
+    }
+    
+    menu.exec(processTable_->horizontalHeader()->mapToGlobal(position));
+}
+
+void ProcessManagerTab::onGroupByChanged(int index) {
+    Q_UNUSED(index);
+    
+    bool grouped = isGrouped();
+    processTable_->setVisible(!grouped);
+    groupTable_->setVisible(grouped);
+    processGroup_->setTitle(grouped ? QString("Process Groups (%1)").arg(groupByCombo_->currentText())
+                                    : QString("Processes"));
+    
+    // Process control needs a single process selected in the flat view
+    updateButtonStates();
+    refreshProcesses();
+}
+
+void ProcessManagerTab::onProcessAggregatesResponse(const Response& response) {
+    if (response.status != CommandStatus::SUCCESS) {
+        onError(QString("Failed to get process groups: %1").arg(QString::fromStdString(response.message)));
+        return;
+    }
+    
+    auto it = response.data.find("data");
+    if (it == response.data.end()) {
+        return;
+    }
+    
+    QJsonDocument document = QJsonDocument::fromJson(QByteArray::fromStdString(it->second));
+    if (!document.isObject()) {
+        onError("Failed to parse process groups");
+        return;
+    }
+    
+    QJsonObject root = document.object();
+    currentGroups_.clear();
+    for (const QJsonValue& value : root.value("groups").toArray()) {
+        QJsonObject object = value.toObject();
+        ProcessAggregate group;
+        group.key = object.value("key").toString().toStdString();
+        group.count = static_cast<uint32_t>(object.value("count").toDouble());
+        group.cpuTotal = object.value("cpu_total").toDouble();
+        group.cpuMax = object.value("cpu_max").toDouble();
+        group.rssTotal = static_cast<uint64_t>(object.value("rss_total").toDouble());
+        currentGroups_.push_back(group);
+    }
+    
+    updateGroupTable();
+    processCountLabel_->setText(QString("Processes: %1 in %2 groups")
+                                .arg(root.value("process_count").toDouble())
+                                .arg(root.value("group_count").toDouble()));
+}
+
 void ProcessManagerTab::onProcessListResponse(const Response& response) {
     if (response.status != CommandStatus::SUCCESS) {
         onError(QString("Failed to get process list: %1").arg(QString::fromStdString(response.message)));
         return;
     }
     
-    // Parse process list from response data
+    // Parse process list from response data: {"process_count":..,"processes":[{..}]},
+    // rows hold only the requested fields, so read them by name
     std::vector<ProcessInfo> processes;
-    
-    try {
-        // Expect process data in format: "pid1,name1,cpu1,memory1,status1,parent1,user1;pid2,name2,..."
-        std::string processData = response.data.count("processes") ? response.data.at("processes") : "";
+    auto it = response.data.find("data");
+    if (it != response.data.end()) {
+        QJsonDocument document = QJsonDocument::fromJson(QByteArray::fromStdString(it->second));
+        if (!document.isObject()) {
+            onError("Failed to parse process data");
+            return;
+        }
         
-        if (!processData.empty()) {
-            std::stringstream ss(processData);
-            std::string processEntry;
-            
-            while (std::getline(ss, processEntry, ';')) {
-                std::stringstream entryStream(processEntry);
-                std::string field;
-                std::vector<std::string> fields;
-                
-                while (std::getline(entryStream, field, ',')) {
-                    fields.push_back(field);
-                }
-                
-                if (fields.size() >= 7) {
-                    ProcessInfo proc;
-                    proc.pid = std::stoul(fields[0]);
-                    proc.name = fields[1];
-                    proc.cpuUsage = std::stod(fields[2]);
-                    proc.memoryUsage = std::stoull(fields[3]);
-                    proc.status = fields[4];
-                    proc.parentPid = std::stoul(fields[5]);
-                    proc.user = fields[6];
-                    
-                    processes.push_back(proc);
-                }
-            }
+        for (const QJsonValue& value : document.object().value("processes").toArray()) {
+            QJsonObject object = value.toObject();
+            ProcessInfo proc;
+            proc.pid = static_cast<uint32_t>(object.value("pid").toDouble());
+            proc.name = object.value("name").toString().toStdString();
+            proc.cpuUsage = object.value("cpu_usage").toDouble();
+            proc.memoryUsage = static_cast<uint64_t>(object.value("memory_usage").toDouble());
+            proc.status = object.value("status").toString().toStdString();
+            proc.parentPid = static_cast<uint32_t>(object.value("parent_pid").toDouble());
+            proc.user = object.value("user").toString().toStdString();
+            proc.executableId = static_cast<uint32_t>(object.value("exe_id").toDouble());
+            processes.push_back(proc);
         }
-    } catch (const std::exception& e) {
-        onError(QString("Failed to parse process data: %1").arg(e.what()));
-        return;
     }
     
     // If no processes from IPC, use placeholder data for development
@@ -268,6 +338,21 @@ void ProcessManagerTab::setupSearchBar() {
     searchLayout_->addWidget(searchEdit_.get());
     searchLayout_->addWidget(clearSearchButton_.get());
     
+    // Grouping is done by the agent, the combo data is the group_by value
+    groupByLabel_ = std::make_unique<QLabel>();
+    groupByLabel_->setText("Group by:");
+    groupByCombo_ = std::make_unique<QComboBox>();
+    groupByCombo_->addItem("None", QString());
+    groupByCombo_->addItem("Name", QString("name"));
+    groupByCombo_->addItem("User", QString("user"));
+    groupByCombo_->addItem("Cgroup", QString("cgroup"));
+    groupByCombo_->addItem("Executable", QString("exe"));
+    connect(groupByCombo_.get(), QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, &ProcessManagerTab::onGroupByChanged);
+    
+    searchLayout_->addWidget(groupByLabel_.get());
+    searchLayout_->addWidget(groupByCombo_.get());
+    
     searchGroup_->setLayout(searchLayout_.get());
 }
 
@@ -283,7 +368,10 @@ void ProcessManagerTab::setupProcessTable() {
     connect(processTable_.get(), &QTableWidget::itemSelectionChanged,
             this, &ProcessManagerTab::onProcessSelectionChanged);
     
+    setupGroupTable();
+    
     processLayout_->addWidget(processTable_.get());
+    processLayout_->addWidget(groupTable_.get());
     processGroup_->setLayout(processLayout_.get());
 }
 
@@ -347,6 +435,80 @@ void ProcessManagerTab::setupProcessTableHeaders() {
     processTable_->horizontalHeader()->setSectionResizeMode(4, QHeaderView::ResizeToContents); // Status
     processTable_->horizontalHeader()->setSectionResizeMode(5, QHeaderView::ResizeToContents); // User
     processTable_->horizontalHeader()->setSectionResizeMode(6, QHeaderView::ResizeToContents); // Parent PID
+    
+    // Columns can be hidden from the header context menu
+    processTable_->horizontalHeader()->setContextMenuPolicy(Qt::CustomContextMenu);
+    connect(processTable_->horizontalHeader(), &QHeaderView::customContextMenuRequested,
+            this, &ProcessManagerTab::showColumnMenu);
+}
+
+void ProcessManagerTab::setupGroupTable() {
+    groupTable_ = std::make_unique<QTableWidget>();
+    
+    QStringList headers;
+    headers << "Group" << "Processes" << "CPU % Total" << "CPU % Max" << "Memory";
+    
+    groupTable_->setColumnCount(headers.size());
+    groupTable_->setHorizontalHeaderLabels(headers);
+    groupTable_->setSelectionBehavior(QAbstractItemView::SelectRows);
+    groupTable_->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    groupTable_->setSortingEnabled(true);
+    
+    groupTable_->horizontalHeader()->setSectionResizeMode(GROUP_COLUMN_KEY, QHeaderView::Stretch);
+    for (int column = GROUP_COLUMN_COUNT; column < GROUP_COLUMN_TOTAL; ++column) {
+        groupTable_->horizontalHeader()->setSectionResizeMode(column, QHeaderView::ResizeToContents);
+    }
+    
+    groupTable_->setVisible(false);
+}
+
+void ProcessManagerTab::updateGroupTable() {
+    QString searchText = currentSearchText_.toLower();
+    
+    // Sorting is suspended while rows are replaced so items stay in their rows
+    groupTable_->setSortingEnabled(false);
+    groupTable_->setRowCount(0);
+    
+    int row = 0;
+    for (const auto& group : currentGroups_) {
+        QString key = group.key.empty() ? QString("(none)") : QString::fromStdString(group.key);
+        if (!searchText.isEmpty() && !key.toLower().contains(searchText)) {
+            continue;
+        }
+        
+        groupTable_->insertRow(row);
+        groupTable_->setItem(row, GROUP_COLUMN_KEY, new QTableWidgetItem(key));
+        
+        auto* countItem = new QTableWidgetItem();
+        countItem->setData(Qt::DisplayRole, group.count);
+        groupTable_->setItem(row, GROUP_COLUMN_COUNT, countItem);
+        groupTable_->setItem(row, GROUP_COLUMN_CPU_TOTAL, new QTableWidgetItem(formatPercentage(group.cpuTotal)));
+        groupTable_->setItem(row, GROUP_COLUMN_CPU_MAX, new QTableWidgetItem(formatPercentage(group.cpuMax)));
+        groupTable_->setItem(row, GROUP_COLUMN_MEMORY, new QTableWidgetItem(formatBytes(group.rssTotal)));
+        row++;
+    }
+    
+    groupTable_->setSortingEnabled(true);
+}
+
+bool ProcessManagerTab::isGrouped() const {
+    return groupByCombo_ && !groupByCombo_->currentData().toString().isEmpty();
+}
+
+std::string ProcessManagerTab::visibleFields() const {
+    // Agent field names, indexed by table column
+    static const char* const COLUMN_FIELDS[COLUMN_COUNT] = {
+        "pid", "name", "cpu_usage", "memory_usage", "status", "user", "parent_pid"
+    };
+    
+    std::string fields = COLUMN_FIELDS[COLUMN_PID];
+    for (int column = COLUMN_NAME; column < COLUMN_COUNT; ++column) {
+        if (!processTable_->isColumnHidden(column)) {
+            fields += ",";
+            fields += COLUMN_FIELDS[column];
+        }
+    }
+    return fields;
 }
 
 void ProcessManagerTab::updateProcessTable(const std::vector<ProcessInfo>& processes) {
@@ -382,6 +544,11 @@ void ProcessManagerTab::clearProcessTable() {
 }
 
 void ProcessManagerTab::filterProcesses() {
+    if (isGrouped()) {
+        updateGroupTable();
+        return;
+    }
+    
     if (currentSearchText_.isEmpty()) {
         filteredProcesses_ = currentProcesses_;
     } else {
@@ -418,7 +585,7 @@ bool ProcessManagerTab::hasValidSelection() const {
 }
 
 void ProcessManagerTab::updateButtonStates() {
-    bool hasSelection = hasValidSelection();
+    bool hasSelection = !isGrouped() && hasValidSelection();
     
     terminateButton_->setEnabled(hasSelection);
     killButton_->setEnabled(hasSelection);
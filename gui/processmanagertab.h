@@ -12,6 +12,7 @@
 #include <QLineEdit>
 #include <QMessageBox>
 #include <QInputDialog>
+#include <QComboBox>
 #include <memory>
 #include "../shared/systemtypes.h"
 #include "ipcclient.h"
@@ -24,6 +25,7 @@ class QTimer;
 class QGroupBox;
 class QLineEdit;
 class QMessageBox;
+class QComboBox;
 QT_END_NAMESPACE
 
 namespace SysMon {
@@ -49,9 +51,12 @@ private slots:
     void searchProcesses();
     void onProcessSelectionChanged();
     void onSearchTextChanged();
+    void showColumnMenu(const QPoint& position);
+    void onGroupByChanged(int index);
     
     // IPC responses
     void onProcessListResponse(const Response& response);
+    void onProcessAggregatesResponse(const Response& response);
     void onProcessOperationResponse(const Response& response);
     void onError(const QString& error);
 
@@ -69,6 +74,12 @@ private:
     void addProcessToTable(const ProcessInfo& process, int row);
     void clearProcessTable();
     void filterProcesses();
+    std::string visibleFields() const;
+    
+    // Grouped view (GET_PROCESS_AGGREGATES)
+    void setupGroupTable();
+    void updateGroupTable();
+    bool isGrouped() const;
     
     // Process operations
     void terminateSelectedProcess();
@@ -97,11 +108,14 @@ private:
     std::unique_ptr<QLabel> searchLabel_;
     std::unique_ptr<QLineEdit> searchEdit_;
     std::unique_ptr<QPushButton> clearSearchButton_;
+    std::unique_ptr<QLabel> groupByLabel_;
+    std::unique_ptr<QComboBox> groupByCombo_;
     
     // Process table section
     std::unique_ptr<QGroupBox> processGroup_;
     std::unique_ptr<QVBoxLayout> processLayout_;
     std::unique_ptr<QTableWidget> processTable_;
+    std::unique_ptr<QTableWidget> groupTable_;
     
     // Control buttons section
     std::unique_ptr<QGroupBox> controlGroup_;
@@ -123,6 +137,7 @@ private:
     // Data
     std::vector<ProcessInfo> currentProcesses_;
     std::vector<ProcessInfo> filteredProcesses_;
+    std::vector<ProcessAggregate> currentGroups_;
     QString currentSearchText_;
     
     // Status
@@ -140,6 +155,15 @@ private:
         COLUMN_COUNT
     };
     
+    enum GroupTableColumns {
+        GROUP_COLUMN_KEY = 0,
+        GROUP_COLUMN_COUNT,
+        GROUP_COLUMN_CPU_TOTAL,
+        GROUP_COLUMN_CPU_MAX,
+        GROUP_COLUMN_MEMORY,
+        GROUP_COLUMN_TOTAL
+    };
+    
     // Constants
     static constexpr int REFRESH_INTERVAL = 2000; // 2 seconds
     static constexpr int MAX_PROCESSES_DISPLAY = 200;
@@ -9,7 +9,6 @@
 #include <QListWidget>
 #include <QTimer>
 #include <QStatusBar>
-#include <sstream>
 #include <algorithm>
 #include <QGroupBox>
 #include <QScrollArea>
@@ -19,6 +18,9 @@
 #include <QShowEvent>
 #include <QHideEvent>
 #include <QMainWindow>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
 
 namespace SysMon {
 
@@ -47,6 +49,10 @@ SystemMonitorTab::SystemMonitorTab(IpcClient* ipcClient, QWidget* parent)
 
 SystemMonitorTab::~SystemMonitorTab() {
     // Timers are automatically deleted by Qt
+    
+    // Pending continuations capture this
+    systemInfoRequest_.cancel();
+    processListRequest_.cancel();
 }
 
 void SystemMonitorTab::showEvent(QShowEvent* event) {
@@ -74,6 +80,9 @@ void SystemMonitorTab::hideEvent(QHideEvent* event) {
         // Stop timers
         systemInfoTimer_->stop();
         processListTimer_->stop();
+        
+        systemInfoRequest_.cancel();
+        processListRequest_.cancel();
     }
 }
 
@@ -85,9 +94,13 @@ void SystemMonitorTab::updateSystemInfo() {
     // Create command to get system info
     Command command = createCommand(CommandType::GET_SYSTEM_INFO, Module::SYSTEM);
     
-    // Send command with response handler
-    ipcClient_->sendCommand(command, [this](const Response& response) {
-        onSystemInfoResponse(response);
+    // Drop the previous refresh if the agent has not answered it yet
+    systemInfoRequest_.cancel();
+    systemInfoRequest_ = ipcClient_->request(command, SYSTEM_UPDATE_INTERVAL * 5);
+    systemInfoRequest_.then([this](const Response& response) {
+        if (!systemInfoRequest_.isCancelled()) {
+            onSystemInfoResponse(response);
+        }
     });
 }
 
@@ -99,9 +112,13 @@ void SystemMonitorTab::updateProcessList() {
     // Create command to get process list
     Command command = createCommand(CommandType::GET_PROCESS_LIST, Module::SYSTEM);
     
-    // Send command with response handler
-    ipcClient_->sendCommand(command, [this](const Response& response) {
-        onProcessListResponse(response);
+    // Drop the previous refresh if the agent has not answered it yet
+    processListRequest_.cancel();
+    processListRequest_ = ipcClient_->request(command, PROCESS_UPDATE_INTERVAL * 5);
+    processListRequest_.then([this](const Response& response) {
+        if (!processListRequest_.isCancelled()) {
+            onProcessListResponse(response);
+        }
     });
 }
 
@@ -111,69 +128,39 @@ void SystemMonitorTab::onSystemInfoResponse(const Response& response) {
         return;
     }
     
-    // Parse system info from response data
-    SystemInfo info;
-    
-    // Parse CPU usage
-    auto cpuIt = response.data.find("cpu_total");
-    if (cpuIt != response.data.end()) {
-        try {
-            info.cpuUsageTotal = std::stod(cpuIt->second);
-        } catch (const std::exception& e) {
-            info.cpuUsageTotal = 0.0;
-        }
-    } else {
-        info.cpuUsageTotal = 0.0; // Default if not found
-    }
-    
-    // Parse memory info
-    auto memTotalIt = response.data.find("memory_total");
-    if (memTotalIt != response.data.end()) {
-        try {
-            info.memoryTotal = std::stoull(memTotalIt->second);
-        } catch (const std::exception& e) {
-            info.memoryTotal = 0;
-        }
-    }
-    
-    auto memUsedIt = response.data.find("memory_used");
-    if (memUsedIt != response.data.end()) {
-        try {
-            info.memoryUsed = std::stoull(memUsedIt->second);
-        } catch (const std::exception& e) {
-            info.memoryUsed = 0;
-        }
-    }
-    
-    auto memFreeIt = response.data.find("memory_free");
-    if (memFreeIt != response.data.end()) {
-        try {
-            info.memoryFree = std::stoull(memFreeIt->second);
-        } catch (const std::exception& e) {
-            info.memoryFree = 0;
-        }
-    }
+    // The agent sends the serializer's document as the message:
+    // {"cpu_total":..,"memory_total":..,..,"cpu_cores":[..]}
+    auto it = response.data.find("data");
+    const std::string& payload = it != response.data.end() ? it->second : response.message;
+    QJsonObject root = QJsonDocument::fromJson(QByteArray::fromStdString(payload)).object();
     
-    // Parse process count
-    auto procCountIt = response.data.find("process_count");
-    if (procCountIt != response.data.end()) {
-        try {
-            info.processCount = std::stoul(procCountIt->second);
-        } catch (const std::exception& e) {
-            info.processCount = 0;
-        }
+    SystemInfo info;
+    info.cpuUsageTotal = root.value("cpu_total").toDouble();
+    info.memoryTotal = static_cast<uint64_t>(root.value("memory_total").toDouble());
+    info.memoryUsed = static_cast<uint64_t>(root.value("memory_used").toDouble());
+    info.memoryFree = static_cast<uint64_t>(root.value("memory_free").toDouble());
+    info.memoryCache = static_cast<uint64_t>(root.value("memory_cache").toDouble());
+    info.memoryBuffers = static_cast<uint64_t>(root.value("memory_buffers").toDouble());
+    info.processCount = static_cast<uint32_t>(root.value("process_count").toDouble());
+    info.threadCount = static_cast<uint32_t>(root.value("thread_count").toDouble());
+    info.contextSwitches = static_cast<uint64_t>(root.value("context_switches").toDouble());
+    info.uptime = std::chrono::seconds(static_cast<int64_t>(root.value("uptime_seconds").toDouble()));
+    for (const QJsonValue& core : root.value("cpu_cores").toArray()) {
+        info.cpuCoresUsage.push_back(core.toDouble());
     }
     
-    // Set default values for missing fields
+    // Set default values for missing fields (e.g. fallback mode, which sends no document)
     if (info.memoryTotal == 0) info.memoryTotal = 8589934592ULL; // 8GB
     if (info.memoryUsed == 0) info.memoryUsed = 4294967296ULL; // 4GB
     if (info.memoryFree == 0) info.memoryFree = info.memoryTotal - info.memoryUsed;
-    info.memoryCache = 268435456ULL; // 256MB
-    info.memoryBuffers = 134217728ULL; // 128MB
-    info.threadCount = 320;
-    info.cpuCoresUsage = {info.cpuUsageTotal, info.cpuUsageTotal, info.cpuUsageTotal, info.cpuUsageTotal};
-    info.contextSwitches = 1000000;
-    info.uptime = std::chrono::seconds(3600);
+    if (info.memoryCache == 0) info.memoryCache = 268435456ULL; // 256MB
+    if (info.memoryBuffers == 0) info.memoryBuffers = 134217728ULL; // 128MB
+    if (info.threadCount == 0) info.threadCount = 320;
+    if (info.cpuCoresUsage.empty()) {
+        info.cpuCoresUsage = {info.cpuUsageTotal, info.cpuUsageTotal, info.cpuUsageTotal, info.cpuUsageTotal};
+    }
+    if (info.contextSwitches == 0) info.contextSwitches = 1000000;
+    if (info.uptime.count() == 0) info.uptime = std::chrono::seconds(3600);
     
     currentSystemInfo_ = info;
     
@@ -189,45 +176,22 @@ void SystemMonitorTab::onProcessListResponse(const Response& response) {
         return;
     }
     
-    // Parse process list from response data
+    // Parse process list from response data: {"process_count":..,"processes":[{..}]}
     std::vector<ProcessInfo> processes;
-    
-    // Expected format: "pid,name,cpu,memory,status,parent,user;pid2,name2,..."
-    std::string processData = response.data.count("processes") ? response.data.at("processes") : "";
-    
-    if (!processData.empty()) {
-        std::istringstream processStream(processData);
-        std::string processEntry;
-        
-        while (std::getline(processStream, processEntry, ';')) {
-            if (processEntry.empty()) continue;
-            
-            std::istringstream entryStream(processEntry);
-            std::string field;
-            std::vector<std::string> fields;
-            
-            while (std::getline(entryStream, field, ',')) {
-                fields.push_back(field);
-            }
-            
-            if (fields.size() >= 7) {
-                ProcessInfo proc;
-                
-                try {
-                    proc.pid = std::stoul(fields[0]);
-                    proc.name = fields[1];
-                    proc.cpuUsage = std::stod(fields[2]);
-                    proc.memoryUsage = std::stoull(fields[3]);
-                    proc.status = fields[4];
-                    proc.parentPid = std::stoul(fields[5]);
-                    proc.user = fields[6];
-                    
-                    processes.push_back(proc);
-                } catch (const std::exception& e) {
-                    // Skip invalid process entry
-                    continue;
-                }
-            }
+    auto it = response.data.find("data");
+    if (it != response.data.end()) {
+        QJsonDocument document = QJsonDocument::fromJson(QByteArray::fromStdString(it->second));
+        for (const QJsonValue& value : document.object().value("processes").toArray()) {
+            QJsonObject object = value.toObject();
+            ProcessInfo proc;
+            proc.pid = static_cast<uint32_t>(object.value("pid").toDouble());
+            proc.name = object.value("name").toString().toStdString();
+            proc.cpuUsage = object.value("cpu_usage").toDouble();
+            proc.memoryUsage = static_cast<uint64_t>(object.value("memory_usage").toDouble());
+            proc.status = object.value("status").toString().toStdString();
+            proc.parentPid = static_cast<uint32_t>(object.value("parent_pid").toDouble());
+            proc.user = object.value("user").toString().toStdString();
+            processes.push_back(proc);
         }
     }
     
@@ -349,25 +313,10 @@ void SystemMonitorTab::setupCpuSection() {
     cpuCoresLayout_ = std::make_unique<QVBoxLayout>();
     cpuCoresWidget_->setLayout(cpuCoresLayout_.get());
     
-    // Create core progress bars - will be dynamically updated based on actual CPU cores
+    // Create core progress bars - more are added if the agent reports more cores
     int coreCount = QThread::idealThreadCount();
     if (coreCount <= 0) coreCount = 4; // Fallback to 4 cores
-    
-    for (int i = 0; i < coreCount; ++i) {
-        auto bar = std::make_unique<QProgressBar>();
-        auto label = std::make_unique<QLabel>();
-        label->setText(QString("Core %1: 0%").arg(i));
-        
-        cpuCoreBars_.push_back(std::move(bar));
-        cpuCoreLabels_.push_back(std::move(label));
-    }
-    
-    for (size_t i = 0; i < cpuCoreBars_.size(); ++i) {
-        auto layout = std::make_unique<QHBoxLayout>();
-        layout->addWidget(cpuCoreLabels_[i].get());
-        layout->addWidget(cpuCoreBars_[i].get());
-        cpuCoresLayout_->addLayout(layout.release());
-    }
+    ensureCoreBars(static_cast<size_t>(coreCount));
     
     auto totalLayout = std::make_unique<QHBoxLayout>();
     totalLayout->addWidget(cpuTotalLabel_.get());
@@ -451,12 +400,29 @@ void SystemMonitorTab::updateCpuDisplay(const SystemInfo& info) {
     cpuTotalValue_->setText(QString("%1%").arg(info.cpuUsageTotal, 0, 'f', 1));
     
     // Update CPU cores
+    ensureCoreBars(info.cpuCoresUsage.size());
     for (size_t i = 0; i < cpuCoreBars_.size() && i < info.cpuCoresUsage.size(); ++i) {
         cpuCoreBars_[i]->setValue(static_cast<int>(info.cpuCoresUsage[i]));
         cpuCoreLabels_[i]->setText(QString("Core %1: %2%").arg(i).arg(info.cpuCoresUsage[i], 0, 'f', 1));
     }
 }
 
+void SystemMonitorTab::ensureCoreBars(size_t count) {
+    for (size_t i = cpuCoreBars_.size(); i < count; ++i) {
+        auto bar = std::make_unique<QProgressBar>();
+        auto label = std::make_unique<QLabel>();
+        label->setText(QString("Core %1: 0%").arg(i));
+        
+        auto layout = std::make_unique<QHBoxLayout>();
+        layout->addWidget(label.get());
+        layout->addWidget(bar.get());
+        cpuCoresLayout_->addLayout(layout.release());
+        
+        cpuCoreBars_.push_back(std::move(bar));
+        cpuCoreLabels_.push_back(std::move(label));
+    }
+}
+
 void SystemMonitorTab::updateMemoryDisplay(const SystemInfo& info) {
     // Update memory values
     memoryTotalValue_->setText(formatBytes(info.memoryTotal));
@@ -57,6 +57,7 @@ private:
     
     // System info display
     void updateCpuDisplay(const SystemInfo& info);
+    void ensureCoreBars(size_t count);
     void updateMemoryDisplay(const SystemInfo& info);
     void updateSystemStats(const SystemInfo& info);
     void updateProcessTable(const std::vector<ProcessInfo>& processes);
@@ -116,6 +117,10 @@ private:
     // IPC client
     IpcClient* ipcClient_;
     
+    // In-flight refreshes; a new tick supersedes one still unanswered
+    CommandFuture systemInfoRequest_;
+    CommandFuture processListRequest_;
+    
     // Update timers
     std::unique_ptr<QTimer> systemInfoTimer_;
     std::unique_ptr<QTimer> processListTimer_;
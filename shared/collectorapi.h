@@ -0,0 +1,90 @@
+#ifndef SYSMON_COLLECTOR_API_H
+#define SYSMON_COLLECTOR_API_H
+
+/*
+ * SysMon collector plugin ABI
+ *
+ * A collector is a shared object exporting SYSMON_COLLECTOR_ENTRY, which
+ * returns a static sysmon_collector descriptor. The agent loads every
+ * plugin from collectors.plugin_dir, checks abi_version, calls create()
+ * once, then collect() on the agent's collector scheduler. Built-in
+ * collectors use the same descriptor, so the agent treats both alike.
+ *
+ * Rules for plugin authors:
+ *  - Only C types cross this boundary; do not throw out of any callback.
+ *  - collect() runs on the scheduler thread and must not block for long.
+ *    Declare SYSMON_COST_HIGH if a run can take more than a few ms.
+ *  - Strings passed to emit() are copied before it returns.
+ *  - New fields are only ever appended; abi_version is bumped when the
+ *    layout of an existing field changes.
+ */
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SYSMON_COLLECTOR_ABI_VERSION 1
+#define SYSMON_COLLECTOR_ENTRY "sysmon_collector_entry"
+
+#if defined(_WIN32)
+#define SYSMON_COLLECTOR_EXPORT __declspec(dllexport)
+#else
+#define SYSMON_COLLECTOR_EXPORT __attribute__((visibility("default")))
+#endif
+
+/* How expensive one collect() call is; the scheduler enforces a floor on
+ * the interval per class and runs cheaper collectors first */
+typedef enum sysmon_cost_class {
+    SYSMON_COST_LOW = 0,        /* a few syscalls, >= 100 ms interval */
+    SYSMON_COST_MEDIUM = 1,     /* file scans, >= 1 s interval */
+    SYSMON_COST_HIGH = 2        /* subprocesses or network, >= 5 s interval */
+} sysmon_cost_class;
+
+typedef enum sysmon_metric_kind {
+    SYSMON_METRIC_GAUGE = 0,    /* instantaneous value */
+    SYSMON_METRIC_COUNTER = 1   /* monotonically increasing total */
+} sysmon_metric_kind;
+
+typedef struct sysmon_metric_desc {
+    const char* name;           /* e.g. "load1"; unique within the collector */
+    const char* unit;           /* e.g. "bytes", "percent", "" */
+    const char* description;
+    int32_t kind;               /* sysmon_metric_kind */
+} sysmon_metric_desc;
+
+/* Sink handed to collect(); instance may be NULL or "" for scalar metrics */
+typedef struct sysmon_sample_sink {
+    void* context;
+    void (*emit)(void* context, const char* metric, const char* instance, double value);
+} sysmon_sample_sink;
+
+typedef struct sysmon_collector {
+    uint32_t abi_version;       /* SYSMON_COLLECTOR_ABI_VERSION */
+    const char* name;           /* unique collector name, [a-z0-9_] */
+    const char* version;
+
+    const sysmon_metric_desc* metrics;
+    uint32_t metric_count;
+
+    uint32_t interval_ms;       /* preferred interval */
+    int32_t cost_class;         /* sysmon_cost_class */
+
+    /* Returns an opaque instance, or NULL on failure. config is the value
+     * of collectors.<name>.config, or "" when unset */
+    void* (*create)(const char* config);
+
+    /* Returns 0 on success; a non-zero result counts as a failed run */
+    int (*collect)(void* instance, const sysmon_sample_sink* sink);
+
+    void (*destroy)(void* instance);
+} sysmon_collector;
+
+typedef const sysmon_collector* (*sysmon_collector_entry_fn)(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SYSMON_COLLECTOR_API_H */
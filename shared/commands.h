@@ -14,14 +14,31 @@ enum class CommandType {
     // System Monitor
     GET_SYSTEM_INFO,
     GET_PROCESS_LIST,
+    GET_PROCESS_AGGREGATES,
+    GET_EXECUTABLE_IDENTITIES,
+    GET_TOP_CONSUMERS,
+    GET_FILESYSTEM_INFO,
+    GET_POWER_INFO,
+    GET_COLLECTORS,
+    GET_COLLECTOR_METRICS,
+    GET_COLLECTOR_HISTORY,
+    GET_JOB_HEALTH,
+    GET_RUNQUEUE_LATENCY,
+    CANCEL_COMMAND,
+    SUBSCRIBE,
+    UNSUBSCRIBE,
     
     // Device Manager
     GET_USB_DEVICES,
     ENABLE_USB_DEVICE,
     DISABLE_USB_DEVICE,
+    GET_USB_POLICY,
+    ADD_USB_POLICY_RULE,
+    REMOVE_USB_POLICY_RULE,
     
     // Network Manager
     GET_NETWORK_INTERFACES,
+    GET_NETWORK_STATS,
     ENABLE_NETWORK_INTERFACE,
     DISABLE_NETWORK_INTERFACE,
     SET_STATIC_IP,
@@ -30,6 +47,8 @@ enum class CommandType {
     // Process Manager
     TERMINATE_PROCESS,
     KILL_PROCESS,
+    GET_PROCESS_DELAYS,
+    GET_TASK_EVENTS,
     
     // Android Manager
     GET_ANDROID_DEVICES,
@@ -42,6 +61,11 @@ enum class CommandType {
     ANDROID_TAKE_SCREENSHOT,
     ANDROID_GET_ORIENTATION,
     ANDROID_GET_LOGCAT,
+    ANDROID_PUSH_FILE,
+    ANDROID_PULL_FILE,
+    ANDROID_INSTALL_APK,
+    ANDROID_GET_TRANSFERS,
+    ANDROID_GET_INSTALLED_APPS,
     
     // Automation
     GET_AUTOMATION_RULES,
@@ -126,5 +150,7 @@ inline Event createEvent(Module module, const std::string& type, const std::map<
 // Utility functions for command handling
 std::string commandTypeToString(CommandType type);
 CommandType stringToCommandType(const std::string& str);
+std::string moduleToString(Module module);
+Module stringToModule(const std::string& str);
 
 } // namespace SysMon
@@ -3,6 +3,8 @@
 #include <sstream>
 #include <regex>
 #include <algorithm>
+#include <cctype>
+#include <cstdlib>
 
 namespace SysMon {
 
@@ -268,75 +270,51 @@ bool IpcProtocol::parseJson(const std::string& json, std::map<std::string, std::
         return false;
     }
     
-    // Extract key-value pairs with proper parsing
-    std::string content = json.substr(1, json.length() - 2); // Remove { }
-    
-    // Remove whitespace
-    content.erase(std::remove_if(content.begin(), content.end(), ::isspace), content.end());
-    
-    if (content.empty()) {
-        lastError_ = "Empty JSON object";
-        return false;
-    }
-    
-    // Parse key-value pairs
-    size_t pos = 0;
-    while (pos < content.length()) {
-        // Find key start
-        if (content[pos] != '"') {
-            lastError_ = "Expected key starting with quote at position " + std::to_string(pos);
+    // Extract key-value pairs; whitespace is only skipped between tokens so
+    // values (often nested JSON payloads) keep their content
+    auto skipWhitespace = [&json](size_t& pos) {
+        while (pos < json.size() && std::isspace(static_cast<unsigned char>(json[pos]))) pos++;
+    };
+    
+    size_t pos = 1;
+    size_t end = json.size() - 1; // Position of the closing }
+    skipWhitespace(pos);
+    while (pos < end) {
+        // Parse key
+        std::string key;
+        if (json[pos] != '"' || !parseJsonString(json, pos, key)) {
+            lastError_ = "Expected key string at position " + std::to_string(pos);
             return false;
         }
-        pos++;
         
-        // Find key end
-        size_t keyEnd = content.find('"', pos);
-        if (keyEnd == std::string::npos) {
-            lastError_ = "Unterminated key string";
-            return false;
-        }
-        
-        std::string key = content.substr(pos, keyEnd - pos);
-        pos = keyEnd + 1;
-        
-        // Skip whitespace and find colon
-        while (pos < content.length() && content[pos] == ' ') pos++;
-        if (pos >= content.length() || content[pos] != ':') {
+        // Find colon
+        skipWhitespace(pos);
+        if (pos >= end || json[pos] != ':') {
             lastError_ = "Expected ':' after key '" + key + "'";
             return false;
         }
         pos++;
-        
-        // Skip whitespace and find value start
-        while (pos < content.length() && content[pos] == ' ') pos++;
-        if (pos >= content.length()) {
-            lastError_ = "Expected value after ':' for key '" + key + "'";
-            return false;
-        }
+        skipWhitespace(pos);
         
         // Parse value (must be quoted string)
-        if (content[pos] != '"') {
+        std::string value;
+        if (pos >= end || json[pos] != '"') {
             lastError_ = "Value must be quoted string for key '" + key + "'";
             return false;
         }
-        pos++;
-        
-        size_t valueEnd = content.find('"', pos);
-        if (valueEnd == std::string::npos) {
+        if (!parseJsonString(json, pos, value)) {
             lastError_ = "Unterminated value string for key '" + key + "'";
             return false;
         }
         
-        std::string value = content.substr(pos, valueEnd - pos);
-        pos = valueEnd + 1;
-        
         // Store pair
         result[key] = value;
         
         // Skip comma if present
-        while (pos < content.length() && content[pos] == ' ') pos++;
-        if (pos < content.length() && content[pos] == ',') {
+        skipWhitespace(pos);
+        if (pos < end && json[pos] == ',') {
             pos++;
+            skipWhitespace(pos);
             continue;
         }
         
@@ -352,6 +330,45 @@ bool IpcProtocol::parseJson(const std::string& json, std::map<std::string, std::
     return true;
 }
 
+// Parse the quoted string starting at pos, undoing escapeJsonString();
+// pos ends just past the closing quote
+bool IpcProtocol::parseJsonString(const std::string& json, size_t& pos, std::string& value) {
+    value.clear();
+    for (size_t i = pos + 1; i < json.size(); ++i) {
+        char c = json[i];
+        if (c == '"') {
+            pos = i + 1;
+            return true;
+        }
+        if (c != '\\') {
+            value += c;
+            continue;
+        }
+        if (++i >= json.size()) {
+            return false;
+        }
+        switch (json[i]) {
+            case 'b': value += '\b'; break;
+            case 'f': value += '\f'; break;
+            case 'n': value += '\n'; break;
+            case 'r': value += '\r'; break;
+            case 't': value += '\t'; break;
+            case 'u': {
+                // Only control characters are emitted as \u escapes
+                if (i + 4 >= json.size()) {
+                    return false;
+                }
+                unsigned long code = std::strtoul(json.substr(i + 1, 4).c_str(), nullptr, 16);
+                value += code < 0x80 ? static_cast<char>(code) : '?';
+                i += 4;
+                break;
+            }
+            default: value += json[i]; break;
+        }
+    }
+    return false;
+}
+
 // Create JSON from map with proper escaping
 std::string IpcProtocol::createJson(const std::map<std::string, std::string>& data) {
     // Validate field count
@@ -473,16 +490,35 @@ std::string IpcProtocol::commandTypeToString(CommandType type) {
     switch (type) {
         case CommandType::GET_SYSTEM_INFO: return "GET_SYSTEM_INFO";
         case CommandType::GET_PROCESS_LIST: return "GET_PROCESS_LIST";
+        case CommandType::GET_PROCESS_AGGREGATES: return "GET_PROCESS_AGGREGATES";
+        case CommandType::GET_EXECUTABLE_IDENTITIES: return "GET_EXECUTABLE_IDENTITIES";
+        case CommandType::GET_TOP_CONSUMERS: return "GET_TOP_CONSUMERS";
+        case CommandType::GET_FILESYSTEM_INFO: return "GET_FILESYSTEM_INFO";
+        case CommandType::GET_POWER_INFO: return "GET_POWER_INFO";
+        case CommandType::GET_COLLECTORS: return "GET_COLLECTORS";
+        case CommandType::GET_COLLECTOR_METRICS: return "GET_COLLECTOR_METRICS";
+        case CommandType::GET_COLLECTOR_HISTORY: return "GET_COLLECTOR_HISTORY";
+        case CommandType::GET_JOB_HEALTH: return "GET_JOB_HEALTH";
+        case CommandType::GET_RUNQUEUE_LATENCY: return "GET_RUNQUEUE_LATENCY";
+        case CommandType::CANCEL_COMMAND: return "CANCEL_COMMAND";
+        case CommandType::SUBSCRIBE: return "SUBSCRIBE";
+        case CommandType::UNSUBSCRIBE: return "UNSUBSCRIBE";
         case CommandType::GET_USB_DEVICES: return "GET_USB_DEVICES";
         case CommandType::ENABLE_USB_DEVICE: return "ENABLE_USB_DEVICE";
         case CommandType::DISABLE_USB_DEVICE: return "DISABLE_USB_DEVICE";
+        case CommandType::GET_USB_POLICY: return "GET_USB_POLICY";
+        case CommandType::ADD_USB_POLICY_RULE: return "ADD_USB_POLICY_RULE";
+        case CommandType::REMOVE_USB_POLICY_RULE: return "REMOVE_USB_POLICY_RULE";
         case CommandType::GET_NETWORK_INTERFACES: return "GET_NETWORK_INTERFACES";
+        case CommandType::GET_NETWORK_STATS: return "GET_NETWORK_STATS";
         case CommandType::ENABLE_NETWORK_INTERFACE: return "ENABLE_NETWORK_INTERFACE";
         case CommandType::DISABLE_NETWORK_INTERFACE: return "DISABLE_NETWORK_INTERFACE";
         case CommandType::SET_STATIC_IP: return "SET_STATIC_IP";
         case CommandType::SET_DHCP_IP: return "SET_DHCP_IP";
         case CommandType::TERMINATE_PROCESS: return "TERMINATE_PROCESS";
         case CommandType::KILL_PROCESS: return "KILL_PROCESS";
+        case CommandType::GET_PROCESS_DELAYS: return "GET_PROCESS_DELAYS";
+        case CommandType::GET_TASK_EVENTS: return "GET_TASK_EVENTS";
         case CommandType::GET_ANDROID_DEVICES: return "GET_ANDROID_DEVICES";
         case CommandType::ANDROID_SCREEN_ON: return "ANDROID_SCREEN_ON";
         case CommandType::ANDROID_SCREEN_OFF: return "ANDROID_SCREEN_OFF";
@@ -493,6 +529,11 @@ std::string IpcProtocol::commandTypeToString(CommandType type) {
         case CommandType::ANDROID_TAKE_SCREENSHOT: return "ANDROID_TAKE_SCREENSHOT";
         case CommandType::ANDROID_GET_ORIENTATION: return "ANDROID_GET_ORIENTATION";
         case CommandType::ANDROID_GET_LOGCAT: return "ANDROID_GET_LOGCAT";
+        case CommandType::ANDROID_PUSH_FILE: return "ANDROID_PUSH_FILE";
+        case CommandType::ANDROID_PULL_FILE: return "ANDROID_PULL_FILE";
+        case CommandType::ANDROID_INSTALL_APK: return "ANDROID_INSTALL_APK";
+        case CommandType::ANDROID_GET_TRANSFERS: return "ANDROID_GET_TRANSFERS";
+        case CommandType::ANDROID_GET_INSTALLED_APPS: return "ANDROID_GET_INSTALLED_APPS";
         case CommandType::GET_AUTOMATION_RULES: return "GET_AUTOMATION_RULES";
         case CommandType::ADD_AUTOMATION_RULE: return "ADD_AUTOMATION_RULE";
         case CommandType::REMOVE_AUTOMATION_RULE: return "REMOVE_AUTOMATION_RULE";
@@ -507,16 +548,35 @@ std::string IpcProtocol::commandTypeToString(CommandType type) {
 CommandType IpcProtocol::stringToCommandType(const std::string& str) {
     if (str == "GET_SYSTEM_INFO") return CommandType::GET_SYSTEM_INFO;
     if (str == "GET_PROCESS_LIST") return CommandType::GET_PROCESS_LIST;
+    if (str == "GET_PROCESS_AGGREGATES") return CommandType::GET_PROCESS_AGGREGATES;
+    if (str == "GET_EXECUTABLE_IDENTITIES") return CommandType::GET_EXECUTABLE_IDENTITIES;
+    if (str == "GET_TOP_CONSUMERS") return CommandType::GET_TOP_CONSUMERS;
+    if (str == "GET_FILESYSTEM_INFO") return CommandType::GET_FILESYSTEM_INFO;
+    if (str == "GET_POWER_INFO") return CommandType::GET_POWER_INFO;
+    if (str == "GET_COLLECTORS") return CommandType::GET_COLLECTORS;
+    if (str == "GET_COLLECTOR_METRICS") return CommandType::GET_COLLECTOR_METRICS;
+    if (str == "GET_COLLECTOR_HISTORY") return CommandType::GET_COLLECTOR_HISTORY;
+    if (str == "GET_JOB_HEALTH") return CommandType::GET_JOB_HEALTH;
+    if (str == "GET_RUNQUEUE_LATENCY") return CommandType::GET_RUNQUEUE_LATENCY;
+    if (str == "CANCEL_COMMAND") return CommandType::CANCEL_COMMAND;
+    if (str == "SUBSCRIBE") return CommandType::SUBSCRIBE;
+    if (str == "UNSUBSCRIBE") return CommandType::UNSUBSCRIBE;
     if (str == "GET_USB_DEVICES") return CommandType::GET_USB_DEVICES;
     if (str == "ENABLE_USB_DEVICE") return CommandType::ENABLE_USB_DEVICE;
     if (str == "DISABLE_USB_DEVICE") return CommandType::DISABLE_USB_DEVICE;
+    if (str == "GET_USB_POLICY") return CommandType::GET_USB_POLICY;
+    if (str == "ADD_USB_POLICY_RULE") return CommandType::ADD_USB_POLICY_RULE;
+    if (str == "REMOVE_USB_POLICY_RULE") return CommandType::REMOVE_USB_POLICY_RULE;
     if (str == "GET_NETWORK_INTERFACES") return CommandType::GET_NETWORK_INTERFACES;
+    if (str == "GET_NETWORK_STATS") return CommandType::GET_NETWORK_STATS;
     if (str == "ENABLE_NETWORK_INTERFACE") return CommandType::ENABLE_NETWORK_INTERFACE;
     if (str == "DISABLE_NETWORK_INTERFACE") return CommandType::DISABLE_NETWORK_INTERFACE;
     if (str == "SET_STATIC_IP") return CommandType::SET_STATIC_IP;
     if (str == "SET_DHCP_IP") return CommandType::SET_DHCP_IP;
     if (str == "TERMINATE_PROCESS") return CommandType::TERMINATE_PROCESS;
     if (str == "KILL_PROCESS") return CommandType::KILL_PROCESS;
+    if (str == "GET_PROCESS_DELAYS") return CommandType::GET_PROCESS_DELAYS;
+    if (str == "GET_TASK_EVENTS") return CommandType::GET_TASK_EVENTS;
     if (str == "GET_ANDROID_DEVICES") return CommandType::GET_ANDROID_DEVICES;
     if (str == "ANDROID_SCREEN_ON") return CommandType::ANDROID_SCREEN_ON;
     if (str == "ANDROID_SCREEN_OFF") return CommandType::ANDROID_SCREEN_OFF;
@@ -527,6 +587,11 @@ CommandType IpcProtocol::stringToCommandType(const std::string& str) {
     if (str == "ANDROID_TAKE_SCREENSHOT") return CommandType::ANDROID_TAKE_SCREENSHOT;
     if (str == "ANDROID_GET_ORIENTATION") return CommandType::ANDROID_GET_ORIENTATION;
     if (str == "ANDROID_GET_LOGCAT") return CommandType::ANDROID_GET_LOGCAT;
+    if (str == "ANDROID_PUSH_FILE") return CommandType::ANDROID_PUSH_FILE;
+    if (str == "ANDROID_PULL_FILE") return CommandType::ANDROID_PULL_FILE;
+    if (str == "ANDROID_INSTALL_APK") return CommandType::ANDROID_INSTALL_APK;
+    if (str == "ANDROID_GET_TRANSFERS") return CommandType::ANDROID_GET_TRANSFERS;
+    if (str == "ANDROID_GET_INSTALLED_APPS") return CommandType::ANDROID_GET_INSTALLED_APPS;
     if (str == "GET_AUTOMATION_RULES") return CommandType::GET_AUTOMATION_RULES;
     if (str == "ADD_AUTOMATION_RULE") return CommandType::ADD_AUTOMATION_RULE;
     if (str == "REMOVE_AUTOMATION_RULE") return CommandType::REMOVE_AUTOMATION_RULE;
@@ -37,6 +37,7 @@ public:
 private:
     // JSON parsing helpers
     static bool parseJson(const std::string& json, std::map<std::string, std::string>& result);
+    static bool parseJsonString(const std::string& json, size_t& pos, std::string& value);
     static std::string createJson(const std::map<std::string, std::string>& data);
     static std::string escapeJsonString(const std::string& input);
     
@@ -2,6 +2,8 @@
 #include <iostream>
 #include <filesystem>
 #include <iomanip>
+#include <algorithm>
+#include <cstring>
 
 namespace SysMon {
 namespace Logging {
@@ -274,6 +276,114 @@ void CompositeLogger::flush() {
     }
 }
 
+// LogRing implementation
+constexpr size_t LogRing::DEFAULT_CAPACITY;
+constexpr size_t LogRing::MAX_CATEGORY_LENGTH;
+constexpr size_t LogRing::MAX_MESSAGE_LENGTH;
+
+LogRing::LogRing(size_t capacity)
+    : head_(0) {
+    // Power of two, so a sequence maps to its slot with a mask
+    size_t size = 1;
+    while (size < std::max<size_t>(capacity, 2)) {
+        size <<= 1;
+    }
+    slots_.reset(new Slot[size]);
+    mask_ = size - 1;
+    for (size_t i = 0; i < size; ++i) {
+        slots_[i].version.store(0, std::memory_order_relaxed);
+    }
+}
+
+void LogRing::push(LogLevel level, const std::string& category, const std::string& message) {
+    uint64_t sequence = head_.fetch_add(1, std::memory_order_relaxed);
+    Slot& slot = slots_[sequence & mask_];
+    
+    slot.version.store(sequence * 2 + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    
+    slot.level = level;
+    slot.timestampUs = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    slot.threadId = std::hash<std::thread::id>()(std::this_thread::get_id());
+    slot.categoryLength = static_cast<uint8_t>(std::min(category.size(), MAX_CATEGORY_LENGTH));
+    std::memcpy(slot.category, category.data(), slot.categoryLength);
+    slot.messageLength = static_cast<uint16_t>(std::min(message.size(), MAX_MESSAGE_LENGTH));
+    std::memcpy(slot.message, message.data(), slot.messageLength);
+    
+    slot.version.store(sequence * 2 + 2, std::memory_order_release);
+}
+
+uint64_t LogRing::read(uint64_t from, std::vector<LogRecord>& records, size_t maxRecords) const {
+    uint64_t head = head_.load(std::memory_order_acquire);
+    uint64_t oldest = head > mask_ + 1 ? head - (mask_ + 1) : 0;
+    uint64_t sequence = std::max(from, oldest);
+    
+    for (size_t count = 0; sequence < head && count < maxRecords; ++sequence) {
+        const Slot& slot = slots_[sequence & mask_];
+        uint64_t published = sequence * 2 + 2;
+        uint64_t before = slot.version.load(std::memory_order_acquire);
+        if (before < published) {
+            break; // Claimed but not yet published; pick it up next time
+        }
+        if (before > published) {
+            continue; // Overwritten by a newer entry
+        }
+        
+        LogRecord record;
+        record.sequence = sequence;
+        record.level = slot.level;
+        record.timestamp = std::chrono::system_clock::time_point(
+            std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                std::chrono::microseconds(slot.timestampUs)));
+        record.threadId = slot.threadId;
+        record.category.assign(slot.category, std::min<size_t>(slot.categoryLength, MAX_CATEGORY_LENGTH));
+        record.message.assign(slot.message, std::min<size_t>(slot.messageLength, MAX_MESSAGE_LENGTH));
+        
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.version.load(std::memory_order_relaxed) != before) {
+            continue; // Overwritten while copying
+        }
+        records.push_back(std::move(record));
+        ++count;
+    }
+    return sequence;
+}
+
+uint64_t LogRing::nextSequence() const {
+    return head_.load(std::memory_order_acquire);
+}
+
+size_t LogRing::capacity() const {
+    return mask_ + 1;
+}
+
+std::string levelName(LogLevel level) {
+    switch (level) {
+        case LogLevel::TRACE: return "TRACE";
+        case LogLevel::DEBUG: return "DEBUG";
+        case LogLevel::INFO: return "INFO";
+        case LogLevel::WARNING: return "WARNING";
+        case LogLevel::ERROR: return "ERROR";
+        case LogLevel::CRITICAL: return "CRITICAL";
+        default: return "UNKNOWN";
+    }
+}
+
+bool parseLevel(const std::string& name, LogLevel& level) {
+    std::string upper = name;
+    std::transform(upper.begin(), upper.end(), upper.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::toupper(c)); });
+    if (upper == "TRACE") level = LogLevel::TRACE;
+    else if (upper == "DEBUG") level = LogLevel::DEBUG;
+    else if (upper == "INFO") level = LogLevel::INFO;
+    else if (upper == "WARNING" || upper == "WARN") level = LogLevel::WARNING;
+    else if (upper == "ERROR") level = LogLevel::ERROR;
+    else if (upper == "CRITICAL") level = LogLevel::CRITICAL;
+    else return false;
+    return true;
+}
+
 // LogManager implementation
 LogManager& LogManager::getInstance() {
     static LogManager instance;
@@ -349,6 +459,7 @@ void LogManager::log(LogLevel level, const std::string& message, const std::stri
     entry.function = function;
     entry.timestamp = std::chrono::system_clock::now();
     
+    ring_.push(level, category, message);
     if (compositeLogger_) {
         compositeLogger_->log(entry);
     }
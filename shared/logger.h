@@ -11,6 +11,7 @@
 #include <thread>
 #include <atomic>
 #include <condition_variable>
+#include <vector>
 
 namespace SysMon {
 namespace Logging {
@@ -125,6 +126,66 @@ private:
     mutable std::mutex mutex_;
 };
 
+// One entry as kept by LogRing
+struct LogRecord {
+    uint64_t sequence;
+    LogLevel level;
+    std::string category;
+    std::string message;
+    std::chrono::system_clock::time_point timestamp;
+    size_t threadId;
+    
+    LogRecord() : sequence(0), level(LogLevel::INFO), threadId(0) {}
+};
+
+// Log Ring - the most recent entries in memory, for live tails
+//
+// Entries are stored as fields, not formatted text, in fixed-size slots.
+// A writer claims a slot with one fetch_add and publishes it through the
+// slot's version counter (a seqlock), so logging never blocks on readers
+// and costs the same whether anyone is reading or not. Readers copy a slot
+// and discard it if the version moved while they copied. Text longer than
+// a slot is truncated.
+class LogRing {
+public:
+    explicit LogRing(size_t capacity = DEFAULT_CAPACITY);
+    
+    void push(LogLevel level, const std::string& category, const std::string& message);
+    
+    // Appends up to maxRecords entries starting at sequence from, oldest
+    // first, and returns the sequence to continue from. Entries already
+    // overwritten are skipped; reading stops at one still being written.
+    uint64_t read(uint64_t from, std::vector<LogRecord>& records, size_t maxRecords) const;
+    
+    // Sequence the next entry will get
+    uint64_t nextSequence() const;
+    size_t capacity() const;
+    
+    // Constants
+    static constexpr size_t DEFAULT_CAPACITY = 2048;
+    static constexpr size_t MAX_CATEGORY_LENGTH = 31;
+    static constexpr size_t MAX_MESSAGE_LENGTH = 471;
+    
+private:
+    struct Slot {
+        std::atomic<uint64_t> version;  // 2*seq+1 while writing, 2*seq+2 once published
+        LogLevel level;
+        int64_t timestampUs;
+        size_t threadId;
+        uint16_t messageLength;
+        uint8_t categoryLength;
+        char category[MAX_CATEGORY_LENGTH];
+        char message[MAX_MESSAGE_LENGTH];
+    };
+    
+    std::unique_ptr<Slot[]> slots_;
+    size_t mask_;
+    std::atomic<uint64_t> head_;
+};
+
+std::string levelName(LogLevel level);
+bool parseLevel(const std::string& name, LogLevel& level);
+
 // Main logging manager
 class LogManager {
 public:
@@ -154,6 +215,9 @@ public:
     // Get current log level
     LogLevel getLogLevel() const { return currentLevel_; }
     
+    // Recent entries that passed the log level, from every logger
+    LogRing& getRing() { return ring_; }
+    
 private:
     LogManager() = default;
     ~LogManager() = default;
@@ -161,6 +225,7 @@ private:
     LogManager& operator=(const LogManager&) = delete;
     
     std::unique_ptr<CompositeLogger> compositeLogger_;
+    LogRing ring_;
     LogLevel currentLevel_;
     mutable std::mutex mutex_;
     bool initialized_;
@@ -0,0 +1,585 @@
+#include "procparsers.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define SYSMON_SWAR_DIGITS 1
+#endif
+
+namespace SysMon {
+namespace ProcParsers {
+
+namespace {
+
+constexpr size_t READ_CHUNK = 4096;
+constexpr size_t VECTOR_WIDTH = 16;
+
+bool isSpace(char c) {
+    return c == ' ' || c == '\t';
+}
+
+#if defined(__ARM_NEON)
+// One nibble per byte of a comparison result: NEON has no movemask
+uint64_t nibbleMask(uint8x16_t matches) {
+    uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(matches), 4);
+    return vget_lane_u64(vreinterpret_u64_u8(narrowed), 0);
+}
+#endif
+
+#ifdef SYSMON_SWAR_DIGITS
+// Eight ASCII digits at once, most significant first
+uint64_t parseEightDigits(const char* digits) {
+    uint64_t chunk;
+    std::memcpy(&chunk, digits, sizeof(chunk));
+    chunk -= 0x3030303030303030ULL;
+    chunk = (chunk * 10 + (chunk >> 8)) & 0x00FF00FF00FF00FFULL;
+    chunk = (chunk * 100 + (chunk >> 16)) & 0x0000FFFF0000FFFFULL;
+    chunk = (chunk * 10000 + (chunk >> 32)) & 0x00000000FFFFFFFFULL;
+    return chunk;
+}
+#endif
+
+// Reads to EOF into buffer's existing storage; procfs files report a size
+// of 0, so the size is only known at the end
+bool readDescriptor(int fd, std::string& buffer, bool positional) {
+#ifdef _WIN32
+    (void)fd;
+    (void)positional;
+    buffer.clear();
+    return false;
+#else
+    size_t used = 0;
+    buffer.resize(std::max(buffer.capacity(), READ_CHUNK));
+    while (true) {
+        if (used == buffer.size()) {
+            buffer.resize(buffer.size() * 2);
+        }
+        ssize_t bytesRead = positional
+            ? pread(fd, &buffer[used], buffer.size() - used, static_cast<off_t>(used))
+            : read(fd, &buffer[used], buffer.size() - used);
+        if (bytesRead < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            buffer.clear();
+            return false;
+        }
+        if (bytesRead == 0) {
+            break;
+        }
+        used += static_cast<size_t>(bytesRead);
+    }
+    buffer.resize(used);
+    return used > 0;
+#endif
+}
+
+void skipSpaces(std::string_view& text) {
+    size_t count = 0;
+    while (count < text.size() && isSpace(text[count])) {
+        ++count;
+    }
+    text.remove_prefix(count);
+}
+
+bool startsWith(std::string_view text, std::string_view prefix) {
+    return text.size() >= prefix.size() && text.compare(0, prefix.size(), prefix) == 0;
+}
+
+int hexValue(char c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+// "cpu  1 2 3 ..." - fields missing on old kernels stay zero
+void parseCpuFields(std::string_view fields, CpuTimes& times) {
+    uint64_t* slots[] = {&times.user, &times.nice, &times.system, &times.idle,
+                         &times.iowait, &times.irq, &times.softirq, &times.steal};
+    for (uint64_t* slot : slots) {
+        if (!parseUnsigned(fields, *slot)) {
+            break;
+        }
+    }
+}
+
+} // anonymous namespace
+
+bool readFile(const char* path, std::string& buffer) {
+#ifdef _WIN32
+    (void)path;
+    buffer.clear();
+    return false;
+#else
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        buffer.clear();
+        return false;
+    }
+    bool ok = readDescriptor(fd, buffer, false);
+    close(fd);
+    return ok;
+#endif
+}
+
+bool readFile(const std::string& path, std::string& buffer) {
+    return readFile(path.c_str(), buffer);
+}
+
+bool readFile(int fd, std::string& buffer) {
+    if (fd < 0) {
+        buffer.clear();
+        return false;
+    }
+    return readDescriptor(fd, buffer, true);
+}
+
+bool readAttribute(const std::string& path, std::string& value) {
+    if (!readFile(path, value)) {
+        return false;
+    }
+
+    std::string_view content(value);
+    std::string_view line;
+    nextLine(content, line);
+    std::string_view trimmed = trim(line);
+    value.erase(0, static_cast<size_t>(trimmed.data() - value.data()));
+    value.resize(trimmed.size());
+    return true;
+}
+
+size_t findByte(std::string_view text, char byte) {
+    const char* data = text.data();
+    size_t size = text.size();
+    size_t i = 0;
+
+#if defined(__SSE2__)
+    const __m128i needle = _mm_set1_epi8(byte);
+    for (; i + VECTOR_WIDTH <= size; i += VECTOR_WIDTH) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle));
+        if (mask != 0) {
+            return i + static_cast<size_t>(__builtin_ctz(static_cast<unsigned>(mask)));
+        }
+    }
+#elif defined(__ARM_NEON)
+    const uint8x16_t needle = vdupq_n_u8(static_cast<uint8_t>(byte));
+    for (; i + VECTOR_WIDTH <= size; i += VECTOR_WIDTH) {
+        uint8x16_t chunk = vld1q_u8(reinterpret_cast<const uint8_t*>(data + i));
+        uint64_t mask = nibbleMask(vceqq_u8(chunk, needle));
+        if (mask != 0) {
+            return i + static_cast<size_t>(__builtin_ctzll(mask) >> 2);
+        }
+    }
+#endif
+
+    for (; i < size; ++i) {
+        if (data[i] == byte) {
+            return i;
+        }
+    }
+    return std::string_view::npos;
+}
+
+size_t digitRun(std::string_view text) {
+    const char* data = text.data();
+    size_t size = text.size();
+    size_t i = 0;
+
+    // Counters are rarely 16 digits long, so the vector loop usually runs
+    // once and answers from the first non-digit lane
+#if defined(__SSE2__)
+    const __m128i zero = _mm_set1_epi8('0');
+    const __m128i nine = _mm_set1_epi8(9);
+    for (; i + VECTOR_WIDTH <= size; i += VECTOR_WIDTH) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i offset = _mm_sub_epi8(chunk, zero);
+        __m128i isDigit = _mm_cmpeq_epi8(_mm_max_epu8(offset, nine), nine);
+        unsigned mask = ~static_cast<unsigned>(_mm_movemask_epi8(isDigit)) & 0xFFFFu;
+        if (mask != 0) {
+            return i + static_cast<size_t>(__builtin_ctz(mask));
+        }
+    }
+#elif defined(__ARM_NEON)
+    const uint8x16_t zero = vdupq_n_u8('0');
+    const uint8x16_t nine = vdupq_n_u8(9);
+    for (; i + VECTOR_WIDTH <= size; i += VECTOR_WIDTH) {
+        uint8x16_t chunk = vld1q_u8(reinterpret_cast<const uint8_t*>(data + i));
+        uint8x16_t notDigit = vmvnq_u8(vcleq_u8(vsubq_u8(chunk, zero), nine));
+        uint64_t mask = nibbleMask(notDigit);
+        if (mask != 0) {
+            return i + static_cast<size_t>(__builtin_ctzll(mask) >> 2);
+        }
+    }
+#endif
+
+    while (i < size && data[i] >= '0' && data[i] <= '9') {
+        ++i;
+    }
+    return i;
+}
+
+bool nextLine(std::string_view& text, std::string_view& line) {
+    if (text.empty()) {
+        return false;
+    }
+
+    size_t end = findByte(text, '\n');
+    if (end == std::string_view::npos) {
+        line = text;
+        text = std::string_view();
+    } else {
+        line = text.substr(0, end);
+        text.remove_prefix(end + 1);
+    }
+    return true;
+}
+
+bool nextField(std::string_view& text, std::string_view& field) {
+    skipSpaces(text);
+    if (text.empty()) {
+        return false;
+    }
+
+    size_t end = 0;
+    while (end < text.size() && !isSpace(text[end])) {
+        ++end;
+    }
+    field = text.substr(0, end);
+    text.remove_prefix(end);
+    return true;
+}
+
+bool skipFields(std::string_view& text, size_t count) {
+    std::string_view field;
+    for (size_t i = 0; i < count; ++i) {
+        if (!nextField(text, field)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool consumePrefix(std::string_view& text, std::string_view prefix) {
+    if (!startsWith(text, prefix)) {
+        return false;
+    }
+    text.remove_prefix(prefix.size());
+    return true;
+}
+
+std::string_view trim(std::string_view text) {
+    size_t start = 0;
+    size_t end = text.size();
+    while (start < end && (isSpace(text[start]) || text[start] == '\r' || text[start] == '\n')) {
+        ++start;
+    }
+    while (end > start && (isSpace(text[end - 1]) || text[end - 1] == '\r' || text[end - 1] == '\n')) {
+        --end;
+    }
+    return text.substr(start, end - start);
+}
+
+bool parseUnsigned(std::string_view& text, uint64_t& value) {
+    skipSpaces(text);
+
+    size_t count = digitRun(text);
+    if (count == 0) {
+        return false;
+    }
+
+    const char* digits = text.data();
+    uint64_t result = 0;
+    size_t i = 0;
+#ifdef SYSMON_SWAR_DIGITS
+    for (; i + 8 <= count; i += 8) {
+        result = result * 100000000ULL + parseEightDigits(digits + i);
+    }
+#endif
+    for (; i < count; ++i) {
+        result = result * 10 + static_cast<uint64_t>(digits[i] - '0');
+    }
+
+    text.remove_prefix(count);
+    value = result;
+    return true;
+}
+
+bool parseSigned(std::string_view& text, int64_t& value) {
+    skipSpaces(text);
+
+    bool negative = !text.empty() && text[0] == '-';
+    std::string_view digits = negative ? text.substr(1) : text;
+    uint64_t magnitude = 0;
+    if (!parseUnsigned(digits, magnitude)) {
+        return false;
+    }
+
+    text = digits;
+    value = negative ? -static_cast<int64_t>(magnitude) : static_cast<int64_t>(magnitude);
+    return true;
+}
+
+bool parseDecimal(std::string_view& text, double& value) {
+    static const double POWERS_OF_TEN[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9,
+        1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19
+    };
+
+    skipSpaces(text);
+    std::string_view rest = text;
+    bool negative = consumePrefix(rest, "-");
+
+    // Past 19 digits the integer part no longer fits in 64 bits
+    double whole = 0.0;
+    size_t wholeDigits = digitRun(rest);
+    if (wholeDigits > 0 && wholeDigits <= 19) {
+        uint64_t integer = 0;
+        parseUnsigned(rest, integer);
+        whole = static_cast<double>(integer);
+    } else if (wholeDigits > 0) {
+        for (size_t i = 0; i < wholeDigits; ++i) {
+            whole = whole * 10.0 + (rest[i] - '0');
+        }
+        rest.remove_prefix(wholeDigits);
+    }
+
+    double fraction = 0.0;
+    size_t fractionDigits = 0;
+    if (consumePrefix(rest, ".")) {
+        fractionDigits = digitRun(rest);
+        // Digits past the 19th cannot change a double
+        size_t used = std::min<size_t>(fractionDigits, 19);
+        uint64_t scaled = 0;
+        for (size_t i = 0; i < used; ++i) {
+            scaled = scaled * 10 + static_cast<uint64_t>(rest[i] - '0');
+        }
+        fraction = static_cast<double>(scaled) / POWERS_OF_TEN[used];
+        rest.remove_prefix(fractionDigits);
+    }
+
+    if (wholeDigits == 0 && fractionDigits == 0) {
+        return false;
+    }
+
+    double result = whole + fraction;
+    value = negative ? -result : result;
+    text = rest;
+    return true;
+}
+
+bool parseHex(std::string_view& text, uint64_t& value) {
+    skipSpaces(text);
+
+    size_t count = 0;
+    uint64_t result = 0;
+    int digit;
+    while (count < text.size() && (digit = hexValue(text[count])) >= 0) {
+        result = (result << 4) | static_cast<uint64_t>(digit);
+        ++count;
+    }
+    if (count == 0) {
+        return false;
+    }
+
+    text.remove_prefix(count);
+    value = result;
+    return true;
+}
+
+bool splitKeyValue(std::string_view line, std::string_view& key, std::string_view& value) {
+    size_t colon = findByte(line, ':');
+    if (colon == std::string_view::npos) {
+        return false;
+    }
+    key = trim(line.substr(0, colon));
+    value = trim(line.substr(colon + 1));
+    return !key.empty();
+}
+
+bool parseKilobytes(std::string_view value, uint64_t& bytes) {
+    uint64_t number = 0;
+    if (!parseUnsigned(value, number)) {
+        return false;
+    }
+
+    value = trim(value);
+    if (value.empty()) {
+        bytes = number;
+        return true;
+    }
+    if (value == "kB") {
+        bytes = number * 1024;
+        return true;
+    }
+    return false;
+}
+
+bool nextHeaderValuePair(std::string_view& text, std::string_view& header, std::string_view& values) {
+    std::string_view rest = text;
+    if (!nextLine(rest, header) || !nextLine(rest, values)) {
+        return false;
+    }
+    text = rest;
+    return true;
+}
+
+bool splitSection(std::string_view line, std::string_view& section, std::string_view& fields) {
+    size_t colon = findByte(line, ':');
+    if (colon == std::string_view::npos) {
+        return false;
+    }
+    section = line.substr(0, colon);
+    fields = line.substr(colon + 1);
+    return true;
+}
+
+bool parseCpuStat(std::string_view text, CpuTimes& total, std::vector<CpuTimes>* cores) {
+    bool found = false;
+    if (cores) {
+        cores->clear();
+    }
+
+    std::string_view line;
+    while (nextLine(text, line)) {
+        if (!startsWith(line, "cpu")) {
+            // The cpu lines come first; the rest of the file is not needed
+            if (found) {
+                break;
+            }
+            continue;
+        }
+
+        line.remove_prefix(3);
+        if (!line.empty() && line[0] == ' ') {
+            parseCpuFields(line, total);
+            found = true;
+        } else if (cores) {
+            uint64_t index = 0;
+            if (parseUnsigned(line, index)) {
+                cores->emplace_back();
+                parseCpuFields(line, cores->back());
+            }
+        }
+    }
+    return found;
+}
+
+bool parseMemInfo(std::string_view text, MemInfo& info) {
+    struct Field {
+        std::string_view label;
+        uint64_t* target;
+    };
+    const Field fields[] = {
+        {"MemTotal", &info.totalBytes},
+        {"MemFree", &info.freeBytes},
+        {"MemAvailable", &info.availableBytes},
+        {"Buffers", &info.buffersBytes},
+        {"Cached", &info.cachedBytes},
+        {"SwapTotal", &info.swapTotalBytes},
+        {"SwapFree", &info.swapFreeBytes},
+    };
+
+    bool haveAvailable = false;
+    size_t remaining = sizeof(fields) / sizeof(fields[0]);
+    std::string_view line, key, value;
+    while (remaining > 0 && nextLine(text, line)) {
+        if (!splitKeyValue(line, key, value)) {
+            continue;
+        }
+        for (const auto& field : fields) {
+            if (key != field.label) {
+                continue;
+            }
+            if (parseKilobytes(value, *field.target)) {
+                haveAvailable = haveAvailable || field.target == &info.availableBytes;
+                --remaining;
+            }
+            break;
+        }
+    }
+
+    // Kernels before 3.14 have no MemAvailable
+    if (!haveAvailable) {
+        info.availableBytes = info.freeBytes + info.buffersBytes + info.cachedBytes;
+    }
+    return info.totalBytes > 0;
+}
+
+bool parseProcessStat(std::string_view line, ProcessStat& stat) {
+    uint64_t pid = 0;
+    if (!parseUnsigned(line, pid)) {
+        return false;
+    }
+
+    // The command name may contain spaces and parentheses; fields resume
+    // after the last ')'
+    size_t open = line.find('(');
+    size_t close = line.rfind(')');
+    if (open == std::string_view::npos || close == std::string_view::npos || close < open) {
+        return false;
+    }
+    stat.pid = static_cast<uint32_t>(pid);
+    stat.name = line.substr(open + 1, close - open - 1);
+
+    std::string_view fields = line.substr(close + 1);
+    skipSpaces(fields);
+    if (fields.empty()) {
+        return false;
+    }
+    stat.state = fields[0];
+    fields.remove_prefix(1);
+
+    // Field 4 (ppid) onwards; only a few are kept
+    for (int index = 1; index <= 21; ++index) {
+        int64_t value = 0;
+        if (!parseSigned(fields, value)) {
+            return index > 1;
+        }
+        uint64_t unsignedValue = value < 0 ? 0 : static_cast<uint64_t>(value);
+        switch (index) {
+            case 1: stat.parentPid = static_cast<uint32_t>(unsignedValue); break;
+            case 11: stat.utime = unsignedValue; break;
+            case 12: stat.stime = unsignedValue; break;
+            case 19: stat.startTime = unsignedValue; break;
+            case 21: stat.rssPages = unsignedValue; break;
+            default: break;
+        }
+    }
+    return true;
+}
+
+double cpuUsagePercent(const CpuTimes& previous, const CpuTimes& current) {
+    uint64_t total = current.total();
+    uint64_t previousTotal = previous.total();
+    if (total <= previousTotal) {
+        return 0.0;
+    }
+
+    uint64_t idle = current.idleTotal() > previous.idleTotal() ? current.idleTotal() - previous.idleTotal() : 0;
+    double totalDiff = static_cast<double>(total - previousTotal);
+    double usage = 100.0 * (1.0 - static_cast<double>(idle) / totalDiff);
+    return usage < 0.0 ? 0.0 : (usage > 100.0 ? 100.0 : usage);
+}
+
+} // namespace ProcParsers
+} // namespace SysMon
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace SysMon {
+
+// procfs and sysfs parsers shared by every collector and Android device telemetry
+//
+// Every parser works on a view of text that is already in memory (a pread
+// buffer or one section of adb shell output) and never copies it; string
+// results are views into the input and are only valid while it is. The
+// tokenizer underneath covers the three shapes procfs uses - whitespace
+// separated numeric rows, "Key: value kB" lines and header/value line pairs
+// - and allocates nothing. Newline search and digit scanning use SSE2 or
+// NEON when the compiler targets them, and plain loops otherwise.
+namespace ProcParsers {
+
+// Cumulative clock ticks from one "cpu" line of /proc/stat
+struct CpuTimes {
+    uint64_t user = 0;
+    uint64_t nice = 0;
+    uint64_t system = 0;
+    uint64_t idle = 0;
+    uint64_t iowait = 0;
+    uint64_t irq = 0;
+    uint64_t softirq = 0;
+    uint64_t steal = 0;
+
+    uint64_t idleTotal() const { return idle + iowait; }
+    uint64_t total() const { return user + nice + system + idle + iowait + irq + softirq + steal; }
+};
+
+// /proc/meminfo, converted to bytes
+struct MemInfo {
+    uint64_t totalBytes = 0;
+    uint64_t freeBytes = 0;
+    uint64_t availableBytes = 0;
+    uint64_t buffersBytes = 0;
+    uint64_t cachedBytes = 0;
+    uint64_t swapTotalBytes = 0;
+    uint64_t swapFreeBytes = 0;
+};
+
+// One /proc/<pid>/stat line
+struct ProcessStat {
+    uint32_t pid = 0;
+    std::string_view name;      // without the parentheses
+    char state = '?';
+    uint32_t parentPid = 0;
+    uint64_t utime = 0;         // clock ticks
+    uint64_t stime = 0;
+    uint64_t startTime = 0;     // clock ticks after boot
+    uint64_t rssPages = 0;
+};
+
+// File reading; buffer keeps its capacity between calls, so a collector
+// that reuses one buffer stops allocating after its first sample
+bool readFile(const char* path, std::string& buffer);
+bool readFile(const std::string& path, std::string& buffer);
+bool readFile(int fd, std::string& buffer);         // pread from offset 0, for kept-open files
+// One-value sysfs attribute without the trailing newline
+bool readAttribute(const std::string& path, std::string& value);
+
+// Position of the first byte in text, or npos
+size_t findByte(std::string_view text, char byte);
+// Number of leading ASCII digits
+size_t digitRun(std::string_view text);
+
+// Splits off the next line (without '\n'); false once text is exhausted
+bool nextLine(std::string_view& text, std::string_view& line);
+// Splits off the next space- or tab-separated field
+bool nextField(std::string_view& text, std::string_view& field);
+bool skipFields(std::string_view& text, size_t count);
+// Removes text's prefix if it has it
+bool consumePrefix(std::string_view& text, std::string_view prefix);
+std::string_view trim(std::string_view text);
+
+// Skips spaces, then consumes a decimal number from the front of text
+bool parseUnsigned(std::string_view& text, uint64_t& value);
+bool parseSigned(std::string_view& text, int64_t& value);
+// Fixed-point decimal ("12.34", "-0.5"), as printed by the kernel; no exponent
+bool parseDecimal(std::string_view& text, double& value);
+// Hexadecimal without a prefix (sysfs ids, /proc/net addresses)
+bool parseHex(std::string_view& text, uint64_t& value);
+
+// "Key: value" and "Key:\tvalue kB" lines; value is trimmed and keeps its unit
+bool splitKeyValue(std::string_view line, std::string_view& key, std::string_view& value);
+// A "value" or "value kB" field, in bytes
+bool parseKilobytes(std::string_view value, uint64_t& bytes);
+
+// /proc/net/snmp style pairs of "Section: Name1 Name2 ..." and
+// "Section: 1 2 ..." lines; both lines keep their section prefix
+bool nextHeaderValuePair(std::string_view& text, std::string_view& header, std::string_view& values);
+// Part before the ':' of a header or value line, and the rest after it
+bool splitSection(std::string_view line, std::string_view& section, std::string_view& fields);
+
+// "cpu" is the aggregate line; cores, if given, receives "cpuN" lines in order
+bool parseCpuStat(std::string_view text, CpuTimes& total, std::vector<CpuTimes>* cores = nullptr);
+bool parseMemInfo(std::string_view text, MemInfo& info);
+bool parseProcessStat(std::string_view line, ProcessStat& stat);
+
+// Busy share of the ticks between two samples, 0..100
+double cpuUsagePercent(const CpuTimes& previous, const CpuTimes& current);
+
+} // namespace ProcParsers
+
+} // namespace SysMon
@@ -9,6 +9,7 @@
 #ifndef SYSMON_NO_OPENSSL
 #include <openssl/rand.h>
 #include <openssl/sha.h>
+#include <openssl/evp.h>
 #endif
 
 namespace SysMon {
@@ -205,6 +206,64 @@ bool SecurityManager::isValidTokenFormat(const std::string& token) {
            });
 }
 
+// Sha256 implementation
+Sha256::Sha256()
+    : context_(nullptr) {
+#ifndef SYSMON_NO_OPENSSL
+    EVP_MD_CTX* context = EVP_MD_CTX_new();
+    if (context && EVP_DigestInit_ex(context, EVP_sha256(), nullptr) != 1) {
+        EVP_MD_CTX_free(context);
+        context = nullptr;
+    }
+    context_ = context;
+#endif
+}
+
+Sha256::~Sha256() {
+#ifndef SYSMON_NO_OPENSSL
+    EVP_MD_CTX_free(static_cast<EVP_MD_CTX*>(context_));
+#endif
+}
+
+void Sha256::update(const void* data, size_t size) {
+#ifndef SYSMON_NO_OPENSSL
+    if (context_) {
+        EVP_DigestUpdate(static_cast<EVP_MD_CTX*>(context_), data, size);
+    }
+#else
+    (void)data;
+    (void)size;
+#endif
+}
+
+std::string Sha256::finish() {
+#ifndef SYSMON_NO_OPENSSL
+    unsigned char digest[EVP_MAX_MD_SIZE];
+    unsigned int length = 0;
+    if (!context_ || EVP_DigestFinal_ex(static_cast<EVP_MD_CTX*>(context_), digest, &length) != 1) {
+        return "";
+    }
+    
+    static const char hex[] = "0123456789abcdef";
+    std::string result(length * 2, '0');
+    for (unsigned int i = 0; i < length; ++i) {
+        result[i * 2] = hex[digest[i] >> 4];
+        result[i * 2 + 1] = hex[digest[i] & 0x0f];
+    }
+    return result;
+#else
+    return "";
+#endif
+}
+
+bool Sha256::isAvailable() {
+#ifndef SYSMON_NO_OPENSSL
+    return true;
+#else
+    return false;
+#endif
+}
+
 // Validation utilities implementation
 namespace Validation {
 
@@ -270,13 +329,14 @@ bool sanitizeString(std::string& str) {
 
 bool isValidCommandType(const std::string& type) {
     static const std::vector<std::string> validTypes = {
-        "GET_SYSTEM_INFO", "GET_PROCESS_LIST", "GET_USB_DEVICES",
-        "ENABLE_USB_DEVICE", "DISABLE_USB_DEVICE", "GET_NETWORK_INTERFACES",
+        "GET_SYSTEM_INFO", "GET_PROCESS_LIST", "GET_PROCESS_AGGREGATES", "GET_EXECUTABLE_IDENTITIES", "GET_TOP_CONSUMERS", "GET_FILESYSTEM_INFO", "GET_POWER_INFO", "GET_COLLECTORS", "GET_COLLECTOR_METRICS", "GET_COLLECTOR_HISTORY", "GET_JOB_HEALTH", "GET_RUNQUEUE_LATENCY", "CANCEL_COMMAND", "SUBSCRIBE", "UNSUBSCRIBE", "GET_USB_DEVICES",
+        "ENABLE_USB_DEVICE", "DISABLE_USB_DEVICE", "GET_USB_POLICY", "ADD_USB_POLICY_RULE", "REMOVE_USB_POLICY_RULE", "GET_NETWORK_INTERFACES", "GET_NETWORK_STATS",
         "ENABLE_NETWORK_INTERFACE", "DISABLE_NETWORK_INTERFACE", "SET_STATIC_IP",
-        "SET_DHCP_IP", "TERMINATE_PROCESS", "KILL_PROCESS", "GET_ANDROID_DEVICES",
+        "SET_DHCP_IP", "TERMINATE_PROCESS", "KILL_PROCESS", "GET_PROCESS_DELAYS", "GET_TASK_EVENTS", "GET_ANDROID_DEVICES",
         "ANDROID_SCREEN_ON", "ANDROID_SCREEN_OFF", "ANDROID_LOCK_DEVICE",
         "ANDROID_GET_FOREGROUND_APP", "ANDROID_LAUNCH_APP", "ANDROID_STOP_APP",
         "ANDROID_TAKE_SCREENSHOT", "ANDROID_GET_ORIENTATION", "ANDROID_GET_LOGCAT",
+        "ANDROID_PUSH_FILE", "ANDROID_PULL_FILE", "ANDROID_INSTALL_APK", "ANDROID_GET_TRANSFERS", "ANDROID_GET_INSTALLED_APPS",
         "GET_AUTOMATION_RULES", "ADD_AUTOMATION_RULE", "REMOVE_AUTOMATION_RULE",
         "ENABLE_AUTOMATION_RULE", "DISABLE_AUTOMATION_RULE", "PING", "SHUTDOWN"
     };
@@ -77,6 +77,24 @@ private:
     bool isValidTokenFormat(const std::string& token);
 };
 
+// Incremental SHA-256 for file identities; finish() returns lowercase hex,
+// or an empty string when built without OpenSSL (SYSMON_NO_OPENSSL)
+class Sha256 {
+public:
+    Sha256();
+    ~Sha256();
+    Sha256(const Sha256&) = delete;
+    Sha256& operator=(const Sha256&) = delete;
+    
+    void update(const void* data, size_t size);
+    std::string finish();
+    
+    static bool isAvailable();
+    
+private:
+    void* context_;
+};
+
 // Input validation utilities
 namespace Validation {
     bool isValidJson(const std::string& json);
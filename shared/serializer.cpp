@@ -6,114 +6,528 @@
 namespace SysMon {
 namespace Serialization {
 
+// FieldMask implementation
+FieldMask::FieldMask(const std::string& fields) {
+    std::stringstream stream(fields);
+    std::string field;
+    while (std::getline(stream, field, ',')) {
+        field.erase(0, field.find_first_not_of(" \t"));
+        field.erase(field.find_last_not_of(" \t") + 1);
+        if (!field.empty()) {
+            fields_.push_back(field);
+        }
+    }
+}
+
+bool FieldMask::isEmpty() const {
+    return fields_.empty();
+}
+
+bool FieldMask::includes(const std::string& field) const {
+    return fields_.empty() || std::find(fields_.begin(), fields_.end(), field) != fields_.end();
+}
+
 // Serializer implementation
 Serializer& Serializer::getInstance() {
     static Serializer instance;
     return instance;
 }
 
-std::string Serializer::serializeSystemInfo(const SystemInfo& info) {
+std::string Serializer::serializeSystemInfo(const SystemInfo& info, const FieldMask& fields) {
     if (!validateSystemInfo(info)) {
         return "{}";
     }
     
     StringBuilder builder(512);
-    builder.append("{");
+    RowWriter row(builder, fields);
+    row.begin();
     
-    builder.escapeAndAppend("\"cpu_total\":").append(info.cpuUsageTotal).append(",");
-    builder.escapeAndAppend("\"memory_total\":").append(info.memoryTotal).append(",");
-    builder.escapeAndAppend("\"memory_used\":").append(info.memoryUsed).append(",");
-    builder.escapeAndAppend("\"memory_free\":").append(info.memoryFree).append(",");
-    builder.escapeAndAppend("\"memory_cache\":").append(info.memoryCache).append(",");
-    builder.escapeAndAppend("\"memory_buffers\":").append(info.memoryBuffers).append(",");
-    builder.escapeAndAppend("\"process_count\":").append(info.processCount).append(",");
-    builder.escapeAndAppend("\"thread_count\":").append(info.threadCount).append(",");
-    builder.escapeAndAppend("\"context_switches\":").append(info.contextSwitches).append(",");
-    builder.escapeAndAppend("\"uptime_seconds\":").append(static_cast<uint64_t>(info.uptime.count())).append(",");
+    if (row.field("cpu_total")) builder.append(info.cpuUsageTotal);
+    if (row.field("memory_total")) builder.append(info.memoryTotal);
+    if (row.field("memory_used")) builder.append(info.memoryUsed);
+    if (row.field("memory_free")) builder.append(info.memoryFree);
+    if (row.field("memory_cache")) builder.append(info.memoryCache);
+    if (row.field("memory_buffers")) builder.append(info.memoryBuffers);
+    if (row.field("process_count")) builder.append(info.processCount);
+    if (row.field("thread_count")) builder.append(info.threadCount);
+    if (row.field("context_switches")) builder.append(info.contextSwitches);
+    if (row.field("uptime_seconds")) builder.append(static_cast<uint64_t>(info.uptime.count()));
     
     // CPU cores usage
-    builder.escapeAndAppend("\"cpu_cores\":[");
-    for (size_t i = 0; i < info.cpuCoresUsage.size(); ++i) {
-        if (i > 0) builder.append(",");
-        builder.append(info.cpuCoresUsage[i]);
+    if (row.field("cpu_cores")) {
+        builder.append("[");
+        for (size_t i = 0; i < info.cpuCoresUsage.size(); ++i) {
+            if (i > 0) builder.append(",");
+            builder.append(info.cpuCoresUsage[i]);
+        }
+        builder.append("]");
     }
-    builder.append("]}");
+    row.end();
     
     return builder.toString();
 }
 
-std::string Serializer::serializeProcessList(const std::vector<ProcessInfo>& processes) {
+std::string Serializer::serializeProcessList(const std::vector<ProcessInfo>& processes, const FieldMask& fields) {
     StringBuilder builder(4096);
     builder.append("{");
-    builder.escapeAndAppend("\"process_count\":").append(processes.size()).append(",");
-    builder.escapeAndAppend("\"processes\":[");
+    builder.append("\"process_count\":").append(processes.size()).append(",");
+    builder.append("\"processes\":[");
     
+    RowWriter row(builder, fields);
+    bool first = true;
     const size_t maxProcesses = std::min(processes.size(), static_cast<size_t>(100)); // Limit to 100
     for (size_t i = 0; i < maxProcesses; ++i) {
         const auto& proc = processes[i];
         if (!validateProcessInfo(proc)) continue;
         
-        if (i > 0) builder.append(",");
-        builder.append("{");
-        builder.escapeAndAppend("\"pid\":").append(proc.pid).append(",");
-        builder.escapeAndAppend("\"name\":\"").escapeAndAppend(proc.name).append("\",");
-        builder.escapeAndAppend("\"cpu_usage\":").append(proc.cpuUsage).append(",");
-        builder.escapeAndAppend("\"memory_usage\":").append(proc.memoryUsage).append(",");
-        builder.escapeAndAppend("\"status\":\"").escapeAndAppend(proc.status).append("\",");
-        builder.escapeAndAppend("\"parent_pid\":").append(proc.parentPid).append(",");
-        builder.escapeAndAppend("\"user\":\"").escapeAndAppend(proc.user).append("\"");
-        builder.append("}");
+        if (!first) builder.append(",");
+        first = false;
+        row.begin();
+        if (row.field("pid")) builder.append(proc.pid);
+        if (row.field("name")) builder.append("\"").escapeAndAppend(proc.name).append("\"");
+        if (row.field("cpu_usage")) builder.append(proc.cpuUsage);
+        if (row.field("memory_usage")) builder.append(proc.memoryUsage);
+        if (row.field("status")) builder.append("\"").escapeAndAppend(proc.status).append("\"");
+        if (row.field("parent_pid")) builder.append(proc.parentPid);
+        if (row.field("user")) builder.append("\"").escapeAndAppend(proc.user).append("\"");
+        if (row.field("exe_id")) builder.append(proc.executableId);
+        row.end();
     }
     builder.append("]}");
     
     return builder.toString();
 }
 
-std::string Serializer::serializeDeviceList(const std::vector<UsbDevice>& devices) {
+std::string Serializer::serializeDeviceList(const std::vector<UsbDevice>& devices, const FieldMask& fields) {
     StringBuilder builder(2048);
     builder.append("{");
-    builder.escapeAndAppend("\"device_count\":").append(devices.size()).append(",");
-    builder.escapeAndAppend("\"devices\":[");
+    builder.append("\"device_count\":").append(devices.size()).append(",");
+    builder.append("\"devices\":[");
     
-    for (size_t i = 0; i < devices.size(); ++i) {
-        const auto& device = devices[i];
+    RowWriter row(builder, fields);
+    bool first = true;
+    for (const auto& device : devices) {
         if (!validateUsbDevice(device)) continue;
         
-        if (i > 0) builder.append(",");
-        builder.append("{");
-        builder.escapeAndAppend("\"vid\":\"").escapeAndAppend(device.vid).append("\",");
-        builder.escapeAndAppend("\"pid\":\"").escapeAndAppend(device.pid).append("\",");
-        builder.escapeAndAppend("\"name\":\"").escapeAndAppend(device.name).append("\",");
-        builder.escapeAndAppend("\"serial\":\"").escapeAndAppend(device.serialNumber).append("\",");
-        builder.escapeAndAppend("\"connected\":").append(device.isConnected).append(",");
-        builder.escapeAndAppend("\"enabled\":").append(device.isEnabled);
-        builder.append("}");
+        if (!first) builder.append(",");
+        first = false;
+        row.begin();
+        if (row.field("vid")) builder.append("\"").escapeAndAppend(device.vid).append("\"");
+        if (row.field("pid")) builder.append("\"").escapeAndAppend(device.pid).append("\"");
+        if (row.field("name")) builder.append("\"").escapeAndAppend(device.name).append("\"");
+        if (row.field("serial")) builder.append("\"").escapeAndAppend(device.serialNumber).append("\"");
+        if (row.field("connected")) builder.append(device.isConnected);
+        if (row.field("enabled")) builder.append(device.isEnabled);
+        row.end();
     }
     builder.append("]}");
     
     return builder.toString();
 }
 
-std::string Serializer::serializeNetworkInterfaces(const std::vector<NetworkInterface>& interfaces) {
+std::string Serializer::serializeNetworkInterfaces(const std::vector<NetworkInterface>& interfaces, const FieldMask& fields) {
     StringBuilder builder(2048);
     builder.append("{");
-    builder.escapeAndAppend("\"interface_count\":").append(interfaces.size()).append(",");
-    builder.escapeAndAppend("\"interfaces\":[");
+    builder.append("\"interface_count\":").append(interfaces.size()).append(",");
+    builder.append("\"interfaces\":[");
     
-    for (size_t i = 0; i < interfaces.size(); ++i) {
-        const auto& iface = interfaces[i];
+    RowWriter row(builder, fields);
+    bool first = true;
+    for (const auto& iface : interfaces) {
         if (!validateNetworkInterface(iface)) continue;
         
-        if (i > 0) builder.append(",");
+        if (!first) builder.append(",");
+        first = false;
+        row.begin();
+        if (row.field("name")) builder.append("\"").escapeAndAppend(iface.name).append("\"");
+        if (row.field("ipv4")) builder.append("\"").escapeAndAppend(iface.ipv4).append("\"");
+        if (row.field("ipv6")) builder.append("\"").escapeAndAppend(iface.ipv6).append("\"");
+        if (row.field("enabled")) builder.append(iface.isEnabled);
+        if (row.field("rx_bytes")) builder.append(iface.rxBytes);
+        if (row.field("tx_bytes")) builder.append(iface.txBytes);
+        if (row.field("rx_speed")) builder.append(iface.rxSpeed);
+        if (row.field("tx_speed")) builder.append(iface.txSpeed);
+        row.end();
+    }
+    builder.append("]}");
+    
+    return builder.toString();
+}
+
+std::string Serializer::serializeTaskDelays(const std::vector<TaskDelayInfo>& tasks,
+                                            const std::vector<TaskDelayInfo>& exitedTasks,
+                                            const FieldMask& fields) {
+    StringBuilder builder(4096);
+    builder.append("{");
+    builder.append("\"task_count\":").append(tasks.size()).append(",");
+    
+    RowWriter row(builder, fields);
+    auto appendTasks = [this, &builder, &row](const std::vector<TaskDelayInfo>& list) {
+        bool first = true;
+        for (const auto& task : list) {
+            if (!validateTaskDelayInfo(task)) continue;
+            
+            if (!first) builder.append(",");
+            first = false;
+            row.begin();
+            if (row.field("pid")) builder.append(task.pid);
+            if (row.field("name")) builder.append("\"").escapeAndAppend(task.name).append("\"");
+            if (row.field("cpu_delay_ms")) builder.append(task.cpuDelayMs);
+            if (row.field("blkio_delay_ms")) builder.append(task.blkioDelayMs);
+            if (row.field("swapin_delay_ms")) builder.append(task.swapinDelayMs);
+            if (row.field("cpu_delay_percent")) builder.append(task.cpuDelayPercent);
+            if (row.field("blkio_delay_percent")) builder.append(task.blkioDelayPercent);
+            if (row.field("swapin_delay_percent")) builder.append(task.swapinDelayPercent);
+            if (row.field("read_bytes")) builder.append(task.readBytes);
+            if (row.field("write_bytes")) builder.append(task.writeBytes);
+            if (row.field("read_rate")) builder.append(task.readRate);
+            if (row.field("write_rate")) builder.append(task.writeRate);
+            if (row.field("exited")) builder.append(task.hasExited);
+            row.end();
+        }
+    };
+    
+    builder.append("\"tasks\":[");
+    appendTasks(tasks);
+    builder.append("],\"exited\":[");
+    appendTasks(exitedTasks);
+    builder.append("]}");
+    
+    return builder.toString();
+}
+
+std::string Serializer::serializeNetworkStats(const std::vector<NetworkStatCounter>& counters, const FieldMask& fields) {
+    StringBuilder builder(2048);
+    builder.append("{");
+    builder.append("\"counter_count\":").append(counters.size()).append(",");
+    builder.append("\"counters\":[");
+    
+    RowWriter row(builder, fields);
+    bool first = true;
+    for (const auto& counter : counters) {
+        if (!validateNetworkStatCounter(counter)) continue;
+        
+        if (!first) builder.append(",");
+        first = false;
+        row.begin();
+        if (row.field("name")) builder.append("\"").escapeAndAppend(counter.name).append("\"");
+        if (row.field("value")) builder.append(counter.value);
+        if (row.field("rate")) builder.append(counter.rate);
+        if (row.field("gauge")) builder.append(counter.isGauge);
+        row.end();
+    }
+    builder.append("]}");
+    
+    return builder.toString();
+}
+
+std::string Serializer::serializeFilesystems(const std::vector<FilesystemInfo>& filesystems, const FieldMask& fields) {
+    StringBuilder builder(2048);
+    builder.append("{");
+    builder.append("\"filesystem_count\":").append(filesystems.size()).append(",");
+    builder.append("\"filesystems\":[");
+    
+    RowWriter row(builder, fields);
+    bool first = true;
+    for (const auto& fs : filesystems) {
+        if (!validateFilesystemInfo(fs)) continue;
+        
+        if (!first) builder.append(",");
+        first = false;
+        row.begin();
+        if (row.field("mount_point")) builder.append("\"").escapeAndAppend(fs.mountPoint).append("\"");
+        if (row.field("device")) builder.append("\"").escapeAndAppend(fs.device).append("\"");
+        if (row.field("fs_type")) builder.append("\"").escapeAndAppend(fs.fsType).append("\"");
+        if (row.field("read_only")) builder.append(fs.isReadOnly);
+        if (row.field("total_bytes")) builder.append(fs.totalBytes);
+        if (row.field("used_bytes")) builder.append(fs.usedBytes);
+        if (row.field("available_bytes")) builder.append(fs.availableBytes);
+        if (row.field("usage_percent")) builder.append(fs.usagePercent);
+        if (row.field("total_inodes")) builder.append(fs.totalInodes);
+        if (row.field("used_inodes")) builder.append(fs.usedInodes);
+        if (row.field("inode_usage_percent")) builder.append(fs.inodeUsagePercent);
+        if (row.field("fill_rate")) builder.append(fs.fillRate);
+        if (row.field("time_to_full")) builder.append(fs.timeToFull);
+        row.end();
+    }
+    builder.append("]}");
+    
+    return builder.toString();
+}
+
+std::string Serializer::serializePowerInfo(const std::vector<PowerDomainInfo>& domains,
+                                           const std::vector<ProcessPowerInfo>& processes,
+                                           const FieldMask& fields) {
+    StringBuilder builder(2048);
+    builder.append("{");
+    builder.append("\"domain_count\":").append(domains.size()).append(",");
+    builder.append("\"domains\":[");
+    
+    // Domains and processes have different key orders, so each needs its own writer
+    RowWriter domainRow(builder, fields);
+    bool first = true;
+    for (const auto& domain : domains) {
+        if (!validatePowerDomainInfo(domain)) continue;
+        
+        if (!first) builder.append(",");
+        first = false;
+        domainRow.begin();
+        if (domainRow.field("name")) builder.append("\"").escapeAndAppend(domain.name).append("\"");
+        if (domainRow.field("zone")) builder.append("\"").escapeAndAppend(domain.zone).append("\"");
+        if (domainRow.field("socket")) builder.append(domain.socket);
+        if (domainRow.field("energy_uj")) builder.append(domain.energyUj);
+        if (domainRow.field("watts")) builder.append(domain.watts);
+        domainRow.end();
+    }
+    builder.append("],\"processes\":[");
+    
+    RowWriter processRow(builder, fields);
+    first = true;
+    for (const auto& process : processes) {
+        if (!validateProcessPowerInfo(process)) continue;
+        
+        if (!first) builder.append(",");
+        first = false;
+        processRow.begin();
+        if (processRow.field("pid")) builder.append(process.pid);
+        if (processRow.field("name")) builder.append("\"").escapeAndAppend(process.name).append("\"");
+        if (processRow.field("cpu_share")) builder.append(process.cpuShare);
+        if (processRow.field("watts")) builder.append(process.watts);
+        processRow.end();
+    }
+    builder.append("]}");
+    
+    return builder.toString();
+}
+
+std::string Serializer::serializeCollectors(const std::vector<CollectorInfo>& collectors) {
+    StringBuilder builder(2048);
+    builder.append("{");
+    builder.append("\"collector_count\":").append(collectors.size()).append(",");
+    builder.append("\"collectors\":[");
+    
+    bool first = true;
+    for (const auto& collector : collectors) {
+        if (!validateCollectorInfo(collector)) continue;
+        
+        if (!first) builder.append(",");
+        first = false;
         builder.append("{");
-        builder.escapeAndAppend("\"name\":\"").escapeAndAppend(iface.name).append("\",");
-        builder.escapeAndAppend("\"ipv4\":\"").escapeAndAppend(iface.ipv4).append("\",");
-        builder.escapeAndAppend("\"ipv6\":\"").escapeAndAppend(iface.ipv6).append("\",");
-        builder.escapeAndAppend("\"enabled\":").append(iface.isEnabled).append(",");
-        builder.escapeAndAppend("\"rx_bytes\":").append(iface.rxBytes).append(",");
-        builder.escapeAndAppend("\"tx_bytes\":").append(iface.txBytes).append(",");
-        builder.escapeAndAppend("\"rx_speed\":").append(iface.rxSpeed).append(",");
-        builder.escapeAndAppend("\"tx_speed\":").append(iface.txSpeed);
+        builder.append("\"name\":\"").escapeAndAppend(collector.name).append("\",");
+        builder.append("\"version\":\"").escapeAndAppend(collector.version).append("\",");
+        builder.append("\"source\":\"").escapeAndAppend(collector.source).append("\",");
+        builder.append("\"cost_class\":\"").escapeAndAppend(collector.costClass).append("\",");
+        builder.append("\"interval_ms\":").append(collector.intervalMs).append(",");
+        builder.append("\"runs\":").append(collector.runs).append(",");
+        builder.append("\"failures\":").append(collector.failures).append(",");
+        builder.append("\"last_run_ms\":").append(collector.lastRunMs).append(",");
+        builder.append("\"timeouts\":").append(collector.timeouts).append(",");
+        builder.append("\"active\":").append(collector.isActive).append(",");
+        builder.append("\"quarantined\":").append(collector.isQuarantined).append(",");
+        builder.append("\"metrics\":[");
+        for (size_t i = 0; i < collector.metrics.size(); ++i) {
+            const auto& metric = collector.metrics[i];
+            if (i > 0) builder.append(",");
+            builder.append("{");
+            builder.append("\"name\":\"").escapeAndAppend(metric.name).append("\",");
+            builder.append("\"unit\":\"").escapeAndAppend(metric.unit).append("\",");
+            builder.append("\"description\":\"").escapeAndAppend(metric.description).append("\",");
+            builder.append("\"kind\":\"").append(metric.isCounter ? "counter" : "gauge").append("\"");
+            builder.append("}");
+        }
+        builder.append("]}");
+    }
+    builder.append("]}");
+    
+    return builder.toString();
+}
+
+std::string Serializer::serializeMetricSamples(const std::vector<MetricSample>& samples, const FieldMask& fields) {
+    StringBuilder builder(4096);
+    builder.append("{");
+    builder.append("\"sample_count\":").append(samples.size()).append(",");
+    builder.append("\"samples\":[");
+    
+    RowWriter row(builder, fields);
+    bool first = true;
+    for (const auto& sample : samples) {
+        if (!validateMetricSample(sample)) continue;
+        
+        if (!first) builder.append(",");
+        first = false;
+        row.begin();
+        if (row.field("collector")) builder.append("\"").escapeAndAppend(sample.collector).append("\"");
+        if (row.field("metric")) builder.append("\"").escapeAndAppend(sample.metric).append("\"");
+        if (row.field("instance")) builder.append("\"").escapeAndAppend(sample.instance).append("\"");
+        if (row.field("value")) builder.append(sample.value);
+        if (row.field("timestamp")) builder.append(sample.timestampMs);
+        row.end();
+    }
+    builder.append("]}");
+    
+    return builder.toString();
+}
+
+std::string Serializer::serializeJobHealth(const std::vector<JobHealthInfo>& jobs) {
+    StringBuilder builder(1024);
+    builder.append("{");
+    builder.append("\"job_count\":").append(jobs.size()).append(",");
+    builder.append("\"jobs\":[");
+    
+    bool first = true;
+    for (const auto& job : jobs) {
+        if (!validateJobHealthInfo(job)) continue;
+        
+        if (!first) builder.append(",");
+        first = false;
+        builder.append("{");
+        builder.append("\"name\":\"").escapeAndAppend(job.name).append("\",");
+        builder.append("\"interval_ms\":").append(job.intervalMs).append(",");
+        builder.append("\"deadline_ms\":").append(job.deadlineMs).append(",");
+        builder.append("\"age_ms\":").append(job.ageMs).append(",");
+        builder.append("\"running_ms\":").append(job.runningMs).append(",");
+        builder.append("\"last_duration_ms\":").append(job.lastDurationMs).append(",");
+        builder.append("\"overruns\":").append(job.overruns).append(",");
+        builder.append("\"running\":").append(job.isRunning).append(",");
+        builder.append("\"stale\":").append(job.isStale).append(",");
+        builder.append("\"quarantined\":").append(job.isQuarantined);
+        builder.append("}");
+    }
+    builder.append("]}");
+    
+    return builder.toString();
+}
+
+std::string Serializer::serializeProcessAggregates(const std::vector<ProcessAggregate>& groups, const std::string& groupBy,
+                                                  size_t processCount, size_t groupCount) {
+    StringBuilder builder(1024);
+    builder.append("{");
+    builder.append("\"group_by\":\"").escapeAndAppend(groupBy).append("\",");
+    builder.append("\"process_count\":").append(processCount).append(",");
+    builder.append("\"group_count\":").append(groupCount).append(",");
+    builder.append("\"groups\":[");
+    
+    bool first = true;
+    for (const auto& group : groups) {
+        if (!validateProcessAggregate(group)) continue;
+        
+        if (!first) builder.append(",");
+        first = false;
+        builder.append("{");
+        builder.append("\"key\":\"").escapeAndAppend(group.key).append("\",");
+        builder.append("\"count\":").append(group.count).append(",");
+        builder.append("\"cpu_total\":").append(group.cpuTotal).append(",");
+        builder.append("\"cpu_max\":").append(group.cpuMax).append(",");
+        builder.append("\"rss_total\":").append(group.rssTotal);
+        builder.append("}");
+    }
+    builder.append("]}");
+    
+    return builder.toString();
+}
+
+std::string Serializer::serializeExecutableIdentities(const std::vector<ExecutableIdentity>& identities,
+                                                    const FieldMask& fields) {
+    StringBuilder builder(4096);
+    builder.append("{");
+    builder.append("\"identity_count\":").append(identities.size()).append(",");
+    builder.append("\"identities\":[");
+    
+    RowWriter row(builder, fields);
+    bool first = true;
+    for (const auto& identity : identities) {
+        if (!validateExecutableIdentity(identity)) continue;
+        
+        if (!first) builder.append(",");
+        first = false;
+        row.begin();
+        if (row.field("id")) builder.append(identity.id);
+        if (row.field("path")) builder.append("\"").escapeAndAppend(identity.path).append("\"");
+        if (row.field("device")) builder.append(identity.device);
+        if (row.field("inode")) builder.append(identity.inode);
+        if (row.field("size")) builder.append(identity.size);
+        if (row.field("mtime_ns")) builder.append(identity.mtimeNs);
+        if (row.field("sha256")) builder.append("\"").append(identity.sha256).append("\"");
+        if (row.field("hash_error")) builder.append("\"").escapeAndAppend(identity.hashError).append("\"");
+        if (row.field("pids")) {
+            builder.append("[");
+            for (size_t i = 0; i < identity.pids.size(); ++i) {
+                if (i > 0) builder.append(",");
+                builder.append(identity.pids[i]);
+            }
+            builder.append("]");
+        }
+        row.end();
+    }
+    builder.append("]}");
+    
+    return builder.toString();
+}
+
+std::string Serializer::serializeTopConsumers(const std::vector<TopConsumerInfo>& consumers, const std::string& metric,
+                                             uint64_t windowSeconds, uint64_t coveredSeconds,
+                                             const FieldMask& fields) {
+    StringBuilder builder(4096);
+    builder.append("{");
+    builder.append("\"metric\":\"").escapeAndAppend(metric).append("\",");
+    builder.append("\"window_seconds\":").append(windowSeconds).append(",");
+    builder.append("\"covered_seconds\":").append(coveredSeconds).append(",");
+    builder.append("\"consumer_count\":").append(consumers.size()).append(",");
+    builder.append("\"consumers\":[");
+    
+    RowWriter row(builder, fields);
+    bool first = true;
+    for (const auto& consumer : consumers) {
+        if (!validateTopConsumer(consumer)) continue;
+    
+        if (!first) builder.append(",");
+        first = false;
+        row.begin();
+        if (row.field("name")) builder.append("\"").escapeAndAppend(consumer.name).append("\"");
+        if (row.field("executable")) builder.append("\"").escapeAndAppend(consumer.executable).append("\"");
+        if (row.field("cgroup")) builder.append("\"").escapeAndAppend(consumer.cgroup).append("\"");
+        if (row.field("value")) builder.append(consumer.value);
+        if (row.field("error")) builder.append(consumer.error);
+        if (row.field("average")) builder.append(consumer.average);
+        row.end();
+    }
+    builder.append("]}");
+    
+    return builder.toString();
+}
+
+std::string Serializer::serializeRunQueueLatency(const RunQueueLatencyInfo& total,
+                                                const std::vector<RunQueueLatencyInfo>& cpus, uint64_t intervalMs) {
+    StringBuilder builder(4096);
+    
+    auto appendLatency = [&builder](const RunQueueLatencyInfo& latency) {
+        builder.append("\"count\":").append(latency.count).append(",");
+        builder.append("\"avg_us\":").append(latency.averageUs).append(",");
+        builder.append("\"p50_us\":").append(latency.p50Us).append(",");
+        builder.append("\"p99_us\":").append(latency.p99Us).append(",");
+        builder.append("\"buckets\":[");
+        for (size_t i = 0; i < latency.buckets.size(); ++i) {
+            if (i > 0) builder.append(",");
+            builder.append(latency.buckets[i]);
+        }
+        builder.append("]");
+    };
+    
+    builder.append("{");
+    builder.append("\"interval_ms\":").append(intervalMs).append(",");
+    builder.append("\"bucket_unit\":\"log2_us\",");
+    builder.append("\"total\":{");
+    appendLatency(total);
+    builder.append("},\"cpus\":[");
+    
+    bool first = true;
+    for (const auto& latency : cpus) {
+        if (!validateRunQueueLatencyInfo(latency)) continue;
+        
+        if (!first) builder.append(",");
+        first = false;
+        builder.append("{\"cpu\":").append(latency.cpu).append(",");
+        appendLatency(latency);
         builder.append("}");
     }
     builder.append("]}");
@@ -121,6 +535,38 @@ std::string Serializer::serializeNetworkInterfaces(const std::vector<NetworkInte
     return builder.toString();
 }
 
+std::string Serializer::serializeTaskEvents(const std::vector<TaskTraceEvent>& events, uint64_t droppedEvents,
+                                            const FieldMask& fields) {
+    StringBuilder builder(4096);
+    builder.append("{");
+    builder.append("\"event_count\":").append(events.size()).append(",");
+    builder.append("\"dropped\":").append(droppedEvents).append(",");
+    builder.append("\"events\":[");
+    
+    RowWriter row(builder, fields);
+    bool first = true;
+    for (const auto& event : events) {
+        if (!validateTaskTraceEvent(event)) continue;
+        
+        if (!first) builder.append(",");
+        first = false;
+        row.begin();
+        if (row.field("type")) builder.append("\"").append(event.type).append("\"");
+        if (row.field("pid")) builder.append(event.pid);
+        if (row.field("parent_pid")) builder.append(event.parentPid);
+        if (row.field("uid")) builder.append(event.uid);
+        if (row.field("name")) builder.append("\"").escapeAndAppend(event.name).append("\"");
+        if (row.field("filename")) builder.append("\"").escapeAndAppend(event.filename).append("\"");
+        if (row.field("exit_code")) builder.append(std::to_string(event.exitCode));
+        if (row.field("lifetime_ms")) builder.append(event.lifetimeMs);
+        if (row.field("timestamp")) builder.append(event.timestamp);
+        row.end();
+    }
+    builder.append("]}");
+    
+    return builder.toString();
+}
+
 std::string Serializer::serializeAndroidDevices(const std::vector<AndroidDeviceInfo>& devices) {
     StringBuilder builder(2048);
     builder.append("{");
@@ -147,6 +593,127 @@ std::string Serializer::serializeAndroidDevices(const std::vector<AndroidDeviceI
     return builder.toString();
 }
 
+std::string Serializer::serializeAndroidApps(const std::vector<AndroidAppInfo>& apps, size_t totalCount,
+                                            size_t matchedCount, size_t offset, uint64_t refreshedAt,
+                                            const FieldMask& fields) {
+    StringBuilder builder(4096);
+    builder.append("{");
+    builder.append("\"total\":").append(totalCount).append(",");
+    builder.append("\"matched\":").append(matchedCount).append(",");
+    builder.append("\"offset\":").append(offset).append(",");
+    builder.append("\"refreshed_at\":").append(refreshedAt).append(",");
+    builder.append("\"apps\":[");
+    
+    RowWriter row(builder, fields);
+    bool first = true;
+    for (const auto& app : apps) {
+        if (!validateAndroidAppInfo(app)) continue;
+        
+        if (!first) builder.append(",");
+        first = false;
+        row.begin();
+        if (row.field("package")) builder.append("\"").escapeAndAppend(app.packageName).append("\"");
+        if (row.field("apk_path")) builder.append("\"").escapeAndAppend(app.apkPath).append("\"");
+        if (row.field("uid")) builder.append(app.uid);
+        if (row.field("system")) builder.append(app.isSystem);
+        row.end();
+    }
+    builder.append("]}");
+    
+    return builder.toString();
+}
+
+std::string Serializer::serializeAndroidActionResults(const std::vector<AndroidActionResult>& results,
+                                                      uint64_t durationMs) {
+    size_t succeeded = std::count_if(results.begin(), results.end(),
+                                     [](const AndroidActionResult& result) { return result.success; });
+    
+    StringBuilder builder(1024);
+    builder.append("{");
+    builder.append("\"device_count\":").append(results.size()).append(",");
+    builder.append("\"succeeded\":").append(succeeded).append(",");
+    builder.append("\"failed\":").append(results.size() - succeeded).append(",");
+    builder.append("\"duration_ms\":").append(durationMs).append(",");
+    builder.append("\"devices\":[");
+    
+    bool first = true;
+    for (const auto& result : results) {
+        if (!validateAndroidActionResult(result)) continue;
+        
+        if (!first) builder.append(",");
+        first = false;
+        builder.append("{");
+        builder.append("\"serial\":\"").escapeAndAppend(result.serial).append("\",");
+        builder.append("\"success\":").append(result.success).append(",");
+        builder.append("\"message\":\"").escapeAndAppend(result.message).append("\",");
+        builder.append("\"duration_ms\":").append(result.durationMs);
+        builder.append("}");
+    }
+    builder.append("]}");
+    
+    return builder.toString();
+}
+
+std::string Serializer::serializeAndroidTransfers(const std::vector<AndroidTransferInfo>& transfers,
+                                                  const FieldMask& fields) {
+    StringBuilder builder(2048);
+    builder.append("{");
+    builder.append("\"transfer_count\":").append(transfers.size()).append(",");
+    builder.append("\"transfers\":[");
+    
+    RowWriter row(builder, fields);
+    bool first = true;
+    for (const auto& transfer : transfers) {
+        if (!validateAndroidTransferInfo(transfer)) continue;
+        
+        if (!first) builder.append(",");
+        first = false;
+        row.begin();
+        if (row.field("id")) builder.append(transfer.id);
+        if (row.field("batch_id")) builder.append(transfer.batchId);
+        if (row.field("serial")) builder.append("\"").escapeAndAppend(transfer.serial).append("\"");
+        if (row.field("operation")) builder.append("\"").append(transfer.operation).append("\"");
+        if (row.field("local_path")) builder.append("\"").escapeAndAppend(transfer.localPath).append("\"");
+        if (row.field("remote_path")) builder.append("\"").escapeAndAppend(transfer.remotePath).append("\"");
+        if (row.field("state")) builder.append("\"").append(transfer.state).append("\"");
+        if (row.field("error")) builder.append("\"").escapeAndAppend(transfer.error).append("\"");
+        if (row.field("bytes_transferred")) builder.append(transfer.bytesTransferred);
+        if (row.field("total_bytes")) builder.append(transfer.totalBytes);
+        if (row.field("started_at")) builder.append(transfer.startedAt);
+        if (row.field("duration_ms")) builder.append(transfer.durationMs);
+        row.end();
+    }
+    builder.append("]}");
+    
+    return builder.toString();
+}
+
+std::string Serializer::serializeUsbPolicyRules(const std::vector<UsbPolicyRule>& rules) {
+    StringBuilder builder(1024);
+    builder.append("{");
+    builder.append("\"rule_count\":").append(rules.size()).append(",");
+    builder.append("\"rules\":[");
+    
+    bool first = true;
+    for (const auto& rule : rules) {
+        if (!validateUsbPolicyRule(rule)) continue;
+        
+        if (!first) builder.append(",");
+        first = false;
+        builder.append("{");
+        builder.append("\"id\":\"").escapeAndAppend(rule.id).append("\",");
+        builder.append("\"action\":\"").append(rule.allow ? "allow" : "deny").append("\",");
+        builder.append("\"vid\":\"").escapeAndAppend(rule.vid).append("\",");
+        builder.append("\"pid\":\"").escapeAndAppend(rule.pid).append("\",");
+        builder.append("\"class\":\"").escapeAndAppend(rule.deviceClass).append("\",");
+        builder.append("\"serial\":\"").escapeAndAppend(rule.serialNumber).append("\"");
+        builder.append("}");
+    }
+    builder.append("]}");
+    
+    return builder.toString();
+}
+
 std::string Serializer::serializeAutomationRules(const std::vector<AutomationRule>& rules) {
     StringBuilder builder(2048);
     builder.append("{");
@@ -248,10 +815,78 @@ bool Serializer::validateNetworkInterface(const NetworkInterface& interface) con
     return interface.isValid();
 }
 
+bool Serializer::validateTaskDelayInfo(const TaskDelayInfo& task) const {
+    return task.isValid();
+}
+
+bool Serializer::validateExecutableIdentity(const ExecutableIdentity& identity) const {
+    return identity.isValid();
+}
+
+bool Serializer::validateTopConsumer(const TopConsumerInfo& consumer) const {
+    return consumer.isValid();
+}
+
+bool Serializer::validateRunQueueLatencyInfo(const RunQueueLatencyInfo& latency) const {
+    return latency.isValid();
+}
+
+bool Serializer::validateTaskTraceEvent(const TaskTraceEvent& event) const {
+    return event.isValid();
+}
+
+bool Serializer::validateNetworkStatCounter(const NetworkStatCounter& counter) const {
+    return counter.isValid();
+}
+
+bool Serializer::validateFilesystemInfo(const FilesystemInfo& filesystem) const {
+    return filesystem.isValid();
+}
+
+bool Serializer::validatePowerDomainInfo(const PowerDomainInfo& domain) const {
+    return domain.isValid();
+}
+
+bool Serializer::validateProcessPowerInfo(const ProcessPowerInfo& process) const {
+    return process.isValid();
+}
+
+bool Serializer::validateUsbPolicyRule(const UsbPolicyRule& rule) const {
+    return rule.isValid();
+}
+
+bool Serializer::validateCollectorInfo(const CollectorInfo& collector) const {
+    return collector.isValid();
+}
+
+bool Serializer::validateMetricSample(const MetricSample& sample) const {
+    return sample.isValid();
+}
+
+bool Serializer::validateJobHealthInfo(const JobHealthInfo& job) const {
+    return job.isValid();
+}
+
+bool Serializer::validateProcessAggregate(const ProcessAggregate& group) const {
+    return group.isValid();
+}
+
 bool Serializer::validateAndroidDeviceInfo(const AndroidDeviceInfo& device) const {
     return device.isValid();
 }
 
+bool Serializer::validateAndroidAppInfo(const AndroidAppInfo& app) const {
+    return app.isValid();
+}
+
+bool Serializer::validateAndroidActionResult(const AndroidActionResult& result) const {
+    return result.isValid();
+}
+
+bool Serializer::validateAndroidTransferInfo(const AndroidTransferInfo& transfer) const {
+    return transfer.isValid();
+}
+
 bool Serializer::validateAutomationRule(const AutomationRule& rule) const {
     return rule.isValid();
 }
@@ -307,5 +942,38 @@ void StringBuilder::clear() {
     stream_->clear();
 }
 
+// RowWriter implementation
+RowWriter::RowWriter(StringBuilder& builder, const FieldMask& mask)
+    : builder_(builder)
+    , mask_(mask)
+    , index_(0)
+    , first_(true) {
+}
+
+void RowWriter::begin() {
+    builder_.append("{");
+    index_ = 0;
+    first_ = true;
+}
+
+bool RowWriter::field(const char* key) {
+    const size_t position = index_++;
+    if (position == selected_.size()) {
+        selected_.push_back(mask_.includes(key) ? 1 : 0);
+    }
+    if (!selected_[position]) {
+        return false;
+    }
+    
+    if (!first_) builder_.append(",");
+    first_ = false;
+    builder_.append("\"").append(key).append("\":");
+    return true;
+}
+
+void RowWriter::end() {
+    builder_.append("}");
+}
+
 } // namespace Serialization
 } // namespace SysMon
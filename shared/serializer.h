@@ -12,17 +12,62 @@
 namespace SysMon {
 namespace Serialization {
 
+class StringBuilder;
+
+// Field projection for GET commands
+//
+// Built from the comma-separated "fields" command parameter. An empty mask
+// selects every field; unknown names are ignored. Only per-row fields are
+// projected, counts and list wrappers are always emitted.
+class FieldMask {
+public:
+    FieldMask() = default;
+    explicit FieldMask(const std::string& fields);
+    
+    bool isEmpty() const;
+    bool includes(const std::string& field) const;
+    
+private:
+    std::vector<std::string> fields_;
+};
+
 // Efficient serializer with memory pooling
 class Serializer {
 public:
     static Serializer& getInstance();
     
     // Serialization methods with memory efficiency
-    std::string serializeSystemInfo(const SystemInfo& info);
-    std::string serializeProcessList(const std::vector<ProcessInfo>& processes);
-    std::string serializeDeviceList(const std::vector<UsbDevice>& devices);
-    std::string serializeNetworkInterfaces(const std::vector<NetworkInterface>& interfaces);
+    std::string serializeSystemInfo(const SystemInfo& info, const FieldMask& fields = FieldMask());
+    std::string serializeProcessList(const std::vector<ProcessInfo>& processes, const FieldMask& fields = FieldMask());
+    std::string serializeTaskDelays(const std::vector<TaskDelayInfo>& tasks, const std::vector<TaskDelayInfo>& exitedTasks,
+                                    const FieldMask& fields = FieldMask());
+    std::string serializeDeviceList(const std::vector<UsbDevice>& devices, const FieldMask& fields = FieldMask());
+    std::string serializeUsbPolicyRules(const std::vector<UsbPolicyRule>& rules);
+    std::string serializeNetworkInterfaces(const std::vector<NetworkInterface>& interfaces, const FieldMask& fields = FieldMask());
+    std::string serializeNetworkStats(const std::vector<NetworkStatCounter>& counters, const FieldMask& fields = FieldMask());
+    std::string serializeFilesystems(const std::vector<FilesystemInfo>& filesystems, const FieldMask& fields = FieldMask());
+    std::string serializePowerInfo(const std::vector<PowerDomainInfo>& domains, const std::vector<ProcessPowerInfo>& processes,
+                                   const FieldMask& fields = FieldMask());
+    std::string serializeCollectors(const std::vector<CollectorInfo>& collectors);
+    std::string serializeMetricSamples(const std::vector<MetricSample>& samples, const FieldMask& fields = FieldMask());
+    std::string serializeJobHealth(const std::vector<JobHealthInfo>& jobs);
+    std::string serializeProcessAggregates(const std::vector<ProcessAggregate>& groups, const std::string& groupBy,
+                                           size_t processCount, size_t groupCount);
+    std::string serializeExecutableIdentities(const std::vector<ExecutableIdentity>& identities,
+                                              const FieldMask& fields = FieldMask());
+    std::string serializeTopConsumers(const std::vector<TopConsumerInfo>& consumers, const std::string& metric,
+                                      uint64_t windowSeconds, uint64_t coveredSeconds,
+                                      const FieldMask& fields = FieldMask());
+    std::string serializeRunQueueLatency(const RunQueueLatencyInfo& total, const std::vector<RunQueueLatencyInfo>& cpus,
+                                         uint64_t intervalMs);
+    std::string serializeTaskEvents(const std::vector<TaskTraceEvent>& events, uint64_t droppedEvents,
+                                    const FieldMask& fields = FieldMask());
     std::string serializeAndroidDevices(const std::vector<AndroidDeviceInfo>& devices);
+    std::string serializeAndroidApps(const std::vector<AndroidAppInfo>& apps, size_t totalCount, size_t matchedCount,
+                                     size_t offset, uint64_t refreshedAt, const FieldMask& fields = FieldMask());
+    std::string serializeAndroidActionResults(const std::vector<AndroidActionResult>& results, uint64_t durationMs);
+    std::string serializeAndroidTransfers(const std::vector<AndroidTransferInfo>& transfers,
+                                          const FieldMask& fields = FieldMask());
     std::string serializeAutomationRules(const std::vector<AutomationRule>& rules);
     
     // JSON utilities with escape handling
@@ -55,9 +100,26 @@ private:
     // Validation helpers
     bool validateSystemInfo(const SystemInfo& info) const;
     bool validateProcessInfo(const ProcessInfo& process) const;
+    bool validateTaskDelayInfo(const TaskDelayInfo& task) const;
     bool validateUsbDevice(const UsbDevice& device) const;
+    bool validateUsbPolicyRule(const UsbPolicyRule& rule) const;
     bool validateNetworkInterface(const NetworkInterface& interface) const;
+    bool validateNetworkStatCounter(const NetworkStatCounter& counter) const;
+    bool validateFilesystemInfo(const FilesystemInfo& filesystem) const;
+    bool validatePowerDomainInfo(const PowerDomainInfo& domain) const;
+    bool validateProcessPowerInfo(const ProcessPowerInfo& process) const;
+    bool validateCollectorInfo(const CollectorInfo& collector) const;
+    bool validateMetricSample(const MetricSample& sample) const;
+    bool validateJobHealthInfo(const JobHealthInfo& job) const;
+    bool validateProcessAggregate(const ProcessAggregate& group) const;
+    bool validateExecutableIdentity(const ExecutableIdentity& identity) const;
+    bool validateTopConsumer(const TopConsumerInfo& consumer) const;
+    bool validateRunQueueLatencyInfo(const RunQueueLatencyInfo& latency) const;
+    bool validateTaskTraceEvent(const TaskTraceEvent& event) const;
     bool validateAndroidDeviceInfo(const AndroidDeviceInfo& device) const;
+    bool validateAndroidAppInfo(const AndroidAppInfo& app) const;
+    bool validateAndroidActionResult(const AndroidActionResult& result) const;
+    bool validateAndroidTransferInfo(const AndroidTransferInfo& transfer) const;
     bool validateAutomationRule(const AutomationRule& rule) const;
 };
 
@@ -84,5 +146,25 @@ private:
     size_t capacity_;
 };
 
+// Writes one JSON object per row, keeping only the fields a mask selects
+//
+// Rows must emit their keys in the same order; the mask is consulted once
+// per key position on the first row and the decision reused afterwards.
+class RowWriter {
+public:
+    RowWriter(StringBuilder& builder, const FieldMask& mask);
+    
+    void begin();
+    bool field(const char* key);    // writes separator and key when selected
+    void end();
+    
+private:
+    StringBuilder& builder_;
+    const FieldMask& mask_;
+    std::vector<char> selected_;
+    size_t index_;
+    bool first_;
+};
+
 } // namespace Serialization
 } // namespace SysMon
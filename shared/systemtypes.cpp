@@ -4,6 +4,7 @@
 #include <algorithm>
 #include <regex>
 #include <chrono>
+#include <cmath>
 
 namespace SysMon {
 
@@ -46,8 +47,12 @@ bool isValidIpAddress(const std::string& ip) {
 }
 
 bool isValidAndroidSerial(const std::string& serial) {
-    return !serial.empty() && serial.length() <= 32 && 
-           std::all_of(serial.begin(), serial.end(), ::isalnum);
+    // Emulators ("emulator-5554") and TCP devices ("10.0.0.5:5555") use
+    // punctuation in their serials
+    return !serial.empty() && serial.length() <= 64 && 
+           std::all_of(serial.begin(), serial.end(), [](char c) {
+               return std::isalnum(static_cast<unsigned char>(c)) || c == '-' || c == '.' || c == ':' || c == '_';
+           });
 }
 
 bool isValidRuleId(const std::string& ruleId) {
@@ -109,7 +114,8 @@ ProcessInfo::ProcessInfo()
     : pid(0)
     , cpuUsage(0.0)
     , memoryUsage(0)
-    , parentPid(0) {
+    , parentPid(0)
+    , executableId(0) {
 }
 
 bool ProcessInfo::isValid() const {
@@ -135,6 +141,39 @@ void ProcessInfo::sanitize() {
     if (user.length() > 64) user = user.substr(0, 64);
 }
 
+// Implementation of TaskDelayInfo methods
+TaskDelayInfo::TaskDelayInfo()
+    : pid(0)
+    , cpuDelayMs(0)
+    , blkioDelayMs(0)
+    , swapinDelayMs(0)
+    , readBytes(0)
+    , writeBytes(0)
+    , cpuDelayPercent(0.0)
+    , blkioDelayPercent(0.0)
+    , swapinDelayPercent(0.0)
+    , readRate(0.0)
+    , writeRate(0.0)
+    , hasExited(false) {
+}
+
+bool TaskDelayInfo::isValid() const {
+    return Validation::isValidProcessId(pid) &&
+           cpuDelayPercent >= 0.0 && blkioDelayPercent >= 0.0 && swapinDelayPercent >= 0.0 &&
+           readRate >= 0.0 && writeRate >= 0.0;
+}
+
+void TaskDelayInfo::sanitize() {
+    // Delays are summed over threads, so multi-threaded processes may exceed 100%
+    cpuDelayPercent = std::max(0.0, cpuDelayPercent);
+    blkioDelayPercent = std::max(0.0, blkioDelayPercent);
+    swapinDelayPercent = std::max(0.0, swapinDelayPercent);
+    readRate = std::max(0.0, readRate);
+    writeRate = std::max(0.0, writeRate);
+    
+    if (name.length() > 64) name = name.substr(0, 64);
+}
+
 // Implementation of NetworkInterface methods
 NetworkInterface::NetworkInterface()
     : isEnabled(false)
@@ -160,6 +199,22 @@ void NetworkInterface::sanitize() {
     if (name.length() > 32) name = name.substr(0, 32);
 }
 
+// Implementation of NetworkStatCounter methods
+NetworkStatCounter::NetworkStatCounter()
+    : value(0)
+    , rate(0.0)
+    , isGauge(false) {
+}
+
+bool NetworkStatCounter::isValid() const {
+    return Validation::isValidNonEmptyString(name) && rate >= 0.0;
+}
+
+void NetworkStatCounter::sanitize() {
+    rate = std::max(0.0, rate);
+    if (name.length() > 64) name = name.substr(0, 64);
+}
+
 // Implementation of UsbDevice methods
 UsbDevice::UsbDevice()
     : isConnected(false)
@@ -229,6 +284,319 @@ void AutomationRule::sanitize() {
     }
 }
 
+// Implementation of UsbPolicyRule methods
+UsbPolicyRule::UsbPolicyRule()
+    : allow(false) {
+}
+
+bool UsbPolicyRule::isValid() const {
+    auto isHex = [](const std::string& value, size_t length) {
+        return value.length() == length &&
+               std::all_of(value.begin(), value.end(), [](char c) { return std::isxdigit(c); });
+    };
+    
+    if (!Validation::isValidRuleId(id)) return false;
+    if (vid.empty() && deviceClass.empty() && serialNumber.empty()) return false;
+    if (!vid.empty() && !isHex(vid, 4)) return false;
+    if (!pid.empty() && (vid.empty() || !isHex(pid, 4))) return false;
+    if (!deviceClass.empty() && !isHex(deviceClass, 2)) return false;
+    return serialNumber.length() <= 128;
+}
+
+void UsbPolicyRule::sanitize() {
+    // sysfs reports hex attributes in lowercase
+    auto toLower = [](std::string& value) {
+        std::transform(value.begin(), value.end(), value.begin(), [](unsigned char c) { return std::tolower(c); });
+    };
+    toLower(vid);
+    toLower(pid);
+    toLower(deviceClass);
+    if (serialNumber.length() > 128) serialNumber = serialNumber.substr(0, 128);
+    
+    // Ensure valid rule ID
+    if (id.empty()) {
+        id = "usbrule_" + std::to_string(std::chrono::system_clock::now().time_since_epoch().count());
+    }
+}
+
+// Implementation of FilesystemInfo methods
+FilesystemInfo::FilesystemInfo()
+    : isReadOnly(false)
+    , totalBytes(0)
+    , usedBytes(0)
+    , availableBytes(0)
+    , totalInodes(0)
+    , usedInodes(0)
+    , usagePercent(0.0)
+    , inodeUsagePercent(0.0)
+    , fillRate(0.0)
+    , timeToFull(-1.0) {
+}
+
+bool FilesystemInfo::isValid() const {
+    return Validation::isValidNonEmptyString(mountPoint) &&
+           usedBytes <= totalBytes &&
+           Validation::isValidPercentage(usagePercent) &&
+           Validation::isValidPercentage(inodeUsagePercent);
+}
+
+void FilesystemInfo::sanitize() {
+    // Clamp percentages and counters
+    usedBytes = std::min(usedBytes, totalBytes);
+    usedInodes = std::min(usedInodes, totalInodes);
+    usagePercent = std::max(0.0, std::min(100.0, usagePercent));
+    inodeUsagePercent = std::max(0.0, std::min(100.0, inodeUsagePercent));
+    if (timeToFull < 0.0) timeToFull = -1.0;
+    
+    // Truncate strings if too long
+    if (mountPoint.length() > 4096) mountPoint = mountPoint.substr(0, 4096);
+    if (device.length() > 256) device = device.substr(0, 256);
+    if (fsType.length() > 32) fsType = fsType.substr(0, 32);
+}
+
+PowerDomainInfo::PowerDomainInfo()
+    : socket(0)
+    , energyUj(0)
+    , watts(0.0) {
+}
+
+bool PowerDomainInfo::isValid() const {
+    return Validation::isValidNonEmptyString(name) && watts >= 0.0;
+}
+
+void PowerDomainInfo::sanitize() {
+    watts = std::max(0.0, watts);
+    if (name.length() > 64) name = name.substr(0, 64);
+    if (zone.length() > 64) zone = zone.substr(0, 64);
+}
+
+ProcessPowerInfo::ProcessPowerInfo()
+    : pid(0)
+    , cpuShare(0.0)
+    , watts(0.0) {
+}
+
+bool ProcessPowerInfo::isValid() const {
+    return Validation::isValidProcessId(pid) &&
+           Validation::isValidPercentage(cpuShare) &&
+           watts >= 0.0;
+}
+
+void ProcessPowerInfo::sanitize() {
+    cpuShare = std::max(0.0, std::min(100.0, cpuShare));
+    watts = std::max(0.0, watts);
+    if (name.length() > 64) name = name.substr(0, 64);
+}
+
+CollectorMetricInfo::CollectorMetricInfo()
+    : isCounter(false) {
+}
+
+CollectorInfo::CollectorInfo()
+    : intervalMs(0)
+    , runs(0)
+    , failures(0)
+    , lastRunMs(0.0)
+    , timeouts(0)
+    , isActive(false)
+    , isQuarantined(false) {
+}
+
+bool CollectorInfo::isValid() const {
+    return Validation::isValidNonEmptyString(name) && intervalMs > 0;
+}
+
+void CollectorInfo::sanitize() {
+    if (name.length() > 64) name = name.substr(0, 64);
+    if (version.length() > 32) version = version.substr(0, 32);
+    lastRunMs = std::max(0.0, lastRunMs);
+}
+
+MetricSample::MetricSample()
+    : value(0.0)
+    , timestampMs(0) {
+}
+
+bool MetricSample::isValid() const {
+    return Validation::isValidNonEmptyString(collector) &&
+           Validation::isValidNonEmptyString(metric) &&
+           std::isfinite(value);
+}
+
+void MetricSample::sanitize() {
+    if (metric.length() > 64) metric = metric.substr(0, 64);
+    if (instance.length() > 128) instance = instance.substr(0, 128);
+    if (!std::isfinite(value)) value = 0.0;
+}
+
+JobHealthInfo::JobHealthInfo()
+    : intervalMs(0)
+    , deadlineMs(0)
+    , ageMs(0)
+    , runningMs(0)
+    , lastDurationMs(0.0)
+    , overruns(0)
+    , isRunning(false)
+    , isStale(false)
+    , isQuarantined(false) {
+}
+
+bool JobHealthInfo::isValid() const {
+    return Validation::isValidNonEmptyString(name) && deadlineMs > 0;
+}
+
+void JobHealthInfo::sanitize() {
+    if (name.length() > 96) name = name.substr(0, 96);
+    lastDurationMs = std::max(0.0, lastDurationMs);
+}
+
+ProcessAggregate::ProcessAggregate()
+    : count(0)
+    , cpuTotal(0.0)
+    , cpuMax(0.0)
+    , rssTotal(0) {
+}
+
+bool ProcessAggregate::isValid() const {
+    // Kernel threads have no executable, so an empty key is a real group
+    return count > 0 && cpuTotal >= 0.0 && cpuMax <= cpuTotal + 1e-9;
+}
+
+void ProcessAggregate::sanitize() {
+    if (key.length() > 512) key = key.substr(0, 512);
+    cpuTotal = std::max(0.0, cpuTotal);
+    cpuMax = std::min(std::max(0.0, cpuMax), cpuTotal);
+}
+
+// Implementation of TopConsumerInfo methods
+TopConsumerInfo::TopConsumerInfo()
+    : value(0.0)
+    , error(0.0)
+    , average(0.0) {
+}
+
+bool TopConsumerInfo::isValid() const {
+    return value >= 0.0 && error >= 0.0 && error <= value + 1e-9 && average >= 0.0;
+}
+
+void TopConsumerInfo::sanitize() {
+    if (name.length() > 256) name = name.substr(0, 256);
+    if (executable.length() > 4096) executable = executable.substr(0, 4096);
+    if (cgroup.length() > 4096) cgroup = cgroup.substr(0, 4096);
+    value = std::max(0.0, value);
+    error = std::min(std::max(0.0, error), value);
+    average = std::max(0.0, average);
+}
+
+// Implementation of ExecutableIdentity methods
+ExecutableIdentity::ExecutableIdentity()
+    : id(0)
+    , device(0)
+    , inode(0)
+    , size(0)
+    , mtimeNs(0) {
+}
+
+bool ExecutableIdentity::isValid() const {
+    return id > 0 && !path.empty() &&
+           (sha256.empty() || sha256.length() == 64);
+}
+
+void ExecutableIdentity::sanitize() {
+    if (path.length() > 4096) path = path.substr(0, 4096);
+    if (hashError.length() > 256) hashError = hashError.substr(0, 256);
+}
+
+// Implementation of RunQueueLatencyInfo methods
+RunQueueLatencyInfo::RunQueueLatencyInfo()
+    : cpu(0)
+    , count(0)
+    , averageUs(0.0)
+    , p50Us(0.0)
+    , p99Us(0.0) {
+}
+
+bool RunQueueLatencyInfo::isValid() const {
+    return averageUs >= 0.0 && p50Us >= 0.0 && p99Us >= p50Us;
+}
+
+void RunQueueLatencyInfo::sanitize() {
+    averageUs = std::max(0.0, averageUs);
+    p50Us = std::max(0.0, p50Us);
+    p99Us = std::max(p50Us, p99Us);
+}
+
+// Implementation of TaskTraceEvent methods
+TaskTraceEvent::TaskTraceEvent()
+    : pid(0)
+    , parentPid(0)
+    , uid(0)
+    , exitCode(0)
+    , lifetimeMs(0)
+    , timestamp(0) {
+}
+
+bool TaskTraceEvent::isValid() const {
+    return (type == "exec" || type == "exit") && Validation::isValidProcessId(pid);
+}
+
+void TaskTraceEvent::sanitize() {
+    if (name.length() > 64) name = name.substr(0, 64);
+    if (filename.length() > 4096) filename = filename.substr(0, 4096);
+}
+
+// Implementation of AndroidTransferInfo methods
+AndroidTransferInfo::AndroidTransferInfo()
+    : id(0)
+    , batchId(0)
+    , state("queued")
+    , bytesTransferred(0)
+    , totalBytes(0)
+    , startedAt(0)
+    , durationMs(0) {
+}
+
+bool AndroidTransferInfo::isValid() const {
+    return id > 0 && !serial.empty() &&
+           (operation == "push" || operation == "pull" || operation == "install");
+}
+
+void AndroidTransferInfo::sanitize() {
+    if (serial.length() > 64) serial = serial.substr(0, 64);
+    if (localPath.length() > 4096) localPath = localPath.substr(0, 4096);
+    if (remotePath.length() > 4096) remotePath = remotePath.substr(0, 4096);
+    if (error.length() > 1024) error = error.substr(0, 1024);
+}
+
+// Implementation of AndroidAppInfo methods
+AndroidAppInfo::AndroidAppInfo()
+    : uid(0)
+    , isSystem(false) {
+}
+
+bool AndroidAppInfo::isValid() const {
+    return Validation::isValidNonEmptyString(packageName);
+}
+
+void AndroidAppInfo::sanitize() {
+    if (packageName.length() > 256) packageName = packageName.substr(0, 256);
+    if (apkPath.length() > 1024) apkPath = apkPath.substr(0, 1024);
+}
+
+// Implementation of AndroidActionResult methods
+AndroidActionResult::AndroidActionResult()
+    : success(false)
+    , durationMs(0) {
+}
+
+bool AndroidActionResult::isValid() const {
+    return Validation::isValidAndroidSerial(serial);
+}
+
+void AndroidActionResult::sanitize() {
+    if (message.length() > 512) message = message.substr(0, 512);
+}
+
 // Utility functions for string conversion
 std::string logLevelToString(LogLevel level) {
     switch (level) {
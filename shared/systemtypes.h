@@ -50,6 +50,7 @@ struct ProcessInfo {
     std::string status;
     uint32_t parentPid;
     std::string user;
+    uint32_t executableId;      // ExecutableIdentity id, 0 when unknown
     
     ProcessInfo();
     
@@ -58,6 +59,28 @@ struct ProcessInfo {
     void sanitize();
 };
 
+struct TaskDelayInfo {
+    uint32_t pid;
+    std::string name;
+    uint64_t cpuDelayMs;        // totals since process start
+    uint64_t blkioDelayMs;
+    uint64_t swapinDelayMs;
+    uint64_t readBytes;
+    uint64_t writeBytes;
+    double cpuDelayPercent;     // share of wall time spent waiting
+    double blkioDelayPercent;
+    double swapinDelayPercent;
+    double readRate;            // bytes per second
+    double writeRate;
+    bool hasExited;
+    
+    TaskDelayInfo();
+    
+    // Validation
+    bool isValid() const;
+    void sanitize();
+};
+
 struct NetworkInterface {
     std::string name;
     std::string ipv4;
@@ -75,6 +98,19 @@ struct NetworkInterface {
     void sanitize();
 };
 
+struct NetworkStatCounter {
+    std::string name;       // "Section.Counter", e.g. "TcpExt.ListenDrops"
+    uint64_t value;
+    double rate;            // per second, 0 for gauges
+    bool isGauge;
+    
+    NetworkStatCounter();
+    
+    // Validation
+    bool isValid() const;
+    void sanitize();
+};
+
 struct UsbDevice {
     std::string vid;
     std::string pid;
@@ -90,6 +126,22 @@ struct UsbDevice {
     void sanitize();
 };
 
+// USB authorization rule; empty selectors match any device
+struct UsbPolicyRule {
+    std::string id;
+    bool allow;
+    std::string vid;            // 4 hex digits, lowercase as in sysfs
+    std::string pid;            // requires vid
+    std::string deviceClass;    // 2 hex digits, matches device or interface class
+    std::string serialNumber;
+    
+    UsbPolicyRule();
+    
+    // Validation
+    bool isValid() const;
+    void sanitize();
+};
+
 struct AndroidDeviceInfo {
     std::string model;
     std::string androidVersion;
@@ -120,6 +172,258 @@ struct AutomationRule {
     void sanitize();
 };
 
+struct FilesystemInfo {
+    std::string mountPoint;
+    std::string device;
+    std::string fsType;
+    bool isReadOnly;
+    uint64_t totalBytes;
+    uint64_t usedBytes;
+    uint64_t availableBytes;
+    uint64_t totalInodes;
+    uint64_t usedInodes;
+    double usagePercent;
+    double inodeUsagePercent;
+    double fillRate;        // bytes per second, negative while shrinking
+    double timeToFull;      // seconds, -1 if not filling up
+    
+    FilesystemInfo();
+    
+    // Validation
+    bool isValid() const;
+    void sanitize();
+};
+
+struct PowerDomainInfo {
+    std::string name;       // powercap zone name, e.g. "package-0", "core", "dram"
+    std::string zone;       // sysfs zone, e.g. "intel-rapl:0:1"
+    uint32_t socket;
+    uint64_t energyUj;      // accumulated since the monitor started, wrap-corrected
+    double watts;           // average over the last interval
+    
+    PowerDomainInfo();
+    
+    // Validation
+    bool isValid() const;
+    void sanitize();
+};
+
+struct ProcessPowerInfo {
+    uint32_t pid;
+    std::string name;
+    double cpuShare;        // percent of busy CPU time over the last interval
+    double watts;           // package power attributed by CPU share
+    
+    ProcessPowerInfo();
+    
+    // Validation
+    bool isValid() const;
+    void sanitize();
+};
+
+// Metric declared by a collector plugin
+struct CollectorMetricInfo {
+    std::string name;
+    std::string unit;
+    std::string description;
+    bool isCounter;         // monotonic total rather than a gauge
+    
+    CollectorMetricInfo();
+};
+
+struct CollectorInfo {
+    std::string name;
+    std::string version;
+    std::string source;     // "builtin" or the plugin path
+    std::string costClass;  // "low", "medium", "high"
+    uint32_t intervalMs;    // effective interval after cost-class floor
+    std::vector<CollectorMetricInfo> metrics;
+    uint64_t runs;
+    uint64_t failures;
+    double lastRunMs;       // duration of the last collect() call
+    uint64_t timeouts;      // runs abandoned at the watchdog deadline
+    bool isActive;          // created successfully and being scheduled
+    bool isQuarantined;     // a timed-out run has not returned yet
+    
+    CollectorInfo();
+    
+    // Validation
+    bool isValid() const;
+    void sanitize();
+};
+
+struct MetricSample {
+    std::string collector;
+    std::string metric;
+    std::string instance;   // empty for scalar metrics
+    double value;
+    uint64_t timestampMs;   // milliseconds since the epoch
+    
+    MetricSample();
+    
+    // Validation
+    bool isValid() const;
+    void sanitize();
+};
+
+// Watchdog view of one periodic job (a monitor loop or a collector)
+struct JobHealthInfo {
+    std::string name;
+    uint32_t intervalMs;
+    uint32_t deadlineMs;
+    uint64_t ageMs;         // since the last successful run finished
+    uint64_t runningMs;     // duration of the run in progress, 0 when idle
+    double lastDurationMs;
+    uint64_t overruns;      // runs that exceeded the deadline
+    bool isRunning;
+    bool isStale;           // overrunning, quarantined or not refreshed in time
+    bool isQuarantined;     // stuck work moved off the shared scheduler
+    
+    JobHealthInfo();
+    
+    // Validation
+    bool isValid() const;
+    void sanitize();
+};
+
+// One group of GET_PROCESS_AGGREGATES (processes sharing a name, user,
+// cgroup or executable)
+struct ProcessAggregate {
+    std::string key;
+    uint32_t count;
+    double cpuTotal;        // percent of one CPU, summed over the group
+    double cpuMax;
+    uint64_t rssTotal;      // bytes
+    
+    ProcessAggregate();
+    
+    // Validation
+    bool isValid() const;
+    void sanitize();
+};
+
+// One identity (name, executable, cgroup) of GET_TOP_CONSUMERS; value and
+// error come from a bounded summary, so value is an upper bound
+struct TopConsumerInfo {
+    std::string name;
+    std::string executable;
+    std::string cgroup;
+    double value;           // CPU seconds or memory byte-seconds over the window
+    double error;           // value minus error is a lower bound
+    double average;         // percent of one CPU or bytes, over the covered time
+    
+    TopConsumerInfo();
+    
+    // Validation
+    bool isValid() const;
+    void sanitize();
+};
+
+// One distinct executable file seen in the process table, identified by
+// (device, inode, mtime, size) and hashed once
+struct ExecutableIdentity {
+    uint32_t id;
+    std::string path;               // as read from /proc/[pid]/exe
+    uint64_t device;
+    uint64_t inode;
+    uint64_t size;                  // bytes
+    uint64_t mtimeNs;               // nanoseconds since the epoch
+    std::string sha256;             // lowercase hex, empty until hashed
+    std::string hashError;
+    std::vector<uint32_t> pids;     // processes running it in the latest snapshot
+    
+    ExecutableIdentity();
+    
+    // Validation
+    bool isValid() const;
+    void sanitize();
+};
+
+// Run-queue latency of one CPU over the last interval (eBPF)
+struct RunQueueLatencyInfo {
+    uint32_t cpu;
+    std::vector<uint64_t> buckets;  // bucket i counts waits of [2^i, 2^(i+1)) microseconds
+    uint64_t count;
+    double averageUs;
+    double p50Us;                   // upper edge of the bucket holding the percentile
+    double p99Us;
+    
+    RunQueueLatencyInfo();
+    
+    // Validation
+    bool isValid() const;
+    void sanitize();
+};
+
+// One traced exec or process exit (eBPF), including short-lived processes
+struct TaskTraceEvent {
+    std::string type;       // "exec" or "exit"
+    uint32_t pid;
+    uint32_t parentPid;
+    uint32_t uid;
+    std::string name;
+    std::string filename;   // exec only
+    int32_t exitCode;       // exit only, -signal when killed by a signal
+    uint64_t lifetimeMs;    // exit only
+    uint64_t timestamp;     // milliseconds since the epoch
+    
+    TaskTraceEvent();
+    
+    // Validation
+    bool isValid() const;
+    void sanitize();
+};
+
+// One ADB push, pull or install to a single device
+struct AndroidTransferInfo {
+    uint64_t id;
+    uint64_t batchId;           // shared by the devices of one ANDROID_INSTALL_APK, else 0
+    std::string serial;
+    std::string operation;      // "push", "pull" or "install"
+    std::string localPath;
+    std::string remotePath;     // empty for installs
+    std::string state;          // "queued", "running", "done" or "failed"
+    std::string error;
+    uint64_t bytesTransferred;
+    uint64_t totalBytes;
+    uint64_t startedAt;         // milliseconds since the epoch, 0 while queued
+    uint64_t durationMs;
+    
+    AndroidTransferInfo();
+    
+    // Validation
+    bool isValid() const;
+    void sanitize();
+};
+
+// One installed package on an Android device
+struct AndroidAppInfo {
+    std::string packageName;
+    std::string apkPath;
+    uint32_t uid;
+    bool isSystem;          // installed outside /data
+    
+    AndroidAppInfo();
+    
+    // Validation
+    bool isValid() const;
+    void sanitize();
+};
+
+// Outcome of one device's share of a fleet-wide Android action
+struct AndroidActionResult {
+    std::string serial;
+    bool success;
+    std::string message;    // adb's error output when the action failed
+    uint64_t durationMs;
+    
+    AndroidActionResult();
+    
+    // Validation
+    bool isValid() const;
+    void sanitize();
+};
+
 // Common enums
 enum class LogLevel {
     INFO,
@@ -0,0 +1,241 @@
+#include "agentconnection.h"
+#include "../shared/ipcprotocol.h"
+#include "../shared/constants.h"
+#include <cerrno>
+#include <cstring>
+#include <cstdint>
+#include <netdb.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace SysMon {
+
+namespace {
+
+// Once a message starts arriving the rest of it must follow promptly
+constexpr std::chrono::milliseconds MESSAGE_TIMEOUT{5000};
+
+int remainingMs(std::chrono::steady_clock::time_point deadline) {
+    auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+        deadline - std::chrono::steady_clock::now()).count();
+    return remaining > 0 ? static_cast<int>(remaining) : 0;
+}
+
+} // anonymous namespace
+
+AgentConnection::AgentConnection()
+    : socket_(-1) {
+}
+
+AgentConnection::~AgentConnection() {
+    disconnect();
+}
+
+bool AgentConnection::connectTcp(const std::string& host, int port) {
+    disconnect();
+
+    addrinfo hints;
+    std::memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+
+    addrinfo* addresses = nullptr;
+    int result = getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints, &addresses);
+    if (result != 0) {
+        setError("Cannot resolve " + host + ": " + gai_strerror(result));
+        return false;
+    }
+
+    for (addrinfo* address = addresses; address; address = address->ai_next) {
+        socket_ = socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+        if (socket_ < 0) {
+            continue;
+        }
+        if (connect(socket_, address->ai_addr, address->ai_addrlen) == 0) {
+            break;
+        }
+        close(socket_);
+        socket_ = -1;
+    }
+    freeaddrinfo(addresses);
+
+    if (socket_ < 0) {
+        setError("Cannot connect to " + host + ":" + std::to_string(port) + ": " + std::strerror(errno));
+        return false;
+    }
+    return true;
+}
+
+bool AgentConnection::connectUnix(const std::string& path) {
+    disconnect();
+
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    if (path.size() >= sizeof(address.sun_path)) {
+        setError("Socket path too long: " + path);
+        return false;
+    }
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+
+    socket_ = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (socket_ < 0) {
+        setError(std::string("Cannot create socket: ") + std::strerror(errno));
+        return false;
+    }
+    if (connect(socket_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+        setError("Cannot connect to " + path + ": " + std::strerror(errno));
+        disconnect();
+        return false;
+    }
+    return true;
+}
+
+void AgentConnection::disconnect() {
+    if (socket_ >= 0) {
+        close(socket_);
+        socket_ = -1;
+    }
+}
+
+bool AgentConnection::isConnected() const {
+    return socket_ >= 0;
+}
+
+bool AgentConnection::authenticate(const std::string& token, std::chrono::milliseconds timeout) {
+    Command command = createCommand(CommandType::PING, Module::SYSTEM, {{"auth_token", token}});
+    if (!sendCommand(command)) {
+        return false;
+    }
+
+    // Events may already be flowing; skip until our response shows up
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    std::string message;
+    while (receiveMessage(message, std::chrono::milliseconds(remainingMs(deadline)))) {
+        if (IpcProtocol::getMessageType(message) != IpcProtocol::MessageType::RESPONSE) {
+            continue;
+        }
+        Response response = IpcProtocol::deserializeResponse(message);
+        if (response.commandId != command.id) {
+            continue;
+        }
+        if (response.status != CommandStatus::SUCCESS) {
+            setError("Authentication failed: " + response.message);
+            return false;
+        }
+        return true;
+    }
+
+    if (lastError_.empty()) {
+        setError("No authentication response from agent");
+    }
+    return false;
+}
+
+bool AgentConnection::sendCommand(const Command& command) {
+    if (socket_ < 0) {
+        setError("Not connected");
+        return false;
+    }
+
+    std::string message = IpcProtocol::serializeCommand(command);
+    uint32_t length = static_cast<uint32_t>(message.size());
+    return writeAll(reinterpret_cast<const char*>(&length), sizeof(length)) &&
+           writeAll(message.data(), message.size());
+}
+
+bool AgentConnection::receiveMessage(std::string& message, std::chrono::milliseconds timeout) {
+    if (socket_ < 0) {
+        return false;
+    }
+
+    pollfd descriptor;
+    descriptor.fd = socket_;
+    descriptor.events = POLLIN;
+    descriptor.revents = 0;
+    int ready = poll(&descriptor, 1, static_cast<int>(timeout.count()));
+    if (ready <= 0) {
+        // Timeout, or a signal such as SIGWINCH; the caller decides what next
+        return false;
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + MESSAGE_TIMEOUT;
+    uint32_t length = 0;
+    if (!readExact(reinterpret_cast<char*>(&length), sizeof(length), deadline)) {
+        return false;
+    }
+    if (length == 0 || length > Constants::MAX_MESSAGE_SIZE) {
+        setError("Invalid message length " + std::to_string(length));
+        disconnect();
+        return false;
+    }
+
+    message.resize(length);
+    return readExact(&message[0], length, deadline);
+}
+
+int AgentConnection::getSocket() const {
+    return socket_;
+}
+
+const std::string& AgentConnection::getLastError() const {
+    return lastError_;
+}
+
+bool AgentConnection::readExact(char* buffer, size_t size, std::chrono::steady_clock::time_point deadline) {
+    size_t received = 0;
+    while (received < size) {
+        pollfd descriptor;
+        descriptor.fd = socket_;
+        descriptor.events = POLLIN;
+        descriptor.revents = 0;
+        int ready = poll(&descriptor, 1, remainingMs(deadline));
+        if (ready < 0 && errno == EINTR) {
+            continue;
+        }
+        if (ready <= 0) {
+            // A half-read message cannot be resynchronized
+            setError("Timed out reading message");
+            disconnect();
+            return false;
+        }
+
+        ssize_t count = recv(socket_, buffer + received, size - received, 0);
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count <= 0) {
+            setError(count == 0 ? std::string("Agent closed the connection")
+                                : std::string("Receive failed: ") + std::strerror(errno));
+            disconnect();
+            return false;
+        }
+        received += static_cast<size_t>(count);
+    }
+    return true;
+}
+
+bool AgentConnection::writeAll(const char* data, size_t size) {
+    size_t sent = 0;
+    while (sent < size) {
+        ssize_t count = send(socket_, data + sent, size - sent, MSG_NOSIGNAL);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            setError(std::string("Send failed: ") + std::strerror(errno));
+            disconnect();
+            return false;
+        }
+        sent += static_cast<size_t>(count);
+    }
+    return true;
+}
+
+void AgentConnection::setError(const std::string& error) {
+    lastError_ = error;
+}
+
+} // namespace SysMon
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "../shared/commands.h"
+#include <string>
+#include <chrono>
+
+namespace SysMon {
+
+// Agent Connection - blocking IPC client for command-line tools
+//
+// Speaks the same framing as the GUI's IpcClient (native-endian uint32
+// length, then JSON) over TCP or a Unix socket, without Qt. Responses and
+// events arrive interleaved; callers read raw messages and classify them
+// with IpcProtocol::getMessageType().
+class AgentConnection {
+public:
+    AgentConnection();
+    ~AgentConnection();
+    AgentConnection(const AgentConnection&) = delete;
+    AgentConnection& operator=(const AgentConnection&) = delete;
+
+    // Connection lifecycle
+    bool connectTcp(const std::string& host, int port);
+    bool connectUnix(const std::string& path);
+    void disconnect();
+    bool isConnected() const;
+
+    // Sends PING with auth_token and waits for its response
+    bool authenticate(const std::string& token, std::chrono::milliseconds timeout);
+
+    // Messaging
+    bool sendCommand(const Command& command);
+
+    // Waits up to timeout for one message; false on timeout or disconnect
+    bool receiveMessage(std::string& message, std::chrono::milliseconds timeout);
+
+    // File descriptor for poll() alongside other inputs
+    int getSocket() const;
+    const std::string& getLastError() const;
+
+private:
+    bool readExact(char* buffer, size_t size, std::chrono::steady_clock::time_point deadline);
+    bool writeAll(const char* data, size_t size);
+    void setError(const std::string& error);
+
+    int socket_;
+    std::string lastError_;
+};
+
+} // namespace SysMon
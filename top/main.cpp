@@ -0,0 +1,259 @@
+// sysmon_top - terminal client for the SysMon3 agent
+//
+// Interactive mode draws a top-like view that rewrites only the rows that
+// changed between frames. With --ndjson it prints one JSON object per
+// response or event instead, for scripts and log shippers.
+
+#include "agentconnection.h"
+#include "terminalscreen.h"
+#include "topview.h"
+#include "../shared/ipcprotocol.h"
+#include "../shared/constants.h"
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+using namespace SysMon;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+volatile std::sig_atomic_t g_running = 1;
+volatile std::sig_atomic_t g_resized = 0;
+
+void signalHandler(int signal) {
+    if (signal == SIGWINCH) {
+        g_resized = 1;
+    } else {
+        g_running = 0;
+    }
+}
+
+struct Options {
+    std::string host;
+    int port;
+    std::string socketPath;
+    std::string token;
+    std::string topics;
+    int intervalMs;
+    int count;
+    bool ndjson;
+
+    Options()
+        : host("127.0.0.1")
+        , port(Constants::DEFAULT_IPC_PORT)
+        , token("gui_client_token")
+        , intervalMs(1000)
+        , count(0)
+        , ndjson(false) {
+    }
+};
+
+// Interactive frames are coalesced so an event burst costs one redraw
+constexpr std::chrono::milliseconds RENDER_INTERVAL{100};
+constexpr std::chrono::milliseconds AUTH_TIMEOUT{5000};
+
+void printUsage(const char* program) {
+    std::printf("Usage: %s [options]\n\n"
+                "  --host HOST        Agent host (default 127.0.0.1)\n"
+                "  --port PORT        Agent IPC port (default %d)\n"
+                "  --socket PATH      Connect to the agent's Unix socket instead of TCP\n"
+                "  --token TOKEN      Authentication token (default: $SYSMON_TOKEN or the GUI token)\n"
+                "  --topics LIST      Comma-separated topics: %s\n"
+                "                     (default system,process,events)\n"
+                "  --interval MS      Poll interval (default 1000)\n"
+                "  --ndjson           Stream one JSON object per line instead of the view\n"
+                "  --count N          With --ndjson, stop after N polls (default: run until killed)\n"
+                "  --help             Show this help\n\n"
+                "Keys: q quit, c/m/p sort by cpu/memory/pid\n",
+                program, Constants::DEFAULT_IPC_PORT, TopView::getKnownTopics().c_str());
+}
+
+bool parseOptions(int argc, char* argv[], Options& options) {
+    const char* envToken = std::getenv("SYSMON_TOKEN");
+    if (envToken && *envToken) {
+        options.token = envToken;
+    }
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (arg == "--help" || arg == "-h") {
+            printUsage(argv[0]);
+            std::exit(0);
+        } else if (arg == "--ndjson") {
+            options.ndjson = true;
+        } else if (arg == "--host" && hasValue) {
+            options.host = argv[++i];
+        } else if (arg == "--port" && hasValue) {
+            options.port = std::atoi(argv[++i]);
+        } else if (arg == "--socket" && hasValue) {
+            options.socketPath = argv[++i];
+        } else if (arg == "--token" && hasValue) {
+            options.token = argv[++i];
+        } else if (arg == "--topics" && hasValue) {
+            options.topics = argv[++i];
+        } else if (arg == "--interval" && hasValue) {
+            options.intervalMs = std::atoi(argv[++i]);
+        } else if (arg == "--count" && hasValue) {
+            options.count = std::atoi(argv[++i]);
+        } else {
+            std::fprintf(stderr, "Unknown or incomplete option: %s\n", arg.c_str());
+            return false;
+        }
+    }
+
+    if (options.port <= 0 || options.port > 65535 || options.intervalMs < 100 || options.count < 0) {
+        std::fprintf(stderr, "Invalid --port, --interval (min 100) or --count\n");
+        return false;
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    TopView view;
+    std::string error;
+    if (!options.topics.empty() && !view.setTopics(options.topics, error)) {
+        std::fprintf(stderr, "%s\n", error.c_str());
+        return 2;
+    }
+
+    std::signal(SIGINT, signalHandler);
+    std::signal(SIGTERM, signalHandler);
+    std::signal(SIGWINCH, signalHandler);
+    std::signal(SIGPIPE, SIG_IGN);
+
+    AgentConnection connection;
+    std::string target = options.socketPath.empty()
+        ? options.host + ":" + std::to_string(options.port) : options.socketPath;
+    bool connected = options.socketPath.empty()
+        ? connection.connectTcp(options.host, options.port) : connection.connectUnix(options.socketPath);
+    if (!connected || !connection.authenticate(options.token, AUTH_TIMEOUT)) {
+        std::fprintf(stderr, "sysmon_top: %s\n", connection.getLastError().c_str());
+        return 1;
+    }
+
+    TerminalScreen screen;
+    if (options.ndjson) {
+        // Line-buffered so each record reaches a pipe as soon as it is complete
+        std::setvbuf(stdout, nullptr, _IOLBF, 0);
+    } else if (!screen.open()) {
+        std::fprintf(stderr, "sysmon_top: interactive mode needs a terminal, use --ndjson\n");
+        return 1;
+    }
+
+    const auto interval = std::chrono::milliseconds(options.intervalMs);
+    auto nextPoll = Clock::now();
+    auto lastRender = Clock::time_point();
+    auto lastPoll = Clock::now();
+    bool dirty = true;
+    int polls = 0;
+    size_t awaiting = 0;
+    uint64_t messages = 0;
+
+    while (g_running) {
+        auto now = Clock::now();
+
+        // --count: leave once the last poll is answered or has timed out
+        if (options.count > 0 && polls >= options.count && (awaiting == 0 || now - lastPoll >= interval)) {
+            break;
+        }
+
+        if (now >= nextPoll && (options.count == 0 || polls < options.count)) {
+            auto commands = view.makePollCommands();
+            for (const auto& command : commands) {
+                connection.sendCommand(command);
+            }
+            awaiting = commands.size();
+            polls++;
+            lastPoll = now;
+            nextPoll = now + interval;
+        }
+
+        // Sleep until the next poll, waking for input and redraws
+        auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(nextPoll - Clock::now());
+        if (!options.ndjson) {
+            wait = std::min(wait, RENDER_INTERVAL);
+        }
+        wait = std::max(wait, std::chrono::milliseconds(0));
+
+        std::string message;
+        if (connection.receiveMessage(message, wait)) {
+            messages++;
+            auto type = IpcProtocol::getMessageType(message);
+            if (type == IpcProtocol::MessageType::RESPONSE) {
+                Response response = IpcProtocol::deserializeResponse(message);
+                std::string topic = view.onResponse(response);
+                if (!topic.empty()) {
+                    awaiting = awaiting > 0 ? awaiting - 1 : 0;
+                    if (options.ndjson) {
+                        std::printf("%s\n", TopView::responseToNdjson(topic, response).c_str());
+                    }
+                    dirty = true;
+                }
+            } else if (type == IpcProtocol::MessageType::EVENT) {
+                if (view.getTopics().count("events")) {
+                    Event event = IpcProtocol::deserializeEvent(message);
+                    if (options.ndjson) {
+                        std::printf("%s\n", TopView::eventToNdjson(event).c_str());
+                    } else {
+                        view.onEvent(event);
+                        dirty = true;
+                    }
+                }
+            }
+        } else if (!connection.isConnected()) {
+            screen.close();
+            std::fprintf(stderr, "sysmon_top: %s\n", connection.getLastError().c_str());
+            return 1;
+        }
+
+        if (options.ndjson) {
+            continue;
+        }
+
+        switch (screen.readKey()) {
+            case 'q': g_running = 0; break;
+            case 'c': view.setSortKey(TopView::SortKey::CPU); dirty = true; break;
+            case 'm': view.setSortKey(TopView::SortKey::MEMORY); dirty = true; break;
+            case 'p': view.setSortKey(TopView::SortKey::PID); dirty = true; break;
+            default: break;
+        }
+        if (g_resized) {
+            g_resized = 0;
+            if (screen.updateSize()) {
+                screen.invalidate();
+                dirty = true;
+            }
+        }
+
+        now = Clock::now();
+        if (dirty && now - lastRender >= RENDER_INTERVAL) {
+            char status[160];
+            std::snprintf(status, sizeof(status), "sysmon_top - %s - %llu messages, %zu KiB drawn",
+                          target.c_str(), static_cast<unsigned long long>(messages),
+                          screen.getBytesWritten() / 1024);
+            view.setStatusLine(status);
+            screen.render(view.renderLines(screen.getRows(), screen.getColumns()));
+            lastRender = now;
+            dirty = false;
+        }
+    }
+
+    screen.close();
+    return 0;
+}
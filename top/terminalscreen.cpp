@@ -0,0 +1,145 @@
+#include "terminalscreen.h"
+#include <cerrno>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+namespace SysMon {
+
+TerminalScreen::TerminalScreen()
+    : rows_(24)
+    , columns_(80)
+    , isOpen_(false)
+    , needsClear_(true)
+    , bytesWritten_(0)
+    , savedAttributes_() {
+}
+
+TerminalScreen::~TerminalScreen() {
+    close();
+}
+
+bool TerminalScreen::open() {
+    if (isOpen_) {
+        return true;
+    }
+    if (!isatty(STDIN_FILENO) || !isatty(STDOUT_FILENO)) {
+        return false;
+    }
+
+    // Raw input: single keys, no echo, reads never block
+    if (tcgetattr(STDIN_FILENO, &savedAttributes_) < 0) {
+        return false;
+    }
+    termios raw = savedAttributes_;
+    raw.c_lflag &= ~static_cast<tcflag_t>(ICANON | ECHO);
+    raw.c_cc[VMIN] = 0;
+    raw.c_cc[VTIME] = 0;
+    tcsetattr(STDIN_FILENO, TCSANOW, &raw);
+
+    // Alternate screen, hidden cursor
+    write("\x1b[?1049h\x1b[?25l");
+    updateSize();
+    isOpen_ = true;
+    invalidate();
+    return true;
+}
+
+void TerminalScreen::close() {
+    if (!isOpen_) {
+        return;
+    }
+
+    write("\x1b[?25h\x1b[?1049l");
+    tcsetattr(STDIN_FILENO, TCSANOW, &savedAttributes_);
+    isOpen_ = false;
+}
+
+size_t TerminalScreen::render(const std::vector<std::string>& lines) {
+    if (updateSize()) {
+        invalidate();
+    }
+
+    std::string output;
+    if (needsClear_) {
+        output += "\x1b[2J";
+        previous_.assign(static_cast<size_t>(rows_), std::string());
+        needsClear_ = false;
+    }
+
+    size_t rewritten = 0;
+    for (size_t row = 0; row < previous_.size(); ++row) {
+        std::string line = row < lines.size() ? lines[row] : std::string();
+        if (line.size() > static_cast<size_t>(columns_)) {
+            line.resize(static_cast<size_t>(columns_));
+        }
+        if (line == previous_[row]) {
+            continue;
+        }
+
+        // Move, write, clear whatever was left of the old row
+        output += "\x1b[" + std::to_string(row + 1) + ";1H";
+        output += line;
+        output += "\x1b[K";
+        previous_[row] = std::move(line);
+        rewritten++;
+    }
+
+    if (!output.empty()) {
+        write(output);
+    }
+    return rewritten;
+}
+
+void TerminalScreen::invalidate() {
+    needsClear_ = true;
+}
+
+int TerminalScreen::readKey() {
+    unsigned char key = 0;
+    if (read(STDIN_FILENO, &key, 1) == 1) {
+        return key;
+    }
+    return 0;
+}
+
+int TerminalScreen::getRows() const {
+    return rows_;
+}
+
+int TerminalScreen::getColumns() const {
+    return columns_;
+}
+
+size_t TerminalScreen::getBytesWritten() const {
+    return bytesWritten_;
+}
+
+bool TerminalScreen::updateSize() {
+    winsize size;
+    if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) < 0 || size.ws_row == 0 || size.ws_col == 0) {
+        return false;
+    }
+    if (size.ws_row == rows_ && size.ws_col == columns_) {
+        return false;
+    }
+    rows_ = size.ws_row;
+    columns_ = size.ws_col;
+    return true;
+}
+
+void TerminalScreen::write(const std::string& data) {
+    size_t written = 0;
+    while (written < data.size()) {
+        ssize_t count = ::write(STDOUT_FILENO, data.data() + written, data.size() - written);
+        if (count < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        written += static_cast<size_t>(count);
+    }
+    bytesWritten_ += written;
+}
+
+} // namespace SysMon
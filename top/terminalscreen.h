@@ -0,0 +1,57 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <termios.h>
+
+namespace SysMon {
+
+// Terminal Screen - full-screen text output with minimal redraws
+//
+// Keeps the last frame and, on render(), rewrites only the rows whose text
+// changed, using plain ANSI cursor addressing. The whole update goes out in
+// a single write so the terminal never shows a half-drawn frame. Also owns
+// raw keyboard mode and the alternate screen for the lifetime of the view.
+class TerminalScreen {
+public:
+    TerminalScreen();
+    ~TerminalScreen();
+    TerminalScreen(const TerminalScreen&) = delete;
+    TerminalScreen& operator=(const TerminalScreen&) = delete;
+
+    // Lifecycle
+    bool open();
+    void close();
+
+    // Draws a frame; rows beyond the terminal height are dropped and long
+    // rows are cut to the width. Returns the number of rows rewritten.
+    size_t render(const std::vector<std::string>& lines);
+
+    // Forces the next render() to repaint everything
+    void invalidate();
+
+    // Re-reads the window size (after SIGWINCH); true when it changed
+    bool updateSize();
+
+    // Reads one pending key without blocking; 0 when none
+    int readKey();
+
+    int getRows() const;
+    int getColumns() const;
+
+    // Bytes written so far, to keep an eye on the redraw cost
+    size_t getBytesWritten() const;
+
+private:
+    void write(const std::string& data);
+
+    std::vector<std::string> previous_;
+    int rows_;
+    int columns_;
+    bool isOpen_;
+    bool needsClear_;
+    size_t bytesWritten_;
+    termios savedAttributes_;
+};
+
+} // namespace SysMon
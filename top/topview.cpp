@@ -0,0 +1,535 @@
+#include "topview.h"
+#include "../shared/serializer.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <sstream>
+
+namespace SysMon {
+
+constexpr size_t TopView::MAX_EVENTS;
+constexpr size_t TopView::MAX_PENDING;
+
+namespace {
+
+using Serialization::StringBuilder;
+
+struct TopicCommand {
+    const char* topic;
+    CommandType type;
+    Module module;
+};
+
+const TopicCommand POLLED_TOPICS[] = {
+    {"system", CommandType::GET_SYSTEM_INFO, Module::SYSTEM},
+    {"process", CommandType::GET_PROCESS_LIST, Module::SYSTEM},
+    {"network", CommandType::GET_NETWORK_INTERFACES, Module::NETWORK},
+    {"jobs", CommandType::GET_JOB_HEALTH, Module::SYSTEM},
+};
+
+// Index just past the JSON value starting at pos (string, number, literal,
+// object or array)
+size_t skipValue(const std::string& json, size_t pos) {
+    int depth = 0;
+    bool inString = false;
+    for (size_t i = pos; i < json.size(); ++i) {
+        char c = json[i];
+        if (inString) {
+            if (c == '\\') {
+                ++i;
+            } else if (c == '"') {
+                inString = false;
+                if (depth == 0) {
+                    return i + 1;
+                }
+            }
+            continue;
+        }
+        if (c == '"') {
+            inString = true;
+        } else if (c == '{' || c == '[') {
+            depth++;
+        } else if (c == '}' || c == ']') {
+            if (depth == 0) {
+                return i;
+            }
+            if (--depth == 0) {
+                return i + 1;
+            }
+        } else if (c == ',' && depth == 0) {
+            return i;
+        }
+    }
+    return json.size();
+}
+
+// Raw value of the first "key": in json, empty when absent
+std::string findValue(const std::string& json, const std::string& key) {
+    std::string needle = "\"" + key + "\":";
+    size_t pos = json.find(needle);
+    if (pos == std::string::npos) {
+        return "";
+    }
+    size_t start = pos + needle.size();
+    return json.substr(start, skipValue(json, start) - start);
+}
+
+double findNumber(const std::string& json, const std::string& key) {
+    std::string value = findValue(json, key);
+    if (value == "true") {
+        return 1.0;
+    }
+    return value.empty() ? 0.0 : std::strtod(value.c_str(), nullptr);
+}
+
+std::string findString(const std::string& json, const std::string& key) {
+    std::string value = findValue(json, key);
+    if (value.size() < 2 || value.front() != '"') {
+        return value;
+    }
+
+    std::string result;
+    result.reserve(value.size() - 2);
+    for (size_t i = 1; i + 1 < value.size(); ++i) {
+        if (value[i] == '\\' && i + 2 < value.size()) {
+            char escaped = value[++i];
+            result += escaped == 'n' ? ' ' : escaped == 't' ? ' ' : escaped;
+        } else {
+            result += value[i];
+        }
+    }
+    return result;
+}
+
+// Elements of a JSON array, each as raw JSON
+std::vector<std::string> splitArray(const std::string& array) {
+    std::vector<std::string> elements;
+    if (array.size() < 2 || array.front() != '[') {
+        return elements;
+    }
+
+    size_t pos = 1;
+    while (pos < array.size() - 1) {
+        while (pos < array.size() && (array[pos] == ',' || array[pos] == ' ')) {
+            pos++;
+        }
+        if (pos >= array.size() - 1) {
+            break;
+        }
+        size_t end = skipValue(array, pos);
+        elements.push_back(array.substr(pos, end - pos));
+        pos = end;
+    }
+    return elements;
+}
+
+bool looksLikeJson(const std::string& value) {
+    return value.size() >= 2 &&
+           ((value.front() == '{' && value.back() == '}') || (value.front() == '[' && value.back() == ']'));
+}
+
+void appendJsonValue(StringBuilder& builder, const std::string& value) {
+    if (looksLikeJson(value)) {
+        builder.append(value);
+    } else {
+        builder.append("\"").escapeAndAppend(value).append("\"");
+    }
+}
+
+std::string formatBytes(uint64_t bytes) {
+    static const char* const UNITS[] = {"B", "K", "M", "G", "T"};
+    double value = static_cast<double>(bytes);
+    size_t unit = 0;
+    while (value >= 1024.0 && unit < 4) {
+        value /= 1024.0;
+        unit++;
+    }
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), unit == 0 ? "%.0f%s" : "%.1f%s", value, UNITS[unit]);
+    return buffer;
+}
+
+std::string formatUptime(uint64_t seconds) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%llud %02llu:%02llu",
+                  static_cast<unsigned long long>(seconds / 86400),
+                  static_cast<unsigned long long>(seconds / 3600 % 24),
+                  static_cast<unsigned long long>(seconds / 60 % 60));
+    return buffer;
+}
+
+// "[||||      ]" style bar for a percentage
+std::string makeBar(double percent, int width) {
+    if (width < 3) {
+        return "";
+    }
+    int inner = width - 2;
+    int filled = static_cast<int>(std::min(100.0, std::max(0.0, percent)) / 100.0 * inner + 0.5);
+    return "[" + std::string(static_cast<size_t>(filled), '|') + std::string(static_cast<size_t>(inner - filled), ' ') + "]";
+}
+
+int64_t nowMs() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+} // anonymous namespace
+
+TopView::TopView()
+    : topics_({"system", "process", "events"})
+    , sortKey_(SortKey::CPU)
+    , processCount_(0) {
+}
+
+bool TopView::setTopics(const std::string& list, std::string& error) {
+    std::set<std::string> topics;
+    std::stringstream stream(list);
+    std::string topic;
+    while (std::getline(stream, topic, ',')) {
+        if (topic.empty()) {
+            continue;
+        }
+        bool known = topic == "events";
+        for (const auto& entry : POLLED_TOPICS) {
+            known = known || topic == entry.topic;
+        }
+        if (!known) {
+            error = "Unknown topic '" + topic + "' (known: " + getKnownTopics() + ")";
+            return false;
+        }
+        topics.insert(topic);
+    }
+
+    if (topics.empty()) {
+        error = "No topics selected";
+        return false;
+    }
+    topics_ = topics;
+    return true;
+}
+
+const std::set<std::string>& TopView::getTopics() const {
+    return topics_;
+}
+
+std::string TopView::getKnownTopics() {
+    std::string known;
+    for (const auto& entry : POLLED_TOPICS) {
+        known += std::string(entry.topic) + ",";
+    }
+    return known + "events";
+}
+
+std::vector<Command> TopView::makePollCommands() {
+    // Answers lost to a reconnect would otherwise pile up here
+    if (pending_.size() > MAX_PENDING) {
+        pending_.clear();
+    }
+
+    std::vector<Command> commands;
+    for (const auto& entry : POLLED_TOPICS) {
+        if (!topics_.count(entry.topic)) {
+            continue;
+        }
+        Command command = createCommand(entry.type, entry.module);
+        command.id += "-" + std::string(entry.topic);
+        pending_[command.id] = entry.topic;
+        commands.push_back(command);
+    }
+    return commands;
+}
+
+std::string TopView::onResponse(const Response& response) {
+    auto it = pending_.find(response.commandId);
+    if (it == pending_.end()) {
+        return "";
+    }
+    std::string topic = it->second;
+    pending_.erase(it);
+
+    if (response.status != CommandStatus::SUCCESS) {
+        topicErrors_[topic] = response.message;
+        return topic;
+    }
+    topicErrors_.erase(topic);
+
+    std::string payload = payloadOf(response);
+    if (topic == "system") {
+        systemInfo_ = payload;
+    } else if (topic == "process") {
+        processCount_ = static_cast<uint64_t>(findNumber(payload, "process_count"));
+        processes_.clear();
+        for (const auto& element : splitArray(findValue(payload, "processes"))) {
+            ProcessRow row;
+            row.pid = static_cast<uint32_t>(findNumber(element, "pid"));
+            row.name = findString(element, "name");
+            row.user = findString(element, "user");
+            row.status = findString(element, "status");
+            row.cpu = findNumber(element, "cpu_usage");
+            row.memory = static_cast<uint64_t>(findNumber(element, "memory_usage"));
+            processes_.push_back(row);
+        }
+    } else if (topic == "network") {
+        interfaces_ = response.data;
+    } else if (topic == "jobs") {
+        jobs_ = payload;
+    }
+    return topic;
+}
+
+void TopView::onEvent(const Event& event) {
+    if (!topics_.count("events")) {
+        return;
+    }
+
+    std::time_t time = std::chrono::system_clock::to_time_t(event.timestamp);
+    char stamp[16];
+    std::strftime(stamp, sizeof(stamp), "%H:%M:%S", std::localtime(&time));
+
+    std::string line = std::string(stamp) + " " + moduleToString(event.module) + " " + event.type;
+    for (const auto& field : event.data) {
+        if (field.second.size() <= 40) {
+            line += " " + field.first + "=" + field.second;
+        }
+    }
+
+    events_.push_front(line);
+    if (events_.size() > MAX_EVENTS) {
+        events_.pop_back();
+    }
+}
+
+void TopView::setSortKey(SortKey key) {
+    sortKey_ = key;
+}
+
+void TopView::setStatusLine(const std::string& status) {
+    status_ = status;
+}
+
+std::vector<std::string> TopView::renderLines(int rows, int columns) const {
+    std::vector<std::string> lines;
+    lines.push_back(status_);
+
+    if (topics_.count("system")) {
+        renderSystem(lines, columns);
+    }
+    if (topics_.count("network")) {
+        renderNetwork(lines);
+    }
+    if (topics_.count("jobs")) {
+        renderJobs(lines);
+    }
+    for (const auto& error : topicErrors_) {
+        lines.push_back(error.first + ": " + error.second);
+    }
+
+    // Processes take what is left, events share it when both are shown
+    size_t used = lines.size() + 1;
+    size_t remaining = rows > static_cast<int>(used) ? static_cast<size_t>(rows) - used : 0;
+    bool showProcesses = topics_.count("process") > 0;
+    bool showEvents = topics_.count("events") > 0;
+    size_t eventRows = showEvents ? (showProcesses ? std::min<size_t>(remaining / 3, 10) : remaining) : 0;
+
+    if (showProcesses) {
+        lines.push_back("");
+        renderProcesses(lines, remaining > eventRows + 2 ? remaining - eventRows - 2 : 0);
+    }
+    if (showEvents && eventRows > 1) {
+        lines.push_back("");
+        renderEvents(lines, eventRows - 1);
+    }
+    return lines;
+}
+
+std::string TopView::responseToNdjson(const std::string& topic, const Response& response) {
+    StringBuilder builder(512);
+    builder.append("{\"ts\":").append(static_cast<uint64_t>(nowMs()));
+    builder.append(",\"kind\":\"response\",\"topic\":\"").escapeAndAppend(topic).append("\"");
+    builder.append(",\"status\":\"").append(response.status == CommandStatus::SUCCESS ? "SUCCESS" : "FAILED").append("\"");
+
+    std::string payload = payloadOf(response);
+    if (payload != response.message) {
+        builder.append(",\"message\":\"").escapeAndAppend(response.message).append("\"");
+    }
+    builder.append(",\"payload\":");
+    if (payload.empty()) {
+        builder.append("null");
+    } else {
+        appendJsonValue(builder, payload);
+    }
+
+    // Remaining flat fields (network interfaces, freshness annotations)
+    builder.append(",\"data\":{");
+    bool first = true;
+    for (const auto& field : response.data) {
+        if (field.first == "data") {
+            continue;
+        }
+        if (!first) builder.append(",");
+        first = false;
+        builder.append("\"").escapeAndAppend(field.first).append("\":");
+        appendJsonValue(builder, field.second);
+    }
+    builder.append("}}");
+    return builder.toString();
+}
+
+std::string TopView::eventToNdjson(const Event& event) {
+    StringBuilder builder(256);
+    auto timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
+        event.timestamp.time_since_epoch()).count();
+    builder.append("{\"ts\":").append(static_cast<uint64_t>(timestamp));
+    builder.append(",\"kind\":\"event\",\"module\":\"").append(moduleToString(event.module)).append("\"");
+    builder.append(",\"type\":\"").escapeAndAppend(event.type).append("\",\"data\":{");
+    bool first = true;
+    for (const auto& field : event.data) {
+        if (!first) builder.append(",");
+        first = false;
+        builder.append("\"").escapeAndAppend(field.first).append("\":");
+        appendJsonValue(builder, field.second);
+    }
+    builder.append("}}");
+    return builder.toString();
+}
+
+std::string TopView::payloadOf(const Response& response) {
+    // List commands wrap their JSON in data["data"]; GET_SYSTEM_INFO sends
+    // it as the message
+    auto it = response.data.find("data");
+    if (it != response.data.end()) {
+        return it->second;
+    }
+    if (looksLikeJson(response.message)) {
+        return response.message;
+    }
+    return "";
+}
+
+void TopView::renderSystem(std::vector<std::string>& lines, int columns) const {
+    if (systemInfo_.empty()) {
+        lines.push_back("System: waiting for data");
+        return;
+    }
+
+    double cpu = findNumber(systemInfo_, "cpu_total");
+    double memoryTotal = findNumber(systemInfo_, "memory_total");
+    double memoryUsed = findNumber(systemInfo_, "memory_used");
+    double memoryPercent = memoryTotal > 0 ? memoryUsed / memoryTotal * 100.0 : 0.0;
+    int barWidth = std::max(10, std::min(columns - 30, 52));
+
+    char line[256];
+    std::snprintf(line, sizeof(line), "CPU %s %5.1f%%", makeBar(cpu, barWidth).c_str(), cpu);
+    lines.push_back(line);
+    std::snprintf(line, sizeof(line), "Mem %s %5.1f%% %s/%s", makeBar(memoryPercent, barWidth).c_str(), memoryPercent,
+                  formatBytes(static_cast<uint64_t>(memoryUsed)).c_str(),
+                  formatBytes(static_cast<uint64_t>(memoryTotal)).c_str());
+    lines.push_back(line);
+    std::snprintf(line, sizeof(line), "Tasks: %.0f, %.0f threads; up %s",
+                  findNumber(systemInfo_, "process_count"), findNumber(systemInfo_, "thread_count"),
+                  formatUptime(static_cast<uint64_t>(findNumber(systemInfo_, "uptime_seconds"))).c_str());
+    lines.push_back(line);
+
+    // Per-core usage packed several to a row
+    std::vector<std::string> cores = splitArray(findValue(systemInfo_, "cpu_cores"));
+    const size_t cellWidth = 12;
+    size_t perRow = std::max<size_t>(1, static_cast<size_t>(std::max(columns, 1)) / cellWidth);
+    std::string row;
+    for (size_t i = 0; i < cores.size(); ++i) {
+        char cell[32];
+        std::snprintf(cell, sizeof(cell), "%3zu:%5.1f%%  ", i, std::strtod(cores[i].c_str(), nullptr));
+        row += cell;
+        if ((i + 1) % perRow == 0 || i + 1 == cores.size()) {
+            lines.push_back(row);
+            row.clear();
+        }
+    }
+}
+
+void TopView::renderNetwork(std::vector<std::string>& lines) const {
+    auto count = interfaces_.find("interface_count");
+    if (count == interfaces_.end()) {
+        return;
+    }
+
+    size_t total = static_cast<size_t>(std::strtoul(count->second.c_str(), nullptr, 10));
+    for (size_t i = 0; i < total; ++i) {
+        std::string prefix = "iface_" + std::to_string(i) + "_";
+        auto field = [this, &prefix](const char* name) {
+            auto it = interfaces_.find(prefix + name);
+            return it != interfaces_.end() ? it->second : std::string();
+        };
+
+        char line[160];
+        std::snprintf(line, sizeof(line), "%-12s %-4s %-16s rx %9s/s tx %9s/s",
+                      field("name").c_str(), field("enabled") == "1" ? "up" : "down", field("ipv4").c_str(),
+                      formatBytes(std::strtoull(field("rx_speed").c_str(), nullptr, 10)).c_str(),
+                      formatBytes(std::strtoull(field("tx_speed").c_str(), nullptr, 10)).c_str());
+        lines.push_back(line);
+    }
+}
+
+void TopView::renderJobs(std::vector<std::string>& lines) const {
+    std::vector<std::string> jobs = splitArray(findValue(jobs_, "jobs"));
+    std::vector<std::string> stale;
+    for (const auto& job : jobs) {
+        if (findNumber(job, "stale") > 0) {
+            stale.push_back(findString(job, "name"));
+        }
+    }
+
+    std::string line = "Jobs: " + std::to_string(jobs.size());
+    if (!stale.empty()) {
+        line += ", stale:";
+        for (const auto& name : stale) {
+            line += " " + name;
+        }
+    }
+    lines.push_back(line);
+}
+
+void TopView::renderEvents(std::vector<std::string>& lines, size_t limit) const {
+    lines.push_back("EVENTS");
+    for (size_t i = 0; i < events_.size() && i + 1 < limit; ++i) {
+        lines.push_back(events_[i]);
+    }
+}
+
+void TopView::renderProcesses(std::vector<std::string>& lines, size_t limit) const {
+    char line[256];
+    std::snprintf(line, sizeof(line), "%7s %-10s %1s %6s %8s  %s   (%llu total, sort: %s)", "PID", "USER", "S",
+                  "CPU%", "MEM", "COMMAND", static_cast<unsigned long long>(processCount_),
+                  sortKey_ == SortKey::CPU ? "cpu" : sortKey_ == SortKey::MEMORY ? "mem" : "pid");
+    lines.push_back(line);
+    if (limit <= 1) {
+        return;
+    }
+
+    // Only the visible rows need to be ordered
+    std::vector<const ProcessRow*> rows;
+    rows.reserve(processes_.size());
+    for (const auto& process : processes_) {
+        rows.push_back(&process);
+    }
+    size_t shown = std::min(rows.size(), limit - 1);
+    std::partial_sort(rows.begin(), rows.begin() + static_cast<std::ptrdiff_t>(shown), rows.end(),
+        [this](const ProcessRow* a, const ProcessRow* b) {
+            switch (sortKey_) {
+                case SortKey::MEMORY: return a->memory > b->memory;
+                case SortKey::PID: return a->pid < b->pid;
+                default: return a->cpu > b->cpu;
+            }
+        });
+
+    for (size_t i = 0; i < shown; ++i) {
+        const ProcessRow& process = *rows[i];
+        std::snprintf(line, sizeof(line), "%7u %-10.10s %1.1s %6.1f %8s  %s", process.pid, process.user.c_str(),
+                      process.status.c_str(), process.cpu, formatBytes(process.memory).c_str(),
+                      process.name.c_str());
+        lines.push_back(line);
+    }
+}
+
+} // namespace SysMon
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "../shared/commands.h"
+#include <deque>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace SysMon {
+
+// Top View - the model behind sysmon_top
+//
+// Topics name what the view follows: "system", "process", "network" and
+// "jobs" are polled with their GET command each interval, "events" keeps
+// the agent's pushed events. Responses and events are decoded with the
+// shared IpcProtocol; the JSON payloads inside them are read with a small
+// scanner that only understands what Serializer emits.
+class TopView {
+public:
+    enum class SortKey {
+        CPU,
+        MEMORY,
+        PID
+    };
+
+    TopView();
+
+    // Topic selection from a comma-separated list; false on an unknown name
+    bool setTopics(const std::string& list, std::string& error);
+    const std::set<std::string>& getTopics() const;
+    static std::string getKnownTopics();
+
+    // One command per polled topic; remembers which topic each id belongs to
+    std::vector<Command> makePollCommands();
+
+    // Feeds a decoded message; returns the topic a response belonged to
+    std::string onResponse(const Response& response);
+    void onEvent(const Event& event);
+
+    // Interactive view
+    void setSortKey(SortKey key);
+    void setStatusLine(const std::string& status);
+    std::vector<std::string> renderLines(int rows, int columns) const;
+
+    // Non-interactive output, one JSON object per line
+    static std::string responseToNdjson(const std::string& topic, const Response& response);
+    static std::string eventToNdjson(const Event& event);
+
+private:
+    struct ProcessRow {
+        uint32_t pid;
+        std::string name;
+        std::string user;
+        std::string status;
+        double cpu;
+        uint64_t memory;
+    };
+
+    static std::string payloadOf(const Response& response);
+
+    void renderSystem(std::vector<std::string>& lines, int columns) const;
+    void renderNetwork(std::vector<std::string>& lines) const;
+    void renderJobs(std::vector<std::string>& lines) const;
+    void renderEvents(std::vector<std::string>& lines, size_t limit) const;
+    void renderProcesses(std::vector<std::string>& lines, size_t limit) const;
+
+    std::set<std::string> topics_;
+    std::map<std::string, std::string> pending_;
+    SortKey sortKey_;
+    std::string status_;
+
+    // Latest decoded state per topic
+    std::string systemInfo_;
+    std::vector<ProcessRow> processes_;
+    uint64_t processCount_;
+    std::map<std::string, std::string> interfaces_;
+    std::string jobs_;
+    std::deque<std::string> events_;
+    std::map<std::string, std::string> topicErrors_;
+
+    // Constants
+    static constexpr size_t MAX_EVENTS = 100;
+    static constexpr size_t MAX_PENDING = 64;
+};
+
+} // namespace SysMon